@@ -39,12 +39,30 @@ struct OrtArenaCfg {
   int initial_growth_chunk_size_bytes;    // use -1 to allow ORT to choose the default
   int64_t max_power_of_two_extend_bytes;  // use -1 to allow ORT to choose the default
 
+  // use -1 to allow ORT to choose the default, 0 disables the thread-local caches of the arena
+  int64_t thread_local_cache_max_bytes = -1;
+
+  // use -1 to allow ORT to choose the default. 0 = normal pages, 1 = transparent huge pages,
+  // 2 = explicit huge pages with a fallback to transparent huge pages. See onnxruntime::HugePageMode.
+  int huge_page_mode = -1;
+
+  // Releases the free regions above trim_watermark_bytes after the arena was idle for trim_idle_interval_ms,
+  // or every trim_run_interval runs. use -1 to allow ORT to choose the default, which disables trimming.
+  int64_t trim_watermark_bytes = -1;
+  int64_t trim_idle_interval_ms = -1;
+  int64_t trim_run_interval = -1;
+
   bool IsValid() {
     return arena_extend_strategy >= -1 && arena_extend_strategy <= 1 &&
            initial_chunk_size_bytes >= -1 &&
            max_dead_bytes_per_chunk >= -1 &&
            initial_growth_chunk_size_bytes >= -1 &&
-           max_power_of_two_extend_bytes >= -1;
+           max_power_of_two_extend_bytes >= -1 &&
+           thread_local_cache_max_bytes >= -1 &&
+           huge_page_mode >= -1 && huge_page_mode <= 2 &&
+           trim_watermark_bytes >= -1 &&
+           trim_idle_interval_ms >= -1 &&
+           trim_run_interval >= -1;
   }
 
   // config key names that we parse in FromKeyValuePairs
@@ -55,6 +73,11 @@ struct OrtArenaCfg {
     static constexpr const char* InitialGrowthChunkSizeBytes = "arena.initial_growth_chunk_size_bytes";
     static constexpr const char* MaxPowerOfTwoExtendBytes = "arena.max_power_of_two_extend_bytes";
     static constexpr const char* MaxMem = "arena.max_mem";
+    static constexpr const char* ThreadLocalCacheMaxBytes = "arena.thread_local_cache_max_bytes";
+    static constexpr const char* HugePageMode = "arena.huge_page_mode";
+    static constexpr const char* TrimWatermarkBytes = "arena.trim_watermark_bytes";
+    static constexpr const char* TrimIdleIntervalMs = "arena.trim_idle_interval_ms";
+    static constexpr const char* TrimRunInterval = "arena.trim_run_interval";
   };
 
   static onnxruntime::common::Status FromKeyValuePairs(const OrtKeyValuePairs& kvps, OrtArenaCfg& cfg);
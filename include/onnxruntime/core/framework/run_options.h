@@ -5,6 +5,7 @@
 
 #include <string>
 #include <atomic>
+#include <chrono>
 
 #include "core/common/inlined_containers_fwd.h"
 #include "core/session/onnxruntime_c_api.h"
@@ -35,6 +36,19 @@ struct OrtRunOptions {
   // So it is possible that only some of the nodes are executed.
   bool only_execute_path_to_fetches = false;
 
+  // Scheduling priority of the Run() calls that use this OrtRunOptions instance on
+  // thread pools shared with other sessions.  Values below 0 are low priority,
+  // 0 (default) is normal and values above 0 are high priority.  While a higher
+  // priority Run() is in flight, lower priority ones run their parallel loops
+  // in the calling thread.
+  int priority = 0;
+
+  // Point in time after which the Run() calls that use this OrtRunOptions instance
+  // fail. Besides between nodes, it is tested between the blocks of parallel loops
+  // and the iterations of Loop and Scan, so that an expired Run() frees its threads
+  // quickly. Defaults to no deadline.
+  std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+
 #ifdef ENABLE_TRAINING
   // Used by onnxruntime::training::TrainingSession. This class is now deprecated.
   // Delete training_mode when TrainingSession is deleted.
@@ -9,7 +9,10 @@
 
 /* Modifications Copyright (c) Microsoft. */
 
+#include <algorithm>
+#include <chrono>
 #include <type_traits>
+#include <vector>
 
 #pragma once
 #include "onnxruntime_config.h"
@@ -52,6 +55,7 @@
 #include "core/common/spin_pause.h"
 #include "core/platform/ort_spin_lock.h"
 #include "core/platform/Barrier.h"
+#include "core/platform/threadpool.h"
 
 // ORT thread pool overview
 // ------------------------
@@ -77,6 +81,8 @@
 //
 //   This spin-then-block behavior is configured via a flag provided
 //   when creating the thread pool, and by the constant spin_count.
+//   Optionally, the time spent spinning is adapted to the gaps
+//   between the work each thread receives (see AdaptiveSpinPolicy).
 //
 // - Although all tasks are simple void()->void functions,
 //   conceptually there are three different kinds:
@@ -151,6 +157,15 @@
 //   active threads over time (when the entire pool is not needed),
 //   and to allow concurrent requests to submit works to their own
 //   respective sets of preferred workers.
+//
+// - In the opt-in NUMA-aware mode (ThreadOptions::numa_aware), workers
+//   are grouped by the NUMA node of their affinity.  A worker steals
+//   from siblings on its own node first, and only crosses nodes once
+//   the queues on its node are empty.  Each parallel section picks a
+//   home node when its first loop is dispatched, and tasks for the
+//   section are kept on workers of that node (spilling to other nodes
+//   only if the section needs more threads than the node has).  This
+//   keeps successive loops over the same data on the node holding it.
 
 namespace onnxruntime {
 namespace concurrency {
@@ -230,6 +245,7 @@ class ThreadPoolProfiler {
   void LogCoreAndBlock(std::ptrdiff_t) {}
   void LogThreadId(int) {}
   void LogRun(int) {}
+  void LogSpinBudget(int, uint64_t) {}
   std::string DumpChildThreadStat() { return {}; }
 };
 #else
@@ -256,6 +272,7 @@ class ThreadPoolProfiler {
   void LogCoreAndBlock(std::ptrdiff_t block_size);  // called in main thread to log core and block size for task breakdown
   void LogThreadId(int thread_idx);                 // called in child thread to log its id
   void LogRun(int thread_idx);                      // called in child thread to log num of run
+  void LogSpinBudget(int thread_idx, uint64_t spin_budget_us);  // called in child thread to log its adaptive spin budget
   std::string DumpChildThreadStat();                // return all child statistics collected so far
 
  private:
@@ -285,6 +302,7 @@ class ThreadPoolProfiler {
     uint64_t num_run_ = 0;
     onnxruntime::TimePoint last_logged_point_ = Clock::now();
     int32_t core_ = -1;  // core that the child thread is running on
+    int64_t spin_budget_us_ = -1;  // latest adaptive spin budget, -1 if not in use
   };
 #ifdef _MSC_VER
 #pragma warning(pop)
@@ -294,6 +312,57 @@ class ThreadPoolProfiler {
 };
 #endif
 
+// Adaptive spin-then-park policy for a worker thread.  The worker
+// reports the length of each idle gap it observes, i.e. the time from
+// running out of work until it obtains the next task, whether it found
+// that task while spinning or after parking.  Gaps no longer than the
+// target are "short": spinning through them avoids an OS wake-up.
+// Longer gaps, such as the time between requests, are better spent
+// parked.
+//
+// The policy keeps exponential moving averages of the fraction of
+// short gaps and of the length of the short gaps.  While most gaps are
+// short, the spin budget covers twice the average short gap (capped at
+// the target); otherwise the budget is zero and the worker parks as
+// soon as it runs out of work.  Parking does not stop the measurement,
+// so a worker resumes spinning once work arrives in short gaps again.
+
+class AdaptiveSpinPolicy {
+ public:
+  constexpr AdaptiveSpinPolicy() = default;
+
+  void SetTarget(uint64_t target_us) {
+    target_us_ = target_us;
+    short_gap_us_ = static_cast<double>(target_us) / 2;
+    spin_budget_us_ = target_us;
+  }
+
+  uint64_t SpinBudgetMicroseconds() const {
+    return spin_budget_us_;
+  }
+
+  void RecordIdleGap(uint64_t gap_us) {
+    const bool short_gap = gap_us <= target_us_;
+    short_gap_rate_ += ((short_gap ? 1.0 : 0.0) - short_gap_rate_) * kSmoothing;
+    if (short_gap) {
+      short_gap_us_ += (static_cast<double>(gap_us) - short_gap_us_) * kSmoothing;
+    }
+    if (short_gap_rate_ >= kMinShortGapRate) {
+      spin_budget_us_ = std::min(target_us_, static_cast<uint64_t>(2 * short_gap_us_) + 1);
+    } else {
+      spin_budget_us_ = 0;
+    }
+  }
+
+ private:
+  static constexpr double kSmoothing = 0.125;
+  static constexpr double kMinShortGapRate = 0.5;
+  uint64_t target_us_ = 0;
+  uint64_t spin_budget_us_ = 0;
+  double short_gap_rate_ = 1.0;
+  double short_gap_us_ = 0.0;
+};
+
 // Extended Eigen thread pool interface, avoiding the need to modify
 // the ThreadPoolInterface.h header from the external Eigen
 // repository.
@@ -384,6 +453,14 @@ class ThreadPoolParallelSection {
   std::atomic<ThreadPoolLoop*> current_loop{nullptr};
   std::atomic<unsigned> workers_in_loop{0};
 
+  // NUMA node whose workers run the section's tasks, or -1 if the pool
+  // is not NUMA-aware.  Chosen when the first loop is dispatched.
+  int numa_node = -1;
+
+  // Worker queue of each par_idx when numa_node != -1, see
+  // AssignNumaWorkers.
+  InlinedVector<unsigned> numa_workers;
+
   // Members to track asynchronous dispatching
   int dispatch_q_idx = -1;      // index of thread that dispatch work to all other threads
   unsigned dispatch_w_idx = 0;  // index of enqueued work
@@ -772,6 +849,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         env_(env),
         num_threads_(num_threads),
         allow_spinning_(allow_spinning),
+        adaptive_spinning_(allow_spinning && thread_options.adaptive_spin_target_us > 0),
         set_denormal_as_zero_(thread_options.set_denormal_as_zero),
         worker_data_(num_threads),
         all_coprimes_(num_threads),
@@ -789,11 +867,18 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       ComputeCoprimes(i, &all_coprimes_.back());
     }
 
+    InitializeNumaNodes(thread_options);
+
     // Eigen::MaxSizeVector has neither essential exception safety features
     // such as swap, nor it is movable. So we have to join threads right here
     // on exception
     ORT_TRY {
       worker_data_.resize(num_threads_);
+      if (adaptive_spinning_) {
+        for (auto& td : worker_data_) {
+          td.spin_policy.SetTarget(static_cast<uint64_t>(thread_options.adaptive_spin_target_us));
+        }
+      }
       for (auto i = 0u; i < num_threads_; i++) {
         worker_data_[i].thread.reset(env_.CreateThread(name, i, WorkerLoop, this, thread_options));
       }
@@ -823,6 +908,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     fn = q.PushBack(std::move(fn));
     if (!fn) {
       // The queue accepted the work; ensure that the thread will pick it up
+      RecordQueueDepth(q);
       td.EnsureAwake();
     } else {
       // Run the work directly if the queue rejected the work
@@ -857,12 +943,14 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     ps.work_done = false;
     ps.tasks_revoked = 0;
     ps.current_dop = 1;
+    ps.numa_node = -1;
     ps.active = true;
   }
 
   void StartParallelSection(ThreadPoolParallelSection& ps) override {
     PerThread* pt = GetPerThread();
     StartParallelSectionInternal(*pt, ps);
+    num_parallel_sections_.fetch_add(1, std::memory_order_relaxed);
   }
 
   // End a parallel section, waiting for all worker threads to exit from
@@ -1069,6 +1157,86 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     }
   }
 
+  // Select the worker queue for par_idx.  This is the preferred worker,
+  // unless the pool is NUMA-aware, in which case the section's mapping
+  // built by AssignNumaWorkers is used.
+
+  unsigned SelectWorker(const ThreadPoolParallelSection& ps,
+                        const InlinedVector<int>& preferred_workers,
+                        unsigned par_idx) {
+    if (ps.numa_node != -1) {
+      assert(par_idx < ps.numa_workers.size());
+      return ps.numa_workers[par_idx];
+    }
+    return preferred_workers[par_idx] % num_threads_;
+  }
+
+  // Map every par_idx of a NUMA-aware section to a distinct worker in a
+  // single pass.  A par_idx keeps its preferred worker if that worker is
+  // on the section's home node, and the other par_idx values take the
+  // remaining workers of the home node.  Only once those are used up do
+  // par_idx values spill to other nodes, again keeping the preferred
+  // worker where it is still free.  The thread entering the section runs
+  // par_idx 0 itself and is never selected, so no two shards of a loop
+  // share a queue unless the section needs more workers than the pool
+  // has.
+
+  void AssignNumaWorkers(const PerThread& pt,
+                         ThreadPoolParallelSection& ps,
+                         const InlinedVector<int>& preferred_workers) {
+    const auto home_node = static_cast<unsigned>(ps.numa_node);
+    const auto& home_workers = numa_node_workers_[home_node];
+    InlinedVector<bool> used(num_threads_, false);
+    if (pt.pool == this) {
+      used[pt.thread_id] = true;
+    }
+
+    ps.numa_workers.assign(num_threads_ + 1, num_threads_);
+    for (unsigned par_idx = 1; par_idx <= num_threads_; ++par_idx) {
+      const unsigned q_idx = preferred_workers[par_idx] % num_threads_;
+      if (numa_node_of_worker_[q_idx] == home_node && !used[q_idx]) {
+        ps.numa_workers[par_idx] = q_idx;
+        used[q_idx] = true;
+      }
+    }
+
+    size_t next_home = 0;
+    unsigned next_any = 0;
+    for (unsigned par_idx = 1; par_idx <= num_threads_; ++par_idx) {
+      if (ps.numa_workers[par_idx] != num_threads_) {
+        continue;
+      }
+      while (next_home < home_workers.size() && used[home_workers[next_home]]) {
+        ++next_home;
+      }
+      unsigned q_idx = preferred_workers[par_idx] % num_threads_;
+      if (next_home < home_workers.size()) {
+        q_idx = home_workers[next_home];
+      } else if (used[q_idx]) {
+        while (next_any < num_threads_ && used[next_any]) {
+          ++next_any;
+        }
+        if (next_any < num_threads_) {
+          q_idx = next_any;
+        }
+      }
+      ps.numa_workers[par_idx] = q_idx;
+      used[q_idx] = true;
+    }
+  }
+
+  // Wake a random worker, which may then steal work from a busy queue.
+  // In NUMA-aware mode the worker is drawn from the section's home node.
+
+  void WakeRandomWorker(PerThread& pt, const ThreadPoolParallelSection& ps) {
+    if (ps.numa_node != -1) {
+      const auto& node_workers = numa_node_workers_[ps.numa_node];
+      worker_data_[node_workers[Rand(&pt.rand) % node_workers.size()]].EnsureAwake();
+    } else {
+      worker_data_[Rand(&pt.rand) % num_threads_].EnsureAwake();
+    }
+  }
+
   // Update the preferred worker for par_idx to be the calling thread
 
   void UpdatePreferredWorker(InlinedVector<int>& preferred_workers,
@@ -1092,7 +1260,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       // recorded from a prior thread pool with a different number of
       // threads, hence we must cap at num_threads_.
       assert(par_idx < preferred_workers.size());
-      unsigned q_idx = preferred_workers[par_idx] % num_threads_;
+      unsigned q_idx = SelectWorker(ps, preferred_workers, par_idx);
       assert(q_idx < num_threads_);
       WorkerData& td = worker_data_[q_idx];
       Queue& q = td.queue;
@@ -1113,9 +1281,10 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       // another thread (which may then steal the task).
       if (push_status == PushResult::ACCEPTED_IDLE || push_status == PushResult::ACCEPTED_BUSY) {
         ps.tasks.push_back({q_idx, w_idx});
+        RecordQueueDepth(q);
         td.EnsureAwake();
         if (push_status == PushResult::ACCEPTED_BUSY) {
-          worker_data_[Rand(&pt.rand) % num_threads_].EnsureAwake();
+          WakeRandomWorker(pt, ps);
         }
       }
     }
@@ -1165,6 +1334,13 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     auto& preferred_workers = pt.preferred_workers;
     InitializePreferredWorkers(preferred_workers);
 
+    // In NUMA-aware mode, fix the section's home node on its first
+    // loop.  Subsequent loops in the section stay on the same node.
+    if (!numa_node_workers_.empty() && ps.numa_node == -1) {
+      ps.numa_node = static_cast<int>(GetHomeNumaNode(pt, preferred_workers));
+      AssignNumaWorkers(pt, ps, preferred_workers);
+    }
+
     // current_dop is the degree of parallelism via any workers already
     // participating in the current parallel section.  Usually, for
     // single-loop parallel sections, current_dop=1.
@@ -1206,7 +1382,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         };
 
         profiler_.LogStart();
-        ps.dispatch_q_idx = preferred_workers[current_dop] % num_threads_;
+        ps.dispatch_q_idx = static_cast<int>(SelectWorker(ps, preferred_workers, current_dop));
         WorkerData& dispatch_td = worker_data_[ps.dispatch_q_idx];
         Queue& dispatch_que = dispatch_td.queue;
 
@@ -1216,9 +1392,10 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         // In addition, if the queue was non-empty, attempt to wake
         // another thread (which may then steal the task).
         if (push_status == PushResult::ACCEPTED_IDLE || push_status == PushResult::ACCEPTED_BUSY) {
+          RecordQueueDepth(dispatch_que);
           dispatch_td.EnsureAwake();
           if (push_status == PushResult::ACCEPTED_BUSY) {
-            worker_data_[Rand(&pt.rand) % num_threads_].EnsureAwake();
+            WakeRandomWorker(pt, ps);
           }
         } else {
           ps.dispatch_q_idx = -1;  // failed to enqueue dispatch_task
@@ -1276,6 +1453,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     // Run work in the main thread
     loop.fn(0);
     profiler_.LogEndAndStart(ThreadPoolProfiler::RUN);
+    const auto wait_start = std::chrono::steady_clock::now();
 
     // Wait for workers to exit the loop
     ps.current_loop = 0;
@@ -1283,6 +1461,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       onnxruntime::concurrency::SpinPause();
     }
     profiler_.LogEnd(ThreadPoolProfiler::WAIT);
+    RecordLoop(std::chrono::steady_clock::now() - wait_start);
   }
 
   // Run a single parallel loop _without_ a parallel section.  This is a
@@ -1307,8 +1486,30 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     profiler_.LogEndAndStart(ThreadPoolProfiler::DISTRIBUTION);
     fn(0);  // run fn(0)
     profiler_.LogEndAndStart(ThreadPoolProfiler::RUN);
+    const auto wait_start = std::chrono::steady_clock::now();
     EndParallelSectionInternal(*pt, ps);  // wait for all
     profiler_.LogEnd(ThreadPoolProfiler::WAIT);
+    RecordLoop(std::chrono::steady_clock::now() - wait_start);
+  }
+
+  // Aggregate the always-on metrics of the pool and its workers.
+  void GetMetrics(ThreadPoolMetrics& metrics) const {
+    metrics.num_threads = num_threads_;
+    metrics.parallel_sections = num_parallel_sections_.load(std::memory_order_relaxed);
+    metrics.parallel_loops = num_parallel_loops_.load(std::memory_order_relaxed);
+    metrics.max_queue_depth = max_queue_depth_.load(std::memory_order_relaxed);
+    metrics.loop_imbalance_us = loop_imbalance_ns_.load(std::memory_order_relaxed) / 1000;
+    metrics.max_loop_imbalance_us = max_loop_imbalance_ns_.load(std::memory_order_relaxed) / 1000;
+    uint64_t spin_ns = 0;
+    uint64_t blocked_ns = 0;
+    for (const auto& td : worker_data_) {
+      metrics.tasks_executed += td.tasks_executed.load(std::memory_order_relaxed);
+      metrics.tasks_stolen += td.tasks_stolen.load(std::memory_order_relaxed);
+      spin_ns += td.spin_ns.load(std::memory_order_relaxed);
+      blocked_ns += td.blocked_ns.load(std::memory_order_relaxed);
+    }
+    metrics.spin_time_us = spin_ns / 1000;
+    metrics.blocked_time_us = blocked_ns / 1000;
   }
 
   int NumThreads() const final {
@@ -1394,6 +1595,15 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     std::unique_ptr<Thread> thread;
     Queue queue;
 
+    // Used only by the thread itself, and only in adaptive spinning mode.
+    AdaptiveSpinPolicy spin_policy;
+
+    // Always-on metrics.  Updated only by the thread itself, and read by GetMetrics.
+    std::atomic<uint64_t> tasks_executed{0};
+    std::atomic<uint64_t> tasks_stolen{0};
+    std::atomic<uint64_t> spin_ns{0};
+    std::atomic<uint64_t> blocked_ns{0};
+
     // Each thread has a status, available read-only without locking, and protected
     // by the mutex field below for updates.  The status is used for three
     // purposes:
@@ -1495,12 +1705,19 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   Environment& env_;
   const unsigned num_threads_;
   const bool allow_spinning_;
+  const bool adaptive_spinning_;
   const bool set_denormal_as_zero_;
   Eigen::MaxSizeVector<WorkerData> worker_data_;
   Eigen::MaxSizeVector<Eigen::MaxSizeVector<unsigned>> all_coprimes_;
   std::atomic<unsigned> blocked_;  // Count of blocked workers, used as a termination condition
   std::atomic<bool> done_;
 
+  // NUMA-aware mode.  numa_node_of_worker_ maps each q_idx to a dense
+  // node index, and numa_node_workers_ lists the q_idx values of the
+  // workers on each node.  Both are empty if the mode is disabled.
+  InlinedVector<unsigned> numa_node_of_worker_;
+  std::vector<InlinedVector<unsigned>> numa_node_workers_;
+
   // SpinLoopStatus indicates whether the main worker spinning (inner) loop should exit immediately when there is
   // no work available (kIdle) or whether it should follow the configured spin-then-block policy (kBusy).
   // This lets the ORT session layer hint to the thread pool that it should stop spinning in between
@@ -1513,6 +1730,38 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   // Default is no control over spinning
   std::atomic<SpinLoopStatus> spin_loop_status_{SpinLoopStatus::kBusy};
 
+  // Always-on metrics updated by the threads entering parallel sections
+  // and loops.  The per-worker metrics are held in WorkerData.
+  std::atomic<uint64_t> num_parallel_sections_{0};
+  std::atomic<uint64_t> num_parallel_loops_{0};
+  std::atomic<uint64_t> max_queue_depth_{0};
+  std::atomic<uint64_t> loop_imbalance_ns_{0};
+  std::atomic<uint64_t> max_loop_imbalance_ns_{0};
+
+  static void AddRelaxed(std::atomic<uint64_t>& counter, uint64_t value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+  }
+
+  static void UpdateMax(std::atomic<uint64_t>& max_value, uint64_t value) {
+    uint64_t current = max_value.load(std::memory_order_relaxed);
+    while (value > current &&
+           !max_value.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  void RecordQueueDepth(const Queue& q) {
+    UpdateMax(max_queue_depth_, q.Size());
+  }
+
+  // Record a parallel loop, and the time the thread that entered it waited
+  // for the workers after completing its own share of the iterations.
+  void RecordLoop(std::chrono::steady_clock::duration wait) {
+    const auto wait_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count());
+    num_parallel_loops_.fetch_add(1, std::memory_order_relaxed);
+    loop_imbalance_ns_.fetch_add(wait_ns, std::memory_order_relaxed);
+    UpdateMax(max_loop_imbalance_ns_, wait_ns);
+  }
+
   // Wake any blocked workers so that they can cleanly exit WorkerLoop().  For
   // a clean exit, each thread will observe (1) done_ set, indicating that the
   // destructor has been called, (2) all threads blocked, and (3) no
@@ -1538,17 +1787,33 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     constexpr int log2_spin = 20;
     const int spin_count = allow_spinning_ ? (1ull << log2_spin) : 0;
     const int steal_count = spin_count / 100;
+    constexpr int spin_clock_interval = 64;
 
     SetDenormalAsZero(set_denormal_as_zero_);
     profiler_.LogThreadId(thread_id);
 
     while (!should_exit) {
       Task t = q.PopFront();
+      const bool idle = !t;
+      std::chrono::steady_clock::time_point idle_start;
       if (!t) {
-        // Spin waiting for work.
-        for (int i = 0; i < spin_count && !done_; i++) {
+        idle_start = std::chrono::steady_clock::now();
+        bool stolen = false;
+
+        // Spin waiting for work.  In adaptive mode, spin for at most the worker's current
+        // budget, checking the clock every spin_clock_interval iterations.
+        int worker_spin_count = spin_count;
+        std::chrono::microseconds spin_budget{0};
+        if (adaptive_spinning_) {
+          spin_budget = std::chrono::microseconds(td.spin_policy.SpinBudgetMicroseconds());
+          if (spin_budget.count() == 0) {
+            worker_spin_count = 0;
+          }
+        }
+        for (int i = 0; i < worker_spin_count && !done_; i++) {
           if (((i + 1) % steal_count == 0)) {
             t = Steal(StealAttemptKind::TRY_ONE);
+            stolen = static_cast<bool>(t);
           } else {
             t = q.PopFront();
           }
@@ -1557,8 +1822,15 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
           if (spin_loop_status_.load(std::memory_order_relaxed) == SpinLoopStatus::kIdle) {
             break;
           }
+          if (adaptive_spinning_ && (i + 1) % spin_clock_interval == 0 &&
+              std::chrono::steady_clock::now() - idle_start >= spin_budget) {
+            break;
+          }
           onnxruntime::concurrency::SpinPause();
         }
+        const auto spin_end = std::chrono::steady_clock::now();
+        AddRelaxed(td.spin_ns, static_cast<uint64_t>(
+                                   std::chrono::duration_cast<std::chrono::nanoseconds>(spin_end - idle_start).count()));
 
         // Attempt to block
         if (!t) {
@@ -1626,14 +1898,29 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
           // blocking, or are exiting, then either work was pushed to
           // us, or it was pushed to an overloaded queue
           if (!t) t = q.PopFront();
-          if (!t) t = Steal(StealAttemptKind::TRY_ALL);
+          if (!t) {
+            t = Steal(StealAttemptKind::TRY_ALL);
+            stolen = static_cast<bool>(t);
+          }
+          AddRelaxed(td.blocked_ns, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                              std::chrono::steady_clock::now() - spin_end)
+                                                              .count()));
+        }
+        if (stolen) {
+          AddRelaxed(td.tasks_stolen, 1);
         }
       }
 
       if (t) {
+        if (idle && adaptive_spinning_) {
+          auto gap = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - idle_start);
+          td.spin_policy.RecordIdleGap(static_cast<uint64_t>(gap.count()));
+          profiler_.LogSpinBudget(thread_id, td.spin_policy.SpinBudgetMicroseconds());
+        }
         td.SetActive();
         t();
         profiler_.LogRun(thread_id);
+        AddRelaxed(td.tasks_executed, 1);
         td.SetSpinning();
       }
     }
@@ -1645,25 +1932,74 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     }
   }
 
-  // Steal tries to steal work from other worker threads in a
-  // best-effort manner.  We steal only from threads that are running
-  // in user code (ThreadStatus::Active).  The intuition behind this
-  // is that the thread is busy with other work, and we will avoid
-  // "snatching" work from a thread which is just about to notice the
-  // work itself.
+  // Group the workers by NUMA node.  The mode is enabled only if every
+  // worker has a known node, and the workers span more than one node.
 
-  Task Steal(StealAttemptKind steal_kind) {
-    PerThread* pt = GetPerThread();
-    unsigned size = num_threads_;
-    unsigned num_attempts = (steal_kind == StealAttemptKind::TRY_ALL) ? size : 1;
+  void InitializeNumaNodes(const ThreadOptions& thread_options) {
+    const auto& numa_nodes = thread_options.numa_nodes;
+    if (!thread_options.numa_aware || numa_nodes.size() < num_threads_) {
+      return;
+    }
+    InlinedVector<int> distinct_nodes;
+    for (unsigned i = 0; i < num_threads_; i++) {
+      if (numa_nodes[i] < 0) {
+        return;
+      }
+      if (std::find(distinct_nodes.begin(), distinct_nodes.end(), numa_nodes[i]) == distinct_nodes.end()) {
+        distinct_nodes.push_back(numa_nodes[i]);
+      }
+    }
+    if (distinct_nodes.size() <= 1) {
+      return;
+    }
+    std::sort(distinct_nodes.begin(), distinct_nodes.end());
+    numa_node_workers_.resize(distinct_nodes.size());
+    numa_node_of_worker_.resize(num_threads_);
+    for (unsigned i = 0; i < num_threads_; i++) {
+      auto node = static_cast<unsigned>(std::lower_bound(distinct_nodes.begin(), distinct_nodes.end(), numa_nodes[i]) -
+                                        distinct_nodes.begin());
+      numa_node_of_worker_[i] = node;
+      numa_node_workers_[node].push_back(i);
+    }
+  }
+
+  // Return the home NUMA node for a parallel section entered by pt.  A
+  // worker in this pool uses its own node.  Other threads use the node
+  // of their first preferred worker, which tracks where earlier loops
+  // from the thread ran (and hence where their data was last touched).
+
+  unsigned GetHomeNumaNode(const PerThread& pt, const InlinedVector<int>& preferred_workers) const {
+    if (pt.pool == this) {
+      return numa_node_of_worker_[pt.thread_id];
+    }
+    assert(preferred_workers.size() > 1);
+    return numa_node_of_worker_[preferred_workers[1] % num_threads_];
+  }
+
+  bool NumaNodeQueuesEmpty(unsigned node) const {
+    for (auto q_idx : numa_node_workers_[node]) {
+      if (!worker_data_[q_idx].queue.Empty()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Attempt to steal from up to num_attempts of the size candidate
+  // workers, visiting them in a pseudo-random order.  worker_at maps a
+  // candidate index in [0,size) to a q_idx.
+
+  template <typename WorkerAt>
+  Task TryStealFrom(PerThread* pt, unsigned size, unsigned num_attempts, WorkerAt&& worker_at) {
     unsigned r = Rand(&pt->rand);
     unsigned inc = all_coprimes_[size - 1][r % all_coprimes_[size - 1].size()];
     unsigned victim = r % size;
 
     for (unsigned i = 0; i < num_attempts; i++) {
       assert(victim < size);
-      if (worker_data_[victim].GetStatus() == WorkerData::ThreadStatus::Active) {
-        Task t = worker_data_[victim].queue.PopBack();
+      WorkerData& td = worker_data_[worker_at(victim)];
+      if (td.GetStatus() == WorkerData::ThreadStatus::Active) {
+        Task t = td.queue.PopBack();
         if (t) {
           return t;
         }
@@ -1677,6 +2013,36 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     return Task();
   }
 
+  // Steal tries to steal work from other worker threads in a
+  // best-effort manner.  We steal only from threads that are running
+  // in user code (ThreadStatus::Active).  The intuition behind this
+  // is that the thread is busy with other work, and we will avoid
+  // "snatching" work from a thread which is just about to notice the
+  // work itself.
+  //
+  // In NUMA-aware mode we first try the siblings on the thief's own
+  // node, and only look at other nodes once the queues on the thief's
+  // node are empty.
+
+  Task Steal(StealAttemptKind steal_kind) {
+    PerThread* pt = GetPerThread();
+    if (!numa_node_workers_.empty() && pt->pool == this) {
+      const unsigned node = numa_node_of_worker_[pt->thread_id];
+      const auto& siblings = numa_node_workers_[node];
+      const auto num_siblings = static_cast<unsigned>(siblings.size());
+      Task t = TryStealFrom(pt, num_siblings,
+                            (steal_kind == StealAttemptKind::TRY_ALL) ? num_siblings : 1,
+                            [&siblings](unsigned i) { return siblings[i]; });
+      if (t || !NumaNodeQueuesEmpty(node)) {
+        return t;
+      }
+    }
+
+    unsigned size = num_threads_;
+    unsigned num_attempts = (steal_kind == StealAttemptKind::TRY_ALL) ? size : 1;
+    return TryStealFrom(pt, size, num_attempts, [](unsigned i) { return i; });
+  }
+
   int NonEmptyQueueIndex() {
     PerThread* pt = GetPerThread();
     const unsigned size = static_cast<unsigned>(worker_data_.size());
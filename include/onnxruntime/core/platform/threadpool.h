@@ -16,6 +16,8 @@ limitations under the License.
 /* Modifications Copyright (c) Microsoft. */
 
 #pragma once
+#include <atomic>
+#include <chrono>
 #include <string>
 #include <vector>
 #include <functional>
@@ -55,6 +57,12 @@ limitations under the License.
 //   libraries such as MLAS.  This lets the libraries tailor the
 //   extent to which they parallelize work.
 //
+// - Arbitrating between callers sharing a pool.  The degree of
+//   parallelism exposed to a caller is capped by its scheduling
+//   options (ThreadPool::ScopedSchedulingOptions): a per-caller
+//   quota, and a priority class that makes lower-priority loops run
+//   sequentially while higher-priority work is in flight.
+//
 // - Handling trivial cases (such as directly running parallel loops
 //   with only a single iteration, or with no iterations at all).
 //
@@ -136,6 +144,22 @@ class ExtendedThreadPoolInterface;
 class LoopCounter;
 class ThreadPoolParallelSection;
 
+// Counters maintained by a thread pool over its lifetime.  Unlike the
+// profiler (ThreadPool::StartProfiling/StopProfiling), they are always
+// collected, and are cheap enough to be read periodically in production.
+struct ThreadPoolMetrics {
+  uint64_t num_threads = 0;            // Worker threads created by the pool
+  uint64_t parallel_sections = 0;      // Multi-loop parallel sections entered
+  uint64_t parallel_loops = 0;         // Parallel loops run, inside or outside parallel sections
+  uint64_t tasks_executed = 0;         // Tasks run by the worker threads
+  uint64_t tasks_stolen = 0;           // Tasks a worker took from another worker's queue
+  uint64_t spin_time_us = 0;           // Time the workers spent spinning while waiting for work
+  uint64_t blocked_time_us = 0;        // Time the workers spent blocked in the OS while waiting for work
+  uint64_t max_queue_depth = 0;        // High-water mark of the length of any worker's queue
+  uint64_t loop_imbalance_us = 0;      // Total time callers waited for the slowest worker after finishing their share of a loop
+  uint64_t max_loop_imbalance_us = 0;  // Longest such wait in a single loop
+};
+
 class ThreadPool {
  public:
 #ifdef _WIN32
@@ -213,6 +237,66 @@ class ThreadPool {
     ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ParallelSection);
   };
 
+  // Scheduling attributes of the parallel work issued by the current
+  // thread.  These let several sessions share one pool (e.g., the
+  // global thread pools created with CreateEnvWithGlobalThreadPools)
+  // without a large request monopolizing its workers.
+  //
+  // priority: work is grouped into three classes, low (< 0), normal
+  // (0), and high (> 0).  While a pool has work of a higher class in
+  // flight, loops of a lower class run sequentially in the calling
+  // thread, leaving the pool's workers to the higher-priority work.
+  //
+  // max_degree_of_parallelism: the maximum number of threads, including
+  // the calling thread, that a single loop may use.  0 means no limit.
+  //
+  // terminate, deadline: cooperative cancellation.  The work of the
+  // caller is cancelled once *terminate is true or the deadline has
+  // passed.  Parallel loops then stop handing out new blocks of
+  // iterations, leaving their results incomplete, so the caller must
+  // check IsCancelled() after the work and discard its results.  Loops
+  // run directly in the calling thread are never interrupted.
+  struct SchedulingOptions {
+    int priority = 0;
+    int max_degree_of_parallelism = 0;
+    const bool* terminate = nullptr;
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+  };
+
+  // Sets the scheduling options of the current thread for the lifetime
+  // of the object, restoring the previous ones on destruction.  If tp is
+  // not nullptr, the priority is also registered as in flight on tp for
+  // the lifetime of the object, so that lower-priority callers of tp
+  // back off.  Tasks submitted with Schedule inherit the options of the
+  // submitting thread.
+  //
+  // Typical use is to cover an InferenceSession::Run call:
+  //
+  // {
+  //   ThreadPool::ScopedSchedulingOptions scope(tp, {run_options.priority, max_dop});
+  //   ... // execute the graph
+  // }
+  class ScopedSchedulingOptions {
+   public:
+    ScopedSchedulingOptions(ThreadPool* tp, const SchedulingOptions& options);
+    ~ScopedSchedulingOptions();
+
+   private:
+    ThreadPool* tp_;
+    SchedulingOptions previous_options_;
+    int priority_class_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ScopedSchedulingOptions);
+  };
+
+  // Returns the scheduling options of the current thread.
+  static SchedulingOptions GetSchedulingOptions();
+
+  // Returns true if the work of the current thread is cancelled according
+  // to its scheduling options.  Cheap enough to test between blocks of a
+  // loop or iterations of a control flow operator.
+  static bool IsCancelled();
+  static bool IsCancelled(const SchedulingOptions& options);
+
   // The below API allows to disable spinning
   // This is used to support real-time scenarios where
   // spinning between relatively infrequent requests
@@ -366,6 +450,10 @@ class ThreadPool {
   static void StartProfiling(concurrency::ThreadPool* tp);
   static std::string StopProfiling(concurrency::ThreadPool* tp);
 
+  // Returns the metrics collected by the pool since its creation.  All counters
+  // are zero if tp is nullptr or the pool did not create any threads.
+  static ThreadPoolMetrics GetMetrics(const concurrency::ThreadPool* tp);
+
  private:
   friend class LoopCounter;
 
@@ -377,6 +465,11 @@ class ThreadPool {
   // thread in the pool. Returns -1 otherwise.
   int CurrentThreadId() const;
 
+  // Returns the maximum number of threads, including the caller, that a loop
+  // issued by the current thread may use, taking into account the caller's
+  // scheduling options and the higher-priority work in flight on the pool.
+  int MaxThreadsForCaller() const;
+
   // Run fn with up to n degree-of-parallelism enlisting the thread pool for
   // help.  The degree-of-parallelism includes the caller, and so if n==1
   // then the function will run directly in the caller.  The fork-join
@@ -428,6 +521,11 @@ class ThreadPool {
 
   // Force the thread pool to run in hybrid mode on a normal cpu.
   bool force_hybrid_ = false;
+
+  // Number of ScopedSchedulingOptions registered on this pool for each
+  // priority class (low, normal, high).
+  static constexpr int kNumPriorityClasses = 3;
+  std::atomic<int> active_scopes_per_priority_class_[kNumPriorityClasses] = {};
 };
 
 }  // namespace concurrency
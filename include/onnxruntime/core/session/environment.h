@@ -16,6 +16,7 @@
 #include "core/framework/allocator.h"
 #include "core/framework/execution_provider.h"
 #include "core/framework/data_transfer_manager.h"
+#include "core/framework/shared_initializer_store.h"
 #include "core/platform/device_discovery.h"
 #include "core/platform/threadpool.h"
 
@@ -120,6 +121,14 @@ class Environment {
    */
   Status UnregisterAllocator(const OrtMemoryInfo& mem_info);
 
+  /**
+   * Returns the store of the initializers shared by content between the sessions of this env.
+   * See kOrtSessionOptionsConfigShareInitializersByContent.
+   */
+  SharedInitializerStore& GetSharedInitializerStore() const {
+    return *shared_initializer_store_;
+  }
+
   Environment() = default;
 
   /**
@@ -197,6 +206,8 @@ class Environment {
   // providing a CPU allocator.
   std::unique_ptr<OrtAllocatorImplWrappingIAllocator> default_cpu_ort_allocator_;
 
+  std::unique_ptr<SharedInitializerStore> shared_initializer_store_ = std::make_unique<SharedInitializerStore>();
+
   using OrtAllocatorUniquePtr = std::unique_ptr<OrtAllocator, std::function<void(OrtAllocator*)>>;
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -328,6 +328,7 @@ ORT_RUNTIME_CLASS(EpDevice);
 ORT_RUNTIME_CLASS(KeyValuePairs);
 ORT_RUNTIME_CLASS(SyncStream);  // Opaque class to create an onnxruntime::Stream.
 ORT_RUNTIME_CLASS(ExternalInitializerInfo);
+ORT_RUNTIME_CLASS(RunCompletionQueue);
 
 #ifdef _MSC_VER
 typedef _Return_type_success_(return == 0) OrtStatus* OrtStatusPtr;
@@ -380,6 +381,10 @@ typedef struct OrtAllocator {
    * - NumArenaExtensions: Number of arena extensions (Relevant only for arena based allocators)
    * - NumArenaShrinkages: Number of arena shrinkages (Relevant only for arena based allocators)
    * - MaxAllocSize: The max single allocation seen.
+   * - NumCacheHits: Number of allocations served by the thread-local caches of an arena.
+   * - NumCacheMisses: Number of cacheable allocations that the thread-local caches of an arena could not serve.
+   * - HugePageBytes: Number of bytes currently mapped with huge pages.
+   * - NumHugePageFallbacks: Number of allocations of at least a huge page that got normal pages.
    *
    * The allocator is free to add other entries as appropriate.
    *
@@ -2980,6 +2985,22 @@ struct OrtApi {
    *  Use -1 to allow ORT to choose the default 1GB for max_power_of_two_extend_bytes.
    *  Ultimately, the allocation size is determined by the allocation memory request.
    *  Further allocation sizes are governed by the arena extend strategy.
+   * "thread_local_cache_max_bytes": Maximum number of bytes of freed chunks up to 256KB that each thread keeps
+   *  in a cache in front of the arena. Allocations served from the cache do not take the lock of the arena,
+   *  which reduces contention when concurrent Run calls share the allocator. Use 0 or -1 to disable the caches.
+   *  Default is 0.
+   * "huge_page_mode": Backing of the arena regions on Linux, to reduce TLB misses on large working sets.
+   *  0 = normal pages, 1 = transparent huge pages (madvise(MADV_HUGEPAGE)), 2 = explicit huge pages (MAP_HUGETLB)
+   *  with a fallback to transparent huge pages. Regions fall back to normal pages when huge pages are unavailable.
+   *  Only applies to CPU arenas. Use -1 to allow ORT to choose the default. Default is 0.
+   * "trim_watermark_bytes": Enables trimming, which releases the most recent free regions of the arena while it
+   *  holds more than this many bytes, without a per-run opt-in like "memory.enable_memory_arena_shrinkage".
+   *  The released bytes are reported as "TotalReleased" in the allocator stats. Use -1 to disable trimming.
+   *  Default is -1.
+   * "trim_idle_interval_ms": Trims the arena once it saw no allocation for this many milliseconds, from a
+   *  background thread. Only relevant with "trim_watermark_bytes". Use -1 or 0 to disable it. Default is -1.
+   * "trim_run_interval": Trims the arena every this many runs of the sessions using it. Only relevant with
+   *  "trim_watermark_bytes". Use -1 or 0 to disable it. Default is -1.
    *
    * \param[in] arena_config_keys Keys to configure the arena
    * \param[in] arena_config_values Values to configure the arena
@@ -6480,6 +6501,176 @@ struct OrtApi {
    * \since Version 1.23.
    */
   ORT_API2_STATUS(Graph_GetModelMetadata, _In_ const OrtGraph* graph, _Outptr_ OrtModelMetadata** out);
+
+  /** \brief Set the scheduling priority of Run calls using the ::OrtRunOptions
+   *
+   * The priority arbitrates between sessions sharing a thread pool, e.g. the global thread pools created with
+   * OrtApi::CreateEnvWithGlobalThreadPools. Values below 0 are low priority, 0 (the default) is normal priority and
+   * values above 0 are high priority. While a higher priority Run is in flight on a thread pool, the parallel loops of
+   * lower priority Runs execute in their calling thread so that the pool's workers serve the higher priority Run.
+   *
+   * The maximum degree of parallelism of each session is configured with the
+   * "session.intra_op.max_degree_of_parallelism" session configuration entry.
+   *
+   * \param[in] options
+   * \param[in] priority
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(RunOptionsSetPriority, _Inout_ OrtRunOptions* options, int priority);
+
+  /** \brief Get the scheduling priority of Run calls using the ::OrtRunOptions
+   *
+   * \param[in] options
+   * \param[out] priority
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(RunOptionsGetPriority, _In_ const OrtRunOptions* options, _Out_ int* priority);
+
+  /** \brief Get the metrics of the thread pools used by a session
+   *
+   * The thread pools maintain these counters for their whole lifetime, without enabling profiling. If the session
+   * uses the global thread pools, the metrics include the work of every session sharing them.
+   *
+   * Keys have the form "intra_op.<metric>" or "inter_op.<metric>", with an entry for each thread pool in use, and
+   * values are decimal integers. The metrics are:
+   *   num_threads: worker threads created by the pool.
+   *   parallel_sections: multi-loop parallel sections entered.
+   *   parallel_loops: parallel loops run.
+   *   tasks_executed: tasks run by the worker threads.
+   *   tasks_stolen: tasks a worker took from another worker's queue.
+   *   spin_time_us, blocked_time_us: time the workers spent spinning and blocked while waiting for work.
+   *   max_queue_depth: high-water mark of the length of any worker's queue.
+   *   loop_imbalance_us, max_loop_imbalance_us: total and longest time the thread running a parallel loop waited for
+   *     the slowest worker after finishing its own share of the loop.
+   *
+   * \param[in] session
+   * \param[out] out Newly created ::OrtKeyValuePairs. Must be freed using OrtApi::ReleaseKeyValuePairs.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(SessionGetThreadPoolMetrics, _In_ const OrtSession* session, _Outptr_ OrtKeyValuePairs** out);
+
+  /** \brief Create a queue that collects the results of runs submitted with OrtApi::RunWithCompletionQueue
+   *
+   * The queue limits how many of its runs execute at once. Runs submitted beyond that limit wait in the queue and
+   * start in submission order as earlier runs finish. The queue may be shared by several sessions.
+   *
+   * \param[in] max_concurrent_runs Maximum number of runs executing at once. Must be greater than 0.
+   * \param[in] max_pending_runs Maximum number of runs waiting to start. OrtApi::RunWithCompletionQueue blocks
+   *            while this many runs are waiting. 0 means no limit.
+   * \param[out] out Newly created ::OrtRunCompletionQueue. Must be freed with OrtApi::ReleaseRunCompletionQueue.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(CreateRunCompletionQueue, size_t max_concurrent_runs, size_t max_pending_runs,
+                  _Outptr_ OrtRunCompletionQueue** out);
+
+  /** \brief Release an ::OrtRunCompletionQueue
+   *
+   * Waits for the runs that are executing to finish. Runs that have not started are dropped and completions that
+   * have not been dequeued are discarded.
+   *
+   * \since Version 1.23.
+   */
+  ORT_CLASS_RELEASE(RunCompletionQueue);
+
+  /** \brief Run the model asynchronously and report its completion to a queue
+   *
+   * The run is executed on the intra op thread pool of the session, which must have at least two threads.
+   * When it finishes, a completion with `tag` and the status of the run is added to `queue`, from where it is
+   * retrieved with OrtApi::RunCompletionQueueDequeue.
+   *
+   * The input names, input values and run options are copied before this function returns.
+   * The session and the `output` array must stay valid until the completion has been dequeued.
+   *
+   * \param[in] session
+   * \param[in] run_options If nullptr, default run options are used.
+   * \param[in] input_names Array of null terminated UTF8 encoded strings of the input names
+   * \param[in] input Array of ::OrtValue%s of the input values
+   * \param[in] input_len Number of elements in the input_names and inputs arrays
+   * \param[in] output_names Array of null terminated UTF8 encoded strings of the output names
+   * \param[in] output_names_len Number of elements in the output_names and outputs array
+   * \param[out] output Array of OrtValue* owned by customers, size to output_names_len. Null entries are set to
+   *             OrtValue%s allocated by onnxruntime when the run succeeds, like OrtApi::RunAsync does.
+   * \param[in] queue The ::OrtRunCompletionQueue that executes the run and receives its completion.
+   * \param[in] tag User data identifying the run in its completion.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(RunWithCompletionQueue, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Inout_updates_all_(output_names_len) OrtValue** output,
+                  _Inout_ OrtRunCompletionQueue* queue, _In_opt_ void* tag);
+
+  /** \brief Retrieve the completions of finished runs from an ::OrtRunCompletionQueue
+   *
+   * Removes up to `max_completions` completions, oldest first. If the queue holds none, waits up to `timeout_ms`
+   * for the first one. A timeout of 0 polls and a negative timeout waits indefinitely.
+   *
+   * \param[in] queue
+   * \param[in] timeout_ms
+   * \param[in] max_completions Size of the `tags` and `statuses` arrays.
+   * \param[out] tags Tags of the finished runs.
+   * \param[out] statuses Status of each finished run. nullptr for a successful run, otherwise an ::OrtStatus that
+   *             must be freed with OrtApi::ReleaseStatus.
+   * \param[out] num_completions Number of completions written to `tags` and `statuses`.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(RunCompletionQueueDequeue, _Inout_ OrtRunCompletionQueue* queue, int64_t timeout_ms,
+                  size_t max_completions, _Out_writes_(max_completions) void** tags,
+                  _Out_writes_(max_completions) OrtStatusPtr* statuses,
+                  _Out_ size_t* num_completions);
+
+  /** \brief Set a deadline for Run calls using the ::OrtRunOptions
+   *
+   * Run calls that have not finished by the deadline fail. The deadline is tested between nodes, between the
+   * blocks of the parallel loops of kernels and between the iterations of Loop and Scan, so an expired Run
+   * releases its threads quickly instead of completing the current node.
+   *
+   * \param[in] options
+   * \param[in] timeout_us Time from now, in microseconds, after which the Run calls fail. The deadline is fixed when
+   *            this function is called, so it also covers the time a Run waits to start, e.g. in an
+   *            ::OrtRunCompletionQueue. A negative value removes the deadline.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(RunOptionsSetDeadline, _Inout_ OrtRunOptions* options, int64_t timeout_us);
+
+  /** \brief Create an ::OrtPrepackedWeightsContainer whose buffers are allocated as configured by an ::OrtArenaCfg
+   *
+   * Like OrtApi::CreatePrepackedWeightsContainer, but the pre-packed buffers of at least a huge page are backed by
+   * huge pages if the "huge_page_mode" of `arena_cfg` enables them (see OrtApi::CreateArenaCfgV2).
+   * The other settings of `arena_cfg` are ignored.
+   *
+   * \param[in] arena_cfg
+   * \param[out] out Newly created ::OrtPrepackedWeightsContainer. Must be freed with
+   *             OrtApi::ReleasePrepackedWeightsContainer
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(CreatePrepackedWeightsContainerWithArenaCfg, _In_ const OrtArenaCfg* arena_cfg,
+                  _Outptr_ OrtPrepackedWeightsContainer** out);
 };
 
 /*
@@ -567,6 +567,7 @@ ORT_DEFINE_RELEASE(IoBinding);
 ORT_DEFINE_RELEASE(ArenaCfg);
 ORT_DEFINE_RELEASE(Status);
 ORT_DEFINE_RELEASE(SyncStream);
+ORT_DEFINE_RELEASE(RunCompletionQueue);
 ORT_DEFINE_RELEASE(OpAttr);
 ORT_DEFINE_RELEASE(Op);
 ORT_DEFINE_RELEASE(KernelInfo);
@@ -818,6 +819,8 @@ struct PrepackedWeightsContainer : detail::Base<OrtPrepackedWeightsContainer> {
   explicit PrepackedWeightsContainer(OrtPrepackedWeightsContainer* p) : Base{p} {}
   /// \brief Wraps OrtApi::CreatePrepackedWeightsContainer
   PrepackedWeightsContainer();
+  /// \brief Wraps OrtApi::CreatePrepackedWeightsContainerWithArenaCfg
+  explicit PrepackedWeightsContainer(const OrtArenaCfg* arena_cfg);
 };
 
 namespace detail {
@@ -964,6 +967,24 @@ struct SyncStream : detail::Base<OrtSyncStream> {
   void* GetHandle() const;                                           ///< Wraps SyncStream_GetHandle
 };
 
+/** \brief Wrapper around ::OrtRunCompletionQueue
+ *
+ * Collects the results of runs submitted with Session::RunAsync and limits how many of them execute at once.
+ */
+struct RunCompletionQueue : detail::Base<OrtRunCompletionQueue> {
+  /// A finished run: the tag it was submitted with and its status.
+  struct Completion {
+    void* tag;
+    Status status;
+  };
+
+  explicit RunCompletionQueue(std::nullptr_t) {}  ///< Create an empty RunCompletionQueue object, must be assigned a valid one to be used
+  RunCompletionQueue(size_t max_concurrent_runs, size_t max_pending_runs);  ///< Wraps OrtApi::CreateRunCompletionQueue
+
+  /// Wraps OrtApi::RunCompletionQueueDequeue
+  std::vector<Completion> Dequeue(int64_t timeout_ms, size_t max_completions);
+};
+
 namespace detail {
 template <typename T>
 struct HardwareDeviceImpl : Ort::detail::Base<T> {
@@ -1132,6 +1153,10 @@ struct RunOptions : detail::Base<OrtRunOptions> {
   RunOptions& SetRunTag(const char* run_tag);  ///< wraps OrtApi::RunOptionsSetRunTag
   const char* GetRunTag() const;               ///< Wraps OrtApi::RunOptionsGetRunTag
 
+  RunOptions& SetPriority(int priority);  ///< Wraps OrtApi::RunOptionsSetPriority
+  int GetPriority() const;                ///< Wraps OrtApi::RunOptionsGetPriority
+  RunOptions& SetDeadline(int64_t timeout_us);  ///< Wraps OrtApi::RunOptionsSetDeadline
+
   RunOptions& AddConfigEntry(const char* config_key, const char* config_value);  ///< Wraps OrtApi::AddRunConfigEntry
   const char* GetConfigEntry(const char* config_key);                            ///< Wraps OrtApi::GetRunConfigEntry
 
@@ -1486,6 +1511,7 @@ struct ConstSessionImpl : Base<T> {
   AllocatedStringPtr GetOverridableInitializerNameAllocated(size_t index, OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetOverridableInitializerName
 
   uint64_t GetProfilingStartTimeNs() const;  ///< Wraps OrtApi::SessionGetProfilingStartTimeNs
+  KeyValuePairs GetThreadPoolMetrics() const;  ///< Wraps OrtApi::SessionGetThreadPoolMetrics
   ModelMetadata GetModelMetadata() const;    ///< Wraps OrtApi::SessionGetModelMetadata
 
   TypeInfo GetInputTypeInfo(size_t index) const;                   ///< Wraps OrtApi::SessionGetInputTypeInfo
@@ -1554,6 +1580,15 @@ struct SessionImpl : ConstSessionImpl<T> {
   void RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
                 const char* const* output_names, Value* output_values, size_t output_count, RunAsyncCallbackFn callback, void* user_data);
 
+  /** \brief Run the model asynchronously and report its completion to a RunCompletionQueue
+   *
+   * Wraps OrtApi::RunWithCompletionQueue. The output_values array must stay valid until the completion with `tag`
+   * has been dequeued.
+   */
+  void RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
+                const char* const* output_names, Value* output_values, size_t output_count, RunCompletionQueue& queue,
+                void* tag);
+
   /** \brief End profiling and return a copy of the profiling file name.
    *
    * \param allocator to allocate memory for the copy of the string returned
@@ -571,6 +571,10 @@ inline PrepackedWeightsContainer::PrepackedWeightsContainer() {
   ThrowOnError(GetApi().CreatePrepackedWeightsContainer(&this->p_));
 }
 
+inline PrepackedWeightsContainer::PrepackedWeightsContainer(const OrtArenaCfg* arena_cfg) {
+  ThrowOnError(GetApi().CreatePrepackedWeightsContainerWithArenaCfg(arena_cfg, &this->p_));
+}
+
 namespace detail {
 template <typename T>
 inline const char* KeyValuePairsImpl<T>::GetValue(const char* key) const {
@@ -637,6 +641,25 @@ inline void* SyncStream::GetHandle() const {
   return GetApi().SyncStream_GetHandle(this->p_);
 }
 
+inline RunCompletionQueue::RunCompletionQueue(size_t max_concurrent_runs, size_t max_pending_runs) {
+  ThrowOnError(GetApi().CreateRunCompletionQueue(max_concurrent_runs, max_pending_runs, &p_));
+}
+
+inline std::vector<RunCompletionQueue::Completion> RunCompletionQueue::Dequeue(int64_t timeout_ms,
+                                                                               size_t max_completions) {
+  std::vector<void*> tags(max_completions);
+  std::vector<OrtStatus*> statuses(max_completions);
+  size_t num_completions = 0;
+  ThrowOnError(GetApi().RunCompletionQueueDequeue(p_, timeout_ms, max_completions, tags.data(), statuses.data(),
+                                                  &num_completions));
+  std::vector<Completion> completions;
+  completions.reserve(num_completions);
+  for (size_t i = 0; i < num_completions; ++i) {
+    completions.push_back({tags[i], Status{statuses[i]}});
+  }
+  return completions;
+}
+
 namespace detail {
 template <typename T>
 inline OrtHardwareDeviceType HardwareDeviceImpl<T>::Type() const {
@@ -910,6 +933,22 @@ inline const char* RunOptions::GetRunTag() const {
   return out;
 }
 
+inline RunOptions& RunOptions::SetPriority(int priority) {
+  ThrowOnError(GetApi().RunOptionsSetPriority(p_, priority));
+  return *this;
+}
+
+inline int RunOptions::GetPriority() const {
+  int out;
+  ThrowOnError(GetApi().RunOptionsGetPriority(p_, &out));
+  return out;
+}
+
+inline RunOptions& RunOptions::SetDeadline(int64_t timeout_us) {
+  ThrowOnError(GetApi().RunOptionsSetDeadline(p_, timeout_us));
+  return *this;
+}
+
 inline RunOptions& RunOptions::AddConfigEntry(const char* config_key, const char* config_value) {
   ThrowOnError(GetApi().AddRunConfigEntry(p_, config_key, config_value));
   return *this;
@@ -1568,6 +1607,13 @@ inline uint64_t ConstSessionImpl<T>::GetProfilingStartTimeNs() const {
   return out;
 }
 
+template <typename T>
+inline KeyValuePairs ConstSessionImpl<T>::GetThreadPoolMetrics() const {
+  OrtKeyValuePairs* out;
+  ThrowOnError(GetApi().SessionGetThreadPoolMetrics(this->p_, &out));
+  return KeyValuePairs(out);
+}
+
 template <typename T>
 inline ModelMetadata ConstSessionImpl<T>::GetModelMetadata() const {
   OrtModelMetadata* out;
@@ -1670,6 +1716,17 @@ inline void SessionImpl<T>::RunAsync(const RunOptions& run_options, const char*
                                  ort_output_values, callback, user_data));
 }
 
+template <typename T>
+inline void SessionImpl<T>::RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
+                                     const char* const* output_names, Value* output_values, size_t output_count, RunCompletionQueue& queue,
+                                     void* tag) {
+  auto ort_input_values = reinterpret_cast<const OrtValue* const*>(input_values);
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values);
+  ThrowOnError(GetApi().RunWithCompletionQueue(this->p_, run_options, input_names,
+                                               ort_input_values, input_count, output_names, output_count,
+                                               ort_output_values, queue, tag));
+}
+
 template <typename T>
 inline AllocatedStringPtr SessionImpl<T>::EndProfilingAllocated(OrtAllocator* allocator) {
   char* out = nullptr;
@@ -67,6 +67,10 @@ static const char* const kOrtSessionOptionsEnableQuantQDQCleanup = "session.enab
 // GeluApproximation has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimization.enable_gelu_approximation";
 
+// Enable or disable fusing chains of elementwise operators into a single FusedElementwise node in graph optimization.
+// "0": disable; "1": enable. The default is "0". The fusion is applied by the CPU execution provider at level 3.
+static const char* const kOrtSessionOptionsEnableElementwiseChainFusion = "optimization.enable_elementwise_chain_fusion";
+
 // Enable or disable Cast chain elimination in graph optimization. "0": disable; "1": enable. The default is "0".
 // CastElimination with chain elimination has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableCastChainElimination = "optimization.enable_cast_chain_elimination";
@@ -172,6 +176,15 @@ static const char* const kOrtSessionOptionsConfigUseORTModelBytesDirectly = "ses
 static const char* const kOrtSessionOptionsConfigUseORTModelBytesForInitializers =
     "session.use_ort_model_bytes_for_initializers";
 
+// Key for memory mapping the file of an ORT format model loaded from a file path.
+// The session keeps the mapping until it is destroyed and the initializers use the mapped bytes directly, so the
+// model is not read or copied on load and processes loading the same model share its pages in the page cache.
+// If the file cannot be mapped, it is read into memory instead.
+// The file MUST NOT be modified or truncated while the session exists.
+// "0": read the model file into memory. [DEFAULT]
+// "1": memory map the model file.
+static const char* const kOrtSessionOptionsConfigMapORTModelFile = "session.map_ort_model_file";
+
 // This should only be specified when exporting an ORT format model for use on a different platform.
 // If the ORT format model will be used on ARM platforms set to "1". For other platforms set to "0"
 // Available since version 1.11.
@@ -231,9 +244,94 @@ static const char* const kOrtSessionOptionsConfigStrictShapeTypeInference = "ses
 // is used for development purpose.
 static const char* const kOrtSessionOptionsConfigStrictAllowReleasedOpsetsOnly = "session.allow_released_opsets_only";
 
-// The file saves configuration for partitioning node among logic streams
+// The file saves configuration for partitioning node among logic streams.
+// A file containing {"type":"CostBasedPartitioner"} lets ORT build multiple CPU streams from per-node cost
+// estimates, so independent branches run concurrently with ExecutionMode::ORT_PARALLEL.
+// See CostBasedPartitioner in onnxruntime/core/framework/allocation_planner.cc for the optional fields.
 static const char* const kNodePartitionConfigFile = "session.node_partition_config_file";
 
+// Selects the order in which the nodes of the graph are executed. The C API has no setter for
+// SessionOptions::execution_order, so this entry is the way to pick one outside of Python.
+// Option values:
+// - "DEFAULT": default topological order. [DEFAULT]
+// - "PRIORITY_BASED": topological order that honors node priorities and runs Shape/Size nodes early.
+// - "CRITICAL_PATH": cost-guided topological order. With ORT_PARALLEL the nodes on the longest remaining path
+//   are started first; with ORT_SEQUENTIAL the nodes that release the most memory are run first, which lowers
+//   the peak of live tensors. Costs are taken from kOrtSessionOptionsConfigNodeCostProfileFile if set and are
+//   estimated from the tensor shapes otherwise.
+static const char* const kOrtSessionOptionsConfigExecutionOrder = "session.execution_order";
+
+// Path to a profile written by an earlier profiling run of the same model (see SessionOptions::enable_profiling).
+// The per-node kernel durations and output sizes it contains drive the "CRITICAL_PATH" execution order.
+static const char* const kOrtSessionOptionsConfigNodeCostProfileFile = "session.node_cost_profile_file";
+
+// Maximum number of samples that concurrent Run() calls are joined into along the batch dimension.
+// Batching applies to models whose graph inputs all have the same symbolic first dimension and that are declared
+// batch-separable with kOrtSessionOptionsConfigDynamicBatchingBatchSeparable. Compatible Run() calls (same inputs,
+// outputs, per-sample shapes, priority and log levels, CPU tensors only) that arrive within the timeout below while
+// other calls are running are concatenated, executed once and the outputs are handed back as views of the batched
+// result. "0" disables batching. [DEFAULT]
+static const char* const kOrtSessionOptionsConfigDynamicBatchingMaxBatchSize = "session.dynamic_batching.max_batch_size";
+
+// Declares that the model is batch-separable: each row of the batched outputs only depends on the same row of the
+// batched inputs, so concatenating Run() calls does not change their results. Models that mix samples, e.g. with
+// batch normalization in training mode or reductions over the batch dimension, must not set it.
+// Dynamic batching is only enabled if this is set.
+// "0": the model is not declared batch-separable. [DEFAULT]
+// "1": the model is batch-separable.
+static const char* const kOrtSessionOptionsConfigDynamicBatchingBatchSeparable =
+    "session.dynamic_batching.batch_separable";
+
+// Maximum time in microseconds the first Run() call of a batch waits for more calls to join it.
+// Only used if kOrtSessionOptionsConfigDynamicBatchingMaxBatchSize is set. Default is "1000".
+static const char* const kOrtSessionOptionsConfigDynamicBatchingTimeoutUs = "session.dynamic_batching.timeout_us";
+
+// Path to a json file with the number of intra-op threads each node runs with.
+// Kernels of the CPU EP see a thread pool narrowed to the thread count of their node, which avoids the fork/join
+// overhead of spreading small operators over all the threads. The file can be shipped with the model.
+// If kOrtSessionOptionsConfigNodeThreadCountsTuningRuns is set, the file is optional and is (re)written with the
+// learned thread counts after each Run() in which nodes finished learning.
+static const char* const kOrtSessionOptionsConfigNodeThreadCountsFile = "session.node_thread_counts_file";
+
+// Learns the thread count of the nodes that have none during the first runs of the session. Each execution of
+// such a node uses the next of the thread counts 1, 2, 4, ..., all threads, until every one of them was measured
+// the given number of times, and the node keeps the smallest thread count that is within 5% of the fastest.
+// "0": thread counts are not learned. [DEFAULT]
+static const char* const kOrtSessionOptionsConfigNodeThreadCountsTuningRuns = "session.node_thread_counts_tuning_runs";
+
+// Maximum number of memory patterns cached per session (or subgraph) when memory patterns are enabled.
+// A pattern is cached for each combination of input shapes; the least recently used one is evicted when the cache
+// is full. If the symbolic dimensions of the graph inputs determine the shapes of the intermediate tensors, the
+// patterns of new input shapes are generated from the first traced run instead of tracing another run.
+// Default is "64".
+static const char* const kOrtSessionOptionsConfigMemoryPatternCacheSize = "session.memory_pattern_cache_size";
+
+// Shares the constant CPU initializers of at least 4 KB with the other sessions of the environment that enable this
+// option and load byte-identical initializers, e.g. fine-tuned variants of a base model that only differ in some
+// weights. Also shares the pre-packed weights of these sessions unless a PrepackedWeightsContainer is provided.
+// "0": initializers are not shared. [DEFAULT]
+// "1": initializers are shared by content.
+static const char* const kOrtSessionOptionsConfigShareInitializersByContent = "session.share_initializers_by_content";
+
+// Maximum number of bytes of activation memory of the main graph. The session tries the execution orders with
+// memory reuse enabled, starting with the configured one, and keeps the first plan whose peak activation memory fits
+// the budget. Session creation fails if no plan fits, or if the peak cannot be computed because a node output has
+// symbolic dimensions (which can be fixed with free dimension overrides) or is not a tensor.
+// The peak covers the buffers planned for the node outputs, not the scratch memory of the kernels or the subgraphs
+// of control flow nodes.
+// "0": no budget. [DEFAULT]
+static const char* const kOrtSessionOptionsConfigMemoryBudgetBytes = "session.memory_budget_bytes";
+
+// Path of a file to record the allocations and frees of the arenas of the session in, in the Chrome trace format.
+// Each allocation made by a node of the main graph or of a subgraph is attributed to the node and, for node outputs,
+// to the OrtValue index. The state of the arena after each event is recorded as counters: bytes in use, total free
+// bytes, largest free chunk, fragmentation (1 - largest free chunk / total free bytes) and free chunks per bin.
+// The events are appended to the file at the end of each Run, and the file is completed when the session is
+// released. Allocations made by intra-op threads are not attributed. The thread-local caches of the arenas are
+// bypassed while recording, so this is meant for diagnosing memory growth rather than for production.
+// "": disabled. [DEFAULT]
+static const char* const kOrtSessionOptionsConfigAllocationTimelineFile = "session.allocation_timeline_file";
+
 // This Option allows setting affinities for intra op threads.
 // Affinity string follows format:
 // logical_processor_id,logical_processor_id;logical_processor_id,logical_processor_id
@@ -251,6 +349,32 @@ static const char* const kNodePartitionConfigFile = "session.node_partition_conf
 //    Hence 64-65 is an invalid configuration, because a windows thread cannot be attached to processors across group boundary.
 static const char* const kOrtSessionOptionsConfigIntraOpThreadAffinities = "session.intra_op_thread_affinities";
 
+// Enable NUMA-aware work distribution in the intra op thread pool.
+// "0": disabled. The default.
+// "1": workers are grouped by the NUMA node of their thread affinity. Idle workers steal work from workers on the
+//      same node first, and only steal across nodes when the queues on their own node are empty. The loops of a
+//      parallel section are kept on a single node where possible.
+// Requires intra op thread affinities, either set via session.intra_op_thread_affinities or assigned automatically
+// when intra_op_num_threads is 0. Has no effect on systems with a single NUMA node.
+static const char* const kOrtSessionOptionsConfigIntraOpNumaAware = "session.intra_op.numa_aware";
+
+// Maximum number of threads, including the calling thread, that a single parallel loop of this session may use in
+// the intra op thread pool. Intended for sessions sharing the global thread pools, so that one session cannot take
+// every worker of the pool. See also OrtApi::RunOptionsSetPriority.
+// "0": no limit. The default.
+// "N": loops use at most N threads. N must be positive.
+static const char* const kOrtSessionOptionsConfigIntraOpMaxDegreeOfParallelism =
+    "session.intra_op.max_degree_of_parallelism";
+
+// Enable the adaptive spin-then-park policy in the intra op thread pool.
+// "0": disabled. Workers spin for a fixed number of iterations before parking. The default.
+// "N": each worker measures the idle gaps between the work it runs (between parallel sections and between Run
+//      calls) and spins only for as long as it expects new work to arrive, at most N microseconds. Workers whose
+//      recent gaps exceed N, e.g. while requests are idle, park without spinning.
+// Only takes effect if session.intra_op.allow_spinning is "1". The spin budget chosen by each worker is reported
+// in the thread pool section of the session profile.
+static const char* const kOrtSessionOptionsConfigIntraOpAdaptiveSpinTargetUs = "session.intra_op.adaptive_spin_target_us";
+
 // This option will dump out the model to assist debugging any issues with layout transformation,
 // and is primarily intended for developer usage. It is only relevant if an execution provider that requests
 // NHWC layout is enabled such as NNAPI, XNNPACK or QNN.
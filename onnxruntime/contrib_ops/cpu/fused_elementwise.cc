@@ -0,0 +1,209 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+
+#include "core/common/inlined_containers.h"
+#include "core/common/narrow.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+bool TryGetOpcode(const std::string& op_type, MLAS_ELTWISE_OPCODE& opcode) {
+  static const InlinedHashMap<std::string, MLAS_ELTWISE_OPCODE> opcodes = {
+      {"Add", MlasEltwiseOpAdd},
+      {"Sub", MlasEltwiseOpSub},
+      {"Mul", MlasEltwiseOpMul},
+      {"Div", MlasEltwiseOpDiv},
+      {"Max", MlasEltwiseOpMax},
+      {"Min", MlasEltwiseOpMin},
+      {"Relu", MlasEltwiseOpRelu},
+      {"Sigmoid", MlasEltwiseOpSigmoid},
+      {"Tanh", MlasEltwiseOpTanh},
+      {"Exp", MlasEltwiseOpExp},
+      {"Log", MlasEltwiseOpLog},
+      {"Erf", MlasEltwiseOpErf},
+      {"Neg", MlasEltwiseOpNeg},
+      {"Abs", MlasEltwiseOpAbs},
+      {"Sqrt", MlasEltwiseOpSqrt},
+      {"Reciprocal", MlasEltwiseOpReciprocal},
+  };
+
+  auto it = opcodes.find(op_type);
+  if (it == opcodes.end()) {
+    return false;
+  }
+  opcode = it->second;
+  return true;
+}
+
+}  // namespace
+
+// Runs a chain of elementwise operators as a single MLAS program. The program in the node attributes
+// writes a new register per instruction. It is compiled once here into an MLAS program whose temporary
+// registers are reused as soon as their last reader has executed. This keeps the working set of a tile
+// small enough to stay in cache.
+class FusedElementwise final : public OpKernel {
+ public:
+  explicit FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+    std::vector<std::string> operators;
+    std::vector<int64_t> operands;
+    ORT_THROW_IF_ERROR(info.GetAttrs("operators", operators));
+    ORT_THROW_IF_ERROR(info.GetAttrs("operands", operands));
+    ORT_ENFORCE(!operators.empty(), "FusedElementwise requires at least one operator.");
+    ORT_ENFORCE(operands.size() == operators.size() * 2,
+                "FusedElementwise requires two operands per operator. Got ", operands.size(),
+                " operands for ", operators.size(), " operators.");
+
+    const size_t input_count = info.GetInputCount();
+    const size_t value_count = input_count + operators.size();
+
+    // Find the last instruction that reads each value of the program.
+    std::vector<size_t> last_use(value_count, 0);
+    std::vector<bool> is_read(value_count, false);
+
+    program_.resize(operators.size());
+
+    for (size_t i = 0; i < operators.size(); ++i) {
+      auto& instruction = program_[i];
+      ORT_ENFORCE(TryGetOpcode(operators[i], instruction.Opcode),
+                  "FusedElementwise does not support operator ", operators[i]);
+
+      const size_t source_count = MlasEltwiseOpIsBinary(instruction.Opcode) ? 2 : 1;
+      for (size_t s = 0; s < source_count; ++s) {
+        const int64_t source = operands[i * 2 + s];
+        ORT_ENFORCE(source >= 0 && static_cast<size_t>(source) < input_count + i,
+                    "FusedElementwise operator ", i, " reads register ", source, " before it is written.");
+        last_use[static_cast<size_t>(source)] = i;
+        is_read[static_cast<size_t>(source)] = true;
+      }
+    }
+
+    // Assign the values written by the program to temporary registers, which follow the input registers.
+    std::vector<uint32_t> physical(value_count);
+    std::vector<uint32_t> free_registers;
+    uint32_t register_count = narrow<uint32_t>(input_count);
+
+    for (size_t i = 0; i < input_count; ++i) {
+      physical[i] = narrow<uint32_t>(i);
+    }
+
+    for (size_t i = 0; i < operators.size(); ++i) {
+      auto& instruction = program_[i];
+      const bool is_binary = MlasEltwiseOpIsBinary(instruction.Opcode);
+      const auto source0 = static_cast<size_t>(operands[i * 2]);
+      const auto source1 = is_binary ? static_cast<size_t>(operands[i * 2 + 1]) : source0;
+
+      instruction.Source0 = physical[source0];
+      instruction.Source1 = physical[source1];
+
+      // Release the temporaries that are not read again so that the destination can reuse them.
+      for (size_t source : {source0, source1}) {
+        if (source >= input_count && last_use[source] == i &&
+            std::find(free_registers.begin(), free_registers.end(), physical[source]) == free_registers.end()) {
+          free_registers.push_back(physical[source]);
+        }
+      }
+
+      const size_t value = input_count + i;
+      if (!free_registers.empty()) {
+        physical[value] = free_registers.back();
+        free_registers.pop_back();
+      } else {
+        physical[value] = register_count++;
+      }
+      instruction.Destination = physical[value];
+
+      if (!is_read[value]) {
+        free_registers.push_back(physical[value]);
+      }
+    }
+
+    register_count_ = register_count;
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  std::vector<MLAS_ELTWISE_INSTRUCTION> program_;
+  size_t register_count_;
+};
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  const int input_count = context->InputCount();
+
+  // Compute the broadcast output shape of the inputs.
+  size_t output_rank = 0;
+  for (int i = 0; i < input_count; ++i) {
+    output_rank = std::max(output_rank, context->Input<Tensor>(i)->Shape().NumDimensions());
+  }
+
+  TensorShapeVector output_dims(output_rank, 1);
+  for (int i = 0; i < input_count; ++i) {
+    const auto dims = context->Input<Tensor>(i)->Shape().GetDims();
+    const size_t offset = output_rank - dims.size();
+    for (size_t d = 0; d < dims.size(); ++d) {
+      int64_t& output_dim = output_dims[offset + d];
+      if (output_dim == 1) {
+        output_dim = dims[d];
+      } else {
+        ORT_RETURN_IF_NOT(dims[d] == 1 || dims[d] == output_dim,
+                          "FusedElementwise inputs are not broadcast compatible.");
+      }
+    }
+  }
+
+  const TensorShape output_shape(output_dims);
+  Tensor& output = *context->Output(0, output_shape);
+
+  const size_t output_size = narrow<size_t>(output_shape.Size());
+  if (output_size == 0) {
+    return Status::OK();
+  }
+
+  // Every input must repeat over the output, so the dimensions that remain after removing its leading ones must
+  // match the trailing dimensions of the output.
+  InlinedVector<const float*> inputs(static_cast<size_t>(input_count));
+  InlinedVector<size_t> input_counts(static_cast<size_t>(input_count));
+
+  for (int i = 0; i < input_count; ++i) {
+    const Tensor& input = *context->Input<Tensor>(i);
+    const auto dims = input.Shape().GetDims();
+
+    size_t first = 0;
+    while (first < dims.size() && dims[first] == 1) {
+      ++first;
+    }
+
+    const size_t offset = output_rank - dims.size();
+    for (size_t d = first; d < dims.size(); ++d) {
+      ORT_RETURN_IF_NOT(dims[d] == output_dims[offset + d], "FusedElementwise input ", i, " with shape ",
+                        input.Shape(), " does not repeat over the output shape ", output_shape);
+    }
+
+    inputs[i] = input.Data<float>();
+    input_counts[i] = narrow<size_t>(input.Shape().Size());
+  }
+
+  MlasEltwiseProgramExecute(program_.data(), program_.size(), register_count_, inputs.data(), input_counts.data(),
+                            inputs.size(), output.MutableData<float>(), output_size,
+                            context->GetOperatorThreadPool());
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -231,13 +231,22 @@ void ThreadPoolProfiler::LogRun(int thread_idx) {
   }
 }
 
+void ThreadPoolProfiler::LogSpinBudget(int thread_idx, uint64_t spin_budget_us) {
+  if (enabled_) {
+    child_thread_stats_[thread_idx].spin_budget_us_ = static_cast<int64_t>(spin_budget_us);
+  }
+}
+
 std::string ThreadPoolProfiler::DumpChildThreadStat() {
   std::stringstream ss;
   for (int i = 0; i < num_threads_; ++i) {
     ss << "\"" << child_thread_stats_[i].thread_id_ << "\": {"
        << "\"num_run\": " << child_thread_stats_[i].num_run_ << ", "
-       << "\"core\": " << child_thread_stats_[i].core_ << "}"
-       << (i == num_threads_ - 1 ? "" : ",");
+       << "\"core\": " << child_thread_stats_[i].core_;
+    if (child_thread_stats_[i].spin_budget_us_ >= 0) {
+      ss << ", \"spin_budget_us\": " << child_thread_stats_[i].spin_budget_us_;
+    }
+    ss << "}" << (i == num_threads_ - 1 ? "" : ",");
   }
   return ss.str();
 }
@@ -390,6 +399,15 @@ ThreadPool::ThreadPool(Env* env,
       assert(thread_options_.affinities.size() >= size_t(threads_to_create));
     }
 
+    if (thread_options_.numa_aware && thread_options_.numa_nodes.empty()) {
+      // Derive the NUMA node of each worker from the first logical processor in its affinity.
+      // Workers without an affinity may migrate between nodes, so their node is left unknown.
+      thread_options_.numa_nodes.reserve(thread_options_.affinities.size());
+      for (const auto& affinity : thread_options_.affinities) {
+        thread_options_.numa_nodes.push_back(affinity.empty() ? -1 : env->GetNumaNodeOfLogicalProcessor(affinity.front()));
+      }
+    }
+
     extended_eigen_threadpool_ =
         std::make_unique<ThreadPoolTempl<Env> >(name,
                                                 threads_to_create,
@@ -417,11 +435,13 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
   }
 
   auto d_of_p = DegreeOfParallelism(this);
+  // The blocks run on worker threads, so test the cancellation of the caller captured here.
+  const SchedulingOptions options = GetSchedulingOptions();
   if (thread_options_.dynamic_block_base_ <= 0) {
     // Split the work across threads in the pool.  Each work item will run a loop claiming iterations,
     // hence we need at most one for each thread, even if the number of blocks of iterations is larger.
     auto num_blocks = total / block_size;
-    auto num_threads_inc_main = NumThreads() + 1;
+    auto num_threads_inc_main = MaxThreadsForCaller();
     int num_work_items = static_cast<int>(std::min(static_cast<std::ptrdiff_t>(num_threads_inc_main), num_blocks));
     assert(num_work_items > 0);
 
@@ -430,7 +450,8 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
       unsigned my_home_shard = lc.GetHomeShard(idx);
       unsigned my_shard = my_home_shard;
       uint64_t my_iter_start, my_iter_end;
-      while (lc.ClaimIterations(my_home_shard, my_shard, my_iter_start, my_iter_end, block_size)) {
+      while (!IsCancelled(options) &&
+             lc.ClaimIterations(my_home_shard, my_shard, my_iter_start, my_iter_end, block_size)) {
         fn(static_cast<std::ptrdiff_t>(my_iter_start),
            static_cast<std::ptrdiff_t>(my_iter_end));
       }
@@ -449,7 +470,7 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
       unsigned my_home_shard = lc.GetHomeShard(idx);
       unsigned my_shard = my_home_shard;
       uint64_t my_iter_start, my_iter_end;
-      while (lc.ClaimIterations(my_home_shard, my_shard, my_iter_start, my_iter_end, b)) {
+      while (!IsCancelled(options) && lc.ClaimIterations(my_home_shard, my_shard, my_iter_start, my_iter_end, b)) {
         fn(static_cast<std::ptrdiff_t>(my_iter_start),
            static_cast<std::ptrdiff_t>(my_iter_end));
         auto todo = left.fetch_sub(static_cast<std::ptrdiff_t>(my_iter_end - my_iter_start), std::memory_order_relaxed);
@@ -460,7 +481,7 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
     };
     // Distribute task among all threads in the pool, reduce number of work items if
     // num_of_blocks is smaller than number of threads.
-    RunInParallel(run_work, std::min(NumThreads() + 1, num_of_blocks), base_block_size);
+    RunInParallel(run_work, std::min(MaxThreadsForCaller(), num_of_blocks), base_block_size);
   }
 }
 
@@ -472,8 +493,75 @@ void ThreadPool::SimpleParallelFor(std::ptrdiff_t total, const std::function<voi
   });
 }
 
+namespace {
+thread_local ThreadPool::SchedulingOptions current_scheduling_options;
+
+int GetPriorityClass(int priority) {
+  return priority < 0 ? 0 : (priority == 0 ? 1 : 2);
+}
+
+bool IsDefault(const ThreadPool::SchedulingOptions& options) {
+  return options.priority == 0 && options.max_degree_of_parallelism == 0 && options.terminate == nullptr &&
+         options.deadline == std::chrono::steady_clock::time_point::max();
+}
+}  // namespace
+
+ThreadPool::ScopedSchedulingOptions::ScopedSchedulingOptions(ThreadPool* tp, const SchedulingOptions& options)
+    : tp_(tp), previous_options_(current_scheduling_options), priority_class_(GetPriorityClass(options.priority)) {
+  ORT_ENFORCE(options.max_degree_of_parallelism >= 0, "max_degree_of_parallelism must be non-negative");
+  current_scheduling_options = options;
+  if (tp_) {
+    tp_->active_scopes_per_priority_class_[priority_class_].fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+ThreadPool::ScopedSchedulingOptions::~ScopedSchedulingOptions() {
+  if (tp_) {
+    tp_->active_scopes_per_priority_class_[priority_class_].fetch_sub(1, std::memory_order_relaxed);
+  }
+  current_scheduling_options = previous_options_;
+}
+
+ThreadPool::SchedulingOptions ThreadPool::GetSchedulingOptions() {
+  return current_scheduling_options;
+}
+
+bool ThreadPool::IsCancelled() {
+  return IsCancelled(current_scheduling_options);
+}
+
+bool ThreadPool::IsCancelled(const SchedulingOptions& options) {
+  if (options.terminate != nullptr && *options.terminate) {
+    return true;
+  }
+  return options.deadline != std::chrono::steady_clock::time_point::max() &&
+         std::chrono::steady_clock::now() >= options.deadline;
+}
+
+int ThreadPool::MaxThreadsForCaller() const {
+  const auto& options = current_scheduling_options;
+  for (int c = GetPriorityClass(options.priority) + 1; c < kNumPriorityClasses; c++) {
+    if (active_scopes_per_priority_class_[c].load(std::memory_order_relaxed) > 0) {
+      return 1;
+    }
+  }
+  int max_threads = NumThreads() + 1;
+  if (options.max_degree_of_parallelism > 0) {
+    max_threads = std::min(max_threads, options.max_degree_of_parallelism);
+  }
+  return max_threads;
+}
+
 void ThreadPool::Schedule(std::function<void()> fn) {
   if (underlying_threadpool_) {
+    // Propagate the caller's scheduling options to the task so that, for instance,
+    // nodes run on the inter-op pool keep the priority and quota of their Run call.
+    if (!IsDefault(current_scheduling_options)) {
+      fn = [options = current_scheduling_options, fn = std::move(fn)]() {
+        ScopedSchedulingOptions scope(nullptr, options);
+        fn();
+      };
+    }
     underlying_threadpool_->Schedule(std::move(fn));
   } else {
     fn();
@@ -547,6 +635,11 @@ bool ThreadPool::ShouldParallelizeLoop(const std::ptrdiff_t num_iterations,
     return false;
   }
 
+  // Do not parallelize loops the caller may only run on its own thread.
+  if (MaxThreadsForCaller() == 1) {
+    return false;
+  }
+
   return true;
 }
 
@@ -639,11 +732,13 @@ bool ThreadPool::ShouldParallelize(const concurrency::ThreadPool* tp) {
 int ThreadPool::DegreeOfParallelism(const concurrency::ThreadPool* tp) {
   // When not using OpenMP, we parallelize over the N threads created by the pool
   // tp, plus 1 for the thread entering a loop.
+  // The number of threads is capped by the caller's scheduling options.
   if (tp) {
-    if (tp->force_hybrid_ || CPUIDInfo::GetCPUIDInfo().IsHybrid()) {
-      return ((tp->NumThreads() + 1)) * TaskGranularityFactor;
+    const int max_threads = tp->MaxThreadsForCaller();
+    if (max_threads > 1 && (tp->force_hybrid_ || CPUIDInfo::GetCPUIDInfo().IsHybrid())) {
+      return max_threads * TaskGranularityFactor;
     } else {
-      return ((tp->NumThreads() + 1));
+      return max_threads;
     }
   } else {
     return 1;
@@ -664,6 +759,14 @@ std::string ThreadPool::StopProfiling(concurrency::ThreadPool* tp) {
   }
 }
 
+ThreadPoolMetrics ThreadPool::GetMetrics(const concurrency::ThreadPool* tp) {
+  ThreadPoolMetrics metrics;
+  if (tp && tp->extended_eigen_threadpool_) {
+    tp->extended_eigen_threadpool_->GetMetrics(metrics);
+  }
+  return metrics;
+}
+
 void ThreadPool::EnableSpinning() {
   if (extended_eigen_threadpool_) {
     extended_eigen_threadpool_->EnableSpinning();
@@ -5,15 +5,20 @@
 #include <list>
 #include <algorithm>
 #include <deque>
+#include <fstream>
+#include <functional>
 #include <sstream>
 #include <ctime>
 #include <iomanip>
 #include <iterator>
+#include <limits>
 #include "core/common/exceptions.h"
 #include "core/common/inlined_containers.h"
+#include "core/common/parse_string.h"
 #include "core/common/safeint.h"
 #include "core/platform/env.h"
 #include "core/framework/data_types.h"
+#include "core/framework/data_types_internal.h"
 #include "core/framework/execution_steps.h"
 #include "core/framework/stream_execution_context.h"
 #include "core/framework/kernel_def_builder.h"
@@ -25,10 +30,8 @@
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/sequential_executor.h"
 
-#ifdef ORT_ENABLE_STREAM
 #include "nlohmann/json.hpp"
 using json = nlohmann::json;
-#endif
 
 using namespace onnxruntime::common;
 using namespace ONNX_NAMESPACE;
@@ -131,6 +134,88 @@ static const KernelCreateInfo& GetKernelCreateInfo(
   return *entry->second;
 }
 
+// Number of elements of a tensor of the given shape. Symbolic dimensions count as 1, which keeps the estimates
+// of different nodes comparable to each other even if e.g. the batch size is unknown.
+static double NumElements(const ONNX_NAMESPACE::TensorShapeProto* shape) {
+  if (shape == nullptr) {
+    return 0.0;
+  }
+  double count = 1.0;
+  for (const auto& dim : shape->dim()) {
+    if (utils::HasDimValue(dim) && dim.dim_value() > 0) {
+      count *= static_cast<double>(dim.dim_value());
+    }
+  }
+  return count;
+}
+
+static double DimValue(const ONNX_NAMESPACE::TensorShapeProto* shape, int axis) {
+  if (shape == nullptr || shape->dim_size() == 0) {
+    return 1.0;
+  }
+  if (axis < 0) {
+    axis += shape->dim_size();
+  }
+  if (axis < 0 || axis >= shape->dim_size() || !utils::HasDimValue(shape->dim(axis))) {
+    return 1.0;
+  }
+  return static_cast<double>(std::max<int64_t>(1, shape->dim(axis).dim_value()));
+}
+
+// rough single core throughput used to turn shapes into an estimated kernel duration
+constexpr double kEstimatedFlopsPerMicrosecond = 1e4;
+constexpr double kEstimatedElementsPerMicrosecond = 1e3;
+// fixed cost of launching a kernel
+constexpr double kNodeLaunchCostUs = 1.0;
+
+// Estimate the duration of a node in microseconds from the shapes of its inputs and outputs:
+// from the FLOPs of MatMul/Gemm/Conv like nodes and from the number of elements touched for the others.
+// get_shape maps a NodeArg to its (possibly null) TensorShapeProto.
+template <typename GetShapeFn>
+static double EstimateNodeCostUs(const Node& node, const GetShapeFn& get_shape) {
+  auto shape_of = [&get_shape](const NodeArg* arg) -> const ONNX_NAMESPACE::TensorShapeProto* {
+    return arg != nullptr && arg->Exists() ? get_shape(*arg) : nullptr;
+  };
+
+  const auto& inputs = node.InputDefs();
+  const auto& outputs = node.OutputDefs();
+  double output_elements = 0.0;
+  for (const auto* output : outputs) {
+    output_elements += NumElements(shape_of(output));
+  }
+
+  double flops = 0.0;
+  const auto& op_type = node.OpType();
+  if (inputs.size() >= 2 && inputs[0]->Exists() && inputs[1]->Exists()) {
+    if (op_type == "MatMul" || op_type == "MatMulInteger" || op_type == "FusedMatMul") {
+      flops = 2.0 * output_elements * DimValue(shape_of(inputs[0]), -1);
+    } else if (op_type == "Gemm") {
+      const auto& attributes = node.GetAttributes();
+      auto trans_a = attributes.find("transA");
+      const bool transposed = trans_a != attributes.end() && trans_a->second.i() != 0;
+      flops = 2.0 * output_elements * DimValue(shape_of(inputs[0]), transposed ? 0 : 1);
+    } else if (op_type == "Conv" || op_type == "FusedConv" || op_type == "ConvInteger") {
+      // each output element reduces over (input channels / group) * kernel size weights
+      flops = 2.0 * output_elements * NumElements(shape_of(inputs[1])) / DimValue(shape_of(inputs[1]), 0);
+    } else if (op_type == "ConvTranspose") {
+      flops = 2.0 * output_elements * NumElements(shape_of(inputs[1])) / DimValue(shape_of(inputs[1]), 1);
+    }
+  }
+
+  double elements = output_elements;
+  for (const auto* input : inputs) {
+    elements += NumElements(shape_of(input));
+  }
+
+  return kNodeLaunchCostUs +
+         std::max(flops / kEstimatedFlopsPerMicrosecond, elements / kEstimatedElementsPerMicrosecond);
+}
+
+// Name under which the profiler records the kernel events of a node.
+static std::string ProfiledNodeName(const Node& node) {
+  return node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name();
+}
+
 class PlannerImpl {
  public:
   PlannerImpl(const Node* parent_node, const onnxruntime::GraphViewer& graph_viewer,
@@ -183,6 +268,8 @@ class PlannerImpl {
 
   size_t num_logic_streams_{0};
   std::vector<InlinedVector<NodeIndex>> stream_nodes_;
+  // node order computed by the planner for ExecutionOrder::CRITICAL_PATH, see ComputeCriticalPathOrder
+  std::vector<NodeIndex> critical_path_order_;
 
   // dependence_graph_ keeps the dependencies combining model graph and logic streams
   // e.g. dependence_graph_[downstream_node] = [upstream_node_0, upstream_node_1, upstream_node_2 ...]
@@ -231,6 +318,10 @@ class PlannerImpl {
   // they became free (more recently freed earlier in the list).
   std::list<FreeBufferInfo> freelist_;
 
+  // The values aliasing a value planned to be written to a bound graph output, with the index of that value.
+  // See ComputeBoundOutputTargets.
+  InlinedVector<std::pair<OrtValueIndex, OrtValueIndex>> bound_output_aliases_;
+
   OrtValueIndex Index(const OrtValueName& name) {
     OrtValueIndex result;
     auto status = ort_value_name_idx_map_.GetIdx(name, result);
@@ -617,6 +708,107 @@ class PlannerImpl {
     return ci.kernel_def->HasExternalOutputs();
   }
 
+#if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
+  // Returns the index of the input of node that the output named output_name aliases, or -1.
+  int AliasedInputIndex(const Node& node, const std::string& output_name) {
+    const KernelCreateInfo& ci = GetKernelCreateInfo(kernel_create_info_map_, node.Index());
+    if (ci.kernel_def == nullptr || HasExternalOutputs(node)) {
+      return -1;
+    }
+
+    const auto input_args = node.InputDefs();
+    const auto output_args = node.OutputDefs();
+    for (const auto& [input_index, output_index] : GetAliasMap(node, ci)) {
+      if (0 <= output_index && static_cast<size_t>(output_index) < output_args.size() &&
+          output_args[output_index]->Name() == output_name &&
+          0 <= input_index && static_cast<size_t>(input_index) < input_args.size() &&
+          input_args[input_index]->Exists()) {
+        return input_index;
+      }
+    }
+    return -1;
+  }
+
+  // A graph output produced by a node that aliases one of its inputs, like Reshape or Identity, is a copy of the
+  // input when the caller binds a buffer for the output. Instead, the value the input aliases through a chain of such
+  // nodes is planned to be written to the bound buffer, which makes the copies no-ops. The value must be a tensor that
+  // is only consumed by the next node of the chain, on the device of the graph output.
+  //
+  // The plan is the same whether or not a run binds the output: the value is allocated rather than reusing a buffer,
+  // and its buffer is reused as usual once the chain is done. In a run that binds a buffer of the same size, the
+  // ExecutionFrame writes the value and the values of the chain to the bound buffer, and gives the later values that
+  // reuse the buffer of the value a buffer of their own. The only cost for the runs that do not bind the output is
+  // that the value does not reuse a dead buffer or an input in place.
+  //
+  // Only the main graph is handled, as control flow nodes provide the outputs of their subgraphs, and only single
+  // stream plans, as the reuse plan of multiple streams is computed from the lifetimes of the buffers.
+  void ComputeBoundOutputTargets() {
+    if (parent_node_ != nullptr || !IsSingleStream()) {
+      return;
+    }
+
+    for (const NodeArg* graph_output : graph_viewer_.GetOutputs()) {
+      const auto output_index = Index(graph_output->Name());
+      const NodeArg* current = graph_output;
+      const char* reason = nullptr;
+      InlinedVector<OrtValueIndex> aliases;
+      while (reason == nullptr) {
+        const Node* producer = graph_viewer_.GetProducerNode(current->Name());
+        if (producer == nullptr) {
+          reason = "is a graph input or an initializer";
+          break;
+        }
+
+        const int input_index = AliasedInputIndex(*producer, current->Name());
+        if (input_index < 0) {
+          if (current != graph_output) {
+            // The producer writes the value, which is then aliased up to the graph output.
+            const auto value_index = Index(current->Name());
+            AllocPlan(value_index).bound_output = output_index;
+            for (const auto alias : aliases) {
+              bound_output_aliases_.emplace_back(alias, value_index);
+            }
+          } else if (producer->ContainsSubgraph()) {
+            reason = "is produced by a control flow node";
+          }
+          break;
+        }
+
+        const NodeArg* input = producer->InputDefs()[input_index];
+        const auto& outputs = graph_viewer_.GetOutputs();
+        if (IsNonTensor(*input)) {
+          reason = "is not a tensor";
+        } else if (graph_viewer_.GetConsumerNodes(input->Name()).size() != 1 ||
+                   std::find(outputs.begin(), outputs.end(), input) != outputs.end()) {
+          reason = "is used by other nodes";
+        } else if (!(AllocPlan(input->Name()).location == AllocPlan(output_index).location)) {
+          reason = "is on another device";
+        }
+        if (current != graph_output) {
+          aliases.push_back(Index(current->Name()));
+        }
+        current = input;
+      }
+
+      if (reason != nullptr) {
+        LOGS(logger_, INFO) << "A buffer bound to graph output " << graph_output->Name()
+                            << " receives a copy of the output, as " << current->Name() << " " << reason;
+      }
+    }
+  }
+
+  // Marks the values of the chains found by ComputeBoundOutputTargets that share the buffer of the value written to
+  // the bound graph output, so that the ExecutionFrame can tell them from the later values that reuse the buffer.
+  void MarkBoundOutputAliases() {
+    for (const auto& [alias, value_index] : bound_output_aliases_) {
+      auto& alias_plan = AllocPlan(alias);
+      if (alias_plan.alloc_kind == AllocKind::kReuse && alias_plan.reused_buffer == value_index) {
+        alias_plan.bound_output = AllocPlan(value_index).bound_output;
+      }
+    }
+  }
+#endif
+
   Status ComputePlanForInputsAndWeights() {
     auto setup_preexisting = [this](const NodeArg* node_arg) {
       auto input_index = Index(node_arg->Name());
@@ -1606,6 +1798,9 @@ class PlannerImpl {
               }
             }
           }
+        } else if (AllocPlan(current).bound_output != -1) {
+          // the buffer may be the one of a graph output, see ComputeBoundOutputTargets
+          AllocPlan(current).alloc_kind = AllocKind::kAllocate;
         } else if (!context_->IsParallelExecutionEnabled() &&
                    FindReusableInput(graph_viewer_, *pnode, static_cast<int>(output_arg_def_index),
                                      &reused, &is_strided_tensor)) {
@@ -1750,7 +1945,7 @@ class PlannerImpl {
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   void CalculateLifetime(std::vector<int>& ort_value_usecount) {
-    auto& execution_plan = graph_viewer_.GetNodesInTopologicalOrder(context_->GetExecutionOrder());
+    auto& execution_plan = NodesInExecutionOrder();
     for (size_t program_counter = 0; program_counter < execution_plan.size(); ++program_counter) {
       auto node_index = execution_plan[program_counter];
       // the node (aka operator) which carries the considered program (aka computation).
@@ -1937,13 +2132,224 @@ class PlannerImpl {
     return Status::OK();
   }
 
+  // The nodes in the order the execution plan is built in.
+  const std::vector<NodeIndex>& NodesInExecutionOrder() const {
+    if (!critical_path_order_.empty()) {
+      return critical_path_order_;
+    }
+    return graph_viewer_.GetNodesInTopologicalOrder(context_->GetExecutionOrder());
+  }
+
+  // Build the ExecutionOrder::CRITICAL_PATH order by list-scheduling the nodes: among the nodes whose producers
+  // have all been scheduled, pick
+  //   - with parallel execution, the one with the longest remaining path to a graph output (its bottom level),
+  //     so long-latency chains are started first and overlap with the short branches;
+  //   - otherwise, the one that releases the most bytes net of what it allocates, which lowers the peak of
+  //     live tensors and hence the arena size.
+  // Node durations and output sizes come from the recorded costs of the context when available and are
+  // estimated from the shapes otherwise.
+  void ComputeCriticalPathOrder() {
+    const auto& topological_order = graph_viewer_.GetNodesInTopologicalOrder(ExecutionOrder::DEFAULT);
+    const size_t num_nodes = topological_order.size();
+    if (num_nodes == 0) {
+      return;
+    }
+
+#ifdef ENABLE_TRAINING
+    // the forward/backward split relies on the position of YieldOp in the topological order, keep it as is.
+    for (auto node_index : topological_order) {
+      if (graph_viewer_.GetNode(node_index)->OpType() == "YieldOp") {
+        return;
+      }
+    }
+#endif
+
+    const NodeExecutionCosts* recorded_costs = context_->GetNodeExecutionCosts();
+    auto get_shape = [this](const NodeArg& arg) { return context_->GetShape(arg); };
+
+    // slot of a node in topological_order, also used to break ties deterministically
+    InlinedHashMap<NodeIndex, size_t> slot_of_node;
+    slot_of_node.reserve(num_nodes);
+    for (size_t slot = 0; slot < num_nodes; ++slot) {
+      slot_of_node[topological_order[slot]] = slot;
+    }
+
+    // size of the values produced by the nodes of this graph and the distinct nodes that still have to read them
+    struct ValueState {
+      double bytes = 0.0;
+      bool is_graph_output = false;
+      size_t pending_consumers = 0;
+      InlinedVector<size_t> consumers;
+    };
+    std::vector<ValueState> values;
+    InlinedHashMap<const NodeArg*, size_t> value_of_arg;
+    const auto& graph_outputs = graph_viewer_.GetOutputs();
+
+    std::vector<double> durations(num_nodes);
+    std::vector<double> bottom_levels(num_nodes);
+    std::vector<size_t> pending_producers(num_nodes, 0);
+    // bytes released by running the node minus the bytes it allocates, kept up to date as nodes are scheduled
+    std::vector<double> memory_deltas(num_nodes, 0.0);
+    for (size_t slot = 0; slot < num_nodes; ++slot) {
+      const auto* node = graph_viewer_.GetNode(topological_order[slot]);
+      const NodeExecutionCost* recorded = nullptr;
+      if (recorded_costs != nullptr) {
+        auto it = recorded_costs->find(ProfiledNodeName(*node));
+        if (it != recorded_costs->end()) {
+          recorded = &it->second;
+        }
+      }
+      durations[slot] = recorded != nullptr && recorded->duration_us > 0.0 ? recorded->duration_us
+                                                                            : EstimateNodeCostUs(*node, get_shape);
+
+      size_t num_outputs = 0;
+      for (const auto* output : node->OutputDefs()) {
+        if (output->Exists()) {
+          ++num_outputs;
+        }
+      }
+      for (const auto* output : node->OutputDefs()) {
+        if (!output->Exists()) {
+          continue;
+        }
+        value_of_arg[output] = values.size();
+        auto& value = values.emplace_back();
+        const MLDataType ml_type = utils::GetMLDataType(*output);
+        if (ml_type != nullptr && ml_type->IsTensorType()) {
+          value.bytes = NumElements(get_shape(*output)) * ml_type->AsTensorType()->GetElementType()->Size();
+        }
+        if (value.bytes == 0.0 && recorded != nullptr) {
+          value.bytes = recorded->output_bytes / static_cast<double>(num_outputs);
+        }
+        value.is_graph_output = std::find(graph_outputs.begin(), graph_outputs.end(), output) != graph_outputs.end();
+        memory_deltas[slot] -= value.bytes;
+      }
+
+      for (auto it = node->InputEdgesBegin(); it != node->InputEdgesEnd(); ++it) {
+        if (slot_of_node.count(it->GetNode().Index()) != 0) {
+          ++pending_producers[slot];
+        }
+      }
+    }
+
+    // the values of this graph read by each node, each listed once however many times the node reads it
+    std::vector<InlinedVector<size_t>> node_inputs(num_nodes);
+    for (size_t slot = 0; slot < num_nodes; ++slot) {
+      const auto* node = graph_viewer_.GetNode(topological_order[slot]);
+      auto add_input = [&](const NodeArg* input) {
+        if (!input->Exists()) {
+          return;
+        }
+        auto it = value_of_arg.find(input);
+        if (it == value_of_arg.end() ||
+            std::find(node_inputs[slot].begin(), node_inputs[slot].end(), it->second) != node_inputs[slot].end()) {
+          return;
+        }
+        node_inputs[slot].push_back(it->second);
+        values[it->second].consumers.push_back(slot);
+        ++values[it->second].pending_consumers;
+      };
+      for (const auto* input : node->InputDefs()) {
+        add_input(input);
+      }
+      for (const auto* input : node->ImplicitInputDefs()) {
+        add_input(input);
+      }
+    }
+
+    // a value is released by the last node reading it, so once a single consumer is left the bytes of the value
+    // count towards the memory delta of that consumer.
+    std::vector<bool> scheduled(num_nodes, false);
+    auto credit_last_consumer = [&](const ValueState& value) {
+      if (value.is_graph_output) {
+        return;
+      }
+      for (size_t consumer : value.consumers) {
+        if (!scheduled[consumer]) {
+          memory_deltas[consumer] += value.bytes;
+          return;
+        }
+      }
+    };
+    for (const auto& value : values) {
+      if (value.pending_consumers == 1) {
+        credit_last_consumer(value);
+      }
+    }
+
+    for (size_t slot = num_nodes; slot-- > 0;) {
+      const auto* node = graph_viewer_.GetNode(topological_order[slot]);
+      double longest_successor = 0.0;
+      for (auto it = node->OutputNodesBegin(); it != node->OutputNodesEnd(); ++it) {
+        auto successor = slot_of_node.find(it->Index());
+        if (successor != slot_of_node.end()) {
+          longest_successor = std::max(longest_successor, bottom_levels[successor->second]);
+        }
+      }
+      bottom_levels[slot] = durations[slot] + longest_successor;
+    }
+
+    const bool parallel = context_->IsParallelExecutionEnabled();
+    std::vector<size_t> ready;
+    for (size_t slot = 0; slot < num_nodes; ++slot) {
+      if (pending_producers[slot] == 0) {
+        ready.push_back(slot);
+      }
+    }
+
+    critical_path_order_.reserve(num_nodes);
+    while (!ready.empty()) {
+      size_t best = 0;
+      for (size_t i = 1; i < ready.size(); ++i) {
+        const double delta = memory_deltas[ready[i]];
+        const double best_delta = memory_deltas[ready[best]];
+        const double level = bottom_levels[ready[i]];
+        const double best_level = bottom_levels[ready[best]];
+        bool better;
+        if (parallel) {
+          better = level != best_level ? level > best_level : delta > best_delta;
+        } else {
+          better = delta != best_delta ? delta > best_delta : level > best_level;
+        }
+        // ties go to the node that comes first in the default order
+        if (better || (level == best_level && delta == best_delta && ready[i] < ready[best])) {
+          best = i;
+        }
+      }
+
+      const size_t slot = ready[best];
+      ready.erase(ready.begin() + best);
+      scheduled[slot] = true;
+      const auto* node = graph_viewer_.GetNode(topological_order[slot]);
+      critical_path_order_.push_back(node->Index());
+
+      for (size_t input : node_inputs[slot]) {
+        if (--values[input].pending_consumers == 1) {
+          credit_last_consumer(values[input]);
+        }
+      }
+      for (auto it = node->OutputEdgesBegin(); it != node->OutputEdgesEnd(); ++it) {
+        auto consumer = slot_of_node.find(it->GetNode().Index());
+        if (consumer != slot_of_node.end() && --pending_producers[consumer->second] == 0) {
+          ready.push_back(consumer->second);
+        }
+      }
+    }
+
+    ORT_ENFORCE(critical_path_order_.size() == num_nodes,
+                "Failed to build the critical path order, scheduled ", critical_path_order_.size(), " of ",
+                num_nodes, " nodes");
+  }
+
 #ifndef ORT_ENABLE_STREAM
   void PartitionIntoStreams(const ExecutionProviders& /*execution_providers*/,
                             const PathString& /*partition_config_file*/) {
     if (graph_viewer_.NumberOfNodes() > 0) {
       stream_nodes_.push_back({});
       plan_.node_stream_map_.resize(SafeInt<size_t>(graph_viewer_.MaxNodeIndex()) + 1);
-      for (auto node_index : graph_viewer_.GetNodesInTopologicalOrder()) {
+      const auto& nodes = critical_path_order_.empty() ? graph_viewer_.GetNodesInTopologicalOrder()
+                                                       : critical_path_order_;
+      for (auto node_index : nodes) {
         stream_nodes_[0].push_back(node_index);
         plan_.node_stream_map_[node_index] = 0;
       }
@@ -1987,7 +2393,7 @@ class PlannerImpl {
                             const PathString& partition_config_file) {
     auto partitioner = IGraphPartitioner::CreateGraphPartitioner(logger_, partition_config_file);
     auto status = partitioner->PartitionGraph(graph_viewer_, execution_providers, stream_nodes_,
-                                              context_->GetExecutionOrder());
+                                              NodesInExecutionOrder());
     ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
     plan_.node_stream_map_.resize(SafeInt<size_t>(graph_viewer_.MaxNodeIndex()) + 1);
     for (size_t i = 0; i < stream_nodes_.size(); ++i) {
@@ -2029,7 +2435,7 @@ class PlannerImpl {
     // before yieldOp thus will be executed in RunForward()
     // But the final result is still correct, as long as all the nodes will be executed in either RunForward() or RunBackward()
     // and no dependency conflict during the execution.
-    const std::vector<NodeIndex>& topo_sort = graph_viewer_.GetNodesInTopologicalOrder(context_->GetExecutionOrder());
+    const std::vector<NodeIndex>& topo_sort = NodesInExecutionOrder();
     plan_.node_index_2_toposort_index.reserve(topo_sort.size());
     size_t yieldOp_index_in_toposort = topo_sort.size();
     for (size_t i = 0; i < topo_sort.size(); i++) {
@@ -2224,7 +2630,7 @@ class PlannerImpl {
       }
     }
 
-    for (auto node_index : graph_viewer_.GetNodesInTopologicalOrder(context_->GetExecutionOrder())) {
+    for (auto node_index : NodesInExecutionOrder()) {
       auto* node = graph_viewer_.GetNode(node_index);
       const auto& output_defs = node->OutputDefs();
       for (size_t output_idx_local = 0; output_idx_local < output_defs.size(); ++output_idx_local) {
@@ -2261,7 +2667,7 @@ class PlannerImpl {
     }
 
     InlinedHashSet<OrtValueIndex> producable_values;
-    for (auto node_index : graph_viewer_.GetNodesInTopologicalOrder(context_->GetExecutionOrder())) {
+    for (auto node_index : NodesInExecutionOrder()) {
       auto* node = graph_viewer_.GetNode(node_index);
       // add the output to produce nodes list
       for (auto* output_def : node->OutputDefs()) {
@@ -2320,7 +2726,7 @@ class PlannerImpl {
       }
     };
 
-    auto num_of_nodes = graph_viewer_.GetNodesInTopologicalOrder(context_->GetExecutionOrder()).size();
+    auto num_of_nodes = NodesInExecutionOrder().size();
     plan_.node_execution_order_in_training.reserve(num_of_nodes);
     for (size_t i = 0; i < stream_nodes_.size(); ++i) {
       process_stream(i, -1);
@@ -2378,6 +2784,9 @@ Status PlannerImpl::CreatePlan(
 #endif
     const PathString& partition_config_file) {
   // 1. partition graph into streams
+  if (context_->GetExecutionOrder() == ExecutionOrder::CRITICAL_PATH) {
+    ComputeCriticalPathOrder();
+  }
   PartitionIntoStreams(execution_providers_, parent_node_ ? PathString{} : partition_config_file);
 
   // 2. initialize the plan based on stream partition result
@@ -2396,9 +2805,18 @@ Status PlannerImpl::CreatePlan(
   ORT_RETURN_IF_ERROR(BuildExecutionPlan(execution_providers_));
 #endif
 
+#if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
+  // plan the values that are written to the buffers of the graph outputs bound by the caller
+  ComputeBoundOutputTargets();
+#endif
+
   // determine sharing/reuse among ml-values
   ORT_RETURN_IF_ERROR(ComputeReusePlan());
 
+#if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
+  MarkBoundOutputAliases();
+#endif
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Adjust the allocate and lifetime intervals for all ml-values, based on their allocation kind.
   AdjustInplaceLifeIntervals();
@@ -2425,6 +2843,116 @@ Status PlannerImpl::CreatePlan(
   return Status::OK();
 }
 
+Status LoadNodeExecutionCosts(const PathString& profile_file, NodeExecutionCosts& costs) {
+  std::ifstream if_stream(profile_file);
+  ORT_RETURN_IF_NOT(if_stream.is_open(), "Failed to open profile file: ", ToUTF8String(profile_file));
+
+  // the profile is a json array of trace events, the kernel events of a node are named "<node name>_kernel_time"
+  // and record the total size of the node outputs in args.output_size.
+  json events = json::parse(if_stream, nullptr, /*allow_exceptions*/ false);
+  ORT_RETURN_IF(events.is_discarded() || !events.is_array(), "Failed to parse profile file: ",
+                ToUTF8String(profile_file));
+
+  constexpr std::string_view kernel_time_suffix = "_kernel_time";
+  InlinedHashMap<std::string, size_t> num_samples;
+  costs.clear();
+  for (const auto& event : events) {
+    if (!event.is_object() || !event.contains("cat") || event["cat"] != "Node" ||
+        !event.contains("name") || !event["name"].is_string() ||
+        !event.contains("dur") || !event["dur"].is_number()) {
+      continue;
+    }
+    const auto& event_name = event["name"].get_ref<const std::string&>();
+    if (event_name.size() <= kernel_time_suffix.size() ||
+        event_name.compare(event_name.size() - kernel_time_suffix.size(), kernel_time_suffix.size(),
+                           kernel_time_suffix) != 0) {
+      continue;
+    }
+
+    double output_bytes = 0.0;
+    if (event.contains("args") && event["args"].is_object() && event["args"].contains("output_size") &&
+        event["args"]["output_size"].is_string()) {
+      TryParseStringWithClassicLocale(event["args"]["output_size"].get_ref<const std::string&>(), output_bytes);
+    }
+
+    // keep a running average over all the recorded runs
+    const std::string node_name = event_name.substr(0, event_name.size() - kernel_time_suffix.size());
+    auto& cost = costs[node_name];
+    const double n = static_cast<double>(++num_samples[node_name]);
+    cost.duration_us += (event["dur"].get<double>() - cost.duration_us) / n;
+    cost.output_bytes += (output_bytes - cost.output_bytes) / n;
+  }
+
+  return Status::OK();
+}
+
+Status EstimatePeakActivationBytes(const SequentialExecutionPlan& plan, const GraphViewer& graph_viewer,
+                                   const OrtValueNameIdxMap& ort_value_name_idx_map, size_t& peak_bytes) {
+  auto get_size = [&](const NodeArg& node_arg, const AllocPlanPerValue& value_plan, size_t& size) -> Status {
+    const auto* shape = node_arg.Shape();
+    ORT_RETURN_IF(value_plan.value_type == nullptr || !value_plan.value_type->IsTensorType() || shape == nullptr,
+                  "The size of '", node_arg.Name(), "' is not known as it is not a tensor with a known shape.");
+    const MLDataType element_type = value_plan.value_type->AsTensorType()->GetElementType();
+    ORT_RETURN_IF(utils::IsDataTypeString(element_type), "The size of the string tensor '", node_arg.Name(),
+                  "' is not known.");
+
+    TensorShapeVector dims;
+    dims.reserve(shape->dim_size());
+    for (const auto& dim : shape->dim()) {
+      ORT_RETURN_IF_NOT(utils::HasDimValue(dim), "The size of '", node_arg.Name(),
+                        "' is not known as its shape has symbolic dimensions.");
+      dims.push_back(dim.dim_value());
+    }
+    return Tensor::CalculateTensorStorageSize(element_type, TensorShape(dims), kAllocAlignment, size);
+  };
+
+  const bool release_buffers = plan.NumberOfValidStreams() <= 1;
+  InlinedHashMap<OrtValueIndex, size_t> live_buffers;
+  InlinedHashSet<NodeIndex> planned_nodes;
+  size_t current_bytes = 0;
+  peak_bytes = 0;
+  for (const auto& stream : plan.execution_plan) {
+    for (const auto& step : stream->steps_) {
+      const NodeIndex node_index = step->GetNodeIndex();
+      const Node* node = graph_viewer.GetNode(node_index);
+      // barrier and notification steps refer to the node they precede
+      if (node == nullptr || !planned_nodes.insert(node_index).second) {
+        continue;
+      }
+
+      for (const NodeArg* output : node->OutputDefs()) {
+        if (!output->Exists()) {
+          continue;
+        }
+        int ort_value_idx = -1;
+        ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(output->Name(), ort_value_idx));
+        const auto& value_plan = plan.allocation_plan[ort_value_idx];
+        if (value_plan.alloc_kind != AllocKind::kAllocate && value_plan.alloc_kind != AllocKind::kAllocateOutput) {
+          continue;
+        }
+
+        size_t size = 0;
+        ORT_RETURN_IF_ERROR(get_size(*output, value_plan, size));
+        live_buffers[ort_value_idx] = size;
+        current_bytes += size;
+      }
+      peak_bytes = std::max(peak_bytes, current_bytes);
+
+      if (release_buffers && node_index < plan.node_release_list.size()) {
+        for (size_t release_action_idx : plan.node_release_list[node_index]) {
+          auto it = live_buffers.find(static_cast<OrtValueIndex>(plan.release_actions[release_action_idx].value_index));
+          if (it != live_buffers.end()) {
+            current_bytes -= it->second;
+            live_buffers.erase(it);
+          }
+        }
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
 Status SequentialPlanner::CreatePlan(
     const Node* parent_node,
     const onnxruntime::GraphViewer& graph_viewer,
@@ -2491,7 +3019,7 @@ class DeviceBasedPartitioner : public IGraphPartitioner {
   Status PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
                         const ExecutionProviders& execution_providers,
                         std::vector<InlinedVector<NodeIndex>>& stream_nodes,
-                        ExecutionOrder execution_order) override;
+                        gsl::span<const NodeIndex> nodes_in_execution_order) override;
 
   const char* Type() const override { return "DeviceBasedPartitioner"; }
   size_t Streams() const override { return node_names_by_stream_.size(); }
@@ -2513,9 +3041,8 @@ class DeviceBasedPartitioner : public IGraphPartitioner {
 Status DeviceBasedPartitioner::PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
                                               const ExecutionProviders& execution_providers,
                                               std::vector<InlinedVector<NodeIndex>>& stream_nodes,
-                                              ExecutionOrder execution_order) {
+                                              gsl::span<const NodeIndex> p_graph_nodes) {
   InlinedHashMap<std::string, int> op_type_counter;
-  auto& p_graph_nodes = graph_viewer.GetNodesInTopologicalOrder(execution_order);
 
   if (node_names_by_stream_.empty()) {  // input configure empty, do it from scratch
 
@@ -2633,6 +3160,168 @@ void DeviceBasedPartitioner::SaveConfig() const {
   }
 }
 
+/*
+CostBasedPartitioner builds multiple CPU streams automatically. Its config is in json format:
+------------------------------------------------------
+{
+"type":"CostBasedPartitioner",
+"max_cpu_streams":4,
+"node_costs":{"node_1":120.5,"node_2":3.0}
+}
+------------------------------------------------------
+"max_cpu_streams" (optional) caps the number of CPU streams. It should not exceed the number of inter-op threads.
+"node_costs" (optional) overrides the estimated cost, in microseconds, of individual nodes,
+e.g. with the per-node durations recorded by the profiler. Unnamed nodes are named "<op type>_<node index>".
+Nodes of non-CPU devices are grouped into one stream per device type, same as DeviceBasedPartitioner.
+CPU nodes are list-scheduled in topological order: each node goes to the CPU stream on which it is estimated
+to start the earliest, accounting for a synchronization cost whenever a producer lives on another stream.
+Concurrency between CPU streams only happens with ExecutionMode::ORT_PARALLEL.
+*/
+class CostBasedPartitioner : public IGraphPartitioner {
+ public:
+  CostBasedPartitioner(const logging::Logger& logger,
+                       const PathString& config_file) : IGraphPartitioner(logger, config_file) {
+    Initialize();
+  }
+
+  Status PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
+                        const ExecutionProviders& execution_providers,
+                        std::vector<InlinedVector<NodeIndex>>& stream_nodes,
+                        gsl::span<const NodeIndex> nodes_in_execution_order) override;
+
+  const char* Type() const override { return "CostBasedPartitioner"; }
+  size_t Streams() const override { return num_streams_; }
+
+ private:
+  // cost of handing a value over to another stream (trigger + barrier + thread pool hop)
+  static constexpr double kCrossStreamSyncCostUs = 10.0;
+  static constexpr size_t kDefaultMaxCpuStreams = 4;
+
+  void Initialize();
+  double GetNodeCost(const Node& node, const std::string& node_name) const;
+
+  size_t max_cpu_streams_ = kDefaultMaxCpuStreams;
+  InlinedHashMap<std::string, double> node_costs_;
+  size_t num_streams_ = 0;
+};
+
+void CostBasedPartitioner::Initialize() {
+  if (config_file_.empty()) {
+    return;
+  }
+  std::ifstream if_stream(config_file_);
+  if (!if_stream.is_open()) {
+    return;
+  }
+  try {
+    json json_config = json::parse(if_stream);
+    if (json_config.contains("max_cpu_streams")) {
+      max_cpu_streams_ = std::max<size_t>(1, json_config["max_cpu_streams"].get<size_t>());
+    }
+    if (json_config.contains("node_costs")) {
+      for (const auto& node_cost : json_config["node_costs"].items()) {
+        node_costs_[node_cost.key()] = node_cost.value().get<double>();
+      }
+    }
+  } catch (const std::exception& ex) {
+    LOGS(logger_, WARNING) << "Caught exception when reading CostBasedPartitioner config, using defaults: "
+                           << ex.what();
+    max_cpu_streams_ = kDefaultMaxCpuStreams;
+    node_costs_.clear();
+  }
+  if_stream.close();
+}
+
+double CostBasedPartitioner::GetNodeCost(const Node& node, const std::string& node_name) const {
+  auto it = node_costs_.find(node_name);
+  if (it != node_costs_.end()) {
+    return it->second;
+  }
+  return EstimateNodeCostUs(node, [](const NodeArg& arg) { return arg.Shape(); });
+}
+
+
+Status CostBasedPartitioner::PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
+                                            const ExecutionProviders& execution_providers,
+                                            std::vector<InlinedVector<NodeIndex>>& stream_nodes,
+                                            gsl::span<const NodeIndex> p_graph_nodes) {
+  // Every stream is a sub-sequence of the same topological order, so barriers between streams can't deadlock.
+
+  stream_nodes.clear();
+  InlinedHashMap<OrtDevice::DeviceType, size_t> device_to_stream;
+  InlinedVector<size_t> cpu_streams;
+  // estimated time at which the last node of each stream finishes
+  InlinedVector<double> stream_finish;
+  InlinedHashMap<NodeIndex, std::pair<size_t, double>> node_stream_and_finish;
+  node_stream_and_finish.reserve(p_graph_nodes.size());
+
+  auto add_stream = [&]() {
+    stream_nodes.push_back({});
+    stream_finish.push_back(0.0);
+    return stream_nodes.size() - 1;
+  };
+
+  for (auto node_index : p_graph_nodes) {
+    const auto* node = graph_viewer.GetNode(node_index);
+    const auto node_name = ProfiledNodeName(*node);
+    const double cost = GetNodeCost(*node, node_name);
+
+    // earliest start of the node if it was placed on stream 'stream_idx', SIZE_MAX stands for a new stream
+    auto start_time = [&](size_t stream_idx) {
+      double start = stream_idx == SIZE_MAX ? 0.0 : stream_finish[stream_idx];
+      for (auto it = node->InputNodesBegin(); it != node->InputNodesEnd(); ++it) {
+        auto producer = node_stream_and_finish.find(it->Index());
+        if (producer == node_stream_and_finish.end()) {
+          continue;
+        }
+        const auto& [producer_stream, producer_finish] = producer->second;
+        const double sync_cost = producer_stream == stream_idx ? 0.0 : kCrossStreamSyncCostUs;
+        start = std::max(start, producer_finish + sync_cost);
+      }
+      return start;
+    };
+
+    auto* ep = execution_providers.Get(*node);
+    ORT_RETURN_IF(ep == nullptr, "Failed to find execution provider for node \"", node_name, "\"");
+    const auto device_type = ep->GetOrtDeviceByMemType(OrtMemType::OrtMemTypeDefault).Type();
+
+    size_t stream_idx = SIZE_MAX;
+    if (device_type != OrtDevice::CPU) {
+      auto it = device_to_stream.find(device_type);
+      if (it == device_to_stream.end()) {
+        it = device_to_stream.emplace(device_type, add_stream()).first;
+      }
+      stream_idx = it->second;
+    } else {
+      double best_start = std::numeric_limits<double>::max();
+      for (auto candidate : cpu_streams) {
+        const double start = start_time(candidate);
+        if (start < best_start) {
+          best_start = start;
+          stream_idx = candidate;
+        }
+      }
+      // only open another stream if that lets the node start strictly earlier
+      if (cpu_streams.size() < max_cpu_streams_ && start_time(SIZE_MAX) < best_start) {
+        stream_idx = add_stream();
+        cpu_streams.push_back(stream_idx);
+      }
+    }
+
+    const double finish = start_time(stream_idx) + cost;
+    stream_nodes[stream_idx].push_back(node_index);
+    stream_finish[stream_idx] = finish;
+    node_stream_and_finish[node_index] = {stream_idx, finish};
+  }
+
+  num_streams_ = stream_nodes.size();
+  LOGS(logger_, INFO) << "CostBasedPartitioner placed " << p_graph_nodes.size() << " nodes on " << num_streams_
+                      << " streams (" << cpu_streams.size() << " CPU), estimated makespan "
+                      << (stream_finish.empty() ? 0.0 : *std::max_element(stream_finish.begin(), stream_finish.end()))
+                      << "us";
+  return Status::OK();
+}
+
 std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(const logging::Logger& logger,
                                                                              const PathString& config_file) {
   // use device based partitioner by default
@@ -2647,6 +3336,8 @@ std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(con
           auto type = json_config["type"];
           if (type == "DeviceBasedPartitioner") {
             partitioner_type = IGraphPartitioner::GraphPartitioningStrategy::DeviceBasedPartition;
+          } else if (type == "CostBasedPartitioner") {
+            partitioner_type = IGraphPartitioner::GraphPartitioningStrategy::CostBasedPartition;
           }
         }
       } catch (const std::exception& ex) {
@@ -2658,6 +3349,9 @@ std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(con
   if (partitioner_type == IGraphPartitioner::GraphPartitioningStrategy::DeviceBasedPartition) {
     LOGS(logger, INFO) << "Use DeviceBasedPartition as default";
     return std::make_unique<DeviceBasedPartitioner>(logger, config_file);
+  } else if (partitioner_type == IGraphPartitioner::GraphPartitioningStrategy::CostBasedPartition) {
+    LOGS(logger, INFO) << "Use CostBasedPartition";
+    return std::make_unique<CostBasedPartitioner>(logger, config_file);
   }  // else if other partitioner types ...
   ORT_THROW("Failed to create partitioner");
 }
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "core/common/inlined_containers.h"
 #include "core/common/status.h"
 #include "core/platform/path_lib.h"
 #include "core/framework/alloc_kind.h"
@@ -34,6 +35,26 @@ class IStreamCommandHandleRegistry;
 using KernelCreateInfoMap = std::unordered_map<onnxruntime::NodeIndex, gsl::not_null<const KernelCreateInfo*>>;
 using SubgraphsKernelCreateInfoMaps = std::unordered_map<std::string, KernelCreateInfoMap>;
 
+// Recorded cost of a node, as measured by the profiler.
+struct NodeExecutionCost {
+  double duration_us = 0.0;
+  double output_bytes = 0.0;
+};
+
+// Recorded node costs keyed by node name. Unnamed nodes use "<op type>_<node index>" like the profiler does.
+using NodeExecutionCosts = InlinedHashMap<std::string, NodeExecutionCost>;
+
+// Read the node costs from a profile written by onnxruntime::profiling::Profiler.
+// Durations and output sizes of the kernel events of a node are averaged over all the recorded runs.
+Status LoadNodeExecutionCosts(const PathString& profile_file, NodeExecutionCosts& costs);
+
+// Compute the peak number of bytes of the buffers that the plan allocates for the node outputs, walking the nodes in
+// the planned order and releasing buffers where the plan releases them. With several streams the order between
+// them is unknown, so no buffer is released. Kernel scratch memory and the subgraphs of control flow nodes are not
+// included. Fails if the size of a planned buffer is not known from the shapes of the graph.
+Status EstimatePeakActivationBytes(const SequentialExecutionPlan& plan, const GraphViewer& graph_viewer,
+                                   const OrtValueNameIdxMap& ort_value_name_idx_map, size_t& peak_bytes);
+
 // ISequentialPlannerContext abstracts how the planner accesses information (such as inferred shape)
 // to do the planning.
 class ISequentialPlannerContext {
@@ -46,15 +67,21 @@ class ISequentialPlannerContext {
   virtual ExecutionOrder GetExecutionOrder() const { return ExecutionOrder::DEFAULT; }
 
   virtual bool GetEnableMemoryReuse() const { return true; }
+
+  // Recorded node costs used by ExecutionOrder::CRITICAL_PATH. nullptr if there are none, in which case
+  // the costs are estimated from the shapes.
+  virtual const NodeExecutionCosts* GetNodeExecutionCosts() const { return nullptr; }
   virtual ~ISequentialPlannerContext() = default;
 };
 
 class SequentialPlannerContext : public ISequentialPlannerContext {
  public:
-  SequentialPlannerContext(ExecutionMode execution_mode, ExecutionOrder execution_order, bool enable_memory_reuse)
+  SequentialPlannerContext(ExecutionMode execution_mode, ExecutionOrder execution_order, bool enable_memory_reuse,
+                           const NodeExecutionCosts* node_execution_costs = nullptr)
       : execution_mode_(execution_mode),
         execution_order_(execution_order),
-        enable_memory_reuse_(enable_memory_reuse) {
+        enable_memory_reuse_(enable_memory_reuse),
+        node_execution_costs_(node_execution_costs) {
   }
 
   const ONNX_NAMESPACE::TensorShapeProto* GetShape(const onnxruntime::NodeArg& arg) const override {
@@ -67,10 +94,13 @@ class SequentialPlannerContext : public ISequentialPlannerContext {
 
   bool GetEnableMemoryReuse() const override { return enable_memory_reuse_; }
 
+  const NodeExecutionCosts* GetNodeExecutionCosts() const override { return node_execution_costs_; }
+
  private:
   ExecutionMode execution_mode_ = ExecutionMode::ORT_SEQUENTIAL;
   ExecutionOrder execution_order_ = ExecutionOrder::DEFAULT;
   bool enable_memory_reuse_ = true;
+  const NodeExecutionCosts* node_execution_costs_ = nullptr;
 };
 
 #ifdef ORT_ENABLE_STREAM
@@ -82,9 +112,11 @@ class IGraphPartitioner {
   // DeviceBasedPartitioner is the default, who partitions a graph based off device information.
   // i.e., given a graph which has CPU EP nodes, Cuda EP nodes and TRT EP nodes,
   // it will be partitioned as two sequences, one is for CPU EP nodes, another is for TRT and Cuda nodes.
-  // We will add more optimized partitioner later.
+  // CostBasedPartitioner additionally spreads CPU EP nodes over several sequences, using per-node cost
+  // estimates to shorten the critical path, so independent branches can run concurrently with ORT_PARALLEL.
   enum GraphPartitioningStrategy {
     DeviceBasedPartition = 0,
+    CostBasedPartition,
     Unknown,
   };
   virtual ~IGraphPartitioner() = default;
@@ -92,10 +124,12 @@ class IGraphPartitioner {
   // perform partition based on the user input when provided.
   static std::unique_ptr<IGraphPartitioner> CreateGraphPartitioner(const logging::Logger& logger,
                                                                    const PathString& config_file);
+  // nodes_in_execution_order lists all the nodes of graph_viewer in the order they are planned to execute,
+  // every stream is expected to keep its nodes in that order.
   virtual Status PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
                                 const ExecutionProviders& execution_providers,
                                 std::vector<InlinedVector<NodeIndex>>& stream_nodes,
-                                ExecutionOrder execution_order) = 0;
+                                gsl::span<const NodeIndex> nodes_in_execution_order) = 0;
   virtual const char* Type() const = 0;
   // return total number of streams
   virtual size_t Streams() const = 0;
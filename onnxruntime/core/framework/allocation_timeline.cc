@@ -0,0 +1,167 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/allocation_timeline.h"
+
+#include <ostream>
+
+#include "core/common/logging/logging.h"
+
+namespace onnxruntime {
+
+namespace {
+// Attribution of the allocations of the calling thread.
+thread_local std::string current_node_name;
+thread_local int current_ort_value_index = -1;
+
+// Writes s as a JSON string. Node names come from the model so they may contain any character.
+void WriteJsonString(std::ostream& out, const std::string& s) {
+  out << '"';
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      out << ' ';
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+double Fragmentation(const AllocationTimeline::ArenaState& state) {
+  // 0 if all the free memory is in one chunk, close to 1 if it is scattered across small chunks.
+  return state.total_free_bytes == 0
+             ? 0.0
+             : 1.0 - static_cast<double>(state.largest_free_chunk_bytes) / static_cast<double>(state.total_free_bytes);
+}
+}  // namespace
+
+AllocationTimeline::ScopedAttribution::ScopedAttribution(std::string node_name)
+    : previous_node_name_(std::move(node_name)),
+      previous_ort_value_index_(current_ort_value_index),
+      sets_node_name_(true) {
+  std::swap(previous_node_name_, current_node_name);
+  current_ort_value_index = -1;
+}
+
+AllocationTimeline::ScopedAttribution::ScopedAttribution(int ort_value_index)
+    : previous_ort_value_index_(current_ort_value_index),
+      sets_node_name_(false) {
+  current_ort_value_index = ort_value_index;
+}
+
+AllocationTimeline::ScopedAttribution::~ScopedAttribution() {
+  if (sets_node_name_) {
+    current_node_name = std::move(previous_node_name_);
+  }
+  current_ort_value_index = previous_ort_value_index_;
+}
+
+AllocationTimeline::AllocationTimeline(const std::filesystem::path& file_path)
+    : file_path_(file_path),
+      start_time_(std::chrono::high_resolution_clock::now()) {
+  file_.open(file_path_, std::ios::out | std::ios::trunc);
+  ORT_ENFORCE(file_.good(), "Failed to open the allocation timeline file ", file_path_.string());
+  file_ << "[\n";
+}
+
+AllocationTimeline::~AllocationTimeline() {
+  ORT_IGNORE_RETURN_VALUE(Flush());
+  std::lock_guard<std::mutex> lock(mutex_);
+  file_ << "\n]\n";
+  file_.close();
+}
+
+long long AllocationTimeline::Now() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() -
+                                                               start_time_)
+      .count();
+}
+
+void AllocationTimeline::RecordAllocation(const std::string& arena_name, const void* ptr, size_t size,
+                                          int64_t region_id, size_t offset, const void* stream,
+                                          ArenaState arena_state) {
+  Allocation allocation{current_node_name, current_ort_value_index, size, region_id, offset, stream};
+  Event event{Now(), logging::GetThreadId(), false, ptr, allocation, arena_name, std::move(arena_state)};
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  live_allocations_.insert_or_assign(ptr, std::move(allocation));
+  events_.push_back(std::move(event));
+}
+
+void AllocationTimeline::RecordFree(const std::string& arena_name, const void* ptr, ArenaState arena_state) {
+  Event event{Now(), logging::GetThreadId(), true, ptr, {}, arena_name, std::move(arena_state)};
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Frees are attributed to the allocation they release, which may have been recorded in an earlier run.
+  if (auto it = live_allocations_.find(ptr); it != live_allocations_.end()) {
+    event.allocation = std::move(it->second);
+    live_allocations_.erase(it);
+  }
+  events_.push_back(std::move(event));
+}
+
+void AllocationTimeline::WriteEvent(const Event& event) {
+  const auto pid = logging::GetProcessId();
+  const auto& allocation = event.allocation;
+  const std::string& name = allocation.node_name.empty() ? event.arena_name : allocation.node_name;
+
+  // The allocation is a span from the allocation to the free, matched by its address.
+  file_ << (has_written_events_ ? ",\n" : "");
+  file_ << R"({"cat" : "Allocation",)";
+  file_ << "\"pid\" :" << pid << ",";
+  file_ << "\"tid\" :" << event.tid << ",";
+  file_ << "\"ts\" :" << event.ts << ",";
+  file_ << "\"ph\" : \"" << (event.is_free ? "e" : "b") << "\",";
+  file_ << "\"id\" : \"" << event.ptr << "\",";
+  file_ << "\"name\" :";
+  WriteJsonString(file_, name);
+  file_ << ",\"args\" : {\"arena\" : ";
+  WriteJsonString(file_, event.arena_name);
+  if (!event.is_free) {
+    file_ << ",\"node\" : ";
+    WriteJsonString(file_, allocation.node_name);
+    file_ << ",\"ort_value_index\" : " << allocation.ort_value_index;
+    file_ << ",\"size\" : " << allocation.size;
+    file_ << ",\"region\" : " << allocation.region_id;
+    file_ << ",\"offset\" : " << allocation.offset;
+    file_ << ",\"stream\" : \"" << allocation.stream << "\"";
+  }
+  file_ << "}}";
+  has_written_events_ = true;
+
+  // The state of the arena after the event, as counters of the arena.
+  const auto& state = event.arena_state;
+  file_ << ",\n{\"cat\" : \"Arena\",\"pid\" :" << pid << ",\"ts\" :" << event.ts << ",\"ph\" : \"C\",\"name\" :";
+  WriteJsonString(file_, event.arena_name + " memory");
+  file_ << ",\"args\" : {\"in_use\" : " << state.bytes_in_use << ",\"total_free\" : " << state.total_free_bytes
+        << ",\"largest_free_chunk\" : " << state.largest_free_chunk_bytes << "}}";
+
+  file_ << ",\n{\"cat\" : \"Arena\",\"pid\" :" << pid << ",\"ts\" :" << event.ts << ",\"ph\" : \"C\",\"name\" :";
+  WriteJsonString(file_, event.arena_name + " fragmentation");
+  file_ << ",\"args\" : {\"fragmentation\" : " << Fragmentation(state) << "}}";
+
+  file_ << ",\n{\"cat\" : \"Arena\",\"pid\" :" << pid << ",\"ts\" :" << event.ts << ",\"ph\" : \"C\",\"name\" :";
+  WriteJsonString(file_, event.arena_name + " free chunks per bin");
+  file_ << ",\"args\" : {";
+  bool is_first_arg = true;
+  for (const auto& [bin_size, num_free_chunks] : state.free_chunks_per_bin) {
+    file_ << (is_first_arg ? "" : ",") << "\"" << bin_size << "\" : " << num_free_chunks;
+    is_first_arg = false;
+  }
+  file_ << "}}";
+}
+
+Status AllocationTimeline::Flush() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& event : events_) {
+    WriteEvent(event);
+  }
+  events_.clear();
+  file_.flush();
+  ORT_RETURN_IF(!file_.good(), "Failed to write the allocation timeline file ", file_path_.string());
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,106 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+
+namespace onnxruntime {
+
+/**
+ * Records the allocations and frees of the arenas of a session, to find out why an arena grows.
+ *
+ * Each allocation is recorded with the node and the OrtValue it is attributed to, its size, the region of the arena
+ * and the offset of the chunk in the region, and its stream. Each event also records the fragmentation of the arena
+ * after it: the total free bytes, the largest free chunk and the number of free chunks in each bin.
+ *
+ * The events are written in the Chrome trace format of the Profiler, so both traces can be loaded in the same
+ * viewer. An allocation is an async span from the allocation to the free, and the arena state is written as
+ * counters. Flush() appends the events recorded so far to the file, and the destructor completes the file.
+ *
+ * This class is thread-safe.
+ */
+class AllocationTimeline {
+ public:
+  // State of an arena after an event.
+  struct ArenaState {
+    size_t bytes_in_use = 0;
+    size_t total_free_bytes = 0;
+    size_t largest_free_chunk_bytes = 0;
+    // Bin size and number of free chunks of the bins that have free chunks.
+    InlinedVector<std::pair<size_t, size_t>> free_chunks_per_bin;
+  };
+
+  // Attributes the allocations of the calling thread to a node, or to an output of the node, while in scope.
+  class ScopedAttribution {
+   public:
+    explicit ScopedAttribution(std::string node_name);
+    explicit ScopedAttribution(int ort_value_index);
+    ~ScopedAttribution();
+
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ScopedAttribution);
+
+   private:
+    std::string previous_node_name_;
+    int previous_ort_value_index_;
+    bool sets_node_name_;
+  };
+
+  explicit AllocationTimeline(const std::filesystem::path& file_path);
+  ~AllocationTimeline();
+
+  const std::filesystem::path& GetFilePath() const noexcept { return file_path_; }
+
+  // region_id and offset locate the chunk in the arena; stream is the stream the chunk is allocated on, if any.
+  void RecordAllocation(const std::string& arena_name, const void* ptr, size_t size, int64_t region_id,
+                        size_t offset, const void* stream, ArenaState arena_state);
+  void RecordFree(const std::string& arena_name, const void* ptr, ArenaState arena_state);
+
+  // Appends the events recorded since the last call to the file.
+  Status Flush();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(AllocationTimeline);
+
+ private:
+  struct Allocation {
+    std::string node_name;
+    int ort_value_index = -1;
+    size_t size = 0;
+    int64_t region_id = -1;
+    size_t offset = 0;
+    const void* stream = nullptr;
+  };
+
+  struct Event {
+    long long ts;
+    unsigned int tid;
+    bool is_free;
+    const void* ptr;
+    Allocation allocation;
+    std::string arena_name;
+    ArenaState arena_state;
+  };
+
+  long long Now() const;
+  void WriteEvent(const Event& event);
+
+  const std::filesystem::path file_path_;
+  const std::chrono::high_resolution_clock::time_point start_time_;
+
+  std::mutex mutex_;
+  std::ofstream file_;                                       // GUARDED_BY(mutex_)
+  bool has_written_events_ = false;                          // GUARDED_BY(mutex_)
+  InlinedHashMap<const void*, Allocation> live_allocations_;  // GUARDED_BY(mutex_)
+  std::vector<Event> events_;                                // GUARDED_BY(mutex_)
+};
+
+}  // namespace onnxruntime
@@ -57,6 +57,26 @@ Status OrtArenaCfg::FromKeyValuePairs(const OrtKeyValuePairs& kvps, OrtArenaCfg&
     ORT_RETURN_IF_ERROR(from_string(it->first, it->second, cfg.max_mem));
   }
 
+  if (auto it = kvps_entries.find(ConfigKeyNames::ThreadLocalCacheMaxBytes); it != kvps_entries.end()) {
+    ORT_RETURN_IF_ERROR(from_string(it->first, it->second, cfg.thread_local_cache_max_bytes));
+  }
+
+  if (auto it = kvps_entries.find(ConfigKeyNames::HugePageMode); it != kvps_entries.end()) {
+    ORT_RETURN_IF_ERROR(from_string(it->first, it->second, cfg.huge_page_mode));
+  }
+
+  if (auto it = kvps_entries.find(ConfigKeyNames::TrimWatermarkBytes); it != kvps_entries.end()) {
+    ORT_RETURN_IF_ERROR(from_string(it->first, it->second, cfg.trim_watermark_bytes));
+  }
+
+  if (auto it = kvps_entries.find(ConfigKeyNames::TrimIdleIntervalMs); it != kvps_entries.end()) {
+    ORT_RETURN_IF_ERROR(from_string(it->first, it->second, cfg.trim_idle_interval_ms));
+  }
+
+  if (auto it = kvps_entries.find(ConfigKeyNames::TrimRunInterval); it != kvps_entries.end()) {
+    ORT_RETURN_IF_ERROR(from_string(it->first, it->second, cfg.trim_run_interval));
+  }
+
   if (!cfg.IsValid()) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
                            "Invalid arena configuration. Please check the values provided.");
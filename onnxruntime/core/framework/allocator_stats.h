@@ -22,6 +22,11 @@ struct AllocatorStats {
                                   // is known. Certain allocator may return 0 to indicate the limit is
                                   // unknown.
   int64_t bytes_limit;
+  int64_t num_cache_hits;    // Allocations served by a thread-local cache of the arena without taking its lock.
+  int64_t num_cache_misses;  // Cacheable allocations that had to go to the arena.
+  int64_t huge_page_bytes;          // Bytes currently mapped with huge pages.
+  int64_t num_huge_page_fallbacks;  // Allocations of at least a huge page that got normal pages.
+  int64_t total_released_bytes;     // Bytes of arena regions returned to the device allocator by shrinkage and trimming.
 
   AllocatorStats() { Clear(); }
 
@@ -35,6 +40,11 @@ struct AllocatorStats {
     this->max_alloc_size = 0;
     this->bytes_limit = 0;
     this->total_allocated_bytes = 0;
+    this->num_cache_hits = 0;
+    this->num_cache_misses = 0;
+    this->huge_page_bytes = 0;
+    this->num_huge_page_fallbacks = 0;
+    this->total_released_bytes = 0;
   }
 
   std::string DebugString() const {
@@ -47,7 +57,12 @@ struct AllocatorStats {
        << "NumReserves:              " << this->num_reserves << "\n"
        << "NumArenaExtensions:       " << this->num_arena_extensions << "\n"
        << "NumArenaShrinkages:       " << this->num_arena_shrinkages << "\n"
-       << "MaxAllocSize:             " << this->max_alloc_size << "\n";
+       << "MaxAllocSize:             " << this->max_alloc_size << "\n"
+       << "NumCacheHits:             " << this->num_cache_hits << "\n"
+       << "NumCacheMisses:           " << this->num_cache_misses << "\n"
+       << "HugePageBytes:            " << this->huge_page_bytes << "\n"
+       << "NumHugePageFallbacks:     " << this->num_huge_page_fallbacks << "\n"
+       << "TotalReleased:            " << this->total_released_bytes << "\n";
     return ss.str();
   }
 };
@@ -3,6 +3,7 @@
 
 #include "core/framework/allocator_utils.h"
 
+#include <algorithm>
 #include <limits>
 #include <mutex>
 #include <sstream>
@@ -13,6 +14,7 @@
 #include "core/common/logging/logging.h"
 #include "core/common/narrow.h"
 #include "core/framework/bfc_arena.h"
+#include "core/framework/huge_page_allocator.h"
 
 namespace onnxruntime {
 using namespace common;
@@ -20,6 +22,14 @@ using namespace common;
 AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
   auto device_allocator = info.device_alloc_factory(info.device_id);
 
+  const int huge_page_mode = info.arena_cfg.huge_page_mode == -1 ? 0 : info.arena_cfg.huge_page_mode;
+  const bool use_huge_pages = huge_page_mode != static_cast<int>(HugePageMode::kDisabled) &&
+                              device_allocator->Info().device.Type() == OrtDevice::CPU;
+  if (use_huge_pages) {
+    device_allocator = std::make_unique<HugePageAllocator>(std::move(device_allocator),
+                                                           static_cast<HugePageMode>(huge_page_mode));
+  }
+
   if (info.use_arena) {
     size_t max_mem = info.arena_cfg.max_mem == 0 ? BFCArena::DEFAULT_MAX_MEM : info.arena_cfg.max_mem;
     int initial_chunk_size_bytes = info.arena_cfg.initial_chunk_size_bytes == -1
@@ -34,6 +44,24 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
     int64_t max_power_of_two_extend_bytes = info.arena_cfg.max_power_of_two_extend_bytes == -1
                                                 ? BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES
                                                 : info.arena_cfg.max_power_of_two_extend_bytes;
+    if (use_huge_pages) {
+      // Regions smaller than a huge page would get normal pages, and regions of a multiple of the huge page size
+      // would take one more huge page for the padding of the buffers. Doubling a region sized this way keeps it
+      // within its huge pages too.
+      initial_chunk_size_bytes = narrow<int>(
+          HugePageAllocator::RegionSizeForHugePages(narrow<size_t>(initial_chunk_size_bytes)));
+      initial_growth_chunk_size_bytes = narrow<int>(
+          HugePageAllocator::RegionSizeForHugePages(narrow<size_t>(initial_growth_chunk_size_bytes)));
+      max_power_of_two_extend_bytes = narrow<int64_t>(
+          HugePageAllocator::RegionSizeForHugePages(narrow<size_t>(max_power_of_two_extend_bytes)));
+    }
+    size_t thread_local_cache_max_bytes = info.arena_cfg.thread_local_cache_max_bytes == -1
+                                              ? BFCArena::DEFAULT_THREAD_LOCAL_CACHE_MAX_BYTES
+                                              : narrow<size_t>(info.arena_cfg.thread_local_cache_max_bytes);
+    BFCArenaTrimPolicy trim_policy;
+    trim_policy.watermark_bytes = info.arena_cfg.trim_watermark_bytes;
+    trim_policy.idle_interval_ms = std::max<int64_t>(info.arena_cfg.trim_idle_interval_ms, 0);
+    trim_policy.run_interval = std::max<int64_t>(info.arena_cfg.trim_run_interval, 0);
     ArenaExtendStrategy arena_extend_str;
     switch (info.arena_cfg.arena_extend_strategy) {
       case static_cast<int>(ArenaExtendStrategy::kSameAsRequested):
@@ -57,7 +85,10 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
                                              arena_extend_str,
                                              initial_chunk_size_bytes,
                                              max_dead_bytes_per_chunk,
-                                             initial_growth_chunk_size_bytes));
+                                             initial_growth_chunk_size_bytes,
+                                             max_power_of_two_extend_bytes,
+                                             thread_local_cache_max_bytes,
+                                             trim_policy));
 #else
       ORT_THROW("StreamAwareArena should be transparent to minimal build.");
 #endif
@@ -69,7 +100,9 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
                                      initial_chunk_size_bytes,
                                      max_dead_bytes_per_chunk,
                                      initial_growth_chunk_size_bytes,
-                                     max_power_of_two_extend_bytes));
+                                     max_power_of_two_extend_bytes,
+                                     thread_local_cache_max_bytes,
+                                     trim_policy));
     }
   } else {
     return device_allocator;
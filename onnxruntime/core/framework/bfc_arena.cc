@@ -3,16 +3,76 @@
 
 #include "core/framework/allocator.h"
 #include "core/framework/bfc_arena.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <type_traits>
 
 namespace onnxruntime {
+
+namespace {
+// 4 classes up to 1KB, then 4 classes in each power-of-two range up to 256KB.
+constexpr int kNumThreadCacheClasses = 4 + 4 * 8;
+
+std::atomic<uint64_t> next_arena_id{1};
+}  // namespace
+
+struct BFCArenaThreadCache {
+  struct CachedChunk {
+    void* ptr;
+    size_t size;
+  };
+
+  explicit BFCArenaThreadCache(BFCArena* a) : arena(a) {}
+
+  std::mutex mutex;
+  BFCArena* arena;                                                       // nullptr once the arena is destroyed
+  std::vector<void*> queued_frees;                                       // GUARDED_BY(mutex)
+  std::array<std::vector<CachedChunk>, kNumThreadCacheClasses> free_lists;  // GUARDED_BY(mutex)
+  size_t cached_bytes = 0;                                               // GUARDED_BY(mutex)
+  std::atomic<int64_t> num_hits{0};
+  std::atomic<int64_t> num_misses{0};
+};
+
+// The caches of the current thread, one per arena. Returns their chunks to the arenas when the thread exits.
+struct BFCArenaThreadCacheList {
+  std::vector<std::pair<uint64_t, std::shared_ptr<BFCArenaThreadCache>>> caches;
+
+  ~BFCArenaThreadCacheList() {
+    for (auto& entry : caches) {
+      BFCArenaThreadCache& cache = *entry.second;
+      std::lock_guard<std::mutex> cache_lock(cache.mutex);
+      BFCArena* arena = cache.arena;
+      if (arena == nullptr) {
+        continue;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(arena->lock_);
+        arena->FlushThreadCacheLocked(cache);
+        arena->stats_.num_cache_hits += cache.num_hits.load(std::memory_order_relaxed);
+        arena->stats_.num_cache_misses += cache.num_misses.load(std::memory_order_relaxed);
+      }
+
+      std::lock_guard<std::mutex> caches_lock(arena->thread_caches_mutex_);
+      auto& arena_caches = arena->thread_caches_;
+      arena_caches.erase(std::remove(arena_caches.begin(), arena_caches.end(), entry.second), arena_caches.end());
+    }
+  }
+};
+
+namespace {
+thread_local BFCArenaThreadCacheList thread_cache_list;
+}  // namespace
 BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
                    size_t total_memory,
                    ArenaExtendStrategy arena_extend_strategy,
                    int initial_chunk_size_bytes,
                    int max_dead_bytes_per_chunk,
                    int initial_growth_chunk_size_bytes,
-                   int64_t max_power_of_two_extend_bytes)
+                   int64_t max_power_of_two_extend_bytes,
+                   size_t thread_local_cache_max_bytes,
+                   const BFCArenaTrimPolicy& trim_policy)
     : IAllocator(OrtMemoryInfo(resource_allocator->Info().name,
                                OrtAllocatorType::OrtArenaAllocator,
                                resource_allocator->Info().device,
@@ -24,14 +84,21 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       initial_chunk_size_bytes_(initial_chunk_size_bytes),
       max_dead_bytes_per_chunk_(max_dead_bytes_per_chunk),
       initial_growth_chunk_size_bytes_(initial_growth_chunk_size_bytes),
-      max_power_of_two_extend_bytes_(max_power_of_two_extend_bytes) {
+      max_power_of_two_extend_bytes_(max_power_of_two_extend_bytes),
+      thread_local_cache_max_bytes_(thread_local_cache_max_bytes),
+      arena_id_(next_arena_id.fetch_add(1, std::memory_order_relaxed)),
+      trim_policy_(trim_policy) {
   LOGS_DEFAULT(INFO) << "Creating BFCArena for " << device_allocator_->Info().name
                      << " with following configs: initial_chunk_size_bytes: " << initial_chunk_size_bytes_
                      << " max_dead_bytes_per_chunk: " << max_dead_bytes_per_chunk_
                      << " initial_growth_chunk_size_bytes: " << initial_growth_chunk_size_bytes_
                      << " max_power_of_two_extend_bytes: " << max_power_of_two_extend_bytes_
                      << " memory limit: " << total_memory
-                     << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy);
+                     << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy)
+                     << " thread_local_cache_max_bytes: " << thread_local_cache_max_bytes_
+                     << " trim_watermark_bytes: " << trim_policy_.watermark_bytes
+                     << " trim_idle_interval_ms: " << trim_policy_.idle_interval_ms
+                     << " trim_run_interval: " << trim_policy_.run_interval;
 
   // static_cast<std::underlying_type_t<ArenaExtendStrategy>>(arena_extend_strategy); doesn't work on this compiler
 
@@ -74,9 +141,38 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       ORT_ENFORCE(BinForSize(bin_size * 2) != BinFromIndex(b));
     }
   }
+
+  if (trim_policy_.watermark_bytes >= 0 && trim_policy_.idle_interval_ms > 0) {
+    trim_thread_ = std::thread(&BFCArena::TrimWhenIdle, this);
+  }
 }
 
 BFCArena::~BFCArena() {
+  if (trim_thread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> trim_lock(trim_thread_mutex_);
+      stop_trim_thread_ = true;
+    }
+    trim_thread_cv_.notify_one();
+    trim_thread_.join();
+  }
+
+  // Detach the caches of the threads still alive. Their chunks are released with the regions.
+  std::vector<std::shared_ptr<BFCArenaThreadCache>> thread_caches;
+  {
+    std::lock_guard<std::mutex> caches_lock(thread_caches_mutex_);
+    thread_caches.swap(thread_caches_);
+  }
+  for (auto& cache : thread_caches) {
+    std::lock_guard<std::mutex> cache_lock(cache->mutex);
+    cache->arena = nullptr;
+    cache->queued_frees.clear();
+    for (auto& free_list : cache->free_lists) {
+      free_list.clear();
+    }
+    cache->cached_bytes = 0;
+  }
+
   for (const auto& region : region_manager_.regions()) {
     device_allocator_->Free(region.ptr());
   }
@@ -320,13 +416,36 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   // so all memory addresses are nicely byte aligned.
   size_t rounded_bytes = RoundedBytes(num_bytes);
 
+  if (timeline_enabled_.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(lock_);
+    void* p = AllocateRawLocked(num_bytes, rounded_bytes, dump_log_on_failure, stream, nullptr);
+    if (timeline_ != nullptr) {
+      RecordAllocationLocked(p);
+    }
+    return p;
+  }
+
+  if (thread_local_cache_max_bytes_ > 0 && stream == nullptr && rounded_bytes <= kMaxThreadCachedChunkSize) {
+    return AllocateFromThreadCache(num_bytes, rounded_bytes, dump_log_on_failure);
+  }
+
+  std::lock_guard<std::mutex> lock(lock_);
+  return AllocateRawLocked(num_bytes, rounded_bytes, dump_log_on_failure, stream, nullptr);
+}
+
+void* BFCArena::AllocateRawLocked(size_t num_bytes, size_t rounded_bytes, bool dump_log_on_failure,
+                                  Stream* stream, BFCArenaThreadCache* held_cache) {
   // The BFC allocator tries to find the best fit first.
   BinNum bin_num = BinNumForSize(rounded_bytes);
 
-  std::lock_guard<std::mutex> lock(lock_);
   // search for a valid chunk
   auto* chunk = FindChunkPtr(bin_num, rounded_bytes, num_bytes, stream);
 
+  // Chunks freed by other threads may still be queued in their caches.
+  if (chunk == nullptr && ReclaimThreadCachesLocked(held_cache, /*flush*/ false)) {
+    chunk = FindChunkPtr(bin_num, rounded_bytes, num_bytes, stream);
+  }
+
   if (chunk != nullptr) {
     return chunk->ptr;
   }
@@ -336,6 +455,15 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 
   // Try to extend
   auto status = Extend(rounded_bytes);
+  if (!status.IsOK() && ReclaimThreadCachesLocked(held_cache, /*flush*/ true)) {
+    // The chunks held by the thread caches may have been coalesced into a chunk that fits.
+    chunk = FindChunkPtr(bin_num, rounded_bytes, num_bytes, stream);
+    if (chunk != nullptr) {
+      return chunk->ptr;
+    }
+    status = Extend(rounded_bytes);
+  }
+
   if (status.IsOK()) {
     chunk = FindChunkPtr(bin_num, rounded_bytes, num_bytes, stream);
     if (chunk != nullptr) {
@@ -360,8 +488,193 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 }
 
 void BFCArena::GetStats(AllocatorStats* stats) {
+  AllocatorStats device_stats;
+  device_allocator_->GetStats(&device_stats);
+
   std::lock_guard<std::mutex> lock(lock_);
   *stats = stats_;
+  stats->huge_page_bytes = device_stats.huge_page_bytes;
+  stats->num_huge_page_fallbacks = device_stats.num_huge_page_fallbacks;
+
+  std::lock_guard<std::mutex> caches_lock(thread_caches_mutex_);
+  for (const auto& cache : thread_caches_) {
+    stats->num_cache_hits += cache->num_hits.load(std::memory_order_relaxed);
+    stats->num_cache_misses += cache->num_misses.load(std::memory_order_relaxed);
+  }
+  // Cache hits do not go through the arena, and the chunks in the free lists of the caches are not in use.
+  stats->num_allocs += stats->num_cache_hits;
+  stats->bytes_in_use -= thread_cached_bytes_.load(std::memory_order_relaxed);
+}
+
+int BFCArena::ThreadCacheClassForAllocation(size_t rounded_bytes, size_t& class_size) {
+  if (rounded_bytes <= 4 * kMinAllocationSize) {
+    const int c = static_cast<int>((rounded_bytes - 1) / kMinAllocationSize);
+    class_size = (c + 1) * kMinAllocationSize;
+    return c;
+  }
+
+  // rounded_bytes is in (2^e, 2^(e+1)], which is split in 4 classes
+  const int e = Log2FloorNonZero(rounded_bytes - 1);
+  const size_t step = size_t{1} << (e - 2);
+  const size_t k = (rounded_bytes - (size_t{1} << e) + step - 1) / step;  // 1..4
+  class_size = (size_t{1} << e) + k * step;
+  return 4 + (e - 10) * 4 + static_cast<int>(k) - 1;
+}
+
+int BFCArena::ThreadCacheClassForChunk(size_t chunk_size) {
+  if (chunk_size <= 4 * kMinAllocationSize) {
+    return static_cast<int>(chunk_size / kMinAllocationSize) - 1;
+  }
+
+  const int e = Log2FloorNonZero(chunk_size - 1);
+  const size_t step = size_t{1} << (e - 2);
+  const size_t k = (chunk_size - (size_t{1} << e)) / step;  // 0..3
+  return 4 + (e - 10) * 4 + static_cast<int>(k) - 1;
+}
+
+BFCArenaThreadCache& BFCArena::GetThreadCache() {
+  auto& caches = thread_cache_list.caches;
+  for (auto& entry : caches) {
+    if (entry.first == arena_id_) {
+      return *entry.second;
+    }
+  }
+
+  // Forget the caches of arenas that were destroyed.
+  caches.erase(std::remove_if(caches.begin(), caches.end(),
+                              [](const auto& entry) {
+                                std::lock_guard<std::mutex> cache_lock(entry.second->mutex);
+                                return entry.second->arena == nullptr;
+                              }),
+               caches.end());
+
+  auto cache = std::make_shared<BFCArenaThreadCache>(this);
+  {
+    std::lock_guard<std::mutex> caches_lock(thread_caches_mutex_);
+    thread_caches_.push_back(cache);
+  }
+  caches.emplace_back(arena_id_, cache);
+  return *cache;
+}
+
+void* BFCArena::AllocateFromThreadCache(size_t num_bytes, size_t rounded_bytes, bool dump_log_on_failure) {
+  size_t class_size = 0;
+  const int c = ThreadCacheClassForAllocation(rounded_bytes, class_size);
+
+  BFCArenaThreadCache& cache = GetThreadCache();
+  std::lock_guard<std::mutex> cache_lock(cache.mutex);
+  auto& free_list = cache.free_lists[c];
+  auto pop_cached_chunk = [&]() {
+    const auto cached_chunk = free_list.back();
+    free_list.pop_back();
+    cache.cached_bytes -= cached_chunk.size;
+    thread_cached_bytes_.fetch_sub(static_cast<int64_t>(cached_chunk.size), std::memory_order_relaxed);
+    return cached_chunk.ptr;
+  };
+
+  void* p = nullptr;
+  if (!free_list.empty()) {
+    p = pop_cached_chunk();
+    cache.num_hits.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    cache.num_misses.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(lock_);
+    DrainThreadCacheLocked(cache);
+    if (!free_list.empty()) {
+      p = pop_cached_chunk();
+      ++stats_.num_allocs;
+    } else {
+      // Allocate the whole class so that the chunk can serve any request of the class once it is cached.
+      p = AllocateRawLocked(num_bytes, class_size, dump_log_on_failure, nullptr, &cache);
+      ChunkFromHandle(region_manager_.get_handle(p))->thread_cached = true;
+    }
+  }
+  return p;
+}
+
+void BFCArena::FreeToThreadCache(void* p) {
+  BFCArenaThreadCache& cache = GetThreadCache();
+  std::lock_guard<std::mutex> cache_lock(cache.mutex);
+  cache.queued_frees.push_back(p);
+  if (cache.queued_frees.size() >= kThreadCacheFreeBatchSize) {
+    std::lock_guard<std::mutex> lock(lock_);
+    DrainThreadCacheLocked(cache);
+  }
+}
+
+void BFCArena::FreeLocked(void* p) {
+  auto it = reserved_chunks_.find(p);
+  if (it != reserved_chunks_.end()) {
+    device_allocator_->Free(it->first);
+    stats_.bytes_in_use -= it->second;
+    stats_.total_allocated_bytes -= it->second;
+    reserved_chunks_.erase(it);
+  } else {
+    DeallocateRawInternal(p);
+  }
+}
+
+void BFCArena::DrainThreadCacheLocked(BFCArenaThreadCache& cache) {
+  for (void* p : cache.queued_frees) {
+    if (reserved_chunks_.find(p) == reserved_chunks_.end()) {
+      // Chunks handed out by a cache are not associated with a stream.
+      Chunk* c = ChunkFromHandle(region_manager_.get_handle(p));
+      if (c->thread_cached && c->size <= kMaxThreadCachedChunkSize &&
+          cache.cached_bytes + c->size <= thread_local_cache_max_bytes_) {
+        c->requested_size = c->size;
+        cache.free_lists[ThreadCacheClassForChunk(c->size)].push_back({p, c->size});
+        cache.cached_bytes += c->size;
+        thread_cached_bytes_.fetch_add(static_cast<int64_t>(c->size), std::memory_order_relaxed);
+        continue;
+      }
+    }
+    FreeLocked(p);
+  }
+  cache.queued_frees.clear();
+}
+
+void BFCArena::FlushThreadCacheLocked(BFCArenaThreadCache& cache) {
+  for (void* p : cache.queued_frees) {
+    FreeLocked(p);
+  }
+  cache.queued_frees.clear();
+
+  for (auto& free_list : cache.free_lists) {
+    for (const auto& cached_chunk : free_list) {
+      DeallocateRawInternal(cached_chunk.ptr);
+    }
+    free_list.clear();
+  }
+  thread_cached_bytes_.fetch_sub(static_cast<int64_t>(cache.cached_bytes), std::memory_order_relaxed);
+  cache.cached_bytes = 0;
+}
+
+bool BFCArena::ReclaimThreadCachesLocked(BFCArenaThreadCache* held_cache, bool flush) {
+  if (thread_local_cache_max_bytes_ == 0) {
+    return false;
+  }
+
+  bool reclaimed = false;
+  std::lock_guard<std::mutex> caches_lock(thread_caches_mutex_);
+  for (const auto& cache : thread_caches_) {
+    std::unique_lock<std::mutex> cache_lock;
+    if (cache.get() != held_cache) {
+      cache_lock = std::unique_lock<std::mutex>(cache->mutex, std::try_to_lock);
+      if (!cache_lock.owns_lock()) {
+        continue;
+      }
+    }
+
+    if (!cache->queued_frees.empty() || (flush && cache->cached_bytes > 0)) {
+      reclaimed = true;
+      if (flush) {
+        FlushThreadCacheLocked(*cache);
+      } else {
+        DrainThreadCacheLocked(*cache);
+      }
+    }
+  }
+  return reclaimed;
 }
 
 BFCArena::Chunk* BFCArena::SplitFreeChunkFromBin(BFCArena::Bin::FreeChunkSet* free_chunks,
@@ -474,37 +787,51 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
-  std::lock_guard<std::mutex> lock(lock_);
-  auto it = reserved_chunks_.find(p);
-  if (it != reserved_chunks_.end()) {
-    device_allocator_->Free(it->first);
-    stats_.bytes_in_use -= it->second;
-    stats_.total_allocated_bytes -= it->second;
-    reserved_chunks_.erase(it);
-  } else {
-    DeallocateRawInternal(p);
+  if (timeline_enabled_.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(lock_);
+    // Reserved chunks do not come from the bins, so their allocation was not recorded either.
+    const bool is_reserved = reserved_chunks_.find(p) != reserved_chunks_.end();
+    FreeLocked(p);
+    if (timeline_ != nullptr && !is_reserved) {
+      RecordFreeLocked(p);
+    }
+    return;
+  }
+  if (thread_local_cache_max_bytes_ > 0) {
+    // Whether the chunk goes to a cache is decided when the queue is drained.
+    FreeToThreadCache(p);
+    return;
   }
-}
-
-Status BFCArena::Shrink() {
   std::lock_guard<std::mutex> lock(lock_);
-  auto num_regions = region_manager_.regions().size();
-  std::vector<void*> region_ptrs;
-  std::vector<size_t> region_sizes;
-  region_ptrs.reserve(num_regions);
-  region_sizes.reserve(num_regions);
+  FreeLocked(p);
+}
 
+size_t BFCArena::ReleaseFreeRegionsLocked(size_t watermark_bytes) {
+  struct RegionInfo {
+    void* ptr;
+    size_t size;
+    int64_t id;
+  };
+  std::vector<RegionInfo> regions;
+  regions.reserve(region_manager_.regions().size());
   for (const auto& region : region_manager_.regions()) {
     if (consider_first_allocation_region_for_shrinkage_ || region.id() != 0) {
-      region_ptrs.push_back(region.ptr());
-      region_sizes.push_back(region.memory_size());
+      regions.push_back({region.ptr(), region.memory_size(), region.id()});
     }
   }
 
-  size_t i = 0;
-  for (void* region_ptr : region_ptrs) {
+  // The regions are sorted by address. Release the most recent ones first, as they are the largest
+  // with the kNextPowerOfTwo strategy.
+  std::sort(regions.begin(), regions.end(), [](const RegionInfo& a, const RegionInfo& b) { return a.id > b.id; });
+
+  size_t released_bytes = 0;
+  for (const auto& region : regions) {
+    if (static_cast<size_t>(stats_.total_allocated_bytes) <= watermark_bytes) {
+      break;
+    }
+
     bool deallocate_region = true;
-    ChunkHandle region_begin_chunk = region_manager_.get_handle(region_ptr);
+    ChunkHandle region_begin_chunk = region_manager_.get_handle(region.ptr);
     ChunkHandle h = region_begin_chunk;
     while (h != kInvalidChunkHandle) {
       const Chunk* c = ChunkFromHandle(h);
@@ -518,9 +845,11 @@ Status BFCArena::Shrink() {
     }
 
     if (deallocate_region) {
-      auto shrink_size = region_sizes[i];
+      auto shrink_size = region.size;
       stats_.num_arena_shrinkages += 1;
       stats_.total_allocated_bytes -= shrink_size;
+      stats_.total_released_bytes += shrink_size;
+      released_bytes += shrink_size;
 
       LOGS_DEFAULT(VERBOSE) << device_allocator_->Info().name << " BFC Arena shrunk by "
                             << shrink_size << " bytes. "
@@ -536,14 +865,20 @@ Status BFCArena::Shrink() {
         h = temp;
       }
 
-      device_allocator_->Free(region_ptr);
-      region_manager_.RemoveAllocationRegion(region_ptr);
+      device_allocator_->Free(region.ptr);
+      region_manager_.RemoveAllocationRegion(region.ptr);
       stats_.num_arena_extensions--;
     }
-
-    ++i;
   }
 
+  return released_bytes;
+}
+
+Status BFCArena::Shrink() {
+  std::lock_guard<std::mutex> lock(lock_);
+  ReclaimThreadCachesLocked(nullptr, /*flush*/ true);
+  ReleaseFreeRegionsLocked(0);
+
   // Will affect how the arena grows if the arena extend strategy is kNextPowerOfTwo
   // In case the extend strategy is kSameAsRequested, the arena growth is exactly the size of the memory request itself
   curr_region_allocation_bytes_ = initial_growth_chunk_size_bytes_;
@@ -551,10 +886,115 @@ Status BFCArena::Shrink() {
   return Status::OK();
 }
 
+size_t BFCArena::Trim() {
+  if (trim_policy_.watermark_bytes < 0) {
+    return 0;
+  }
+
+  std::lock_guard<std::mutex> lock(lock_);
+  const auto watermark_bytes = static_cast<size_t>(trim_policy_.watermark_bytes);
+  if (static_cast<size_t>(stats_.total_allocated_bytes) <= watermark_bytes) {
+    return 0;
+  }
+
+  ReclaimThreadCachesLocked(nullptr, /*flush*/ true);
+  const size_t released_bytes = ReleaseFreeRegionsLocked(watermark_bytes);
+  if (released_bytes > 0) {
+    // Grow from the initial size again, like after Shrink().
+    curr_region_allocation_bytes_ = initial_growth_chunk_size_bytes_;
+    LOGS_DEFAULT(INFO) << device_allocator_->Info().name << " BFC Arena trimmed by " << released_bytes
+                       << " bytes to " << stats_.total_allocated_bytes << " bytes.";
+  }
+  return released_bytes;
+}
+
+void BFCArena::OnRunEnd() {
+  if (trim_policy_.run_interval <= 0 || trim_policy_.watermark_bytes < 0) {
+    return;
+  }
+
+  if (runs_since_trim_.fetch_add(1, std::memory_order_relaxed) + 1 >= trim_policy_.run_interval) {
+    runs_since_trim_.store(0, std::memory_order_relaxed);
+    Trim();
+  }
+}
+
+void BFCArena::SetAllocationTimeline(std::shared_ptr<AllocationTimeline> timeline) {
+  std::lock_guard<std::mutex> lock(lock_);
+  timeline_enabled_.store(timeline != nullptr, std::memory_order_release);
+  timeline_ = std::move(timeline);
+}
+
+std::shared_ptr<AllocationTimeline> BFCArena::GetAllocationTimeline() const {
+  std::lock_guard<std::mutex> lock(lock_);
+  return timeline_;
+}
+
+void BFCArena::RecordAllocationLocked(const void* p) {
+  const BFCArena::Chunk* c = ChunkFromHandle(region_manager_.get_handle(p));
+  const AllocationRegion& region = region_manager_.region_for(p);
+  const size_t offset = static_cast<size_t>(static_cast<const char*>(p) - static_cast<const char*>(region.ptr()));
+  timeline_->RecordAllocation(Info().name, p, c->size, region.id(), offset, c->stream, ArenaStateLocked());
+}
+
+void BFCArena::RecordFreeLocked(const void* p) {
+  timeline_->RecordFree(Info().name, p, ArenaStateLocked());
+}
+
+AllocationTimeline::ArenaState BFCArena::ArenaStateLocked() {
+  AllocationTimeline::ArenaState state;
+  state.bytes_in_use = stats_.bytes_in_use;
+  for (BinNum b = 0; b < kNumBins; b++) {
+    const Bin* bin = BinFromIndex(b);
+    if (bin->free_chunks.empty()) {
+      continue;
+    }
+    for (ChunkHandle h : bin->free_chunks) {
+      state.total_free_bytes += ChunkFromHandle(h)->size;
+    }
+    // The free chunks of a bin are sorted by size.
+    state.largest_free_chunk_bytes = std::max(state.largest_free_chunk_bytes,
+                                              ChunkFromHandle(*bin->free_chunks.rbegin())->size);
+    state.free_chunks_per_bin.emplace_back(bin->bin_size, bin->free_chunks.size());
+  }
+  return state;
+}
+
+int64_t BFCArena::AllocationCountLocked() {
+  int64_t count = stats_.num_allocs;
+  std::lock_guard<std::mutex> caches_lock(thread_caches_mutex_);
+  for (const auto& cache : thread_caches_) {
+    count += cache->num_hits.load(std::memory_order_relaxed);
+  }
+  return count;
+}
+
+void BFCArena::TrimWhenIdle() {
+  const auto interval = std::chrono::milliseconds(trim_policy_.idle_interval_ms);
+  // Allocation counts at the previous check and at the last trim, so that an idle arena is only trimmed once.
+  int64_t last_count = -1;
+  int64_t trimmed_count = -1;
+  std::unique_lock<std::mutex> trim_lock(trim_thread_mutex_);
+  while (!trim_thread_cv_.wait_for(trim_lock, interval, [this]() { return stop_trim_thread_; })) {
+    int64_t count = 0;
+    {
+      std::lock_guard<std::mutex> lock(lock_);
+      count = AllocationCountLocked();
+    }
+
+    if (count == last_count && count != trimmed_count) {
+      Trim();
+      trimmed_count = count;
+    }
+    last_count = count;
+  }
+}
+
 void BFCArena::DeallocateRawInternal(void* ptr) {
   // Find the chunk from the ptr.
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
+  ChunkFromHandle(h)->thread_cached = false;
 
   // Consider coalescing it.
   FreeAndMaybeCoalesce(h);
@@ -833,14 +1273,18 @@ StreamAwareArena::StreamAwareArena(std::unique_ptr<IAllocator> resource_allocato
                                    int initial_chunk_size_bytes,
                                    int max_dead_bytes_per_chunk,
                                    int initial_growth_chunk_size_bytes,
-                                   int64_t max_power_of_two_extend_bytes)
+                                   int64_t max_power_of_two_extend_bytes,
+                                   size_t thread_local_cache_max_bytes,
+                                   const BFCArenaTrimPolicy& trim_policy)
     : BFCArena(std::move(resource_allocator),
                total_memory,
                arena_extend_strategy,
                initial_chunk_size_bytes,
                max_dead_bytes_per_chunk,
                initial_growth_chunk_size_bytes,
-               max_power_of_two_extend_bytes) {
+               max_power_of_two_extend_bytes,
+               thread_local_cache_max_bytes,
+               trim_policy) {
   arena_type_ = ArenaType::StreamAwareArena;
 }
 
@@ -16,9 +16,12 @@ limitations under the License.
 
 #pragma once
 #include <array>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <thread>
 
 #include "onnxruntime_config.h"
 
@@ -27,6 +30,7 @@ limitations under the License.
 #include "core/common/logging/severity.h"
 #include "core/common/safeint.h"
 
+#include "core/framework/allocation_timeline.h"
 #include "core/framework/arena_extend_strategy.h"
 #include "core/framework/allocator.h"
 
@@ -44,6 +48,23 @@ namespace onnxruntime {
 #endif
 
 class StreamAwareArena;
+struct BFCArenaThreadCache;
+struct BFCArenaThreadCacheList;
+
+// Policy of a BFCArena for releasing the free regions above a watermark without an explicit Shrink().
+// Trimming happens after the arena was idle for idle_interval_ms, or every run_interval calls to
+// BFCArena::OnRunEnd(), whichever is enabled.
+struct BFCArenaTrimPolicy {
+  // The arena keeps its free regions while it holds at most this many bytes. Negative disables trimming.
+  int64_t watermark_bytes = -1;
+  // Time without allocations after which a background thread trims the arena. 0 disables it.
+  int64_t idle_interval_ms = 0;
+  // Number of runs after which the arena is trimmed. 0 disables it.
+  int64_t run_interval = 0;
+
+  bool IsEnabled() const { return watermark_bytes >= 0 && (idle_interval_ms > 0 || run_interval > 0); }
+};
+
 // A memory allocator that implements a 'best-fit with coalescing'
 // algorithm.  This is essentially a very simple version of Doug Lea's
 // malloc (dlmalloc).
@@ -60,6 +81,7 @@ class BFCArena : public IAllocator {
   static const int DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES = 2 * 1024 * 1024;
   static const int64_t DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES = 1024 * 1024 * 1024;  // 1GB
   static const size_t DEFAULT_MAX_MEM = std::numeric_limits<size_t>::max();
+  static const size_t DEFAULT_THREAD_LOCAL_CACHE_MAX_BYTES = 0;
 
   enum ArenaType {
     BaseArena,
@@ -72,7 +94,9 @@ class BFCArena : public IAllocator {
            int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
            int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
            int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
-           int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES);
+           int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+           size_t thread_local_cache_max_bytes = DEFAULT_THREAD_LOCAL_CACHE_MAX_BYTES,
+           const BFCArenaTrimPolicy& trim_policy = BFCArenaTrimPolicy());
 
   ~BFCArena() override;
 
@@ -85,6 +109,7 @@ class BFCArena : public IAllocator {
   void Free(void* p) override;
 
   // Frees all allocation regions in which no chunk is in use.
+  // The chunks held by the thread-local caches are returned to the arena first.
   // Does not free any reserved chunks.
   // Resets the size that the arena will grow by in the next allocation to
   // `initial_growth_chunk_size_bytes_` but ultimately all
@@ -92,6 +117,22 @@ class BFCArena : public IAllocator {
   // and the allocation request.
   Status Shrink();
 
+  // Frees the most recent allocation regions in which no chunk is in use until the arena holds at most
+  // the watermark of the trim policy. The chunks held by the thread-local caches are returned to the arena first.
+  // Returns the number of bytes released to the device allocator, which GetStats() accumulates in
+  // total_released_bytes.
+  size_t Trim();
+
+  // Called by the sessions using the arena at the end of each run. Trims the arena every run_interval runs.
+  void OnRunEnd();
+
+  const BFCArenaTrimPolicy& GetTrimPolicy() const { return trim_policy_; }
+
+  // Records the allocations and frees of the arena in timeline, or stops recording if timeline is nullptr.
+  // While recording, the thread-local caches are bypassed so that every allocation and free is seen by the arena.
+  void SetAllocationTimeline(std::shared_ptr<AllocationTimeline> timeline);
+  std::shared_ptr<AllocationTimeline> GetAllocationTimeline() const;
+
   void* Reserve(size_t size) override;
 
   void GetStats(AllocatorStats* stats) override;
@@ -115,8 +156,70 @@ class BFCArena : public IAllocator {
   ArenaType arena_type_;
 
  private:
+  friend struct BFCArenaThreadCacheList;
+
   void DeallocateRawInternal(void* ptr);
 
+  // Allocates a chunk of at least rounded_bytes. Requires lock_.
+  // held_cache is the thread cache locked by the caller, if any.
+  void* AllocateRawLocked(size_t num_bytes, size_t rounded_bytes, bool dump_log_on_failure, Stream* stream,
+                          BFCArenaThreadCache* held_cache);
+
+  // Thread-local caches.
+  //
+  // With thread_local_cache_max_bytes > 0, each thread that uses the arena gets a cache of free chunks of up to
+  // kMaxThreadCachedChunkSize bytes, sorted in size classes. Allocations without a stream are served from the
+  // cache of the calling thread without taking lock_. Free() queues the pointer in the cache of the calling
+  // thread, and the queue is drained in batches under lock_: the chunks handed out by a cache, which are marked
+  // with Chunk::thread_cached, go to the free lists of the cache, and the other pointers (chunks associated with a
+  // stream, large and reserved chunks) go back to the arena. The chunks held by a cache stay in use from the
+  // arena's point of view, GetStats() accounts for them and for the allocations served by the caches. As cache hits
+  // do not update the chunks, RequestedSize() of a chunk reused from a cache returns the size of the chunk.
+  //
+  // Each cache has its own mutex, which is only contended when the arena reclaims the cached chunks.
+  // Lock order: cache mutex, lock_, thread_caches_mutex_. Caches are only try-locked while lock_ is held.
+  static const size_t kMaxThreadCachedChunkSize = 256 * 1024;
+  static const size_t kThreadCacheFreeBatchSize = 32;
+
+  BFCArenaThreadCache& GetThreadCache();
+  void* AllocateFromThreadCache(size_t num_bytes, size_t rounded_bytes, bool dump_log_on_failure);
+  void FreeToThreadCache(void* p);
+
+  // Frees a pointer that did not come from a free list of a cache. Requires lock_.
+  void FreeLocked(void* p);
+
+  // Moves the queued frees of a cache to its free lists, or back to the arena if they were not handed out by a
+  // cache or do not fit. Requires lock_ and cache.mutex.
+  void DrainThreadCacheLocked(BFCArenaThreadCache& cache);
+
+  // Returns all the chunks of a cache to the arena. Requires lock_ and cache.mutex.
+  void FlushThreadCacheLocked(BFCArenaThreadCache& cache);
+
+  // Drains the queued frees of all caches, and returns their cached chunks to the arena too if flush is true.
+  // Caches locked by other threads are skipped. Returns true if any chunk was returned to the arena.
+  // Requires lock_.
+  bool ReclaimThreadCachesLocked(BFCArenaThreadCache* held_cache, bool flush);
+
+  // Frees the allocation regions in which no chunk is in use, most recent first, while the arena holds more than
+  // watermark_bytes. Returns the number of bytes released. Requires lock_.
+  size_t ReleaseFreeRegionsLocked(size_t watermark_bytes);
+
+  // Records the allocation or the free of p in timeline_. Requires lock_.
+  void RecordAllocationLocked(const void* p);
+  void RecordFreeLocked(const void* p);
+  // Free bytes of the bins, for the allocation timeline. Requires lock_.
+  AllocationTimeline::ArenaState ArenaStateLocked();
+
+  // Body of trim_thread_. Trims the arena when no allocation happened during an idle interval.
+  void TrimWhenIdle();
+  // Number of allocations, including the ones served by the thread caches. Requires lock_.
+  int64_t AllocationCountLocked();
+
+  // Size classes of the thread caches. The class of an allocation is the smallest class that holds
+  // rounded_bytes, the class of a cached chunk the largest one that fits in the chunk.
+  int ThreadCacheClassForAllocation(size_t rounded_bytes, size_t& class_size);
+  int ThreadCacheClassForChunk(size_t chunk_size);
+
   // A ChunkHandle is an index into the chunks_ vector in BFCAllocator
   // kInvalidChunkHandle means an invalid chunk
   using ChunkHandle = size_t;
@@ -164,6 +267,9 @@ class BFCArena : public IAllocator {
 
     uint64_t stream_sync_id = 0;
 
+    // Whether the chunk was handed out by a thread-local cache. Cleared when the chunk goes back to the arena.
+    bool thread_cached = false;
+
     bool in_use() const { return allocation_id != -1; }
 
     std::string DebugString(BFCArena* a, bool recurse) {
@@ -329,6 +435,8 @@ class BFCArena : public IAllocator {
 
     const std::vector<AllocationRegion>& regions() const { return regions_; }
 
+    const AllocationRegion& region_for(const void* p) const { return *RegionFor(p); }
+
    private:
     ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RegionManager);
 
@@ -501,11 +609,31 @@ class BFCArena : public IAllocator {
   const int initial_growth_chunk_size_bytes_;
   const int64_t max_power_of_two_extend_bytes_;
 
+  const size_t thread_local_cache_max_bytes_;
+  // Identifies the caches of this arena in the thread-local storage of the threads.
+  const uint64_t arena_id_;
+  std::mutex thread_caches_mutex_;
+  std::vector<std::shared_ptr<BFCArenaThreadCache>> thread_caches_;  // GUARDED_BY(thread_caches_mutex_)
+  // Bytes of the chunks in the free lists of all caches.
+  std::atomic<int64_t> thread_cached_bytes_{0};
+
   // This flag is only relevant if Shrink() is invoked.
   // This is a boolean flag that controls whether the first allocation region
   // is to be considered for shrinkage or not.
   bool consider_first_allocation_region_for_shrinkage_;
 
+  const BFCArenaTrimPolicy trim_policy_;
+  std::atomic<int64_t> runs_since_trim_{0};
+  // Background thread of the idle trimming, if enabled.
+  std::mutex trim_thread_mutex_;
+  std::condition_variable trim_thread_cv_;
+  bool stop_trim_thread_ = false;  // GUARDED_BY(trim_thread_mutex_)
+  std::thread trim_thread_;
+
+  std::shared_ptr<AllocationTimeline> timeline_;  // GUARDED_BY(lock_)
+  // Whether timeline_ is set, to check it without taking lock_.
+  std::atomic<bool> timeline_enabled_{false};
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(BFCArena);
 };
 
@@ -518,7 +646,9 @@ class StreamAwareArena : public BFCArena {
                    int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
                    int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
                    int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
-                   int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES);
+                   int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+                   size_t thread_local_cache_max_bytes = DEFAULT_THREAD_LOCAL_CACHE_MAX_BYTES,
+                   const BFCArenaTrimPolicy& trim_policy = BFCArenaTrimPolicy());
 
   bool IsStreamAware() const override { return true; }
 
@@ -3,6 +3,7 @@
 
 #include "core/framework/execution_frame.h"
 
+#include <optional>
 #include <sstream>
 
 #include "core/framework/mem_pattern_planner.h"
@@ -345,8 +346,7 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
 #ifdef ORT_ENABLE_STREAM
       device_streams_(device_streams),
 #endif
-      session_state_(session_state),
-      mem_patterns_(nullptr) {
+      session_state_(session_state) {
   Init(
       feed_mlvalue_idxs, feeds, session_state.GetInitializedTensors(),
 #if !defined(DISABLE_SPARSE_TENSORS)
@@ -537,9 +537,26 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
   // Lazily get the allocator only if needed.
   AllocatorPtr alloc = nullptr;
 
+  const auto& per_alloc_plan = GetAllocationPlan(ort_value_index);
+
+  // write the value to the buffer the caller bound to the graph output that aliases it, if it has the same size.
+  if (per_alloc_plan.bound_output != -1 && !utils::IsDataTypeString(element_type)) {
+    OrtValue& bound_output = GetMutableMLValue(per_alloc_plan.bound_output);
+    if (bound_output.IsTensor()) {
+      Tensor& bound_tensor = *bound_output.GetMutable<Tensor>();
+      if (bound_tensor.Location().device == location &&
+          bound_tensor.SizeInBytes() == Tensor::CalculateTensorStorageSize(element_type, shape)) {
+        Tensor::InitOrtValue(element_type, shape, bound_tensor.MutableDataRaw(), bound_tensor.Location(), ort_value);
+        bound_output_substitutes_.emplace(ort_value_index, OrtValue());
+        // keep the memory patterns the same whether or not an output is bound.
+        TraceAllocate(ort_value_index, size);
+        return Status::OK();
+      }
+    }
+  }
+
   // if we have pre-calculated memory pattern, and the ort_value is not output mlvalue
   // try to allocate on pre-allocated big chunk.
-  const auto& per_alloc_plan = GetAllocationPlan(ort_value_index);
 
   if (mem_patterns_ && per_alloc_plan.alloc_kind != AllocKind::kAllocateOutput &&
       per_alloc_plan.alloc_kind != AllocKind::kAllocatedExternally) {
@@ -577,6 +594,14 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
   if (!alloc) alloc = GetAllocator(location);
   ORT_ENFORCE(alloc && alloc.get() != nullptr, "Failed to get allocator for ", location.ToString());
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // Attribute the buffer to the value in the allocation timeline.
+  std::optional<AllocationTimeline::ScopedAttribution> timeline_attribution;
+  if (session_state_.GetAllocationTimeline() != nullptr) {
+    timeline_attribution.emplace(ort_value_index);
+  }
+#endif
+
   Stream* current_stream = GetValueStream(ort_value_index);
   if (current_stream) {
 #ifdef ORT_ENABLE_STREAM
@@ -770,6 +795,26 @@ Status ExecutionFrame::AllocateAsPerAllocationPlan(OrtValue& ort_value, int ort_
 #ifdef ENABLE_STRIDED_TENSORS
         is_strided_tensor = per_alloc_plan.is_strided_tensor;
 #endif  // ENABLE_STRIDED_TENSORS
+
+        // the values reusing the buffer of a graph output after the value written to it must not overwrite it.
+        // they share a buffer of the same size instead.
+        auto substitute = bound_output_substitutes_.find(reuse_mlvalue_index);
+        if (substitute != bound_output_substitutes_.end() && per_alloc_plan.bound_output == -1) {
+          OrtValue& substitute_value = substitute->second;
+          if (!substitute_value.IsAllocated()) {
+            const Tensor& reused_tensor = GetMLValue(reuse_mlvalue_index).Get<Tensor>();
+            Tensor::InitOrtValue(reused_tensor.DataType(), reused_tensor.Shape(),
+                                 GetAllocator(reused_tensor.Location().device), substitute_value);
+          }
+
+          Tensor& substitute_tensor = *substitute_value.GetMutable<Tensor>();
+          ORT_RETURN_IF(!is_strided_tensor && shape->Size() > substitute_tensor.Shape().Size(),
+                        "Shape mismatch attempting to re-use buffer. ", substitute_tensor.Shape(), " < ", *shape);
+          ORT_RETURN_IF_ERROR(AllocateTensorWithPreAllocateBufferHelper(
+              ort_value, substitute_tensor.MutableDataRaw(), ml_data_type, alloc_info, *shape));
+          break;
+        }
+
         ORT_RETURN_IF_ERROR(AllocateMLValueTensorPreAllocateBuffer(
             ort_value, reuse_mlvalue_index, ml_data_type, alloc_info, *shape, is_strided_tensor));
         break;
@@ -880,6 +925,7 @@ void ExecutionFrame::VerifyOutputSizes(int output_index, const Node& node, const
 // do not call this in ParallExecutionPlan
 Status ExecutionFrame::ReleaseMLValueImpl(int ort_value_idx) {
   ORT_RETURN_IF_ERROR(IExecutionFrame::ReleaseMLValueImpl(ort_value_idx));
+  bound_output_substitutes_.erase(ort_value_idx);
   TraceFree(ort_value_idx);
   return Status::OK();
 }
@@ -932,11 +978,14 @@ void ExecutionFrame::TraceFree(int ort_value_idx) {
 
 // generate memory pattern based on the tracing of memory allocation/free in current execution
 // return error if the planner is not setup.
-Status ExecutionFrame::GeneratePatterns(MemoryPatternGroup& out) {
+Status ExecutionFrame::GeneratePatterns(MemoryPatternGroup& out, MemoryPatternTrace* trace) {
   if (!planner_.has_value()) {
     return Status(ONNXRUNTIME, FAIL, "Memory pattern planner is not enabled on this execution framework.");
   }
 
+  if (trace != nullptr) {
+    *trace = planner_->GetTrace();
+  }
   return planner_->GeneratePatterns(out);
 }
 
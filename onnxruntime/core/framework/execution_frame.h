@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -162,7 +163,8 @@ class ExecutionFrame final : public IExecutionFrame {
                                                 bool is_strided_tensor = false);
 
   // thread-safe
-  Status GeneratePatterns(MemoryPatternGroup& out);
+  // trace receives the traced allocations and frees if not null.
+  Status GeneratePatterns(MemoryPatternGroup& out, MemoryPatternTrace* trace = nullptr);
 
   bool HasMemoryPatternPlanner() const {
     return planner_.has_value();
@@ -243,7 +245,8 @@ class ExecutionFrame final : public IExecutionFrame {
   // If we already have cached memory pattern on these input shapes
   // Use this mem pattern that create a big chunk for all the internal
   // kernel's input/output tensors.
-  const MemoryPatternGroup* mem_patterns_;
+  // The session state may evict it from its cache while the frame uses it.
+  std::shared_ptr<const MemoryPatternGroup> mem_patterns_;
 
   // If no cached memory pattern, and we enable the memory pattern optimization
   // use this planner_ to trace the memory allocation in current executor.
@@ -252,6 +255,10 @@ class ExecutionFrame final : public IExecutionFrame {
   // Big chunks on different locations that will be used by mem_pattern.
   InlinedHashMap<OrtDevice, BufferUniquePtr> buffers_;
 
+  // The values written to the buffers of bound graph outputs, with the buffer shared by the values that reuse their
+  // buffer later on, allocated on first use. See AllocPlanPerValue::bound_output.
+  InlinedHashMap<int, OrtValue> bound_output_substitutes_;
+
   // Given the input shapes of the executed graph, ExecutionFrame tries inferring
   // all symbolic shapes. inferred_shapes_[i] is the shape of OrtValue indexed
   // by i, if the key i exists.
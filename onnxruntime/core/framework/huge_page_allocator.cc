@@ -0,0 +1,161 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/huge_page_allocator.h"
+
+#include <algorithm>
+
+#include "core/mlas/inc/mlas.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+#endif
+
+namespace onnxruntime {
+
+namespace {
+#if defined(__linux__)
+size_t RoundUp(size_t size, size_t alignment) {
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+// madvise(MADV_HUGEPAGE) succeeds even if transparent huge pages are disabled in the system settings.
+bool TransparentHugePagesEnabled() {
+  static const bool enabled = []() {
+    std::ifstream settings("/sys/kernel/mm/transparent_hugepage/enabled");
+    std::string line;
+    return std::getline(settings, line) && line.find("[never]") == std::string::npos;
+  }();
+  return enabled;
+}
+#endif
+}  // namespace
+
+HugePageAllocator::HugePageAllocator(std::unique_ptr<IAllocator> fallback_allocator, HugePageMode mode)
+    : IAllocator(fallback_allocator->Info()),
+      fallback_allocator_(std::move(fallback_allocator)),
+      mode_(mode) {
+  ORT_ENFORCE(Info().device.Type() == OrtDevice::CPU, "Huge pages are only supported for CPU memory.");
+}
+
+HugePageAllocator::~HugePageAllocator() {
+  for (const auto& [p, mapped_size] : mapped_buffers_) {
+    Unmap(p, mapped_size);
+  }
+}
+
+size_t HugePageAllocator::RegionSizeForHugePages(size_t size) {
+  static_assert(MLAS_SYMM_QGEMM_BUF_OVERRUN <= kHugePagePadding);
+  const size_t num_huge_pages = std::max<size_t>((size + kHugePageSize - 1) / kHugePageSize, 1);
+  return num_huge_pages * kHugePageSize - kHugePagePadding;
+}
+
+void* HugePageAllocator::Alloc(size_t size) {
+  if (mode_ == HugePageMode::kDisabled || size + kHugePagePadding < kHugePageSize) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.num_allocs;
+  } else {
+    // Some MLAS kernels read past the end of their buffers, like the default CPU allocator allows.
+    size_t mapped_size = 0;
+    void* p = MapHugePages(size + MLAS_SYMM_QGEMM_BUF_OVERRUN, mapped_size);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.num_allocs;
+    if (p != nullptr) {
+      mapped_buffers_.emplace(p, mapped_size);
+      stats_.huge_page_bytes += static_cast<int64_t>(mapped_size);
+      return p;
+    }
+    ++stats_.num_huge_page_fallbacks;
+  }
+
+  return fallback_allocator_->Alloc(size);
+}
+
+void HugePageAllocator::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+
+  size_t mapped_size = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = mapped_buffers_.find(p);
+    if (it != mapped_buffers_.end()) {
+      mapped_size = it->second;
+      stats_.huge_page_bytes -= static_cast<int64_t>(mapped_size);
+      mapped_buffers_.erase(it);
+    }
+  }
+
+  if (mapped_size != 0) {
+    Unmap(p, mapped_size);
+  } else {
+    fallback_allocator_->Free(p);
+  }
+}
+
+void HugePageAllocator::GetStats(AllocatorStats* stats) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  *stats = stats_;
+}
+
+void* HugePageAllocator::MapHugePages(size_t size, size_t& mapped_size) {
+#if defined(__linux__)
+  if (mode_ == HugePageMode::kExplicit) {
+    mapped_size = RoundUp(size, kHugePageSize);
+    void* p = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (p != MAP_FAILED) {
+      return p;
+    }
+  }
+
+  if (!TransparentHugePagesEnabled()) {
+    return nullptr;
+  }
+
+  // Transparent huge pages only back aligned ranges, so map an extra huge page to align the buffer
+  // and unmap the excess.
+  mapped_size = RoundUp(size, static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+  const size_t reserved_size = mapped_size + kHugePageSize;
+  void* reserved = mmap(nullptr, reserved_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (reserved == MAP_FAILED) {
+    return nullptr;
+  }
+
+  auto* begin = static_cast<uint8_t*>(reserved);
+  auto* end = begin + reserved_size;
+  auto* aligned = reinterpret_cast<uint8_t*>(RoundUp(reinterpret_cast<uintptr_t>(begin), kHugePageSize));
+  if (aligned != begin) {
+    munmap(begin, aligned - begin);
+  }
+  if (aligned + mapped_size != end) {
+    munmap(aligned + mapped_size, end - (aligned + mapped_size));
+  }
+
+  if (madvise(aligned, mapped_size, MADV_HUGEPAGE) != 0) {
+    munmap(aligned, mapped_size);
+    return nullptr;
+  }
+  return aligned;
+#else
+  ORT_UNUSED_PARAMETER(size);
+  mapped_size = 0;
+  return nullptr;
+#endif
+}
+
+void HugePageAllocator::Unmap(void* p, size_t mapped_size) {
+#if defined(__linux__)
+  munmap(p, mapped_size);
+#else
+  ORT_UNUSED_PARAMETER(p);
+  ORT_UNUSED_PARAMETER(mapped_size);
+#endif
+}
+
+}  // namespace onnxruntime
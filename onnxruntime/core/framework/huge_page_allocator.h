@@ -0,0 +1,64 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+
+#include "core/common/inlined_containers.h"
+#include "core/framework/allocator.h"
+
+namespace onnxruntime {
+
+// Values of OrtArenaCfg::huge_page_mode.
+enum class HugePageMode : int {
+  kDisabled = 0,
+  // The buffers are mapped with madvise(MADV_HUGEPAGE), so the kernel backs them with transparent huge pages
+  // when it can.
+  kTransparent = 1,
+  // The buffers are mapped with MAP_HUGETLB from the huge page pool reserved by the administrator,
+  // with a fallback to transparent huge pages.
+  kExplicit = 2,
+};
+
+/**
+ * CPU allocator that maps large buffers with huge pages to reduce the TLB misses of large working sets,
+ * like the regions of an arena or pre-packed weights.
+ *
+ * Buffers smaller than a huge page, and buffers that cannot get huge pages (none available, or the platform is
+ * not Linux), come from the wrapped allocator. GetStats() reports the bytes mapped with huge pages and the
+ * number of fallbacks of buffers of at least a huge page.
+ */
+class HugePageAllocator : public IAllocator {
+ public:
+  static constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+  // Alloc() pads each buffer for the reads of MLAS kernels past its end. A buffer of up to a multiple of
+  // kHugePageSize minus this padding fits in that many huge pages.
+  static constexpr size_t kHugePagePadding = 256;
+
+  // Size of the buffers that fill the huge pages spanned by size, for the regions of an arena. A region of
+  // exactly a multiple of kHugePageSize would spill into one more huge page because of the padding.
+  static size_t RegionSizeForHugePages(size_t size);
+
+  HugePageAllocator(std::unique_ptr<IAllocator> fallback_allocator, HugePageMode mode);
+  ~HugePageAllocator() override;
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+  void GetStats(AllocatorStats* stats) override;
+
+ private:
+  // Returns nullptr if huge pages are unavailable. mapped_size is the length of the mapping.
+  void* MapHugePages(size_t size, size_t& mapped_size);
+  static void Unmap(void* p, size_t mapped_size);
+
+  const std::unique_ptr<IAllocator> fallback_allocator_;
+  const HugePageMode mode_;
+
+  std::mutex mutex_;
+  InlinedHashMap<void*, size_t> mapped_buffers_;  // GUARDED_BY(mutex_). Mapped size of each huge page buffer.
+  AllocatorStats stats_;                          // GUARDED_BY(mutex_)
+};
+
+}  // namespace onnxruntime
@@ -58,6 +58,17 @@ class MemoryPattern {
   size_t peak_size_{0};
 };
 
+// Allocations and frees traced by an OrtValuePatternPlanner, in the order they happened.
+struct MemoryPatternTrace {
+  struct Event {
+    int ort_value_idx;
+    size_t size;  // 0 for a free
+    bool is_free;
+  };
+
+  std::vector<Event> events;
+};
+
 struct MemoryPatternGroup {
   std::vector<OrtDevice> locations;
   std::vector<MemoryPattern> patterns;
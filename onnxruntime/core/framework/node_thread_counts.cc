@@ -0,0 +1,143 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/node_thread_counts.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+#include "nlohmann/json.hpp"
+using json = nlohmann::json;
+
+namespace onnxruntime {
+
+namespace {
+// A candidate is preferred over one with more threads unless it is more than this fraction slower.
+constexpr double kSlowdownTolerance = 0.05;
+}  // namespace
+
+NodeThreadCounts::NodeThreadCounts(int max_thread_count, size_t num_tuning_runs)
+    : num_tuning_runs_(num_tuning_runs) {
+  for (int thread_count = 1; thread_count < max_thread_count; thread_count *= 2) {
+    candidates_.push_back(thread_count);
+  }
+  candidates_.push_back(std::max(max_thread_count, 1));
+}
+
+Status NodeThreadCounts::Load(const PathString& file_path) {
+  std::ifstream if_stream(file_path);
+  ORT_RETURN_IF_NOT(if_stream.is_open(), "Failed to open node thread counts file: ", ToUTF8String(file_path));
+
+  json content = json::parse(if_stream, nullptr, /*allow_exceptions*/ false);
+  ORT_RETURN_IF(content.is_discarded() || !content.is_object() || !content.contains("node_thread_counts") ||
+                    !content["node_thread_counts"].is_object(),
+                "Failed to parse node thread counts file: ", ToUTF8String(file_path));
+
+  for (const auto& item : content["node_thread_counts"].items()) {
+    ORT_RETURN_IF_NOT(item.value().is_number_integer() && item.value().get<int64_t>() >= 0 &&
+                          item.value().get<int64_t>() <= std::numeric_limits<int>::max(),
+                      "Invalid thread count for node ", item.key(), " in ", ToUTF8String(file_path));
+    auto& entry = entries_[item.key()];
+    if (entry == nullptr) {
+      entry = std::make_unique<Entry>();
+    }
+    entry->thread_count.store(item.value().get<int>(), std::memory_order_relaxed);
+  }
+
+  return Status::OK();
+}
+
+Status NodeThreadCounts::Save(const PathString& file_path) const {
+  json thread_counts = json::object();
+  for (const auto& [name, entry] : entries_) {
+    const int thread_count = entry->thread_count.load(std::memory_order_acquire);
+    if (thread_count >= 0) {
+      thread_counts[name] = thread_count;
+    }
+  }
+
+  std::ofstream of_stream(file_path, std::ios::trunc);
+  ORT_RETURN_IF_NOT(of_stream.is_open(), "Failed to open node thread counts file for writing: ",
+                    ToUTF8String(file_path));
+  json content;
+  content["node_thread_counts"] = std::move(thread_counts);
+  of_stream << content.dump(1);
+  ORT_RETURN_IF_NOT(of_stream.good(), "Failed to write node thread counts file: ", ToUTF8String(file_path));
+  return Status::OK();
+}
+
+Status NodeThreadCounts::SaveIfUpdated(const PathString& file_path) {
+  // Concurrent runs that see an update write the file one after the other, the last write has all the updates.
+  std::lock_guard<std::mutex> save_lock(save_mutex_);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!updated_) {
+      return Status::OK();
+    }
+    updated_ = false;
+  }
+  return Save(file_path);
+}
+
+NodeThreadCounts::Entry& NodeThreadCounts::GetOrAddEntry(const std::string& unique_node_name) {
+  auto& entry = entries_[unique_node_name];
+  if (entry == nullptr) {
+    entry = std::make_unique<Entry>();
+    if (num_tuning_runs_ == 0 || candidates_.size() == 1) {
+      entry->thread_count.store(0, std::memory_order_relaxed);
+    } else {
+      entry->fastest_duration_us.resize(candidates_.size(), std::numeric_limits<double>::max());
+    }
+  }
+  return *entry;
+}
+
+int NodeThreadCounts::GetTuningThreadCount(Entry& entry, bool& tuning) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const size_t num_measurements = candidates_.size() * num_tuning_runs_;
+  if (entry.num_executions >= num_measurements) {
+    // Concurrent runs already claimed all the measurements, run with all threads until the thread count is known.
+    tuning = false;
+    return 0;
+  }
+
+  tuning = true;
+  // Cycling through the candidates spreads the warm-up effects of the first executions over all of them.
+  return candidates_[entry.num_executions++ % candidates_.size()];
+}
+
+void NodeThreadCounts::ReportDuration(Entry& entry, int thread_count, std::chrono::nanoseconds duration) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (entry.thread_count.load(std::memory_order_relaxed) >= 0) {
+    return;
+  }
+
+  for (size_t i = 0; i < candidates_.size(); ++i) {
+    if (candidates_[i] == thread_count) {
+      const double duration_us = std::chrono::duration<double, std::micro>(duration).count();
+      entry.fastest_duration_us[i] = std::min(entry.fastest_duration_us[i], duration_us);
+      break;
+    }
+  }
+
+  if (++entry.num_durations < candidates_.size() * num_tuning_runs_) {
+    return;
+  }
+
+  const double fastest = *std::min_element(entry.fastest_duration_us.begin(), entry.fastest_duration_us.end());
+  size_t selected = candidates_.size() - 1;
+  for (size_t i = 0; i < candidates_.size(); ++i) {
+    if (entry.fastest_duration_us[i] <= fastest * (1.0 + kSlowdownTolerance)) {
+      selected = i;
+      break;
+    }
+  }
+
+  // The full pool is stored as no limit, so that the thread counts carry over to machines with more cores.
+  entry.thread_count.store(selected + 1 == candidates_.size() ? 0 : candidates_[selected], std::memory_order_release);
+  entry.fastest_duration_us.clear();
+  updated_ = true;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/platform/path_lib.h"
+
+namespace onnxruntime {
+
+/**
+ * Number of intra-op threads each node of a session runs with.
+ *
+ * Small kernels often lose more time to the fork/join of a parallel loop than they gain from the extra threads.
+ * The executor caps the degree of parallelism a kernel sees (ThreadPool::DegreeOfParallelism and the parallel
+ * loops of the pool) at the thread count of its node, so such kernels use a narrowed view of the pool.
+ *
+ * The thread counts are loaded from a file written by an earlier session, or learned during the first runs of
+ * the session. While learning, each execution of a node uses the next candidate thread count
+ * (1, 2, 4, ..., all threads) until every candidate was measured num_tuning_runs times. The node then keeps the
+ * smallest thread count whose fastest execution is within 5% of the fastest execution of all candidates.
+ *
+ * The file is a json object keyed by the unique node names of IResourceAccountant::MakeUniqueNodeName:
+ * {"node_thread_counts":{"MatMul_1234":4,"Add_5678":1}}
+ * A thread count of 0 means the node uses all the threads of the pool. Control flow nodes have no entry, so that
+ * the nodes of their subgraphs run with their own thread counts.
+ */
+class NodeThreadCounts {
+ public:
+  struct Entry {
+    // The thread count of the node once known, 0 for no limit, or -1 while it is learned.
+    std::atomic<int> thread_count{-1};
+
+    // Learning state, guarded by the mutex of the owning NodeThreadCounts.
+    size_t num_executions = 0;
+    size_t num_durations = 0;
+    InlinedVector<double> fastest_duration_us;
+  };
+
+  /**
+   * @param max_thread_count Degree of parallelism of the intra-op thread pool.
+   * @param num_tuning_runs Number of times each candidate thread count is measured for a node whose thread count
+   *                        is not known. 0 disables learning and such nodes use all threads.
+   */
+  NodeThreadCounts(int max_thread_count, size_t num_tuning_runs);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(NodeThreadCounts);
+
+  Status Load(const PathString& file_path);
+  Status Save(const PathString& file_path) const;
+
+  // Saves the thread counts if nodes finished learning since the last call.
+  Status SaveIfUpdated(const PathString& file_path);
+
+  // Returns the entry of a node. Must be called before the session runs, the entries are not added concurrently.
+  Entry& GetOrAddEntry(const std::string& unique_node_name);
+
+  /**
+   * Returns the thread count to run the next execution of a node with, 0 for no limit.
+   * `tuning` is set if the duration of the execution should be passed to ReportDuration().
+   */
+  int GetThreadCount(Entry& entry, bool& tuning) {
+    const int thread_count = entry.thread_count.load(std::memory_order_acquire);
+    if (thread_count >= 0) {
+      tuning = false;
+      return thread_count;
+    }
+    return GetTuningThreadCount(entry, tuning);
+  }
+
+  void ReportDuration(Entry& entry, int thread_count, std::chrono::nanoseconds duration);
+
+ private:
+  int GetTuningThreadCount(Entry& entry, bool& tuning);
+
+  const size_t num_tuning_runs_;
+  InlinedVector<int> candidates_;  // the last one is the full pool
+
+  // Entries are never removed, so their addresses are stable.
+  InlinedHashMap<std::string, std::unique_ptr<Entry>> entries_;
+
+  std::mutex mutex_;
+  bool updated_ = false;  // GUARDED_BY(mutex_)
+
+  // Serializes the writes of SaveIfUpdated(), acquired before mutex_.
+  std::mutex save_mutex_;
+};
+
+}  // namespace onnxruntime
@@ -37,7 +37,10 @@ common::Status OrtValuePatternPlanner::TraceAllocation(int ort_value_idx, size_t
     return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT);
   }
 
+  // Record the events in the order the planner sees them.
+  std::lock_guard<std::mutex> lock(trace_mutex_);
   it->second.TraceAllocation(ort_value_idx, size);
+  trace_.events.push_back({ort_value_idx, size, false});
   return common::Status::OK();
 }
 
@@ -48,7 +51,9 @@ common::Status OrtValuePatternPlanner::TraceFree(int ort_value_index) {
     return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT);
   }
 
+  std::lock_guard<std::mutex> lock(trace_mutex_);
   it->second.TraceFree(ort_value_index);
+  trace_.events.push_back({ort_value_index, 0, true});
   return common::Status::OK();
 }
 
@@ -63,4 +68,9 @@ common::Status OrtValuePatternPlanner::GeneratePatterns(MemoryPatternGroup& out)
   return common::Status::OK();
 }
 
+MemoryPatternTrace OrtValuePatternPlanner::GetTrace() const {
+  std::lock_guard<std::mutex> lock(trace_mutex_);
+  return trace_;
+}
+
 }  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #pragma once
 #include <vector>
 #include <memory>
+#include <mutex>
 
 #include "core/common/common.h"
 #include "core/common/inlined_containers.h"
@@ -28,6 +29,8 @@ class OrtValuePatternPlanner {
   common::Status TraceAllocation(int ort_value_idx, size_t size);
   common::Status TraceFree(int ort_value_index);
   common::Status GeneratePatterns(MemoryPatternGroup& out);
+  // Returns the allocations and frees traced so far.
+  MemoryPatternTrace GetTrace() const;
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(OrtValuePatternPlanner);
 
  private:
@@ -35,5 +38,8 @@ class OrtValuePatternPlanner {
   // MemPatternPlanner has copying disabled to using node map
   NodeHashMap<OrtDevice, MemPatternPlanner> planner_map_;
   const ExecutionPlanBase& execution_planner_;
+
+  mutable std::mutex trace_mutex_;
+  MemoryPatternTrace trace_;  // GUARDED_BY(trace_mutex_)
 };
 }  // namespace onnxruntime
@@ -29,8 +29,10 @@ AllocatorPtr PrepackedWeightsContainer::GetOrCreateAllocator(const std::string&
   if (device_name == CPU) {
     // TODO: Investigate benefits of using an arena based allocator
     // For now, we go with a non-arena based allocator
+    OrtArenaCfg arena_cfg{0, -1, -1, -1, -1, -1L};
+    arena_cfg.huge_page_mode = huge_page_mode_;
     AllocatorCreationInfo device_info{[](int) { return std::make_unique<CPUAllocator>(); },
-                                      0, false};
+                                      0, false, arena_cfg};
     auto allocator = CreateAllocator(device_info);
 
     allocators_[device_name] = allocator;
@@ -28,6 +28,11 @@ class PrepackedWeightsContainer final {
   PrepackedWeightsContainer() {
   }
 
+  // The buffers of at least a huge page are backed by huge pages, as configured by arena_cfg.huge_page_mode.
+  // The other settings of arena_cfg are ignored, the pre-packed buffers are not allocated from an arena.
+  explicit PrepackedWeightsContainer(const OrtArenaCfg& arena_cfg) : huge_page_mode_(arena_cfg.huge_page_mode) {
+  }
+
   ~PrepackedWeightsContainer() = default;
 
   // Returns an allocator keyed by device name.
@@ -71,6 +76,9 @@ class PrepackedWeightsContainer final {
   // to PrePackedWeights instances.
   // The key is : op_type + "+" + hash_of_prepacked_buffers_in_the_PrepackedWeights_instance.
   std::unordered_map<std::string, PrePackedWeights> prepacked_weights_map_;
+
+ private:
+  int huge_page_mode_ = -1;
 };
 
 // Maps a pre-packed weight blob key to PrepackedWeights instance
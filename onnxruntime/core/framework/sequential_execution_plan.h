@@ -35,6 +35,11 @@ struct AllocPlanPerValue {
   // reused_buffer is valid only if alloc_kind == kReuse. It indicates
   // which OrtValue's buffer must be reused for this OrtValue.
   OrtValueIndex reused_buffer{0};
+  // bound_output is valid only if alloc_kind == kAllocate or kReuse. For kAllocate, it indicates the graph
+  // output whose buffer this OrtValue is written to if the caller provides one of the same size, as the graph
+  // output aliases this OrtValue. For kReuse, it indicates that this OrtValue is one of the aliases in between,
+  // which share that buffer, unlike the other OrtValues reusing the buffer. -1 if there is none.
+  OrtValueIndex bound_output{-1};
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   IntervalT life_interval{0, 0};
   IntervalT allocate_interval{0, 0};
@@ -4,6 +4,7 @@
 #include "core/framework/sequential_executor.h"
 
 #include <chrono>
+#include <optional>
 #include <thread>
 #include <vector>
 #include <sstream>
@@ -344,6 +345,14 @@ class KernelScope {
     node_compute_range_.Begin();
 #endif
 
+#if !defined(ORT_MINIMAL_BUILD)
+    // Attribute the allocations of the kernel to its node in the allocation timeline.
+    if (session_state_.GetAllocationTimeline() != nullptr) {
+      auto& node = kernel.Node();
+      timeline_attribution_.emplace(node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name());
+    }
+#endif
+
     if (session_state_.Profiler().IsEnabled()) {
       auto& node = kernel.Node();
       node_name_ = node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name();
@@ -428,7 +437,56 @@ class KernelScope {
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
   utils::NodeDumpContext dump_context_;
 #endif
+
+#if !defined(ORT_MINIMAL_BUILD)
+  std::optional<AllocationTimeline::ScopedAttribution> timeline_attribution_;
+#endif
+};
+
+#if !defined(ORT_MINIMAL_BUILD)
+// Caps the intra-op parallelism of a kernel at the thread count of its node, and reports the duration of the
+// kernel while the thread count of the node is learned.
+class NodeThreadCountScope {
+ public:
+  NodeThreadCountScope(const SessionState& session_state, NodeIndex node_index)
+      : entry_(session_state.GetNodeThreadCountEntry(node_index)) {
+    if (entry_ == nullptr) {
+      return;
+    }
+
+    node_thread_counts_ = session_state.GetNodeThreadCounts();
+    thread_count_ = node_thread_counts_->GetThreadCount(*entry_, tuning_);
+    if (thread_count_ > 0) {
+      // The thread count of the node does not lift a lower limit set for the whole Run.
+      auto options = concurrency::ThreadPool::GetSchedulingOptions();
+      if (options.max_degree_of_parallelism == 0 || thread_count_ < options.max_degree_of_parallelism) {
+        options.max_degree_of_parallelism = thread_count_;
+        scheduling_scope_.emplace(nullptr, options);
+      }
+    }
+
+    if (tuning_) {
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~NodeThreadCountScope() {
+    if (tuning_) {
+      node_thread_counts_->ReportDuration(*entry_, thread_count_, std::chrono::steady_clock::now() - start_);
+    }
+  }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(NodeThreadCountScope);
+
+ private:
+  NodeThreadCounts::Entry* entry_;
+  NodeThreadCounts* node_thread_counts_ = nullptr;
+  int thread_count_ = 0;
+  bool tuning_ = false;
+  std::chrono::steady_clock::time_point start_;
+  std::optional<concurrency::ThreadPool::ScopedSchedulingOptions> scheduling_scope_;
 };
+#endif
 
 onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
                                   NodeIndex idx,
@@ -458,6 +516,9 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
     ORT_THROW("Async Kernel Support is not implemented yet.");
   } else {
     KernelScope kernel_scope(session_scope, kernel_ctx, *p_kernel);
+#if !defined(ORT_MINIMAL_BUILD)
+    NodeThreadCountScope node_thread_count_scope(ctx.GetSessionState(), idx);
+#endif
     ORT_TRY {
 #ifdef ENABLE_TRAINING
       // AllocateInputsContiguously - is only required for NCCL kernels
@@ -650,6 +711,10 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
 
   ctx.WaitAll();
   ORT_RETURN_IF_ERROR(ctx.TaskStatus());
+  // Kernels stop their parallel loops early once the Run is cancelled, so the outputs of the last nodes
+  // may be incomplete even if every node returned OK.
+  ORT_RETURN_IF(terminate_flag, "Exiting due to terminate flag being set to true.");
+  ORT_RETURN_IF(concurrency::ThreadPool::IsCancelled(), "Exiting because the deadline of the Run has passed.");
   ORT_RETURN_IF_ERROR(ctx.GetExecutionFrame().GetOutputs(fetches));
   if (ctx.GetExecutionFrame().HasMemoryPatternPlanner()) {
     bool all_tensors = true;
@@ -662,8 +727,10 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
 
     if (all_tensors) {
       MemoryPatternGroup mem_patterns;
-      ORT_RETURN_IF_ERROR(ctx.GetExecutionFrame().GeneratePatterns(mem_patterns));
-      ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(feeds, std::move(mem_patterns)));
+      MemoryPatternTrace trace;
+      ORT_RETURN_IF_ERROR(ctx.GetExecutionFrame().GeneratePatterns(mem_patterns, &trace));
+      ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(feeds, feed_mlvalue_idxs,
+                                                                      std::move(mem_patterns), &trace));
     }
   }
 
@@ -28,6 +28,7 @@ enum class ExecutionOrder {
   DEFAULT = 0,           // default topological sort
   PRIORITY_BASED = 1,    // priority-based topological sort
   MEMORY_EFFICIENT = 2,  // memory-efficient topological sort for training purposes.
+  CRITICAL_PATH = 3,     // cost-guided topological sort, built by the allocation planner from per-node costs.
 };
 
 inline std::ostream& operator<<(std::ostream& os, const ExecutionOrder& order) {
@@ -41,6 +42,9 @@ inline std::ostream& operator<<(std::ostream& os, const ExecutionOrder& order) {
     case ExecutionOrder::MEMORY_EFFICIENT:
       os << "MEMORY_EFFICIENT";
       break;
+    case ExecutionOrder::CRITICAL_PATH:
+      os << "CRITICAL_PATH";
+      break;
     default:
       os << "UNKNOWN";
       break;
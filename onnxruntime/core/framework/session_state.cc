@@ -3,10 +3,13 @@
 
 #include "core/framework/session_state.h"
 
+#include <limits>
 #include <sstream>
 
 #include <mutex>
 #include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
+#include "core/common/path_string.h"
 #include "core/common/safeint.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/framework/allocator.h"
@@ -14,6 +17,7 @@
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/resource_accountant.h"
 #include "core/framework/session_state_utils.h"
 #include "core/framework/utils.h"
 #include "core/providers/cpu/controlflow/utils.h"
@@ -108,6 +112,10 @@ SessionState::SessionState(Graph& graph,
 {
   enable_mem_pattern_ = sess_options_.enable_mem_pattern &&
                         sess_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL;
+  const std::string cache_size_str =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternCacheSize, "64");
+  ORT_ENFORCE(TryParseStringWithClassicLocale(cache_size_str, mem_patterns_cache_size_) && mem_patterns_cache_size_ > 0,
+              "Invalid value for ", kOrtSessionOptionsConfigMemoryPatternCacheSize, ": ", cache_size_str);
   if (parent_allocators) {
     allocators_ = parent_allocators;
     initializer_allocators_ = parent_initializer_allocators;
@@ -135,6 +143,14 @@ SessionState::SessionState(Graph& graph,
   }
 }
 
+SessionState::~SessionState() {
+  if (prepacked_weights_store_ != nullptr) {
+    // The kernels may refer to the pre-packed buffers, so destroy them before releasing the buffers.
+    session_kernels_.clear();
+    prepacked_weights_store_->ReleasePrepackedWeights(used_prepacked_weights_keys_);
+  }
+}
+
 AllocatorPtr SessionState::GetAllocator(const OrtMemoryInfo& location) const noexcept {
   return GetAllocator(location.device);
 }
@@ -529,6 +545,7 @@ Status SessionState::PrepackConstantInitializedTensors(
                                                                           node.Name()));
 
                       ++used_shared_pre_packed_weights_counter_;
+                      AddPrepackedWeightsUser(prepacked_weights_container_key);
 
                       // Write references to what is stored in the shared container
                       // and release memory mapped entries this container may have loaded from disk
@@ -570,6 +587,7 @@ Status SessionState::PrepackConstantInitializedTensors(
                       ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
                                                                           shared_prepacked,
                                                                           node.Name()));
+                      AddPrepackedWeightsUser(prepacked_weights_container_key);
                     }
                   }
 
@@ -627,6 +645,7 @@ Status SessionState::PrepackConstantInitializedTensors(
                     // release the constant initialized tensor
                     st->initialized_tensors_.erase(ort_value_idx);
                     constant_initialized_tensors.erase(ort_value_idx);
+                    st->shared_initializers_.erase(ort_value_idx);
                   }
                 }
               }
@@ -651,6 +670,11 @@ Status SessionState::PrepackConstantInitializedTensors(
   bool should_cache_prepacked_weights_for_shared_initializers = (prepacked_weights_container_ != nullptr);
 
   if (should_cache_prepacked_weights_for_shared_initializers) {
+    if (auto* store = GetSharedInitializerStore();
+        store != nullptr && prepacked_weights_container_ == &store->GetPrepackedWeightsContainer()) {
+      prepacked_weights_store_ = store;
+    }
+
     // serialize calls to the method that looks up the container, calls UseCachedPrePackedWeight/PrePack
     // and writes pre-packed weights to the container
     std::lock_guard<std::mutex> l(prepacked_weights_container_->mutex_);
@@ -660,6 +684,13 @@ Status SessionState::PrepackConstantInitializedTensors(
   }
 }
 
+void SessionState::AddPrepackedWeightsUser(const std::string& key) {
+  if (prepacked_weights_store_ != nullptr) {
+    prepacked_weights_store_->AddPrepackedWeightsUser(key);
+    used_prepacked_weights_keys_.push_back(key);
+  }
+}
+
 static int64_t
 CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs) {
   int64_t key = 0;
@@ -903,38 +934,69 @@ Status SessionState::GeneratePatternGroupCache(gsl::span<const OrtValue> tensor_
 
 #endif
 
-// MemoryPatternGroup pointer is cached. It only inserted upon creation
+std::shared_ptr<const SessionState::CachedMemoryPattern> SessionState::InsertMemoryPatternLocked(
+    int64_t key, CachedMemoryPattern cached) const {
+  auto entry = std::make_shared<const CachedMemoryPattern>(std::move(cached));
+  auto it = mem_patterns_.find(key);
+  if (it != mem_patterns_.end()) {
+    mem_patterns_lru_.erase(it->second);
+    mem_patterns_.erase(it);
+  }
+
+  mem_patterns_lru_.emplace_front(key, entry);
+  mem_patterns_.insert_or_assign(key, mem_patterns_lru_.begin());
+  while (mem_patterns_lru_.size() > mem_patterns_cache_size_) {
+    // Frames that use the evicted pattern keep it alive.
+    mem_patterns_.erase(mem_patterns_lru_.back().first);
+    mem_patterns_lru_.pop_back();
+  }
+  return entry;
+}
+
+// MemoryPatternGroup is cached in an LRU. It is only inserted upon creation
 // and is not updated if already present.
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
+std::shared_ptr<const MemoryPatternGroup> SessionState::GetMemoryPatternGroup(
     gsl::span<const OrtValue> tensor_inputs,
     gsl::span<const int> feed_mlvalue_idxs,
     const InlinedHashMap<int, TensorShape>*& out_inferred_shapes) const {
   out_inferred_shapes = nullptr;
   int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
   std::lock_guard<std::mutex> lock(mem_patterns_lock_);
+
+  std::shared_ptr<const CachedMemoryPattern> entry;
   auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
+  if (it != mem_patterns_.end()) {
+    mem_patterns_lru_.splice(mem_patterns_lru_.begin(), mem_patterns_lru_, it->second);
+    entry = it->second->second;
+  } else {
 #ifdef ENABLE_TRAINING
-    MemoryPatternGroup mem_patterns;
+    CachedMemoryPattern inferred;
     InlinedHashMap<int, TensorShape> inferred_shapes;
-    if (GeneratePatternGroupCache(tensor_inputs, feed_mlvalue_idxs, mem_patterns, inferred_shapes).IsOK()) {
-      auto patt_insert = mem_patterns_.insert_or_assign(key, std::move(mem_patterns));
-      auto ptr = &patt_insert.first->second;
-      auto shape_insert = shape_patterns_.insert_or_assign(key, std::move(inferred_shapes));
-      out_inferred_shapes = &shape_insert.first->second;
-      return ptr;
+    if (GeneratePatternGroupCache(tensor_inputs, feed_mlvalue_idxs, inferred.mem_patterns, inferred_shapes).IsOK()) {
+      inferred.inferred_shapes = std::move(inferred_shapes);
+      entry = InsertMemoryPatternLocked(key, std::move(inferred));
     }
-#else
-    ORT_UNUSED_PARAMETER(feed_mlvalue_idxs);
 #endif
-    return nullptr;
+    if (entry == nullptr && symbolic_mem_pattern_ != nullptr) {
+      CachedMemoryPattern cached;
+      auto status = symbolic_mem_pattern_->Generate(feed_mlvalue_idxs, tensor_inputs, cached.mem_patterns);
+      if (status.IsOK()) {
+        entry = InsertMemoryPatternLocked(key, std::move(cached));
+      } else {
+        LOGS(logger_, VERBOSE) << "Failed to generate the memory pattern of the input shapes: "
+                               << status.ErrorMessage();
+      }
+    }
+
+    if (entry == nullptr) {
+      return nullptr;
+    }
   }
 
-  auto patt_hit = shape_patterns_.find(key);
-  if (patt_hit != shape_patterns_.cend()) {
-    out_inferred_shapes = &patt_hit->second;
+  if (entry->inferred_shapes.has_value()) {
+    out_inferred_shapes = &*entry->inferred_shapes;
   }
-  return &it->second;
+  return std::shared_ptr<const MemoryPatternGroup>(entry, &entry->mem_patterns);
 }
 
 void SessionState::ResolveMemoryPatternFlag() {
@@ -984,12 +1046,28 @@ void SessionState::ResolveMemoryPatternFlag() {
 }
 
 Status SessionState::UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
-                                                   MemoryPatternGroup mem_patterns) const {
+                                                   gsl::span<const int> feed_mlvalue_idxs,
+                                                   MemoryPatternGroup mem_patterns,
+                                                   const MemoryPatternTrace* trace) const {
   int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
 
   std::lock_guard<std::mutex> lock(mem_patterns_lock_);
-  // Do not update if present, as the pointer to the existing one is cached
-  mem_patterns_.emplace(key, std::move(mem_patterns));
+  if (trace != nullptr && !symbolic_mem_pattern_attempted_) {
+    symbolic_mem_pattern_attempted_ = true;
+    symbolic_mem_pattern_ = SymbolicMemoryPattern::Create(*graph_viewer_, ort_value_name_idx_map_,
+                                                          *GetExecutionPlan(), feed_mlvalue_idxs, tensor_inputs,
+                                                          *trace);
+    LOGS(logger_, VERBOSE) << (symbolic_mem_pattern_ != nullptr
+                                   ? "Memory patterns of other input shapes are generated from the traced run."
+                                   : "Memory patterns depend on more than the symbolic dimensions of the inputs.");
+  }
+
+  // Do not update if present, as frames may use the existing one
+  if (mem_patterns_.find(key) == mem_patterns_.end()) {
+    CachedMemoryPattern cached;
+    cached.mem_patterns = std::move(mem_patterns);
+    InsertMemoryPatternLocked(key, std::move(cached));
+  }
   return Status::OK();
 }
 
@@ -1541,9 +1619,21 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   SubgraphsKernelCreateInfoMaps subgraphs_kernel_create_info_maps;
   AccumulateAllNestedSubgraphsInfo(*this, "", 0, subgraphs_kernel_create_info_maps);
 
-  SequentialPlannerContext context(session_options.execution_mode,
-                                   session_options.execution_order,
-                                   session_options.enable_mem_reuse);
+  NodeExecutionCosts node_execution_costs;
+  bool has_node_execution_costs = false;
+  if (session_options.execution_order == ExecutionOrder::CRITICAL_PATH) {
+    const std::string profile_file =
+        session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigNodeCostProfileFile, "");
+    if (!profile_file.empty()) {
+      auto load_status = LoadNodeExecutionCosts(ToPathString(profile_file), node_execution_costs);
+      if (load_status.IsOK()) {
+        has_node_execution_costs = true;
+      } else {
+        LOGS(logger_, WARNING) << "Estimating node costs from shapes for the critical path order. "
+                               << load_status.ErrorMessage();
+      }
+    }
+  }
 
 #ifdef _WIN32
 
@@ -1559,18 +1649,72 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
 
 #endif
 
-  auto status = SequentialPlanner::CreatePlan(parent_node, *graph_viewer_, valid_outer_scope_node_args,
-                                              execution_providers_, kernel_create_info_map_,
-                                              subgraphs_kernel_create_info_maps,
-                                              outer_scope_node_arg_to_location_map,
-                                              ort_value_name_idx_map_, context,
+  auto create_plan = [&](ExecutionOrder execution_order, bool enable_mem_reuse) {
+    SequentialPlannerContext context(session_options.execution_mode,
+                                     execution_order,
+                                     enable_mem_reuse,
+                                     has_node_execution_costs ? &node_execution_costs : nullptr);
+
+    return SequentialPlanner::CreatePlan(parent_node, *graph_viewer_, valid_outer_scope_node_args,
+                                         execution_providers_, kernel_create_info_map_,
+                                         subgraphs_kernel_create_info_maps,
+                                         outer_scope_node_arg_to_location_map,
+                                         ort_value_name_idx_map_, context,
 #ifdef ORT_ENABLE_STREAM
-                                              GetStreamHandleRegistryInstance(),
+                                         GetStreamHandleRegistryInstance(),
 #endif
-                                              partition_config_file,
-                                              Logger(),
-                                              p_seq_exec_plan_);
-  ORT_RETURN_IF_ERROR(status);
+                                         partition_config_file,
+                                         Logger(),
+                                         p_seq_exec_plan_);
+  };
+  ORT_RETURN_IF_ERROR(create_plan(session_options.execution_order, session_options.enable_mem_reuse));
+
+  const std::string memory_budget_str =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryBudgetBytes, "0");
+  size_t memory_budget = 0;
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(memory_budget_str, memory_budget),
+                    "Invalid value for ", kOrtSessionOptionsConfigMemoryBudgetBytes, ": ", memory_budget_str);
+  if (memory_budget > 0 && parent_ == nullptr) {
+    // The configured plan is tried first, then the other execution orders with memory reuse.
+    InlinedVector<std::pair<ExecutionOrder, bool>> candidates{
+        {session_options.execution_order, session_options.enable_mem_reuse}};
+    for (ExecutionOrder execution_order : {ExecutionOrder::DEFAULT,
+#if !defined(ORT_MINIMAL_BUILD)
+                                           ExecutionOrder::PRIORITY_BASED,
+#endif
+#ifdef ENABLE_TRAINING
+                                           ExecutionOrder::MEMORY_EFFICIENT,
+#endif
+                                           ExecutionOrder::CRITICAL_PATH}) {
+      if (execution_order != session_options.execution_order || !session_options.enable_mem_reuse) {
+        candidates.emplace_back(execution_order, true);
+      }
+    }
+
+    size_t smallest_peak_bytes = std::numeric_limits<size_t>::max();
+    for (size_t i = 0; i < candidates.size(); ++i) {
+      if (i > 0) {
+        ORT_RETURN_IF_ERROR(create_plan(candidates[i].first, candidates[i].second));
+      }
+
+      size_t peak_bytes = 0;
+      auto estimate_status = EstimatePeakActivationBytes(*p_seq_exec_plan_, *graph_viewer_, ort_value_name_idx_map_,
+                                                         peak_bytes);
+      ORT_RETURN_IF_NOT(estimate_status.IsOK(), "The memory budget set with ", kOrtSessionOptionsConfigMemoryBudgetBytes,
+                        " cannot be checked: ", estimate_status.ErrorMessage());
+      if (peak_bytes <= memory_budget) {
+        LOGS(logger_, INFO) << "Using the plan with execution order " << candidates[i].first
+                            << " whose peak activation memory of " << peak_bytes
+                            << " bytes fits the memory budget of " << memory_budget << " bytes.";
+        break;
+      }
+
+      smallest_peak_bytes = std::min(smallest_peak_bytes, peak_bytes);
+      ORT_RETURN_IF(i + 1 == candidates.size(), "No execution plan fits the memory budget of ", memory_budget,
+                    " bytes set with ", kOrtSessionOptionsConfigMemoryBudgetBytes,
+                    ". The smallest peak activation memory of the plans is ", smallest_peak_bytes, " bytes.");
+    }
+  }
 
   if (session_options.IsLoadCancellationFlagSet()) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED,
@@ -1656,7 +1800,15 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
         return Status::OK();
       },
       logger_, data_transfer_mgr_, external_data_loader_mgr_, *p_seq_exec_plan_, session_options,
-      memory_profile_func, graph_.GetPrepacked()));
+      memory_profile_func, graph_.GetPrepacked(), GetSharedInitializerStore(), shared_initializers_));
+
+  if (!shared_initializers_.empty()) {
+    const auto stats = GetSharedInitializerStore()->GetStats();
+    LOGS(logger_, INFO) << "Loaded " << shared_initializers_.size()
+                        << " initializers through the shared initializer store. The store holds "
+                        << stats.num_initializers << " initializers (" << stats.unique_bytes
+                        << " bytes) and saves " << stats.saved_bytes << " bytes across sessions.";
+  }
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Record Weight allocation info on device
@@ -1672,6 +1824,21 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
 
   ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // Only kernels of the CPU EP run on the intra-op thread pool of the session. Control flow nodes get no thread
+  // count: their duration includes the execution of their subgraphs, whose nodes have thread counts of their own
+  // and must not inherit the limit of the control flow node.
+  if (auto* node_thread_counts = GetNodeThreadCounts(); node_thread_counts != nullptr) {
+    node_thread_count_entries_.assign(static_cast<size_t>(graph_viewer_->MaxNodeIndex()), nullptr);
+    for (const auto& node : graph_viewer_->Nodes()) {
+      if (node.GetExecutionProviderType() == kCpuExecutionProvider && !node.ContainsSubgraph()) {
+        node_thread_count_entries_[node.Index()] =
+            &node_thread_counts->GetOrAddEntry(IResourceAccountant::MakeUniqueNodeName(node));
+      }
+    }
+  }
+#endif
+
   if (!disable_prepacking) {
     ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
                                                           session_options.initializers_to_share_map));
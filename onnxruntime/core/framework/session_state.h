@@ -3,8 +3,10 @@
 
 #pragma once
 
+#include <list>
 #include <memory>
 #include <map>
+#include <optional>
 #include <unordered_map>
 #include <string>
 #include <vector>
@@ -18,6 +20,7 @@
 #include "core/common/logging/logging.h"
 #include "core/common/profiler.h"
 #include "core/framework/allocation_planner.h"
+#include "core/framework/allocation_timeline.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/external_data_loader_manager.h"
 #include "core/framework/execution_providers.h"
@@ -28,10 +31,13 @@
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/mem_pattern.h"
+#include "core/framework/node_thread_counts.h"
 #include "core/framework/ort_value.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/shared_initializer_store.h"
+#include "core/framework/symbolic_mem_pattern.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/onnx_protobuf.h"
 #include <mutex>
@@ -101,8 +107,7 @@ class SessionState {
                AllocatorMap* parent_allocators = nullptr,
                AllocatorMap* parent_initializer_allocators = nullptr);
 
-  ~SessionState() {
-  }
+  ~SessionState();
 
   // Graph viewer. CreateGraphInfo must have been called previously.
   const GraphViewer& GetGraphViewer() const noexcept { return *graph_viewer_; };
@@ -226,8 +231,11 @@ class SessionState {
   made under mutex being held. In inference scenarios,
   it is not mutable, we do not obtain a lock and simply get a pointer
   w/o copying a hashtable
+  On a cache miss, the pattern is generated from the symbolic memory pattern if one was
+  recorded for the model. The returned pointer keeps the inferred shapes alive, as the
+  entry may be evicted from the cache while the caller uses it.
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(
+  std::shared_ptr<const MemoryPatternGroup> GetMemoryPatternGroup(
       gsl::span<const OrtValue> tensor_inputs,
       gsl::span<const int> feed_mlvalue_idxs,
       const InlinedHashMap<int, TensorShape>*& inferred_shapes) const;
@@ -236,9 +244,13 @@ class SessionState {
   Set generated memory pattern with a given input shapes.
   Const as it's an internal cache update only.
   All inputs must represent Tensors
+  If trace is not null, the first trace is used to create the symbolic memory pattern
+  that generates the patterns of other input shapes.
   */
   Status UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
-                                       MemoryPatternGroup mem_patterns) const;
+                                       gsl::span<const int> feed_mlvalue_idxs,
+                                       MemoryPatternGroup mem_patterns,
+                                       const MemoryPatternTrace* trace = nullptr) const;
 
   bool GetUseDeterministicCompute() const { return sess_options_.use_deterministic_compute; }
 
@@ -373,6 +385,21 @@ class SessionState {
   /// <returns>true of false
   bool GetSaveModeForPrepacks(bool saving_model, bool saving_ort_format);
 
+  void SetSharedInitializerStore(SharedInitializerStore* shared_initializer_store) {
+    shared_initializer_store_ = shared_initializer_store;
+  }
+
+  /**
+   * Returns a pointer to the store of the initializers shared by content with other sessions, if enabled.
+   * The object pointer is only present at the root SessionState object
+   */
+  SharedInitializerStore* GetSharedInitializerStore() const {
+    if (parent_ != nullptr) {
+      return parent_->GetSharedInitializerStore();
+    }
+    return shared_initializer_store_;
+  }
+
 #if !defined(ORT_MINIMAL_BUILD)
 
   void SetNodeStatsRecorder(NodeStatsRecorder* node_stats_recorder) {
@@ -389,6 +416,44 @@ class SessionState {
     }
     return node_stats_recorder_;
   }
+
+  void SetNodeThreadCounts(NodeThreadCounts* node_thread_counts) {
+    node_thread_counts_ = node_thread_counts;
+  }
+
+  /**
+   * Returns a pointer to the per-node intra-op thread counts if they are enabled for the session.
+   * The object pointer is only present at the root SessionState object
+   */
+  NodeThreadCounts* GetNodeThreadCounts() const {
+    if (parent_ != nullptr) {
+      return parent_->GetNodeThreadCounts();
+    }
+    return node_thread_counts_;
+  }
+
+  /**
+   * Returns the thread count entry of a node of this graph, or nullptr if the node runs with all the threads of
+   * the intra-op thread pool.
+   */
+  NodeThreadCounts::Entry* GetNodeThreadCountEntry(NodeIndex node_index) const {
+    return node_index < node_thread_count_entries_.size() ? node_thread_count_entries_[node_index] : nullptr;
+  }
+
+  void SetAllocationTimeline(AllocationTimeline* allocation_timeline) {
+    allocation_timeline_ = allocation_timeline;
+  }
+
+  /**
+   * Returns a pointer to the AllocationTimeline object if it was enabled for the session.
+   * The object pointer is only present at the root SessionState object
+   */
+  AllocationTimeline* GetAllocationTimeline() const {
+    if (parent_ != nullptr) {
+      return parent_->GetAllocationTimeline();
+    }
+    return allocation_timeline_;
+  }
 #endif
 
  private:
@@ -411,6 +476,9 @@ class SessionState {
   Status PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
                                            const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map);
 
+  // Records that a kernel uses the pre-packed weight with the given key of prepacked_weights_container_.
+  void AddPrepackedWeightsUser(const std::string& key);
+
   SessionState* GetMutableSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name);
 
   Status CreateSubgraphSessionState();
@@ -513,23 +581,42 @@ class SessionState {
 
 #if !defined(ORT_MINIMAL_BUILD)
   NodeStatsRecorder* node_stats_recorder_ = nullptr;
+  NodeThreadCounts* node_thread_counts_ = nullptr;
+  // Entries of node_thread_counts_ for the nodes of this graph, indexed by node index.
+  InlinedVector<NodeThreadCounts::Entry*> node_thread_count_entries_;
+  AllocationTimeline* allocation_timeline_ = nullptr;
 #endif
 
+  SharedInitializerStore* shared_initializer_store_ = nullptr;
+  // Initializers of this graph shared with other sessions by OrtValue index. Keeps them in the shared initializer
+  // store until they are released after pre-packing.
+  std::unordered_map<int, std::shared_ptr<const OrtValue>> shared_initializers_;
+
   // switch for enable memory pattern optimization or not.
   bool enable_mem_pattern_;
 
+  struct CachedMemoryPattern {
+    MemoryPatternGroup mem_patterns;
+    // Only set for the patterns generated from the inferred shapes in training scenarios.
+    std::optional<InlinedHashMap<int, TensorShape>> inferred_shapes;
+  };
+  using MemoryPatternCacheEntry = std::pair<int64_t, std::shared_ptr<const CachedMemoryPattern>>;
+
+  // Inserts the entry as the most recently used one and evicts the least recently used entries
+  // beyond mem_patterns_cache_size_. mem_patterns_lock_ must be held.
+  std::shared_ptr<const CachedMemoryPattern> InsertMemoryPatternLocked(int64_t key, CachedMemoryPattern cached) const;
+
   // lock for the mem_patterns_
   mutable std::mutex mem_patterns_lock_;
-  // cache for the generated mem_patterns. key is calculated based on input shapes.
-  // must be a node based container as a pointer is cached.
-  mutable NodeHashMap<int64_t, MemoryPatternGroup> mem_patterns_;
-  // This is mutable under mutex in training scenarios so execution frame would make a copy
-  // of the value when created.
-#ifdef ENABLE_TRAINING
-  mutable NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
-#else
-  NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
-#endif
+  // LRU cache for the generated mem_patterns. key is calculated based on input shapes.
+  // The front is the most recently used entry. Execution frames share the ownership of their entry.
+  mutable std::list<MemoryPatternCacheEntry> mem_patterns_lru_;
+  mutable InlinedHashMap<int64_t, std::list<MemoryPatternCacheEntry>::iterator> mem_patterns_;
+  // Maximum number of entries of the cache. Set with kOrtSessionOptionsConfigMemoryPatternCacheSize.
+  size_t mem_patterns_cache_size_ = 64;
+  // Generates the patterns of the input shapes that are not cached. Created from the first traced run.
+  mutable std::unique_ptr<SymbolicMemoryPattern> symbolic_mem_pattern_;
+  mutable bool symbolic_mem_pattern_attempted_ = false;
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -554,6 +641,12 @@ class SessionState {
   // prepacked_weights_container_ can be nullptr if no caching is required for prepacked weights
   PrepackedWeightsContainer* const prepacked_weights_container_{};
 
+  // Set if prepacked_weights_container_ is the container of the shared initializer store, which removes the
+  // pre-packed weights once no session uses them. Keys of the pre-packed weights of the container used by the
+  // kernels of this graph, released on destruction.
+  SharedInitializerStore* prepacked_weights_store_ = nullptr;
+  std::vector<std::string> used_prepacked_weights_keys_;
+
 #ifdef ENABLE_TRAINING
 // Needed for ORTTrainer. Should be removed along with ORTTrainer code
 #ifndef DISABLE_ABSEIL
@@ -22,6 +22,7 @@
 #include "core/framework/ort_value_name_idx_map.h"
 #include "core/framework/sequential_execution_plan.h"
 #include "core/framework/session_state.h"
+#include "core/framework/shared_initializer_store.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
 #include "core/framework/bfc_arena.h"
@@ -239,7 +240,9 @@ common::Status SaveInitializedTensors(
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
     const MemoryProfileFunction& memory_profile_func,
-    PrepackedWeightsForGraph& prepacked_for_graph) {
+    PrepackedWeightsForGraph& prepacked_for_graph,
+    SharedInitializerStore* shared_initializer_store,
+    std::unordered_map<int, std::shared_ptr<const OrtValue>>& shared_initializers) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
@@ -291,6 +294,32 @@ common::Status SaveInitializedTensors(
 
   static const auto default_cpu_device = OrtDevice();
 
+  // Constant CPU initializers are looked up in the shared initializer store by content once loaded.
+  // They get their own buffer rather than a block of the planned buffer, which can be freed if they are shared.
+  // Initializers that point into memory they do not own, like the bytes of an ORT format model, are not shared as
+  // the memory may only be valid while the session that loaded them is.
+  const auto points_into_model_bytes = [&graph](const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+    OrtValue ort_value;
+    return utils::HasExternalDataInMemory(tensor_proto) &&
+           graph.GetOrtValueInitializer(tensor_proto.name(), ort_value) && !ort_value.Get<Tensor>().OwnsBuffer();
+  };
+
+  InlinedHashSet<int> shared_initializer_candidate_ids;
+  if (shared_initializer_store != nullptr) {
+    for (const auto& [ort_value_index, tensor_proto] : id_to_initialized_tensor) {
+      size_t size_in_bytes = 0;
+      if (user_supplied_initializer_ids.count(ort_value_index) == 0 &&
+          !points_into_model_bytes(*tensor_proto) &&
+          exec_plan.GetLocation(ort_value_index) == default_cpu_device &&
+          !utils::HasString(*tensor_proto) &&
+          graph.IsConstantInitializer(tensor_proto->name(), /* check_outer_scope */ false) &&
+          utils::GetSizeInBytesFromTensorProto<0>(*tensor_proto, &size_in_bytes).IsOK() &&
+          size_in_bytes >= SharedInitializerStore::kMinSharedBytes) {
+        shared_initializer_candidate_ids.insert(ort_value_index);
+      }
+    }
+  }
+
   // tensors requiring a specific allocation order are traced first, to ensure they are allocated in order
   // NB1: vector with init allocation order may contain a subset of all tensors (or none at all)
   // NB2: only skip tracing and planning memory when data is external (i.e mmap) and on CPU.
@@ -308,8 +337,9 @@ common::Status SaveInitializedTensors(
     // - Values that are external and mapped from disk. We let the OS manage the memory.
     // - we do not trace values that are in memory because they may be sitting on top of the user allocated
     //   memory.
-    const bool trace_allocation = (exec_plan.GetLocation(ort_value_index) != default_cpu_device) ||
-                                  !utils::HasExternalData(*tensor_proto);
+    const bool trace_allocation = ((exec_plan.GetLocation(ort_value_index) != default_cpu_device) ||
+                                   !utils::HasExternalData(*tensor_proto)) &&
+                                  shared_initializer_candidate_ids.count(ort_value_index) == 0;
 
     if (trace_allocation) {
       // can not trace string tensor, and they exist only on CPU
@@ -324,6 +354,9 @@ common::Status SaveInitializedTensors(
     if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
       continue;
     }
+    if (shared_initializer_candidate_ids.count(entry.first) != 0) {
+      continue;
+    }
     if (utils::HasString(*entry.second)) {
       // do not trace string tensor
       continue;
@@ -420,6 +453,13 @@ common::Status SaveInitializedTensors(
       }
     }
 
+    if (shared_initializer_candidate_ids.count(ort_value_index) != 0 && SharedInitializerStore::CanShare(ort_value)) {
+      // Use the buffer of an identical initializer of another session if there is one. This buffer is freed then.
+      auto shared_initializer = shared_initializer_store->GetOrAdd(ort_value);
+      ort_value = *shared_initializer;
+      shared_initializers.emplace(ort_value_index, std::move(shared_initializer));
+    }
+
     // 'name' is a reference to a string within the TensorProto that save_tensor_func may free
     // so we need to output this message prior to calling save_tensor_func
     VLOGS(logger, 1) << "Adding weight with name : " << name << " with index: " << ort_value_index;
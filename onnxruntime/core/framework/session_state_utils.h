@@ -25,6 +25,7 @@ class GraphViewer;
 class OrtValueNameIdxMap;
 class DataTransferManager;
 class ExternalDataLoaderManager;
+class SharedInitializerStore;
 class NodeArg;
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 class MemoryInfo;
@@ -51,7 +52,9 @@ common::Status SaveInitializedTensors(
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
     const MemoryProfileFunction& memory_profile_func,
-    PrepackedWeightsForGraph& prepacked_for_graph);
+    PrepackedWeightsForGraph& prepacked_for_graph,
+    SharedInitializerStore* shared_initializer_store,
+    std::unordered_map<int, std::shared_ptr<const OrtValue>>& shared_initializers);
 
 common::Status AllocateTensor(
     const onnxruntime::MemBuffer* memory_buffer,
@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shared_initializer_store.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+bool SharedInitializerStore::CanShare(const OrtValue& value) {
+  if (!value.IsTensor()) {
+    return false;
+  }
+
+  const auto& tensor = value.Get<Tensor>();
+  return !tensor.IsDataTypeString() && tensor.Location().device == OrtDevice() &&
+         tensor.SizeInBytes() >= kMinSharedBytes;
+}
+
+uint64_t SharedInitializerStore::Hash(const Tensor& tensor) {
+  uint64_t hash[2] = {0, 0};
+  MurmurHash3::x86_128(tensor.DataRaw(), tensor.SizeInBytes(), static_cast<uint32_t>(tensor.GetElementType()), hash);
+  return hash[0] ^ (hash[1] * 31);
+}
+
+bool SharedInitializerStore::Equals(const Tensor& a, const Tensor& b) {
+  return a.DataType() == b.DataType() && a.Shape() == b.Shape() &&
+         (a.DataRaw() == b.DataRaw() || std::memcmp(a.DataRaw(), b.DataRaw(), a.SizeInBytes()) == 0);
+}
+
+std::shared_ptr<const OrtValue> SharedInitializerStore::GetOrAdd(const OrtValue& value) {
+  ORT_ENFORCE(CanShare(value), "The value cannot be shared.");
+  const auto& tensor = value.Get<Tensor>();
+  const uint64_t hash = Hash(tensor);
+
+  // The contents are compared without holding the mutex, as they may be large. The entries added by other threads
+  // in the meantime are compared before value is stored.
+  std::vector<std::shared_ptr<const OrtValue>> compared;
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    std::vector<std::shared_ptr<const OrtValue>> candidates;
+    auto [begin, end] = entries_.equal_range(hash);
+    for (auto it = begin; it != end;) {
+      if (auto stored = it->second.lock(); stored == nullptr) {
+        it = entries_.erase(it);
+      } else {
+        if (std::find(compared.begin(), compared.end(), stored) == compared.end()) {
+          candidates.push_back(std::move(stored));
+        }
+        ++it;
+      }
+    }
+
+    if (candidates.empty()) {
+      auto stored = std::make_shared<const OrtValue>(value);
+      entries_.emplace(hash, stored);
+      return stored;
+    }
+
+    lock.unlock();
+    for (auto& candidate : candidates) {
+      if (Equals(candidate->Get<Tensor>(), tensor)) {
+        return candidate;
+      }
+    }
+    compared.insert(compared.end(), candidates.begin(), candidates.end());
+    lock.lock();
+  }
+}
+
+void SharedInitializerStore::AddPrepackedWeightsUser(const std::string& key) {
+  ++prepacked_weights_users_[key];
+}
+
+void SharedInitializerStore::ReleasePrepackedWeights(gsl::span<const std::string> keys) {
+  std::lock_guard<std::mutex> lock(prepacked_weights_container_.mutex_);
+  for (const auto& key : keys) {
+    auto it = prepacked_weights_users_.find(key);
+    if (it != prepacked_weights_users_.end() && --it->second == 0) {
+      prepacked_weights_users_.erase(it);
+      prepacked_weights_container_.prepacked_weights_map_.erase(key);
+    }
+  }
+}
+
+SharedInitializerStore::Stats SharedInitializerStore::GetStats() const {
+  Stats stats;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& entry : entries_) {
+    // Each session holds a pointer per initializer that uses the entry, until it releases the initializer after
+    // pre-packing it.
+    const auto num_users = static_cast<size_t>(entry.second.use_count());
+    if (auto stored = entry.second.lock(); stored != nullptr) {
+      const size_t size = stored->Get<Tensor>().SizeInBytes();
+      ++stats.num_initializers;
+      stats.unique_bytes += size;
+      stats.saved_bytes += size * (std::max<size_t>(num_users, 1) - 1);
+    }
+  }
+  return stats;
+}
+
+}  // namespace onnxruntime
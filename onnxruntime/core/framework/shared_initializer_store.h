@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <gsl/gsl>
+
+#include "core/common/common.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/prepacked_weights_container.h"
+
+namespace onnxruntime {
+
+/**
+ * Content-addressed store of the constant CPU initializers of the sessions of an environment.
+ *
+ * Sessions that load byte-identical initializers, like fine-tuned variants of a base model, share the buffer of
+ * the first session that loaded them instead of holding a copy each. The buffer is the one the first session
+ * created, so initializers with external data stay backed by the memory-mapped file. Kernels do not write to
+ * constant initializers, so the buffer is effectively read-only.
+ *
+ * The store also provides a PrepackedWeightsContainer for the sessions that have none, whose pre-packed buffers
+ * are keyed by their content hash and are shared the same way. The sessions register the pre-packed weights they
+ * use, and a weight is removed from the container when the last session that uses it releases it.
+ *
+ * This class is thread-safe.
+ */
+class SharedInitializerStore {
+ public:
+  // Initializers smaller than this are not shared, as they save less memory than hashing them costs.
+  static constexpr size_t kMinSharedBytes = 4096;
+
+  struct Stats {
+    size_t num_initializers = 0;  // Distinct initializers used by the sessions.
+    size_t unique_bytes = 0;      // Bytes held by these initializers.
+    size_t saved_bytes = 0;       // Bytes the sessions would hold in addition without sharing.
+  };
+
+  SharedInitializerStore() = default;
+
+  // Returns true if value is a tensor that can be stored.
+  static bool CanShare(const OrtValue& value);
+
+  // Returns the stored initializer with the same element type, shape and content as value, or stores value if
+  // there is none. The initializer stays in the store while a returned pointer to it is alive.
+  std::shared_ptr<const OrtValue> GetOrAdd(const OrtValue& value);
+
+  PrepackedWeightsContainer& GetPrepackedWeightsContainer() { return prepacked_weights_container_; }
+
+  // Records a use of the pre-packed weight with the given key of the container.
+  // The caller must hold the mutex of the container.
+  void AddPrepackedWeightsUser(const std::string& key);
+
+  // Releases a use of each of the pre-packed weights with the given keys. The weights without any remaining use
+  // are removed from the container.
+  void ReleasePrepackedWeights(gsl::span<const std::string> keys);
+
+  Stats GetStats() const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SharedInitializerStore);
+
+ private:
+  static uint64_t Hash(const Tensor& tensor);
+  static bool Equals(const Tensor& a, const Tensor& b);
+
+  mutable std::mutex mutex_;
+  // Entries by content hash. Expired entries are removed on the next insertion with the same hash.
+  std::unordered_multimap<uint64_t, std::weak_ptr<const OrtValue>> entries_;  // GUARDED_BY(mutex_)
+
+  PrepackedWeightsContainer prepacked_weights_container_;
+  // Number of uses of each pre-packed weight of the container by key.
+  std::unordered_map<std::string, size_t> prepacked_weights_users_;  // GUARDED_BY(prepacked_weights_container_.mutex_)
+};
+
+}  // namespace onnxruntime
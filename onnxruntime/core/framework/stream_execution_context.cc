@@ -235,6 +235,12 @@ void RunSince(size_t stream_idx, StreamExecutionContext& ctx, SessionScope& sess
       ctx.CompleteTask();
       return;
     }
+    if (concurrency::ThreadPool::IsCancelled()) {
+      // The deadline of the Run has passed.
+      ctx.SetStatus(ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting because the deadline of the Run has passed."));
+      ctx.CompleteTask();
+      return;
+    }
     bool continue_flag = true;
     Status status;
     ORT_TRY {
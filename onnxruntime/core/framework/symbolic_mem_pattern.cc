@@ -0,0 +1,147 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/symbolic_mem_pattern.h"
+
+#include <algorithm>
+#include <string>
+
+#include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/ort_value_pattern_planner.h"
+#include "core/framework/sequential_execution_plan.h"
+#include "core/framework/tensor.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+std::unique_ptr<SymbolicMemoryPattern> SymbolicMemoryPattern::Create(
+    const GraphViewer& graph_viewer, const OrtValueNameIdxMap& ort_value_name_idx_map,
+    const SequentialExecutionPlan& execution_plan, gsl::span<const int> feed_mlvalue_idxs,
+    gsl::span<const OrtValue> feeds, const MemoryPatternTrace& trace) {
+  std::unique_ptr<SymbolicMemoryPattern> pattern(new SymbolicMemoryPattern(execution_plan));
+
+  auto get_shape = [&](int ort_value_idx) -> const ONNX_NAMESPACE::TensorShapeProto* {
+    std::string name;
+    if (!ort_value_name_idx_map.GetName(ort_value_idx, name).IsOK()) {
+      return nullptr;
+    }
+    const NodeArg* node_arg = graph_viewer.GetNodeArg(name);
+    return node_arg != nullptr ? node_arg->Shape() : nullptr;
+  };
+
+  InlinedHashMap<std::string, int> symbol_indices;
+  for (int ort_value_idx : feed_mlvalue_idxs) {
+    const auto* shape = get_shape(ort_value_idx);
+    if (shape == nullptr) {
+      continue;
+    }
+
+    InlinedVector<int> symbols(shape->dim_size(), -1);
+    for (int i = 0; i < shape->dim_size(); ++i) {
+      if (shape->dim(i).has_dim_param()) {
+        symbols[i] = symbol_indices.emplace(shape->dim(i).dim_param(), static_cast<int>(symbol_indices.size()))
+                         .first->second;
+      }
+    }
+    pattern->feed_symbols_.insert_or_assign(ort_value_idx, std::move(symbols));
+  }
+  pattern->num_symbols_ = symbol_indices.size();
+
+  InlinedVector<int64_t> symbol_values;
+  if (!pattern->BindSymbols(feed_mlvalue_idxs, feeds, symbol_values).IsOK()) {
+    return nullptr;
+  }
+
+  const auto& allocation_plan = execution_plan.GetAllocationPlan();
+  pattern->events_.reserve(trace.events.size());
+  for (const auto& traced : trace.events) {
+    Event event{traced.ort_value_idx, traced.is_free, nullptr, 0, {}};
+    if (!traced.is_free) {
+      const auto* shape = get_shape(traced.ort_value_idx);
+      const auto* value_type = allocation_plan[traced.ort_value_idx].value_type;
+      if (shape == nullptr || value_type == nullptr || !value_type->IsTensorType()) {
+        return nullptr;
+      }
+
+      event.element_type = static_cast<const TensorTypeBase*>(value_type)->GetElementType();
+      event.alignment = std::max(execution_plan.GetLocation(traced.ort_value_idx).GetAlignment(), kAllocAlignment);
+      for (const auto& dim : shape->dim()) {
+        if (dim.has_dim_value()) {
+          event.dims.push_back({dim.dim_value(), -1});
+        } else if (auto it = dim.has_dim_param() ? symbol_indices.find(dim.dim_param()) : symbol_indices.end();
+                   it != symbol_indices.end()) {
+          event.dims.push_back({0, it->second});
+        } else {
+          // The dimension depends on the data, or is a symbol produced inside the graph.
+          return nullptr;
+        }
+      }
+
+      size_t size = 0;
+      if (!ComputeSize(event, symbol_values, size).IsOK() || size != traced.size) {
+        return nullptr;
+      }
+    }
+    pattern->events_.push_back(std::move(event));
+  }
+
+  return pattern;
+}
+
+Status SymbolicMemoryPattern::BindSymbols(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                                          InlinedVector<int64_t>& symbol_values) const {
+  symbol_values.assign(num_symbols_, -1);
+  for (size_t i = 0; i < feed_mlvalue_idxs.size(); ++i) {
+    auto it = feed_symbols_.find(feed_mlvalue_idxs[i]);
+    if (it == feed_symbols_.end()) {
+      continue;
+    }
+
+    const auto& symbols = it->second;
+    const auto dims = feeds[i].Get<Tensor>().Shape().GetDims();
+    ORT_RETURN_IF(dims.size() != symbols.size(), "The rank of a feed does not match the rank of its graph input.");
+    for (size_t k = 0; k < dims.size(); ++k) {
+      if (symbols[k] == -1) {
+        continue;
+      }
+      auto& value = symbol_values[symbols[k]];
+      ORT_RETURN_IF(value != -1 && value != dims[k], "A symbolic dimension has different values in the feeds.");
+      value = dims[k];
+    }
+  }
+  return Status::OK();
+}
+
+Status SymbolicMemoryPattern::ComputeSize(const Event& event, gsl::span<const int64_t> symbol_values, size_t& size) {
+  TensorShapeVector dims;
+  dims.reserve(event.dims.size());
+  for (const auto& dim : event.dims) {
+    if (dim.symbol == -1) {
+      dims.push_back(dim.value);
+    } else {
+      ORT_RETURN_IF(symbol_values[dim.symbol] == -1, "A symbolic dimension is not bound by the feeds.");
+      dims.push_back(symbol_values[dim.symbol]);
+    }
+  }
+  return Tensor::CalculateTensorStorageSize(event.element_type, TensorShape(dims), event.alignment, size);
+}
+
+Status SymbolicMemoryPattern::Generate(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                                       MemoryPatternGroup& output) const {
+  InlinedVector<int64_t> symbol_values;
+  ORT_RETURN_IF_ERROR(BindSymbols(feed_mlvalue_idxs, feeds, symbol_values));
+
+  OrtValuePatternPlanner planner(execution_plan_);
+  for (const auto& event : events_) {
+    if (event.is_free) {
+      ORT_RETURN_IF_ERROR(planner.TraceFree(event.ort_value_idx));
+    } else {
+      size_t size = 0;
+      ORT_RETURN_IF_ERROR(ComputeSize(event, symbol_values, size));
+      ORT_RETURN_IF_ERROR(planner.TraceAllocation(event.ort_value_idx, size));
+    }
+  }
+  return planner.GeneratePatterns(output);
+}
+
+}  // namespace onnxruntime
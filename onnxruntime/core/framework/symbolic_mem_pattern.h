@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/mem_pattern.h"
+#include "core/framework/ort_value.h"
+
+namespace onnxruntime {
+class ExecutionPlanBase;
+class GraphViewer;
+class OrtValueNameIdxMap;
+struct SequentialExecutionPlan;
+
+/**
+ * Memory pattern whose block sizes and offsets are functions of the symbolic dimensions of the feeds.
+ *
+ * It is created from the allocations and frees traced in a run. If the shape of every traced tensor consists of
+ * constant dimensions and symbolic dimensions of the feeds, the pattern for other feed shapes is generated by
+ * replaying the trace with the sizes computed from these shapes, so no other run needs to be traced.
+ * The replay makes the decisions of the planner for the new sizes, so a single trace serves e.g. every sequence
+ * length of a model.
+ *
+ * The sizes computed for the traced shapes are checked against the traced sizes when the pattern is created.
+ * Kernels whose output shapes do not match their shape inference fall back to regular allocations, like with any
+ * memory pattern whose block size does not match.
+ */
+class SymbolicMemoryPattern {
+ public:
+  // Returns nullptr if a traced size cannot be expressed in the symbolic dimensions of the feeds.
+  static std::unique_ptr<SymbolicMemoryPattern> Create(const GraphViewer& graph_viewer,
+                                                       const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                                       const SequentialExecutionPlan& execution_plan,
+                                                       gsl::span<const int> feed_mlvalue_idxs,
+                                                       gsl::span<const OrtValue> feeds,
+                                                       const MemoryPatternTrace& trace);
+
+  // Generates the memory patterns for the shapes of the feeds.
+  // Fails if the feeds do not bind the symbolic dimensions that the sizes depend on.
+  Status Generate(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                  MemoryPatternGroup& output) const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SymbolicMemoryPattern);
+
+ private:
+  // A constant dimension if symbol is -1, otherwise the index of a symbolic dimension.
+  struct Dim {
+    int64_t value;
+    int symbol;
+  };
+
+  struct Event {
+    int ort_value_idx;
+    bool is_free;
+    // Storage of the allocated tensor.
+    MLDataType element_type;
+    size_t alignment;
+    InlinedVector<Dim> dims;
+  };
+
+  explicit SymbolicMemoryPattern(const ExecutionPlanBase& execution_plan) : execution_plan_(execution_plan) {}
+
+  Status BindSymbols(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                     InlinedVector<int64_t>& symbol_values) const;
+  static Status ComputeSize(const Event& event, gsl::span<const int64_t> symbol_values, size_t& size);
+
+  const ExecutionPlanBase& execution_plan_;
+  // Symbolic dimension of each dimension of the feeds, by OrtValue index, or -1.
+  InlinedHashMap<int, InlinedVector<int>> feed_symbols_;
+  size_t num_symbols_ = 0;
+  std::vector<Event> events_;
+};
+
+}  // namespace onnxruntime
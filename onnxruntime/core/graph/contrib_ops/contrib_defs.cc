@@ -631,6 +631,44 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
           return true;
         }));
 
+constexpr const char* FusedElementwise_ver1_doc = R"DOC(
+Computes a chain of elementwise operators in a single pass over memory. The chain is a program over registers:
+registers 0 to N-1 hold the N inputs and instruction i writes register N+i. The output is the register written by
+the last instruction.
+
+Each entry of `operators` is one of Add, Sub, Mul, Div, Max, Min, Relu, Sigmoid, Tanh, Exp, Log, Erf, Neg, Abs,
+Sqrt or Reciprocal. `operands` holds two register indices per instruction; the second index is -1 for unary
+operators.
+
+Every input must either have the shape of the output or broadcast to it as a suffix of the output shape, which
+includes scalars.)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    FusedElementwise, 1,
+    OpSchema()
+        .SetDomain(kMSDomain)
+        .SinceVersion(1)
+        .SetDoc(FusedElementwise_ver1_doc)
+        .Attr("operators", "The operator of each instruction.", AttributeProto::STRINGS)
+        .Attr("operands", "The two source registers of each instruction.", AttributeProto::INTS)
+        .Input(0, "inputs", "The input tensors.", "T", OpSchema::Variadic)
+        .Output(0, "Y", "The output.", "T")
+        .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+
+          std::vector<const ONNX_NAMESPACE::TensorShapeProto*> shapes;
+          for (size_t i = 0; i < ctx.getNumInputs(); ++i) {
+            if (!hasInputShape(ctx, i)) {
+              return;
+            }
+            shapes.push_back(&ctx.getInputType(i)->tensor_type().shape());
+          }
+
+          multidirectionalBroadcastShapeInference(
+              shapes, *ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape());
+        }));
+
 // Used to be ONNX 1.7 Inverse(12)
 // Comment out docs not to increase the binary size
 //
@@ -334,6 +334,9 @@ const std::vector<NodeIndex>& GraphViewer::GetNodesInTopologicalOrder(ExecutionO
 #else
       ORT_THROW("Memory efficient topological order is not enabled for non-training build.");
 #endif
+    case ExecutionOrder::CRITICAL_PATH:
+      // the allocation planner derives this order from per-node costs, which the graph doesn't know about.
+      return nodes_in_topological_order_;
     default:
       ORT_THROW("Invalid ExecutionOrder");
   }
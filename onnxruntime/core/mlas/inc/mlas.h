@@ -827,6 +827,7 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmWinograd,
 #if defined(MLAS_TARGET_WASM_SCALAR)
     MlasConvAlgorithmDepthwise,
 #endif
@@ -859,6 +860,11 @@ struct MLAS_CONV_PARAMETERS {
         struct {
             size_t ThreadStrideN;
         } ExpandThenGemmSegmented;
+        struct {
+            size_t TileSize;
+            size_t TileRowsPerBlock;
+            const float* PackedFilter;
+        } Winograd;
     } u;
 };
 
@@ -878,7 +884,8 @@ MlasConvPrepare(MLAS_CONV_PARAMETERS* Parameters,
                 const MLAS_ACTIVATION* Activation,
                 size_t* WorkingBufferSize,
                 float Beta,
-                MLAS_THREADPOOL* ThreadPool);
+                MLAS_THREADPOOL* ThreadPool,
+                const float* PackedFilter = nullptr);
 
 void
 MLASCALL
@@ -892,6 +899,31 @@ MlasConv(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Winograd convolution filter packing routines. The packed filter for a 3x3
+// kernel can be supplied to MlasConv through Parameters->u.Winograd.PackedFilter
+// when MlasConvPrepare selects MlasConvAlgorithmWinograd. The packed filter size
+// is zero if the Winograd algorithm is not used for the channel counts.
+//
+
+size_t
+MLASCALL
+MlasConvWinogradPackedFilterSize(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount
+    );
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const float* Filter,
+    float* PackedFilter
+    );
+
 void
 MLASCALL
 MlasConvDepthwise(
@@ -1122,6 +1154,43 @@ MlasComputeTanh(
     size_t N
     );
 
+template<typename T>
+void
+MLASCALL
+MlasComputeLog(
+    const T* Input,
+    T* Output,
+    size_t N
+    );
+
+template<typename T>
+void
+MLASCALL
+MlasComputeSin(
+    const T* Input,
+    T* Output,
+    size_t N
+    );
+
+template<typename T>
+void
+MLASCALL
+MlasComputeCos(
+    const T* Input,
+    T* Output,
+    size_t N
+    );
+
+template<typename T>
+void
+MLASCALL
+MlasComputePow(
+    const T* Input,
+    T Exponent,
+    T* Output,
+    size_t N
+    );
+
 //
 // Transpose routines.
 //
@@ -1137,6 +1206,85 @@ MlasTranspose(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Reduction routines.
+//
+
+enum MLAS_REDUCE_KIND {
+    MlasReduceSum,
+    MlasReduceMean,
+    MlasReduceMaximum,
+    MlasReduceLogSumExp,
+};
+
+template<typename T>
+void
+MLASCALL
+MlasReduce(
+    MLAS_REDUCE_KIND ReduceKind,
+    const T* Input,
+    T* Output,
+    size_t OuterCount,
+    size_t ReduceCount,
+    size_t InnerCount,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Elementwise program routines.
+//
+// An elementwise program is a sequence of instructions over a register file.
+// Registers [0, InputCount) hold the program inputs and are read only. The
+// remaining registers hold temporary values. The destination register of the
+// last instruction is the program output.
+//
+
+enum MLAS_ELTWISE_OPCODE {
+    MlasEltwiseOpAdd,
+    MlasEltwiseOpSub,
+    MlasEltwiseOpMul,
+    MlasEltwiseOpDiv,
+    MlasEltwiseOpMax,
+    MlasEltwiseOpMin,
+    MlasEltwiseOpRelu,
+    MlasEltwiseOpSigmoid,
+    MlasEltwiseOpTanh,
+    MlasEltwiseOpExp,
+    MlasEltwiseOpLog,
+    MlasEltwiseOpErf,
+    MlasEltwiseOpNeg,
+    MlasEltwiseOpAbs,
+    MlasEltwiseOpSqrt,
+    MlasEltwiseOpReciprocal,
+};
+
+struct MLAS_ELTWISE_INSTRUCTION {
+    MLAS_ELTWISE_OPCODE Opcode;
+    uint32_t Destination;
+    uint32_t Source0;
+    uint32_t Source1;
+};
+
+bool
+MLASCALL
+MlasEltwiseOpIsBinary(
+    MLAS_ELTWISE_OPCODE Opcode
+    );
+
+void
+MLASCALL
+MlasEltwiseProgramExecute(
+    const MLAS_ELTWISE_INSTRUCTION* Instructions,
+    size_t InstructionCount,
+    size_t RegisterCount,
+    const float* const* Inputs,
+    const size_t* InputCounts,
+    size_t InputCount,
+    float* Output,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Buffer reordering routines.
 //
@@ -880,6 +880,17 @@ Return Value:
 
     const MLAS_CONV_ALGORITHM Algorithm = Parameters->Algorithm;
 
+    //
+    // Schedule blocks of Winograd tiles across multiple threads.
+    //
+
+    if (Algorithm == MlasConvAlgorithmWinograd) {
+
+        MlasConvWinograd(Parameters, Input, Filter, Bias, WorkingBuffer, Output, ThreadPool);
+
+        return;
+    }
+
     //
     // Schedule batches of GEMMs across multiple threads.
     //
@@ -1008,6 +1019,16 @@ Return Value:
 
                     break;
                 }
+
+                case MlasConvAlgorithmWinograd:
+                {
+                    //
+                    // The Winograd algorithm is scheduled across all batches
+                    // and groups above.
+                    //
+
+                    break;
+                }
             }
 
             //
@@ -1047,7 +1068,8 @@ MlasConvPrepare(
     const MLAS_ACTIVATION* Activation,
     size_t* WorkingBufferSize,
     float Beta,
-    MLAS_THREADPOOL* ThreadPool
+    MLAS_THREADPOOL* ThreadPool,
+    const float* PackedFilter
     )
 /*++
 
@@ -1094,6 +1116,11 @@ Arguments:
     ThreadPool - Supplies the thread pool object to use, else nullptr if the
         base library threading support should be used.
 
+    PackedFilter - Optionally supplies the filter transformed by
+        MlasConvWinogradPackFilter, which is used if the Winograd algorithm is
+        selected. Without a packed filter, the Winograd algorithm is only
+        selected if the filter transform done by each call is amortized.
+
 Return Value:
 
     None.
@@ -1224,6 +1251,15 @@ Return Value:
         }
     }
 
+    //
+    // Detect a 3x3 stride 1 convolution that benefits from the Winograd
+    // algorithm.
+    //
+
+    if (MlasConvWinogradTryPrepare(Parameters, PackedFilter, WorkingBufferSize, ThreadPool)) {
+        return;
+    }
+
     if (FilterCount > OutputSize) {
 
         //
@@ -0,0 +1,1205 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convolve_winograd.cpp
+
+Abstract:
+
+    This module implements the Winograd minimal filtering algorithms F(2x2,3x3)
+    and F(4x4,3x3) for single precision 3x3 stride 1 convolutions.
+
+    The input image is split into overlapping tiles of (TileSize + 2) x
+    (TileSize + 2) elements. Each tile and each 3x3 filter is transformed into
+    the Winograd domain, where the convolution becomes an elementwise product
+    that is accumulated over the input channels. Batching the tiles turns the
+    accumulation for each of the (TileSize + 2)^2 transformed positions into an
+    independent GEMM of FilterCount x TileCount x InputChannels. The products
+    are then transformed back into TileSize x TileSize output tiles.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of output tiles that a thread transforms and multiplies as
+// a single block. The block is sized in whole rows of tiles.
+//
+
+#define MLAS_CONV_WINOGRAD_TILES_PER_BLOCK          64
+
+//
+// Define the minimum sizes for which the transformed domain GEMMs are large
+// enough to amortize the cost of the input and output transforms compared to
+// the GEMM of the expanded input. The K dimension of that GEMM is the number of
+// input channels times the 3x3 kernel size.
+//
+
+#define MLAS_CONV_WINOGRAD_MINIMUM_K                (16 * 9)
+#define MLAS_CONV_WINOGRAD_MINIMUM_FILTER_COUNT     8
+#define MLAS_CONV_WINOGRAD_F4X4_MINIMUM_CHANNELS    32
+#define MLAS_CONV_WINOGRAD_MINIMUM_TILES            16
+
+//
+// Define the number of output tiles per thread for which the filter transform
+// done by each call is amortized if the caller does not supply a packed filter.
+// The filter is transformed on the calling thread before the tiles are
+// scheduled.
+//
+
+#define MLAS_CONV_WINOGRAD_UNPACKED_MINIMUM_TILES_PER_THREAD    256
+
+//
+// Define the parameters to execute blocks of a Winograd convolution on worker
+// threads.
+//
+
+struct MLAS_CONV_WINOGRAD_WORK_BLOCK {
+    const MLAS_CONV_PARAMETERS* Parameters;
+    const float* Input;
+    const float* PackedFilter;
+    const float* Bias;
+    float* WorkingBuffer;
+    float* Output;
+    size_t WorkingBufferSizePerThread;
+    ptrdiff_t ThreadCount;
+};
+
+//
+// Define the element operations used by the Winograd transforms. The
+// transforms are written once and instantiated for single elements and for
+// vectors of elements, where each vector lane holds the same position of an
+// adjacent tile.
+//
+
+struct MLAS_WINOGRAD_FLOAT32 {
+
+    typedef float T;
+
+    static constexpr size_t Count = 1;
+
+    static MLAS_FORCEINLINE T Load(const float* Buffer) { return *Buffer; }
+
+    static MLAS_FORCEINLINE void Store(float* Buffer, T Value) { *Buffer = Value; }
+
+    static MLAS_FORCEINLINE T Add(T Value1, T Value2) { return Value1 + Value2; }
+
+    static MLAS_FORCEINLINE T Sub(T Value1, T Value2) { return Value1 - Value2; }
+
+    static MLAS_FORCEINLINE T Mul(T Value, float Scalar) { return Value * Scalar; }
+};
+
+struct MLAS_WINOGRAD_FLOAT32X4 {
+
+    typedef MLAS_FLOAT32X4 T;
+
+    static constexpr size_t Count = 4;
+
+    static MLAS_FORCEINLINE T Load(const float* Buffer) { return MlasLoadFloat32x4(Buffer); }
+
+    static MLAS_FORCEINLINE void Store(float* Buffer, T Value) { MlasStoreFloat32x4(Buffer, Value); }
+
+    static MLAS_FORCEINLINE T Add(T Value1, T Value2) { return MlasAddFloat32x4(Value1, Value2); }
+
+    static MLAS_FORCEINLINE T Sub(T Value1, T Value2) { return MlasSubtractFloat32x4(Value1, Value2); }
+
+    static MLAS_FORCEINLINE T Mul(T Value, float Scalar)
+    {
+        return MlasMultiplyFloat32x4(Value, MlasBroadcastFloat32x4(Scalar));
+    }
+};
+
+//
+// Winograd F(2,3) transforms:
+//
+//  Bt = | 1  0 -1  0 |   G = |   1    0    0 |   At = | 1  1  1  0 |
+//       | 0  1  1  0 |       | 1/2  1/2  1/2 |        | 0  1 -1 -1 |
+//       | 0 -1  1  0 |       | 1/2 -1/2  1/2 |
+//       | 0  1  0 -1 |       |   0    0    1 |
+//
+
+struct MLAS_WINOGRAD_F2X3 {
+
+    static constexpr size_t TileSize = 2;
+    static constexpr size_t Alpha = 4;
+
+    template<typename V>
+    static
+    MLAS_FORCEINLINE
+    void
+    InputTransform(const typename V::T* d, typename V::T* o)
+    {
+        o[0] = V::Sub(d[0], d[2]);
+        o[1] = V::Add(d[1], d[2]);
+        o[2] = V::Sub(d[2], d[1]);
+        o[3] = V::Sub(d[1], d[3]);
+    }
+
+    template<typename V>
+    static
+    MLAS_FORCEINLINE
+    void
+    FilterTransform(const typename V::T* g, typename V::T* u)
+    {
+        u[0] = g[0];
+        u[1] = V::Mul(V::Add(V::Add(g[0], g[1]), g[2]), 0.5f);
+        u[2] = V::Mul(V::Add(V::Sub(g[0], g[1]), g[2]), 0.5f);
+        u[3] = g[2];
+    }
+
+    template<typename V>
+    static
+    MLAS_FORCEINLINE
+    void
+    OutputTransform(const typename V::T* m, typename V::T* y)
+    {
+        y[0] = V::Add(V::Add(m[0], m[1]), m[2]);
+        y[1] = V::Sub(V::Sub(m[1], m[2]), m[3]);
+    }
+};
+
+//
+// Winograd F(4,3) transforms using the interpolation points 0, -1, 1, 1/2,
+// -1/2 and infinity:
+//
+//  Bt = | 4  0 -5  0  1  0 |   G = |    1/4      0     0 |
+//       | 0 -4 -4  1  1  0 |       |   -1/6   -1/6  -1/6 |
+//       | 0  4 -4 -1  1  0 |       |   -1/6    1/6  -1/6 |
+//       | 0 -2 -1  2  1  0 |       |   1/24   1/12   1/6 |
+//       | 0  2 -1 -2  1  0 |       |   1/24  -1/12   1/6 |
+//       | 0  4  0 -5  0  1 |       |      0      0     1 |
+//
+//  At = | 1  1  1  1  1  0 |
+//       | 0  1 -1  2 -2  0 |
+//       | 0  1  1  4  4  0 |
+//       | 0  1 -1  8 -8  1 |
+//
+
+struct MLAS_WINOGRAD_F4X3 {
+
+    static constexpr size_t TileSize = 4;
+    static constexpr size_t Alpha = 6;
+
+    template<typename V>
+    static
+    MLAS_FORCEINLINE
+    void
+    InputTransform(const typename V::T* d, typename V::T* o)
+    {
+        o[0] = V::Add(V::Sub(V::Mul(d[0], 4.0f), V::Mul(d[2], 5.0f)), d[4]);
+        o[1] = V::Add(V::Sub(d[3], V::Mul(V::Add(d[1], d[2]), 4.0f)), d[4]);
+        o[2] = V::Add(V::Sub(V::Mul(V::Sub(d[1], d[2]), 4.0f), d[3]), d[4]);
+        o[3] = V::Add(V::Sub(V::Mul(V::Sub(d[3], d[1]), 2.0f), d[2]), d[4]);
+        o[4] = V::Add(V::Sub(V::Mul(V::Sub(d[1], d[3]), 2.0f), d[2]), d[4]);
+        o[5] = V::Add(V::Sub(V::Mul(d[1], 4.0f), V::Mul(d[3], 5.0f)), d[5]);
+    }
+
+    template<typename V>
+    static
+    MLAS_FORCEINLINE
+    void
+    FilterTransform(const typename V::T* g, typename V::T* u)
+    {
+        u[0] = V::Mul(g[0], 1.0f / 4.0f);
+        u[1] = V::Mul(V::Add(V::Add(g[0], g[1]), g[2]), -1.0f / 6.0f);
+        u[2] = V::Mul(V::Add(V::Sub(g[0], g[1]), g[2]), -1.0f / 6.0f);
+        u[3] = V::Add(V::Add(V::Mul(g[0], 1.0f / 24.0f), V::Mul(g[1], 1.0f / 12.0f)), V::Mul(g[2], 1.0f / 6.0f));
+        u[4] = V::Add(V::Sub(V::Mul(g[0], 1.0f / 24.0f), V::Mul(g[1], 1.0f / 12.0f)), V::Mul(g[2], 1.0f / 6.0f));
+        u[5] = g[2];
+    }
+
+    template<typename V>
+    static
+    MLAS_FORCEINLINE
+    void
+    OutputTransform(const typename V::T* m, typename V::T* y)
+    {
+        const typename V::T m12a = V::Add(m[1], m[2]);
+        const typename V::T m12s = V::Sub(m[1], m[2]);
+        const typename V::T m34a = V::Add(m[3], m[4]);
+        const typename V::T m34s = V::Sub(m[3], m[4]);
+
+        y[0] = V::Add(V::Add(m[0], m12a), m34a);
+        y[1] = V::Add(m12s, V::Mul(m34s, 2.0f));
+        y[2] = V::Add(m12a, V::Mul(m34a, 4.0f));
+        y[3] = V::Add(V::Add(m12s, V::Mul(m34s, 8.0f)), m[5]);
+    }
+};
+
+size_t
+MlasConvWinogradTileSize(
+    size_t InputChannels,
+    size_t FilterCount
+    )
+/*++
+
+Routine Description:
+
+    This routine selects the Winograd output tile size for the supplied
+    channel counts. The selection depends only on the channel counts so that a
+    filter packed ahead of time agrees with the tile size chosen by
+    MlasConvPrepare for any input shape.
+
+Arguments:
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of output channels per group.
+
+Return Value:
+
+    Returns the output tile size, else zero if the Winograd algorithm is not
+    profitable for the channel counts.
+
+--*/
+{
+    if (InputChannels * 9 < MLAS_CONV_WINOGRAD_MINIMUM_K ||
+        FilterCount < MLAS_CONV_WINOGRAD_MINIMUM_FILTER_COUNT) {
+        return 0;
+    }
+
+    if (InputChannels >= MLAS_CONV_WINOGRAD_F4X4_MINIMUM_CHANNELS &&
+        FilterCount >= MLAS_CONV_WINOGRAD_F4X4_MINIMUM_CHANNELS) {
+        return MLAS_WINOGRAD_F4X3::TileSize;
+    }
+
+    return MLAS_WINOGRAD_F2X3::TileSize;
+}
+
+template<typename WinogradType>
+void
+MlasConvWinogradPackFilterImpl(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const float* Filter,
+    float* PackedFilter
+    )
+{
+    constexpr size_t Alpha = WinogradType::Alpha;
+    constexpr size_t AlphaSquared = Alpha * Alpha;
+
+    const size_t PackedGroupSize = AlphaSquared * FilterCount * InputChannels;
+
+    for (size_t group = 0; group < GroupCount; group++) {
+
+        float* packed = PackedFilter + group * PackedGroupSize;
+
+        for (size_t f = 0; f < FilterCount; f++) {
+
+            for (size_t c = 0; c < InputChannels; c++) {
+
+                const float* g = Filter + ((group * FilterCount + f) * InputChannels + c) * 9;
+
+                float Columns[3][Alpha];
+                float U[Alpha][Alpha];
+
+                //
+                // Compute U = G * g * Gt by transforming the filter columns
+                // and then the resulting rows.
+                //
+
+                for (size_t kx = 0; kx < 3; kx++) {
+                    const float Column[3] = {g[kx], g[3 + kx], g[6 + kx]};
+                    WinogradType::template FilterTransform<MLAS_WINOGRAD_FLOAT32>(Column, Columns[kx]);
+                }
+
+                for (size_t i = 0; i < Alpha; i++) {
+                    const float Row[3] = {Columns[0][i], Columns[1][i], Columns[2][i]};
+                    WinogradType::template FilterTransform<MLAS_WINOGRAD_FLOAT32>(Row, U[i]);
+                }
+
+                for (size_t xi = 0; xi < AlphaSquared; xi++) {
+                    packed[(xi * FilterCount + f) * InputChannels + c] = U[xi / Alpha][xi % Alpha];
+                }
+            }
+        }
+    }
+}
+
+size_t
+MLASCALL
+MlasConvWinogradPackedFilterSize(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the number of elements required to store a 3x3 filter
+    transformed for the Winograd convolution algorithm.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of output channels per group.
+
+Return Value:
+
+    Returns the number of elements of the packed filter, else zero if the
+    Winograd algorithm is not used for the channel counts.
+
+--*/
+{
+    const size_t TileSize = MlasConvWinogradTileSize(InputChannels, FilterCount);
+
+    if (TileSize == 0) {
+        return 0;
+    }
+
+    const size_t Alpha = TileSize + 2;
+
+    return GroupCount * Alpha * Alpha * FilterCount * InputChannels;
+}
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const float* Filter,
+    float* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a 3x3 filter for use by the Winograd convolution
+    algorithm.
+
+    The packed filter is stored as [GroupCount][Alpha^2][FilterCount]
+    [InputChannels] so that each transformed position is a row major matrix
+    that can be used directly as the A operand of a GEMM.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of output channels per group.
+
+    Filter - Supplies the filter tensor in [GroupCount * FilterCount]
+        [InputChannels][3][3] order.
+
+    PackedFilter - Supplies the buffer to receive the packed filter. The buffer
+        must be sized to the number of elements returned by
+        MlasConvWinogradPackedFilterSize.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t TileSize = MlasConvWinogradTileSize(InputChannels, FilterCount);
+
+    if (TileSize == MLAS_WINOGRAD_F4X3::TileSize) {
+        MlasConvWinogradPackFilterImpl<MLAS_WINOGRAD_F4X3>(
+            GroupCount, InputChannels, FilterCount, Filter, PackedFilter);
+    } else if (TileSize == MLAS_WINOGRAD_F2X3::TileSize) {
+        MlasConvWinogradPackFilterImpl<MLAS_WINOGRAD_F2X3>(
+            GroupCount, InputChannels, FilterCount, Filter, PackedFilter);
+    }
+}
+
+size_t
+MlasConvWinogradWorkingBufferSizePerThread(
+    const MLAS_CONV_PARAMETERS* Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of working buffer elements required by
+    each thread to process a block of tile rows.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters, including the Winograd tile size and tile rows per block.
+
+Return Value:
+
+    Returns the number of working buffer elements per thread.
+
+--*/
+{
+    const size_t TileSize = Parameters->u.Winograd.TileSize;
+    const size_t Alpha = TileSize + 2;
+    const size_t TilesW = (Parameters->OutputShape[1] + TileSize - 1) / TileSize;
+    const size_t TileCount = Parameters->u.Winograd.TileRowsPerBlock * TilesW;
+
+    //
+    // The buffer holds the transformed input tiles, the transformed domain
+    // products, and the strip of input or output rows for a single tile row.
+    //
+
+    return Alpha * Alpha * (Parameters->InputChannels + Parameters->FilterCount) * TileCount +
+        Alpha * TileSize * (TilesW + 1);
+}
+
+template<typename WinogradType, typename V>
+size_t
+MlasConvWinogradInputTransformTiles(
+    const float* Strip,
+    size_t StripStride,
+    float* v,
+    size_t PositionStride,
+    size_t TileStart,
+    size_t TileEnd
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a run of adjacent input tiles from a tile row into
+    the Winograd domain, processing V::Count tiles per iteration.
+
+Arguments:
+
+    Strip - Supplies the input rows for the tile row, split into TileSize
+        phases so that the same position of adjacent tiles is contiguous.
+
+    StripStride - Supplies the number of elements in each phase of the strip.
+
+    v - Supplies the buffer to receive the transformed tiles.
+
+    PositionStride - Supplies the number of elements between transformed
+        positions in the output buffer.
+
+    TileStart - Supplies the first tile to transform.
+
+    TileEnd - Supplies the end of the tiles to transform.
+
+Return Value:
+
+    Returns the first tile that was not transformed.
+
+--*/
+{
+    constexpr size_t TileSize = WinogradType::TileSize;
+    constexpr size_t Alpha = WinogradType::Alpha;
+
+    typedef typename V::T T;
+
+    size_t tw = TileStart;
+
+    for (; tw + V::Count <= TileEnd; tw += V::Count) {
+
+        T Rows[Alpha][Alpha];
+
+        //
+        // Compute Bt * d * B by transforming the rows and then the resulting
+        // columns.
+        //
+
+        for (size_t y = 0; y < Alpha; y++) {
+
+            T d[Alpha];
+
+            for (size_t x = 0; x < Alpha; x++) {
+                d[x] = V::Load(Strip + (y * TileSize + x % TileSize) * StripStride + tw + x / TileSize);
+            }
+
+            WinogradType::template InputTransform<V>(d, Rows[y]);
+        }
+
+        for (size_t x = 0; x < Alpha; x++) {
+
+            T Column[Alpha];
+            T o[Alpha];
+
+            for (size_t y = 0; y < Alpha; y++) {
+                Column[y] = Rows[y][x];
+            }
+
+            WinogradType::template InputTransform<V>(Column, o);
+
+            for (size_t y = 0; y < Alpha; y++) {
+                V::Store(v + (y * Alpha + x) * PositionStride + tw, o[y]);
+            }
+        }
+    }
+
+    return tw;
+}
+
+template<typename WinogradType>
+void
+MlasConvWinogradInputTransform(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    float* V,
+    float* Strip,
+    size_t TileRowStart,
+    size_t TileRows
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a block of input tiles into the Winograd domain.
+
+    The transformed tiles are stored as [Alpha^2][InputChannels][TileCount] so
+    that each transformed position is a row major matrix that can be used
+    directly as the B operand of a GEMM.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor for the current batch and group.
+
+    V - Supplies the buffer to receive the transformed tiles.
+
+    Strip - Supplies a scratch buffer for the input rows of a tile row.
+
+    TileRowStart - Supplies the first row of tiles to transform.
+
+    TileRows - Supplies the number of rows of tiles to transform.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t TileSize = WinogradType::TileSize;
+    constexpr size_t Alpha = WinogradType::Alpha;
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t InputSize = Parameters->InputSize;
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+
+    const size_t TilesW = (Parameters->OutputShape[1] + TileSize - 1) / TileSize;
+    const size_t TileCount = TileRows * TilesW;
+    const size_t PositionStride = InputChannels * TileCount;
+    const size_t StripStride = TilesW + 1;
+
+    for (size_t c = 0; c < InputChannels; c++) {
+
+        const float* input = Input + c * InputSize;
+
+        for (size_t tr = 0; tr < TileRows; tr++) {
+
+            //
+            // Gather the input rows for the tile row with zero padding. The
+            // input indices wrap around when the tile overlaps the top or
+            // left padding, which is then treated as out of bounds.
+            //
+
+            const size_t ih0 = (TileRowStart + tr) * TileSize - PaddingTop;
+
+            for (size_t y = 0; y < Alpha; y++) {
+
+                const size_t ih = ih0 + y;
+                const float* row = input + ih * InputWidth;
+
+                for (size_t phase = 0; phase < TileSize; phase++) {
+
+                    float* strip = Strip + (y * TileSize + phase) * StripStride;
+
+                    for (size_t j = 0; j < StripStride; j++) {
+
+                        const size_t iw = j * TileSize + phase - PaddingLeft;
+
+                        strip[j] = (ih < InputHeight && iw < InputWidth) ? row[iw] : 0.0f;
+                    }
+                }
+            }
+
+            float* v = V + c * TileCount + tr * TilesW;
+
+            size_t tw = MlasConvWinogradInputTransformTiles<WinogradType, MLAS_WINOGRAD_FLOAT32X4>(
+                Strip, StripStride, v, PositionStride, 0, TilesW);
+
+            MlasConvWinogradInputTransformTiles<WinogradType, MLAS_WINOGRAD_FLOAT32>(
+                Strip, StripStride, v, PositionStride, tw, TilesW);
+        }
+    }
+}
+
+template<typename WinogradType, typename V>
+size_t
+MlasConvWinogradOutputTransformTiles(
+    const float* m,
+    size_t PositionStride,
+    float* Strip,
+    size_t StripStride,
+    size_t TileStart,
+    size_t TileEnd
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a run of adjacent tiles from a tile row of Winograd
+    domain products back to output tiles, processing V::Count tiles per
+    iteration.
+
+Arguments:
+
+    m - Supplies the products for the tile row.
+
+    PositionStride - Supplies the number of elements between transformed
+        positions in the products buffer.
+
+    Strip - Supplies the buffer to receive the output rows for the tile row,
+        split into TileSize phases so that the same position of adjacent tiles
+        is contiguous.
+
+    StripStride - Supplies the number of elements in each phase of the strip.
+
+    TileStart - Supplies the first tile to transform.
+
+    TileEnd - Supplies the end of the tiles to transform.
+
+Return Value:
+
+    Returns the first tile that was not transformed.
+
+--*/
+{
+    constexpr size_t TileSize = WinogradType::TileSize;
+    constexpr size_t Alpha = WinogradType::Alpha;
+
+    typedef typename V::T T;
+
+    size_t tw = TileStart;
+
+    for (; tw + V::Count <= TileEnd; tw += V::Count) {
+
+        T Rows[TileSize][Alpha];
+
+        //
+        // Compute At * m * A by transforming the columns and then the
+        // resulting rows.
+        //
+
+        for (size_t x = 0; x < Alpha; x++) {
+
+            T Column[Alpha];
+            T o[TileSize];
+
+            for (size_t y = 0; y < Alpha; y++) {
+                Column[y] = V::Load(m + (y * Alpha + x) * PositionStride + tw);
+            }
+
+            WinogradType::template OutputTransform<V>(Column, o);
+
+            for (size_t y = 0; y < TileSize; y++) {
+                Rows[y][x] = o[y];
+            }
+        }
+
+        for (size_t y = 0; y < TileSize; y++) {
+
+            T o[TileSize];
+
+            WinogradType::template OutputTransform<V>(Rows[y], o);
+
+            for (size_t x = 0; x < TileSize; x++) {
+                V::Store(Strip + (y * TileSize + x) * StripStride + tw, o[x]);
+            }
+        }
+    }
+
+    return tw;
+}
+
+template<typename WinogradType>
+void
+MlasConvWinogradOutputTransform(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* M,
+    float* Output,
+    float* Strip,
+    size_t TileRowStart,
+    size_t TileRows
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a block of Winograd domain products back to output
+    tiles. Tiles that extend beyond the output dimensions are clipped.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    M - Supplies the products stored as [Alpha^2][FilterCount][TileCount].
+
+    Output - Supplies the output tensor for the current batch and group.
+
+    Strip - Supplies a scratch buffer for the output rows of a tile row.
+
+    TileRowStart - Supplies the first row of tiles to transform.
+
+    TileRows - Supplies the number of rows of tiles to transform.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t TileSize = WinogradType::TileSize;
+
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+    const float Beta = Parameters->Beta;
+
+    const size_t TilesW = (OutputWidth + TileSize - 1) / TileSize;
+    const size_t TileCount = TileRows * TilesW;
+    const size_t PositionStride = FilterCount * TileCount;
+    const size_t StripStride = TilesW;
+
+    for (size_t f = 0; f < FilterCount; f++) {
+
+        float* output = Output + f * OutputSize;
+
+        for (size_t tr = 0; tr < TileRows; tr++) {
+
+            const float* m = M + f * TileCount + tr * TilesW;
+
+            size_t tw = MlasConvWinogradOutputTransformTiles<WinogradType, MLAS_WINOGRAD_FLOAT32X4>(
+                m, PositionStride, Strip, StripStride, 0, TilesW);
+
+            MlasConvWinogradOutputTransformTiles<WinogradType, MLAS_WINOGRAD_FLOAT32>(
+                m, PositionStride, Strip, StripStride, tw, TilesW);
+
+            //
+            // Interleave the phases of the strip into the output rows.
+            //
+
+            const size_t oh0 = (TileRowStart + tr) * TileSize;
+            const size_t CountH = std::min(TileSize, OutputHeight - oh0);
+
+            for (size_t y = 0; y < CountH; y++) {
+
+                const float* strip = Strip + y * TileSize * StripStride;
+                float* out = output + (oh0 + y) * OutputWidth;
+
+                if (Beta == 0.0f) {
+                    for (size_t ow = 0; ow < OutputWidth; ow++) {
+                        out[ow] = strip[(ow % TileSize) * StripStride + ow / TileSize];
+                    }
+                } else {
+                    for (size_t ow = 0; ow < OutputWidth; ow++) {
+                        out[ow] = strip[(ow % TileSize) * StripStride + ow / TileSize] + Beta * out[ow];
+                    }
+                }
+            }
+        }
+    }
+}
+
+template<typename WinogradType>
+void
+MlasConvWinogradOperation(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* PackedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    size_t TileRowStart,
+    size_t TileRows
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of output tile rows for a single batch and
+    group using the Winograd algorithm.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor for the current batch and group.
+
+    PackedFilter - Supplies the packed filter for the current group.
+
+    Bias - Optionally supplies the bias vector for the current group.
+
+    WorkingBuffer - Supplies the working buffer for the current thread.
+
+    Output - Supplies the output tensor for the current batch and group.
+
+    TileRowStart - Supplies the first row of tiles to compute.
+
+    TileRows - Supplies the number of rows of tiles to compute.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t TileSize = WinogradType::TileSize;
+    constexpr size_t AlphaSquared = WinogradType::Alpha * WinogradType::Alpha;
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+
+    const size_t TilesW = (OutputWidth + TileSize - 1) / TileSize;
+    const size_t TileCount = TileRows * TilesW;
+
+    float* V = WorkingBuffer;
+    float* M = V + AlphaSquared * InputChannels * TileCount;
+    float* Strip = M + AlphaSquared * FilterCount * TileCount;
+
+    MlasConvWinogradInputTransform<WinogradType>(Parameters, Input, V, Strip, TileRowStart, TileRows);
+
+    //
+    // Accumulate over the input channels independently for each transformed
+    // position.
+    //
+
+    for (size_t xi = 0; xi < AlphaSquared; xi++) {
+
+        MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, TileCount, InputChannels,
+            1.0f, PackedFilter + xi * FilterCount * InputChannels, InputChannels,
+            V + xi * InputChannels * TileCount, TileCount, 0.0f,
+            M + xi * FilterCount * TileCount, TileCount);
+    }
+
+    MlasConvWinogradOutputTransform<WinogradType>(Parameters, M, Output, Strip, TileRowStart, TileRows);
+
+    //
+    // Apply the activation with optional bias to the completed output rows.
+    //
+
+    const size_t OutputRowStart = TileRowStart * TileSize;
+    const size_t OutputRows = std::min((TileRowStart + TileRows) * TileSize, OutputHeight) -
+        OutputRowStart;
+
+    MlasActivation(Parameters->Activation, Output + OutputRowStart * OutputWidth, Bias,
+        FilterCount, OutputRows * OutputWidth, Parameters->OutputSize);
+}
+
+template<typename WinogradType>
+void
+MlasConvWinogradThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    Winograd convolution operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WINOGRAD_WORK_BLOCK* WorkBlock = (MLAS_CONV_WINOGRAD_WORK_BLOCK*)Context;
+
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    constexpr size_t TileSize = WinogradType::TileSize;
+    constexpr size_t AlphaSquared = WinogradType::Alpha * WinogradType::Alpha;
+
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputGroupSize = Parameters->InputChannels * Parameters->InputSize;
+    const size_t OutputGroupSize = FilterCount * Parameters->OutputSize;
+    const size_t PackedFilterGroupSize = AlphaSquared * FilterCount * Parameters->InputChannels;
+
+    const size_t TilesH = (Parameters->OutputShape[0] + TileSize - 1) / TileSize;
+    const size_t TileRowsPerBlock = Parameters->u.Winograd.TileRowsPerBlock;
+    const size_t BlocksPerImage = (TilesH + TileRowsPerBlock - 1) / TileRowsPerBlock;
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount,
+        Parameters->BatchCount * GroupCount * BlocksPerImage, &WorkIndex, &WorkRemaining);
+
+    float* WorkingBuffer = WorkBlock->WorkingBuffer + Index * WorkBlock->WorkingBufferSizePerThread;
+
+    while (WorkRemaining > 0) {
+
+        const size_t bg = WorkIndex / BlocksPerImage;
+        const size_t group = bg % GroupCount;
+        const size_t TileRowStart = (WorkIndex % BlocksPerImage) * TileRowsPerBlock;
+        const size_t TileRows = std::min(TileRowsPerBlock, TilesH - TileRowStart);
+
+        const float* bias = WorkBlock->Bias;
+
+        if (bias != nullptr) {
+            bias += group * FilterCount;
+        }
+
+        MlasConvWinogradOperation<WinogradType>(Parameters,
+            WorkBlock->Input + bg * InputGroupSize,
+            WorkBlock->PackedFilter + group * PackedFilterGroupSize,
+            bias,
+            WorkingBuffer,
+            WorkBlock->Output + bg * OutputGroupSize,
+            TileRowStart,
+            TileRows);
+
+        WorkIndex++;
+        WorkRemaining--;
+    }
+}
+
+bool
+MlasConvWinogradTryPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    const float* PackedFilter,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine determines whether the Winograd algorithm should be used for
+    the convolution and, if so, computes the blocking parameters and the
+    required working buffer size.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation. The shapes must already be
+        promoted to two dimensions.
+
+    PackedFilter - Optionally supplies the filter transformed by
+        MlasConvWinogradPackFilter.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    Returns true if the Winograd algorithm was selected, else false.
+
+--*/
+{
+    if (Parameters->Dimensions != 2 ||
+        Parameters->KernelShape[0] != 3 || Parameters->KernelShape[1] != 3 ||
+        Parameters->StrideShape[0] != 1 || Parameters->StrideShape[1] != 1 ||
+        Parameters->DilationShape[0] != 1 || Parameters->DilationShape[1] != 1) {
+        return false;
+    }
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t TileSize = MlasConvWinogradTileSize(InputChannels, FilterCount);
+
+    if (TileSize == 0) {
+        return false;
+    }
+
+    //
+    // Require enough output tiles for the transformed domain GEMMs to be
+    // worthwhile.
+    //
+
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+
+    if (OutputHeight < TileSize || OutputWidth < TileSize) {
+        return false;
+    }
+
+    const size_t TilesH = (OutputHeight + TileSize - 1) / TileSize;
+    const size_t TilesW = (OutputWidth + TileSize - 1) / TileSize;
+
+    if (TilesH * TilesW < MLAS_CONV_WINOGRAD_MINIMUM_TILES) {
+        return false;
+    }
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // convolution operation.
+    //
+
+    ptrdiff_t TargetThreadCount;
+    double Complexity = double(Parameters->BatchCount) * double(Parameters->GroupCount) *
+        double(FilterCount) * double(Parameters->OutputSize) * double(Parameters->K);
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Without a packed filter, MlasConvWinograd transforms the filter on each
+    // call before scheduling the tiles, so require enough tiles per thread to
+    // hide that cost.
+    //
+
+    const size_t TileCount = Parameters->BatchCount * TilesH * TilesW;
+
+    if (PackedFilter == nullptr &&
+        TileCount < size_t(TargetThreadCount) * MLAS_CONV_WINOGRAD_UNPACKED_MINIMUM_TILES_PER_THREAD) {
+        return false;
+    }
+
+    //
+    // Block the image by rows of tiles. Shrink the blocks if there are not
+    // enough batches and groups to keep the target threads busy.
+    //
+
+    const size_t BatchGroupCount = Parameters->BatchCount * Parameters->GroupCount;
+    const size_t BlocksPerImageTarget = (size_t(TargetThreadCount) + BatchGroupCount - 1) / BatchGroupCount;
+
+    size_t TileRowsPerBlock = (MLAS_CONV_WINOGRAD_TILES_PER_BLOCK + TilesW - 1) / TilesW;
+    TileRowsPerBlock = std::min(TileRowsPerBlock, (TilesH + BlocksPerImageTarget - 1) / BlocksPerImageTarget);
+    TileRowsPerBlock = std::max(TileRowsPerBlock, size_t(1));
+
+    const size_t BlocksPerImage = (TilesH + TileRowsPerBlock - 1) / TileRowsPerBlock;
+    const size_t WorkCount = BatchGroupCount * BlocksPerImage;
+
+    if (size_t(TargetThreadCount) > WorkCount) {
+        TargetThreadCount = ptrdiff_t(WorkCount);
+    }
+
+    Parameters->ThreadCount = TargetThreadCount;
+
+    Parameters->Algorithm = MlasConvAlgorithmWinograd;
+    Parameters->u.Winograd.TileSize = TileSize;
+    Parameters->u.Winograd.TileRowsPerBlock = TileRowsPerBlock;
+    Parameters->u.Winograd.PackedFilter = PackedFilter;
+
+    *WorkingBufferSize = size_t(TargetThreadCount) *
+        MlasConvWinogradWorkingBufferSizePerThread(Parameters);
+
+    return true;
+}
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the convolution operation using the Winograd
+    algorithm selected by MlasConvWinogradTryPrepare.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor.
+
+    Filter - Supplies the filter tensor. The filter is only used if the
+        parameters do not supply a packed filter.
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvPrepare.
+
+    Output - Supplies the output tensor.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t TileSize = Parameters->u.Winograd.TileSize;
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t GroupCount = Parameters->GroupCount;
+
+    const float* PackedFilter = Parameters->u.Winograd.PackedFilter;
+
+    //
+    // Transform the filter on the calling thread if the caller did not supply
+    // a packed filter.
+    //
+
+    if (PackedFilter == nullptr) {
+
+        const size_t PackedFilterSize =
+            MlasConvWinogradPackedFilterSize(GroupCount, InputChannels, FilterCount);
+
+        MlasThreadedBufAlloc(PackedFilterSize * sizeof(float));
+
+        float* PackedFilterBuffer = reinterpret_cast<float*>(ThreadedBufHolder.get());
+
+        MlasConvWinogradPackFilter(GroupCount, InputChannels, FilterCount, Filter,
+            PackedFilterBuffer);
+
+        PackedFilter = PackedFilterBuffer;
+    }
+
+    MLAS_CONV_WINOGRAD_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.Input = Input;
+    WorkBlock.PackedFilter = PackedFilter;
+    WorkBlock.Bias = Bias;
+    WorkBlock.WorkingBuffer = WorkingBuffer;
+    WorkBlock.Output = Output;
+    WorkBlock.WorkingBufferSizePerThread = MlasConvWinogradWorkingBufferSizePerThread(Parameters);
+    WorkBlock.ThreadCount = Parameters->ThreadCount;
+
+    if (TileSize == MLAS_WINOGRAD_F4X3::TileSize) {
+        MlasExecuteThreaded(MlasConvWinogradThreaded<MLAS_WINOGRAD_F4X3>, &WorkBlock,
+            WorkBlock.ThreadCount, ThreadPool);
+    } else {
+        MlasExecuteThreaded(MlasConvWinogradThreaded<MLAS_WINOGRAD_F2X3>, &WorkBlock,
+            WorkBlock.ThreadCount, ThreadPool);
+    }
+}
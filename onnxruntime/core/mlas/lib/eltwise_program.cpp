@@ -0,0 +1,562 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    eltwise_program.cpp
+
+Abstract:
+
+    This module implements routines to execute a program of elementwise
+    operations in a single pass over memory.
+
+    The output is split into tiles that are small enough for the temporary
+    registers of the program to stay resident in the first level cache. Each
+    instruction of the program is applied to the whole tile before moving to
+    the next instruction, so every input element is read once and every
+    output element is written once.
+
+    Inputs that contain fewer elements than the output repeat with a period
+    of their element count. Inputs with a short period are expanded into a
+    pattern buffer once per thread. Longer periods are read in place by
+    splitting tiles at the period boundaries.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of output elements that are processed as a single tile.
+//
+
+#define MLAS_ELTWISE_PROGRAM_TILE_SIZE      256
+
+//
+// Define the structure used to pass the parameters of a program to worker
+// threads.
+//
+
+struct MLAS_ELTWISE_PROGRAM_WORK_BLOCK {
+    const MLAS_ELTWISE_INSTRUCTION* Instructions;
+    size_t InstructionCount;
+    size_t RegisterCount;
+    const float* const* Inputs;
+    const size_t* InputCounts;
+    size_t InputCount;
+    float* Output;
+    size_t N;
+    ptrdiff_t ThreadCount;
+};
+
+struct MlasEltwiseProgramAddOp {
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 A, MLAS_FLOAT32X4 B) { return MlasAddFloat32x4(A, B); }
+};
+
+struct MlasEltwiseProgramSubOp {
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 A, MLAS_FLOAT32X4 B) { return MlasSubtractFloat32x4(A, B); }
+};
+
+struct MlasEltwiseProgramMulOp {
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 A, MLAS_FLOAT32X4 B) { return MlasMultiplyFloat32x4(A, B); }
+};
+
+struct MlasEltwiseProgramDivOp {
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 A, MLAS_FLOAT32X4 B) { return MlasDivideFloat32x4(A, B); }
+};
+
+struct MlasEltwiseProgramMaxOp {
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 A, MLAS_FLOAT32X4 B) { return MlasPropagateNaNFloat32x4(A, B, MlasMaximumFloat32x4(A, B)); }
+};
+
+struct MlasEltwiseProgramMinOp {
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 A, MLAS_FLOAT32X4 B) { return MlasPropagateNaNFloat32x4(A, B, MlasMinimumFloat32x4(A, B)); }
+};
+
+struct MlasEltwiseProgramReluOp {
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 A) { return MlasMaximumFloat32x4(A, MlasZeroFloat32x4()); }
+};
+
+struct MlasEltwiseProgramNegOp {
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 A) { return MlasXorFloat32x4(A, MlasBroadcastFloat32x4(-0.0f)); }
+};
+
+struct MlasEltwiseProgramAbsOp {
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 A) { return MlasAndNotFloat32x4(MlasBroadcastFloat32x4(-0.0f), A); }
+};
+
+struct MlasEltwiseProgramReciprocalOp {
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 A) { return MlasDivideFloat32x4(MlasBroadcastFloat32x4(1.0f), A); }
+};
+
+template<typename Op>
+void
+MlasEltwiseProgramBinary(
+    const float* Source0,
+    const float* Source1,
+    float* Destination,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine applies a binary vector operation to a pair of buffers.
+
+    N.B. The trailing elements are computed with the same vector operation so
+    that the results do not depend on the position of an element in the tile.
+
+Arguments:
+
+    Source0 - Supplies the first operand buffer.
+
+    Source1 - Supplies the second operand buffer.
+
+    Destination - Supplies the output buffer, which may alias either operand.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N >= 4) {
+        MlasStoreFloat32x4(Destination, Op::Apply(MlasLoadFloat32x4(Source0), MlasLoadFloat32x4(Source1)));
+
+        Source0 += 4;
+        Source1 += 4;
+        Destination += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+        MLAS_FLOAT32X4 Result = Op::Apply(MlasBroadcastFloat32x4(Source0), MlasBroadcastFloat32x4(Source1));
+        MlasStoreLaneFloat32x4<0>(Destination, Result);
+
+        Source0 += 1;
+        Source1 += 1;
+        Destination += 1;
+        N -= 1;
+    }
+}
+
+template<typename Op>
+void
+MlasEltwiseProgramUnary(
+    const float* Source,
+    float* Destination,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine applies a unary vector operation to a buffer.
+
+Arguments:
+
+    Source - Supplies the operand buffer.
+
+    Destination - Supplies the output buffer, which may alias the operand.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N >= 4) {
+        MlasStoreFloat32x4(Destination, Op::Apply(MlasLoadFloat32x4(Source)));
+
+        Source += 4;
+        Destination += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+        MlasStoreLaneFloat32x4<0>(Destination, Op::Apply(MlasBroadcastFloat32x4(Source)));
+
+        Source += 1;
+        Destination += 1;
+        N -= 1;
+    }
+}
+
+void
+MlasEltwiseProgramExecuteInstruction(
+    MLAS_ELTWISE_OPCODE Opcode,
+    const float* Source0,
+    const float* Source1,
+    float* Destination,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine executes a single instruction of a program over a span of
+    elements.
+
+Arguments:
+
+    Opcode - Supplies the operation to execute.
+
+    Source0 - Supplies the first operand buffer.
+
+    Source1 - Supplies the second operand buffer for binary operations, else
+        nullptr.
+
+    Destination - Supplies the output buffer, which may alias either operand.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    switch (Opcode) {
+        case MlasEltwiseOpAdd:
+            MlasEltwiseProgramBinary<MlasEltwiseProgramAddOp>(Source0, Source1, Destination, N);
+            break;
+
+        case MlasEltwiseOpSub:
+            MlasEltwiseProgramBinary<MlasEltwiseProgramSubOp>(Source0, Source1, Destination, N);
+            break;
+
+        case MlasEltwiseOpMul:
+            MlasEltwiseProgramBinary<MlasEltwiseProgramMulOp>(Source0, Source1, Destination, N);
+            break;
+
+        case MlasEltwiseOpDiv:
+            MlasEltwiseProgramBinary<MlasEltwiseProgramDivOp>(Source0, Source1, Destination, N);
+            break;
+
+        case MlasEltwiseOpMax:
+            MlasEltwiseProgramBinary<MlasEltwiseProgramMaxOp>(Source0, Source1, Destination, N);
+            break;
+
+        case MlasEltwiseOpMin:
+            MlasEltwiseProgramBinary<MlasEltwiseProgramMinOp>(Source0, Source1, Destination, N);
+            break;
+
+        case MlasEltwiseOpRelu:
+            MlasEltwiseProgramUnary<MlasEltwiseProgramReluOp>(Source0, Destination, N);
+            break;
+
+        case MlasEltwiseOpSigmoid:
+            MlasComputeLogistic(Source0, Destination, N);
+            break;
+
+        case MlasEltwiseOpTanh:
+            MlasComputeTanh(Source0, Destination, N);
+            break;
+
+        case MlasEltwiseOpExp:
+            MlasComputeExp(Source0, Destination, N);
+            break;
+
+        case MlasEltwiseOpLog:
+            MlasComputeLog(Source0, Destination, N);
+            break;
+
+        case MlasEltwiseOpErf:
+            MlasComputeErf(Source0, Destination, N);
+            break;
+
+        case MlasEltwiseOpNeg:
+            MlasEltwiseProgramUnary<MlasEltwiseProgramNegOp>(Source0, Destination, N);
+            break;
+
+        case MlasEltwiseOpAbs:
+            MlasEltwiseProgramUnary<MlasEltwiseProgramAbsOp>(Source0, Destination, N);
+            break;
+
+        case MlasEltwiseOpSqrt:
+            for (size_t n = 0; n < N; n++) {
+                Destination[n] = std::sqrt(Source0[n]);
+            }
+            break;
+
+        case MlasEltwiseOpReciprocal:
+            MlasEltwiseProgramUnary<MlasEltwiseProgramReciprocalOp>(Source0, Destination, N);
+            break;
+    }
+}
+
+void
+MlasEltwiseProgramThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a program over a
+    segment of the output.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_ELTWISE_PROGRAM_WORK_BLOCK*)Context;
+
+    const MLAS_ELTWISE_INSTRUCTION* Instructions = WorkBlock->Instructions;
+    const size_t InstructionCount = WorkBlock->InstructionCount;
+    const size_t RegisterCount = WorkBlock->RegisterCount;
+    const size_t InputCount = WorkBlock->InputCount;
+    const size_t N = WorkBlock->N;
+
+    size_t TileIndex;
+    size_t TileRemaining;
+
+    const size_t TileCount = (N + MLAS_ELTWISE_PROGRAM_TILE_SIZE - 1) / MLAS_ELTWISE_PROGRAM_TILE_SIZE;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount, TileCount, &TileIndex, &TileRemaining);
+
+    if (TileRemaining == 0) {
+        return;
+    }
+
+    //
+    // Carve the thread local buffer into the register table, the pattern
+    // table, the temporary registers and the pattern buffers of the short
+    // period inputs.
+    //
+
+    const size_t TemporaryCount = RegisterCount - InputCount;
+    const size_t TemporaryElements = TemporaryCount * MLAS_ELTWISE_PROGRAM_TILE_SIZE;
+
+    size_t PatternElements = 0;
+
+    for (size_t i = 0; i < InputCount; i++) {
+        const size_t Count = WorkBlock->InputCounts[i];
+        if (Count < N && Count < MLAS_ELTWISE_PROGRAM_TILE_SIZE) {
+            PatternElements += UpAlignSize((MLAS_ELTWISE_PROGRAM_TILE_SIZE + Count) * sizeof(float)) / sizeof(float);
+        }
+    }
+
+    const size_t TableBytes = UpAlignSize((RegisterCount + InputCount) * sizeof(float*));
+
+    MlasThreadedBufAlloc(TableBytes + (TemporaryElements + PatternElements) * sizeof(float));
+
+    uint8_t* Buffer = ThreadedBufHolder.get();
+    const float** Registers = reinterpret_cast<const float**>(Buffer);
+    const float** InputPatterns = Registers + RegisterCount;
+    float* Temporaries = reinterpret_cast<float*>(Buffer + TableBytes);
+    float* Patterns = Temporaries + TemporaryElements;
+
+    for (size_t t = 0; t < TemporaryCount; t++) {
+        Registers[InputCount + t] = Temporaries + t * MLAS_ELTWISE_PROGRAM_TILE_SIZE;
+    }
+
+    //
+    // Expand the short period inputs so that any span of a tile can be read
+    // contiguously starting from the offset within the period.
+    //
+
+    for (size_t i = 0; i < InputCount; i++) {
+        const float* Input = WorkBlock->Inputs[i];
+        const size_t Count = WorkBlock->InputCounts[i];
+
+        InputPatterns[i] = nullptr;
+
+        if (Count < N && Count < MLAS_ELTWISE_PROGRAM_TILE_SIZE) {
+            const size_t PatternCount = MLAS_ELTWISE_PROGRAM_TILE_SIZE + Count;
+            for (size_t n = 0; n < PatternCount; n++) {
+                Patterns[n] = Input[n % Count];
+            }
+            InputPatterns[i] = Patterns;
+            Patterns += UpAlignSize(PatternCount * sizeof(float)) / sizeof(float);
+        }
+    }
+
+    const MLAS_ELTWISE_INSTRUCTION& LastInstruction = Instructions[InstructionCount - 1];
+
+    size_t Start = TileIndex * MLAS_ELTWISE_PROGRAM_TILE_SIZE;
+    const size_t End = std::min(N, (TileIndex + TileRemaining) * MLAS_ELTWISE_PROGRAM_TILE_SIZE);
+
+    while (Start < End) {
+
+        //
+        // Split the span at the next period boundary of any input that is
+        // read in place.
+        //
+
+        size_t CountN = std::min(End - Start, size_t(MLAS_ELTWISE_PROGRAM_TILE_SIZE));
+
+        for (size_t i = 0; i < InputCount; i++) {
+            const size_t Count = WorkBlock->InputCounts[i];
+
+            if (Count >= N) {
+                Registers[i] = WorkBlock->Inputs[i] + Start;
+            } else if (InputPatterns[i] != nullptr) {
+                Registers[i] = InputPatterns[i] + (Start % Count);
+            } else {
+                const size_t Offset = Start % Count;
+                Registers[i] = WorkBlock->Inputs[i] + Offset;
+                CountN = std::min(CountN, Count - Offset);
+            }
+        }
+
+        for (size_t ip = 0; ip < InstructionCount; ip++) {
+            const MLAS_ELTWISE_INSTRUCTION& Instruction = Instructions[ip];
+
+            float* Destination = (&Instruction == &LastInstruction) ?
+                WorkBlock->Output + Start : const_cast<float*>(Registers[Instruction.Destination]);
+            const float* Source1 = MlasEltwiseOpIsBinary(Instruction.Opcode) ?
+                Registers[Instruction.Source1] : nullptr;
+
+            MlasEltwiseProgramExecuteInstruction(Instruction.Opcode, Registers[Instruction.Source0],
+                Source1, Destination, CountN);
+        }
+
+        Start += CountN;
+    }
+}
+
+bool
+MLASCALL
+MlasEltwiseOpIsBinary(
+    MLAS_ELTWISE_OPCODE Opcode
+    )
+/*++
+
+Routine Description:
+
+    This routine returns whether the operation reads two operands.
+
+Arguments:
+
+    Opcode - Supplies the operation.
+
+Return Value:
+
+    Returns true if the operation is binary, else false.
+
+--*/
+{
+    switch (Opcode) {
+        case MlasEltwiseOpAdd:
+        case MlasEltwiseOpSub:
+        case MlasEltwiseOpMul:
+        case MlasEltwiseOpDiv:
+        case MlasEltwiseOpMax:
+        case MlasEltwiseOpMin:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+void
+MLASCALL
+MlasEltwiseProgramExecute(
+    const MLAS_ELTWISE_INSTRUCTION* Instructions,
+    size_t InstructionCount,
+    size_t RegisterCount,
+    const float* const* Inputs,
+    const size_t* InputCounts,
+    size_t InputCount,
+    float* Output,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine executes a program of elementwise operations.
+
+Arguments:
+
+    Instructions - Supplies the instructions of the program. Every register
+        must be written before it is read and only temporary registers may be
+        written.
+
+    InstructionCount - Supplies the number of instructions.
+
+    RegisterCount - Supplies the number of registers, including the input
+        registers.
+
+    Inputs - Supplies the buffers of the program inputs.
+
+    InputCounts - Supplies the number of elements of each input. The count
+        must divide N; inputs with fewer elements than N repeat with a period
+        of their element count.
+
+    InputCount - Supplies the number of inputs.
+
+    Output - Supplies the output buffer. The output must not alias any input
+        that contains fewer elements than N.
+
+    N - Supplies the number of elements of the output.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (N == 0 || InstructionCount == 0) {
+        return;
+    }
+
+    MLAS_ELTWISE_PROGRAM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Instructions = Instructions;
+    WorkBlock.InstructionCount = InstructionCount;
+    WorkBlock.RegisterCount = RegisterCount;
+    WorkBlock.Inputs = Inputs;
+    WorkBlock.InputCounts = InputCounts;
+    WorkBlock.InputCount = InputCount;
+    WorkBlock.Output = Output;
+    WorkBlock.N = N;
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // program. Limit the number of threads to the number of tiles and try to
+    // keep each thread processing a minimum amount of work before using
+    // another thread.
+    //
+
+    const size_t TileCount = (N + MLAS_ELTWISE_PROGRAM_TILE_SIZE - 1) / MLAS_ELTWISE_PROGRAM_TILE_SIZE;
+
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCount) > TileCount) {
+        ThreadCount = ptrdiff_t(TileCount);
+    }
+
+    constexpr size_t MinimumElementsPerThread = 16384;
+
+    size_t BlockCount = ((N * InstructionCount) / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCount) > BlockCount) {
+        ThreadCount = ptrdiff_t(BlockCount);
+    }
+
+    WorkBlock.ThreadCount = ThreadCount;
+
+    MlasExecuteThreaded(MlasEltwiseProgramThreaded, &WorkBlock, ThreadCount, ThreadPool);
+}
@@ -0,0 +1,489 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    log.cpp
+
+Abstract:
+
+    This module implements routines to compute the natural logarithm and the
+    power function.
+
+    This implementation uses the same polynomial coefficients and algorithm as
+    found in Cephes logf(). The mantissa is reduced to [sqrt(0.5), sqrt(2)) and
+    a degree 9 polynomial approximates log(1 + x), giving results within a few
+    ULP of std::log() over the full single precision range, including
+    denormals. The power function is computed as exp(y * log(|x|)) using the
+    exponential kernel of the platform.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Bundles the floating point constants for use by kernels written in assembly.
+//
+
+MLAS_INTERNAL_DATA const struct {
+    float SqrtHalf;
+    float MinimumNormal;
+    float DenormalScale;
+    float DenormalExponentBias;
+    float p0;
+    float p1;
+    float p2;
+    float p3;
+    float p4;
+    float p5;
+    float p6;
+    float p7;
+    float p8;
+    float Log2Low;
+    float Log2High;
+    float MaximumValue;
+    float OneHalf;
+    float One;
+    float ExponentScale;
+    float ExponentBias;
+    int32_t ExponentMask;
+    int32_t MantissaMask;
+    int32_t HalfExponent;
+} MlasLogConstants = {
+    0.707106781186547524f,
+    1.17549435e-38f,
+    8388608.0f,
+    23.0f,
+    7.0376836292e-2f,
+    -1.1514610310e-1f,
+    1.1676998740e-1f,
+    -1.2420140846e-1f,
+    1.4249322787e-1f,
+    -1.6668057665e-1f,
+    2.0000714765e-1f,
+    -2.4999993993e-1f,
+    3.3333331174e-1f,
+    -2.12194440e-4f,
+    0.693359375f,
+    std::numeric_limits<float>::max(),
+    0.5f,
+    1.0f,
+    1.0f / 8388608.0f,
+    126.0f,
+    0x7F800000,
+    0x007FFFFF,
+    0x3F000000,
+};
+
+//
+// Number of elements staged in a local single precision buffer at a time.
+//
+
+constexpr size_t MLAS_LOG_BLOCK_SIZE = 256;
+
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasComputeLogVector(
+    MLAS_FLOAT32X4 Value
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the natural logarithm for the supplied vector.
+
+    Negative inputs produce NaN, zero produces negative infinity and positive
+    infinity and NaN are returned unchanged.
+
+Arguments:
+
+    Value - Supplies the values to operate on.
+
+Return Value:
+
+    Returns the natural logarithm of the input.
+
+--*/
+{
+    const MLAS_FLOAT32X4 Zero = MlasZeroFloat32x4();
+    const MLAS_FLOAT32X4 One = MlasBroadcastFloat32x4(MlasLogConstants.One);
+
+    //
+    // Scale denormal inputs into the normal range so that the exponent and
+    // mantissa can be extracted directly from the representation.
+    //
+
+    MLAS_FLOAT32X4 DenormalMask = MlasGreaterThanFloat32x4(MlasBroadcastFloat32x4(MlasLogConstants.MinimumNormal), Value);
+    MLAS_FLOAT32X4 x = MlasBlendFloat32x4(Value,
+        MlasMultiplyFloat32x4(Value, MlasBroadcastFloat32x4(MlasLogConstants.DenormalScale)), DenormalMask);
+
+    MLAS_INT32X4 Bits = MlasReinterpretAsInt32x4(x);
+
+    //
+    // The biased exponent field is exactly representable after conversion to
+    // single precision, so scaling by 2^-23 recovers the biased exponent.
+    //
+
+    MLAS_FLOAT32X4 e = MlasCastToFloat32x4(MlasAndInt32x4(Bits, MlasBroadcastInt32x4(MlasLogConstants.ExponentMask)));
+    e = MlasMultiplyFloat32x4(e, MlasBroadcastFloat32x4(MlasLogConstants.ExponentScale));
+    e = MlasSubtractFloat32x4(e, MlasBroadcastFloat32x4(MlasLogConstants.ExponentBias));
+    e = MlasSubtractFloat32x4(e, MlasAndFloat32x4(DenormalMask, MlasBroadcastFloat32x4(MlasLogConstants.DenormalExponentBias)));
+
+    //
+    // Extract the mantissa in the range [0.5, 1) and shift it to the range
+    // [sqrt(0.5) - 1, sqrt(2) - 1).
+    //
+
+    MLAS_FLOAT32X4 m = MlasReinterpretAsFloat32x4(MlasOrInt32x4(
+        MlasAndInt32x4(Bits, MlasBroadcastInt32x4(MlasLogConstants.MantissaMask)),
+        MlasBroadcastInt32x4(MlasLogConstants.HalfExponent)));
+
+    MLAS_FLOAT32X4 SmallMask = MlasGreaterThanFloat32x4(MlasBroadcastFloat32x4(MlasLogConstants.SqrtHalf), m);
+    e = MlasSubtractFloat32x4(e, MlasAndFloat32x4(SmallMask, One));
+    m = MlasAddFloat32x4(MlasSubtractFloat32x4(m, One), MlasAndFloat32x4(SmallMask, m));
+
+    MLAS_FLOAT32X4 z = MlasMultiplyFloat32x4(m, m);
+
+    MLAS_FLOAT32X4 p = MlasBroadcastFloat32x4(MlasLogConstants.p0);
+    p = MlasMultiplyAddFloat32x4(p, m, MlasLogConstants.p1);
+    p = MlasMultiplyAddFloat32x4(p, m, MlasLogConstants.p2);
+    p = MlasMultiplyAddFloat32x4(p, m, MlasLogConstants.p3);
+    p = MlasMultiplyAddFloat32x4(p, m, MlasLogConstants.p4);
+    p = MlasMultiplyAddFloat32x4(p, m, MlasLogConstants.p5);
+    p = MlasMultiplyAddFloat32x4(p, m, MlasLogConstants.p6);
+    p = MlasMultiplyAddFloat32x4(p, m, MlasLogConstants.p7);
+    p = MlasMultiplyAddFloat32x4(p, m, MlasLogConstants.p8);
+    p = MlasMultiplyFloat32x4(p, MlasMultiplyFloat32x4(m, z));
+
+    p = MlasMultiplyAddFloat32x4(e, MlasLogConstants.Log2Low, p);
+    p = MlasMultiplyAddFloat32x4(z, -MlasLogConstants.OneHalf, p);
+    MLAS_FLOAT32X4 Result = MlasAddFloat32x4(m, p);
+    Result = MlasMultiplyAddFloat32x4(e, MlasLogConstants.Log2High, Result);
+
+    //
+    // Fix up the special values. Multiplying the input by zero propagates NaN
+    // (and produces NaN for infinity, which is then overridden).
+    //
+
+    Result = MlasAddFloat32x4(Result, MlasMultiplyFloat32x4(Value, Zero));
+
+    MLAS_FLOAT32X4 AbsValue = MlasAndNotFloat32x4(MlasBroadcastFloat32x4(-0.0f), Value);
+    MLAS_FLOAT32X4 ZeroMask = MlasGreaterThanFloat32x4(MlasBroadcastFloat32x4(std::numeric_limits<float>::denorm_min()), AbsValue);
+    MLAS_FLOAT32X4 NegativeMask = MlasGreaterThanFloat32x4(Zero, Value);
+    MLAS_FLOAT32X4 InfinityMask = MlasGreaterThanFloat32x4(Value, MlasBroadcastFloat32x4(MlasLogConstants.MaximumValue));
+
+    Result = MlasBlendFloat32x4(Result, MlasBroadcastFloat32x4(-std::numeric_limits<float>::infinity()), ZeroMask);
+    Result = MlasBlendFloat32x4(Result, MlasBroadcastFloat32x4(std::numeric_limits<float>::quiet_NaN()), NegativeMask);
+    Result = MlasBlendFloat32x4(Result, Value, InfinityMask);
+
+    return Result;
+}
+
+void
+MLASCALL
+MlasLogKernel(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the natural logarithm.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N >= 4) {
+        MlasStoreFloat32x4(Output, MlasComputeLogVector(MlasLoadFloat32x4(Input)));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    if (N > 0) {
+        float Buffer[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+        std::copy_n(Input, N, Buffer);
+        MlasStoreFloat32x4(Buffer, MlasComputeLogVector(MlasLoadFloat32x4(Buffer)));
+        std::copy_n(Buffer, N, Output);
+    }
+}
+
+template <>
+void
+MLASCALL
+MlasComputeLog<float>(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the natural logarithm.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasLogKernel(Input, Output, N);
+}
+
+template <>
+void
+MLASCALL
+MlasComputeLog<MLAS_FP16>(
+    const MLAS_FP16* Input,
+    MLAS_FP16* Output,
+    size_t N
+    )
+{
+    float Buffer[MLAS_LOG_BLOCK_SIZE];
+
+    while (N > 0) {
+        const size_t count = std::min(N, MLAS_LOG_BLOCK_SIZE);
+
+        MlasConvertHalfToFloatBuffer(Input, Buffer, count);
+        MlasLogKernel(Buffer, Buffer, count);
+        MlasConvertFloatToHalfBuffer(Buffer, Output, count);
+
+        Input += count;
+        Output += count;
+        N -= count;
+    }
+}
+
+static
+void
+MlasPowKernel(
+    const float* Input,
+    float Exponent,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the power function with a
+    finite, non-zero exponent.
+
+    The magnitude of the result is computed as exp(Exponent * log(|Input|)).
+    Negative inputs produce NaN unless the exponent is an integer, in which
+    case the sign of the result follows the parity of the exponent.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Exponent - Supplies the exponent.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const bool ExponentIsInteger = std::nearbyint(Exponent) == Exponent;
+    const bool ExponentIsOdd = ExponentIsInteger && std::fmod(Exponent, 2.0f) != 0.0f;
+
+    const MLAS_FLOAT32X4 ExponentVector = MlasBroadcastFloat32x4(Exponent);
+    const MLAS_FLOAT32X4 SignMask = MlasBroadcastFloat32x4(ExponentIsOdd ? -0.0f : 0.0f);
+    const MLAS_FLOAT32X4 NegativeInfinity = MlasBroadcastFloat32x4(-std::numeric_limits<float>::infinity());
+    const MLAS_FLOAT32X4 PositiveInfinity = MlasBroadcastFloat32x4(std::numeric_limits<float>::infinity());
+    const MLAS_FLOAT32X4 NaN = MlasBroadcastFloat32x4(std::numeric_limits<float>::quiet_NaN());
+    const MLAS_FLOAT32X4 Zero = MlasZeroFloat32x4();
+
+    float Buffer[MLAS_LOG_BLOCK_SIZE];
+
+    while (N > 0) {
+        const size_t count = std::min(N, MLAS_LOG_BLOCK_SIZE);
+        const size_t VectorCount = (count + 3) / 4 * 4;
+
+        //
+        // Compute Exponent * log(|Input|) into the local buffer, padding the
+        // partial vector with ones.
+        //
+
+        for (size_t i = 0; i < VectorCount; i += 4) {
+            MLAS_FLOAT32X4 Value;
+
+            if (i + 4 <= count) {
+                Value = MlasLoadFloat32x4(Input + i);
+            } else {
+                float Partial[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+                std::copy_n(Input + i, count - i, Partial);
+                Value = MlasLoadFloat32x4(Partial);
+            }
+
+            MLAS_FLOAT32X4 AbsValue = MlasAndNotFloat32x4(MlasBroadcastFloat32x4(-0.0f), Value);
+            MLAS_FLOAT32X4 Logarithm = MlasComputeLogVector(AbsValue);
+            MlasStoreFloat32x4(Buffer + i, MlasMultiplyFloat32x4(Logarithm, ExponentVector));
+        }
+
+        MlasComputeExp(Buffer, Buffer, VectorCount);
+
+        //
+        // Apply the sign of the result and fix up NaN inputs, which the
+        // exponential kernel does not propagate, and negative bases with a
+        // fractional exponent.
+        //
+
+        for (size_t i = 0; i < VectorCount; i += 4) {
+            MLAS_FLOAT32X4 Value;
+
+            if (i + 4 <= count) {
+                Value = MlasLoadFloat32x4(Input + i);
+            } else {
+                float Partial[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+                std::copy_n(Input + i, count - i, Partial);
+                Value = MlasLoadFloat32x4(Partial);
+            }
+
+            MLAS_FLOAT32X4 Result = MlasLoadFloat32x4(Buffer + i);
+            Result = MlasOrFloat32x4(Result, MlasAndFloat32x4(Value, SignMask));
+
+            MLAS_FLOAT32X4 OrderedMask = MlasOrFloat32x4(MlasGreaterThanFloat32x4(Value, NegativeInfinity),
+                                                         MlasGreaterThanFloat32x4(PositiveInfinity, Value));
+            Result = MlasBlendFloat32x4(NaN, Result, OrderedMask);
+
+            if (!ExponentIsInteger) {
+                MLAS_FLOAT32X4 NegativeMask = MlasAndFloat32x4(MlasGreaterThanFloat32x4(Zero, Value),
+                                                               MlasGreaterThanFloat32x4(Value, NegativeInfinity));
+                Result = MlasBlendFloat32x4(Result, NaN, NegativeMask);
+            }
+
+            if (i + 4 <= count) {
+                MlasStoreFloat32x4(Output + i, Result);
+            } else {
+                float Partial[4];
+                MlasStoreFloat32x4(Partial, Result);
+                std::copy_n(Partial, count - i, Output + i);
+            }
+        }
+
+        Input += count;
+        Output += count;
+        N -= count;
+    }
+}
+
+static
+void
+MlasPowScalarFallback(
+    const float* Input,
+    float Exponent,
+    float* Output,
+    size_t N
+    )
+{
+    for (size_t n = 0; n < N; n++) {
+        Output[n] = std::pow(Input[n], Exponent);
+    }
+}
+
+template <>
+void
+MLASCALL
+MlasComputePow<float>(
+    const float* Input,
+    float Exponent,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the power function with a scalar exponent.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer of bases.
+
+    Exponent - Supplies the exponent.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // A zero or non-finite exponent has special cases that are cheaper to
+    // handle with the C runtime (for example, pow(NaN, 0) is one).
+    //
+
+    if (Exponent == 0.0f || !std::isfinite(Exponent)) {
+        MlasPowScalarFallback(Input, Exponent, Output, N);
+    } else {
+        MlasPowKernel(Input, Exponent, Output, N);
+    }
+}
+
+template <>
+void
+MLASCALL
+MlasComputePow<MLAS_FP16>(
+    const MLAS_FP16* Input,
+    MLAS_FP16 Exponent,
+    MLAS_FP16* Output,
+    size_t N
+    )
+{
+    const float ExponentFloat = Exponent.ToFloat();
+    float Buffer[MLAS_LOG_BLOCK_SIZE];
+
+    while (N > 0) {
+        const size_t count = std::min(N, MLAS_LOG_BLOCK_SIZE);
+
+        MlasConvertHalfToFloatBuffer(Input, Buffer, count);
+        MlasComputePow(Buffer, ExponentFloat, Buffer, count);
+        MlasConvertFloatToHalfBuffer(Buffer, Output, count);
+
+        Input += count;
+        Output += count;
+        N -= count;
+    }
+}
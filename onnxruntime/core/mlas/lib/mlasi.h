@@ -1022,6 +1022,9 @@ extern "C" {
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasComputeExpF32Kernel;
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasLogisticKernel;
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasTanhKernel;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasLogKernel;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasSinKernel;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasCosKernel;
     MLAS_COMPUTE_SUMEXP_FLOAT_KERNEL MlasComputeSumExpF32Kernel;
     MLAS_COMPUTE_SOFTMAX_OUTPUT_FLOAT_KERNEL MlasComputeSoftmaxOutputF32Kernel;
     MLAS_COMPUTE_LOGSOFTMAX_OUTPUT_FLOAT_KERNEL MlasComputeLogSoftmaxOutputF32Kernel;
@@ -1572,6 +1575,29 @@ MlasConvDepthwiseFloat_CHW(
 
 #endif
 
+//
+// Winograd convolution routines.
+//
+
+bool
+MlasConvWinogradTryPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    const float* PackedFilter,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 
 //
 // Define the missing ARM64 NEON intrinsic macros from arm64_neon.h that enable
@@ -2463,6 +2489,26 @@ MlasMinimumFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
 #endif
 }
 
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasPropagateNaNFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2, MLAS_FLOAT32X4 Result)
+{
+    // N.B. MlasMaximumFloat32x4 and MlasMinimumFloat32x4 return one of the
+    // operands if the other is NaN. This replaces the lanes of their result
+    // where either operand is NaN with NaN. A lane is not NaN if it is greater
+    // than negative infinity or less than positive infinity, and the sum of the
+    // operands is NaN in the other lanes.
+    const MLAS_FLOAT32X4 NegativeInfinity = MlasBroadcastFloat32x4(-std::numeric_limits<float>::infinity());
+    const MLAS_FLOAT32X4 PositiveInfinity = MlasBroadcastFloat32x4(std::numeric_limits<float>::infinity());
+
+    MLAS_FLOAT32X4 Ordered1 = MlasOrFloat32x4(MlasGreaterThanFloat32x4(Vector1, NegativeInfinity),
+        MlasGreaterThanFloat32x4(PositiveInfinity, Vector1));
+    MLAS_FLOAT32X4 Ordered2 = MlasOrFloat32x4(MlasGreaterThanFloat32x4(Vector2, NegativeInfinity),
+        MlasGreaterThanFloat32x4(PositiveInfinity, Vector2));
+
+    return MlasBlendFloat32x4(MlasAddFloat32x4(Vector1, Vector2), Result, MlasAndFloat32x4(Ordered1, Ordered2));
+}
+
 MLAS_FORCEINLINE
 MLAS_FLOAT32X4
 MlasClampFloat32x4(MLAS_FLOAT32X4 Value, float LowerRange, float UpperRange)
@@ -33,6 +33,8 @@ enum QNBitGemmVariant {
     HQ4BitGemmVariant_CompFp16,
     HQ4BitGemmVariant_CompInt8,
     SQ8BitGemmVariant_CompInt8,
+    SQ2BitGemmVariant_CompFp32,
+    SQ2BitGemmVariant_CompInt8,
 
     // End of valid variants
 
@@ -63,6 +65,12 @@ GetQNBitGemmVariant(
             if (ComputeType == SQNBIT_CompInt8) {
                 return SQ8BitGemmVariant_CompInt8;
             }
+        } else if (BlkBitWidth == 2) {
+            if (ComputeType == SQNBIT_CompFp32) {
+                return SQ2BitGemmVariant_CompFp32;
+            } else if (ComputeType == SQNBIT_CompInt8) {
+                return SQ2BitGemmVariant_CompInt8;
+            }
         }
     }
 
@@ -106,6 +114,17 @@ MlasIsQNBitGemmAvailable(
                    Dispatch->SQ8BitGemmKernel_BlkSum_CompInt8 != nullptr &&
                    Dispatch->QuantizeARowComputeBlkSum_CompInt8 != nullptr;
         }
+        case SQ2BitGemmVariant_CompFp32: {
+            return Dispatch->SQ2BitGemmPackQuantBData != nullptr &&
+                   Dispatch->SQ2BitGemmM1Kernel_CompFp32 != nullptr &&
+                   Dispatch->SQ2BitBlkDequantBForSgemm_CompFp32 != nullptr;
+        }
+        case SQ2BitGemmVariant_CompInt8: {
+            return Dispatch->SQ2BitGemmPackQuantBData != nullptr &&
+                   Dispatch->SQ2BitGemmKernel_CompInt8 != nullptr &&
+                   (Dispatch->QuantizeARow_CompInt8 != nullptr ||
+                    Dispatch->QuantizeARowComputeBlkSum_CompInt8 != nullptr);
+        }
         default: {
             return false;
         }
@@ -131,8 +150,8 @@ QNBitGemmPerGemmWorkspaceSize(
         return 0;
     }
 
-    if (BlkBitWidth == 4 || BlkBitWidth == 8) {
-        return Dispatch->QNBitGemmPerGemmWorkspaceSize(M, N, K, BlkLen, HasZeroPoint, ComputeType);
+    if (BlkBitWidth == 2 || BlkBitWidth == 4 || BlkBitWidth == 8) {
+        return Dispatch->QNBitGemmPerGemmWorkspaceSize(M, N, K, BlkBitWidth, BlkLen, HasZeroPoint, ComputeType);
     }
 
     return 0;
@@ -150,7 +169,7 @@ QNBitGemmPerGemmWorkspaceAlignment(
         return 1;
     }
 
-    if (BlkBitWidth == 4 || BlkBitWidth == 8) {
+    if (BlkBitWidth == 2 || BlkBitWidth == 4 || BlkBitWidth == 8) {
         return Dispatch->QNBitGemmPerGemmWorkspaceAlignment(BlkLen, ComputeType);
     }
 
@@ -223,6 +242,10 @@ MlasQNBitGemmPackQuantBDataSize(
         return Dispatch->Q8BitGemmPackQuantBDataSize(
             N, K, BlkLen, HasZeroPoint, ComputeType
         );
+    } else if (BlkBitWidth == 2 && Dispatch->Q2BitGemmPackQuantBDataSize != nullptr) {
+        return Dispatch->Q2BitGemmPackQuantBDataSize(
+            N, K, BlkLen, HasZeroPoint, ComputeType
+        );
     }
 
     return 0;
@@ -321,6 +344,19 @@ MlasQNBitGemmPackQuantBData(
                 ThreadPool
             );
         }
+    } else if (BlkBitWidth == 2) {
+        // Only the quantized data is packed. Scales and zero points are used as they are.
+        if (QuantBData != nullptr && Dispatch->SQ2BitGemmPackQuantBData != nullptr) {
+            Dispatch->SQ2BitGemmPackQuantBData(
+                N,
+                K,
+                BlkLen,
+                ComputeType,
+                static_cast<const std::byte*>(QuantBData),
+                static_cast<std::byte*>(PackedQuantBDataAndOrBlkSumWorkspace),
+                ThreadPool
+            );
+        }
     }
 }
 
@@ -376,8 +412,9 @@ AddBiasForGemm(const float* Bias, float* C, size_t CountM, size_t CountN, size_t
     }
 }
 
+template <size_t BlkBitWidth>
 void
-SQ4BitGemm_CompFp32(
+SQNBitGemm_CompFp32(
     const size_t BlkLen,
     const size_t K,
     const MLAS_QNBIT_GEMM_DATA_PARAMS<float>* const DataParams,
@@ -388,10 +425,16 @@ SQ4BitGemm_CompFp32(
     const size_t RangeCountN
 )
 {
-    constexpr size_t BlkBitWidth = 4;
+    static_assert(BlkBitWidth == 2 || BlkBitWidth == 4, "only implemented for 2-bit and 4-bit quantized B");
 
     MLAS_UNREFERENCED_PARAMETER(PerGemmWorkspace);
 
+    const auto* Dispatch = GetMlasPlatform().QNBitGemmDispatch;
+    const auto M1Kernel = (BlkBitWidth == 2) ? Dispatch->SQ2BitGemmM1Kernel_CompFp32
+                                             : Dispatch->SQ4BitGemmM1Kernel_CompFp32;
+    const auto DequantBForSgemm = (BlkBitWidth == 2) ? Dispatch->SQ2BitBlkDequantBForSgemm_CompFp32
+                                                     : Dispatch->SQ4BitBlkDequantBForSgemm_CompFp32;
+
     const size_t lda = DataParams->lda;
     const size_t ldc = DataParams->ldc;
 
@@ -425,7 +468,7 @@ SQ4BitGemm_CompFp32(
             float* c_blk = C + n;
             const float* bias = (Bias == nullptr) ? nullptr : Bias + n;
 
-            GetMlasPlatform().QNBitGemmDispatch->SQ4BitGemmM1Kernel_CompFp32(
+            M1Kernel(
                 BlkLen,
                 a_row, b_col, b_col_scale, b_col_zp, c_blk, CountN, K, k_blks, bias
             );
@@ -463,7 +506,7 @@ SQ4BitGemm_CompFp32(
         float* c_blk = C + n;
         const float* bias = (Bias == nullptr) ? nullptr : Bias + n;
 
-        GetMlasPlatform().QNBitGemmDispatch->SQ4BitBlkDequantBForSgemm_CompFp32(
+        DequantBForSgemm(
             BlkLen,
             dequant_b, b_col, b_col_scale, b_col_zp, CountN, K, k_blks
         );
@@ -787,6 +830,95 @@ SQ8BitGemm_CompInt8(
     }
 }
 
+void
+SQ2BitGemm_CompInt8(
+    const size_t BlkLen,
+    const size_t K,
+    const MLAS_QNBIT_GEMM_DATA_PARAMS<float>* const DataParams,
+    void* const PerGemmWorkspace,
+    const size_t RangeStartM,
+    const size_t RangeCountM,
+    const size_t RangeStartN,
+    const size_t RangeCountN
+)
+{
+    constexpr size_t BlkBitWidth = 2;
+
+    const size_t k_blks = MlasDivRoundup(K, BlkLen);
+
+#ifdef MLAS_TARGET_AMD64_IX86
+    // A is quantized with separate scales and block sums.
+    const PerGemmQuantAWorkspace* const per_gemm_quant_a_workspace =
+        static_cast<const PerGemmQuantAWorkspace*>(PerGemmWorkspace);
+
+    const size_t lda = k_blks * BlkLen;
+    const std::byte* QuantA = per_gemm_quant_a_workspace->QuantData + RangeStartM * lda;
+    const float* QuantAScale = per_gemm_quant_a_workspace->QuantScale + RangeStartM * k_blks;
+    const float* ABlockSum = per_gemm_quant_a_workspace->BlockSum + RangeStartM * k_blks;
+#else
+    // A scales are stored with the quantized A blocks.
+    const size_t lda = k_blks * Q8BlkSize(BlkLen);
+    const std::byte* QuantA = static_cast<const std::byte*>(PerGemmWorkspace) + RangeStartM * lda;
+    const float* QuantAScale = nullptr;
+    const float* ABlockSum = nullptr;
+#endif
+
+    const size_t ldc = DataParams->ldc;
+    const size_t ldb = k_blks * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t k_blks_zp_bytes = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(k_blks);
+
+    const std::byte* QuantBData = static_cast<const std::byte*>(DataParams->PackedQuantBData) + RangeStartN * ldb;
+    const float* QuantBScale = DataParams->QuantBScale + RangeStartN * k_blks;
+    const std::byte* QuantBZeroPoint =
+        (DataParams->QuantBZeroPoint == nullptr)
+            ? nullptr
+            : static_cast<const std::byte*>(DataParams->QuantBZeroPoint) + RangeStartN * k_blks_zp_bytes;
+
+    float* C = DataParams->C + RangeStartM * ldc + RangeStartN;
+
+    const float* Bias = (DataParams->Bias == nullptr) ? nullptr : DataParams->Bias + RangeStartN;
+
+    size_t CountN;
+    for (size_t n = 0; n < RangeCountN; n += CountN) {
+        CountN = std::min(RangeCountN - n, size_t{128});
+
+        const std::byte* a_row = QuantA;
+        const float* a_row_scale = QuantAScale;
+        const float* a_row_blk_sum = ABlockSum;
+        const std::byte* b_col = QuantBData + n * ldb;
+        const float* b_col_scale = QuantBScale + n * k_blks;
+        const std::byte* b_col_zp =
+            (QuantBZeroPoint == nullptr) ? nullptr : QuantBZeroPoint + n * k_blks_zp_bytes;
+        float* c_blk = C + n;
+        const float* bias = (Bias == nullptr) ? nullptr : Bias + n;
+
+        size_t RowsRemaining = RangeCountM;
+        while (RowsRemaining > 0) {
+            const auto RowsHandled = GetMlasPlatform().QNBitGemmDispatch->SQ2BitGemmKernel_CompInt8(
+                BlkLen,
+                a_row, a_row_scale, a_row_blk_sum, b_col, b_col_scale, b_col_zp, c_blk,
+                RowsRemaining, CountN, K, k_blks, ldc, bias
+            );
+
+            if (DataParams->PostProcessor != nullptr) {
+                DataParams->PostProcessor->Process(
+                    DataParams->C, RangeStartM + RangeCountM - RowsRemaining, RangeStartN + n,
+                    RowsHandled, CountN, ldc
+                );
+            }
+
+            c_blk += RowsHandled * ldc;
+            a_row += RowsHandled * lda;
+            if (a_row_scale != nullptr) {
+                a_row_scale += RowsHandled * k_blks;
+                a_row_blk_sum += RowsHandled * k_blks;
+            }
+
+            RowsRemaining -= RowsHandled;
+        }
+    }
+}
+
 template <typename T>
 void
 InitializeWorkspace_CompInt8(
@@ -794,6 +926,7 @@ InitializeWorkspace_CompInt8(
     size_t N,
     size_t K,
     size_t BatchN,
+    size_t BlkBitWidth,
     size_t BlkLen,
     const MLAS_QNBIT_GEMM_DATA_PARAMS<T>* DataParams,
     void* Workspace,
@@ -808,6 +941,7 @@ InitializeWorkspace_CompInt8<float>(
     size_t N,
     size_t K,
     size_t BatchN,
+    size_t BlkBitWidth,
     size_t BlkLen,
     const MLAS_QNBIT_GEMM_DATA_PARAMS<float>* DataParams,
     void* Workspace,
@@ -817,7 +951,8 @@ InitializeWorkspace_CompInt8<float>(
 {
     MLAS_UNREFERENCED_PARAMETER(N);
 
-    const auto UsePacked = GetMlasPlatform().QNBitGemmDispatch->UsePacked_CompInt8;
+    // The packed A format is only used by the 4-bit kernels.
+    const auto UsePacked = (BlkBitWidth == 4) ? GetMlasPlatform().QNBitGemmDispatch->UsePacked_CompInt8 : nullptr;
     const auto QuantizeA_Packed = GetMlasPlatform().QNBitGemmDispatch->QuantizeA_Packed_CompInt8;
     const auto QuantizeARow = GetMlasPlatform().QNBitGemmDispatch->QuantizeARow_CompInt8;
     const auto QuantizeARow2 = GetMlasPlatform().QNBitGemmDispatch->QuantizeARowComputeBlkSum_CompInt8;
@@ -875,6 +1010,7 @@ InitializeWorkspace_CompInt8<MLAS_FP16>(
     size_t N,
     size_t K,
     size_t BatchN,
+    size_t BlkBitWidth,
     size_t BlkLen,
     const MLAS_QNBIT_GEMM_DATA_PARAMS<MLAS_FP16>* DataParams,
     void* Workspace,
@@ -885,6 +1021,7 @@ InitializeWorkspace_CompInt8<MLAS_FP16>(
     MLAS_UNREFERENCED_PARAMETER(N);
     MLAS_UNREFERENCED_PARAMETER(K);
     MLAS_UNREFERENCED_PARAMETER(BatchN);
+    MLAS_UNREFERENCED_PARAMETER(BlkBitWidth);
     MLAS_UNREFERENCED_PARAMETER(BlkLen);
     MLAS_UNREFERENCED_PARAMETER(DataParams);
     MLAS_UNREFERENCED_PARAMETER(Workspace);
@@ -898,6 +1035,7 @@ using InitializeWorkspaceFn = std::function<void(
     size_t N,
     size_t K,
     size_t BatchN,
+    size_t BlkBitWidth,
     size_t BlkLen,
     const MLAS_QNBIT_GEMM_DATA_PARAMS<T>* DataParams,
     void* Workspace,
@@ -916,6 +1054,7 @@ GetInitializeWorkspace(QNBitGemmVariant variant)
     switch (variant) {
         case SQ4BitGemmVariant_CompInt8:
         case SQ8BitGemmVariant_CompInt8:
+        case SQ2BitGemmVariant_CompInt8:
             return InitializeWorkspace_CompInt8<float>;
         default:
             return nullptr;
@@ -956,11 +1095,15 @@ GetQNBitGemm(QNBitGemmVariant variant)
 {
     switch (variant) {
         case SQ4BitGemmVariant_CompFp32:
-            return SQ4BitGemm_CompFp32;
+            return SQNBitGemm_CompFp32<4>;
         case SQ4BitGemmVariant_CompInt8:
             return SQ4BitGemm_CompInt8;
         case SQ8BitGemmVariant_CompInt8:
             return SQ8BitGemm_CompInt8;
+        case SQ2BitGemmVariant_CompFp32:
+            return SQNBitGemm_CompFp32<2>;
+        case SQ2BitGemmVariant_CompInt8:
+            return SQ2BitGemm_CompInt8;
         default:
             return nullptr;
     }
@@ -1015,7 +1158,7 @@ MlasQNBitGemmBatch(
     if (const auto InitializeWorkspaceOperation = GetInitializeWorkspace<T>(Variant);
         InitializeWorkspaceOperation != nullptr) {
         InitializeWorkspaceOperation(
-            M, N, K, BatchN, BlkLen, DataParams, Workspace, PerGemmWorkspaceStride, ThreadPool
+            M, N, K, BatchN, BlkBitWidth, BlkLen, DataParams, Workspace, PerGemmWorkspaceStride, ThreadPool
         );
     }
 
@@ -1042,6 +1185,9 @@ MlasQNBitGemmBatch(
                 const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->QuantBScale = packed_quant_b.PackedQuantBScale;
                 PerGemmQuantAWorkspace per_gemm_quant_a_workspace(PerGemmWorkspace, M, BlockCountK, BlkLen);
                 ComputeOperation(BlkLen, K, Data, &per_gemm_quant_a_workspace, 0, M, 0, N);
+            } else if (Variant == SQ2BitGemmVariant_CompInt8 && GetMlasPlatform().QNBitGemmDispatch->QuantizeARowComputeBlkSum_CompInt8 != nullptr) {
+                PerGemmQuantAWorkspace per_gemm_quant_a_workspace(PerGemmWorkspace, M, BlockCountK, BlkLen);
+                ComputeOperation(BlkLen, K, Data, &per_gemm_quant_a_workspace, 0, M, 0, N);
             } else {
                 ComputeOperation(BlkLen, K, Data, PerGemmWorkspace, 0, M, 0, N);
             }
@@ -1120,6 +1266,9 @@ MlasQNBitGemmBatch(
             const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->QuantBBlkSum = packed_quant_b.QuantBBlkSum;
             const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->QuantBScale = packed_quant_b.PackedQuantBScale;
 
+            PerGemmQuantAWorkspace per_gemm_quant_a_workspace(PerGemmWorkspace, M, BlockCountK, BlkLen);
+            ComputeOperation(BlkLen, K, Data, &per_gemm_quant_a_workspace, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+        } else if (Variant == SQ2BitGemmVariant_CompInt8 && GetMlasPlatform().QNBitGemmDispatch->QuantizeARowComputeBlkSum_CompInt8 != nullptr) {
             PerGemmQuantAWorkspace per_gemm_quant_a_workspace(PerGemmWorkspace, M, BlockCountK, BlkLen);
             ComputeOperation(BlkLen, K, Data, &per_gemm_quant_a_workspace, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
         } else {
@@ -75,7 +75,9 @@ template <size_t BlkBitWidth>
 constexpr MLAS_FORCEINLINE size_t
 MlasQNBitZeroPointsForBlksSizeInBytes(size_t BlkCount)
 {
-    if constexpr (BlkBitWidth <= 4) {
+    if constexpr (BlkBitWidth <= 2) {
+        return MlasDivRoundup(BlkCount, 4);  // 4 blocks per byte
+    } else if constexpr (BlkBitWidth <= 4) {
         return MlasDivRoundup(BlkCount, 2);  // 2 blocks per byte
     } else {
         return BlkCount;
@@ -113,6 +115,17 @@ struct MLAS_QNBIT_GEMM_DISPATCH {
 
     Q8BitGemmPackQuantBDataSize_Fn* Q8BitGemmPackQuantBDataSize = nullptr;
 
+    /** Gets size of packed quantized B data containing 2-bit integers. See MlasQNBitGemmPackQuantBDataSize(). */
+    typedef size_t(Q2BitGemmPackQuantBDataSize_Fn)(
+        size_t N,
+        size_t K,
+        size_t BlkLen,
+        bool HasZeroPoint,
+        MLAS_QNBIT_GEMM_COMPUTE_TYPE ComputeType
+    );
+
+    Q2BitGemmPackQuantBDataSize_Fn* Q2BitGemmPackQuantBDataSize = nullptr;
+
     /** Packs quantized B data containing 4-bit integers. See MlasQNBitGemmPackQuantBData(). */
     typedef void(Q4BitGemmPackQuantBData_Fn)(
         size_t N,
@@ -157,6 +170,22 @@ struct MLAS_QNBIT_GEMM_DISPATCH {
 
     SQ8BitGemmPackQuantBDataAndSumBlk_Fn* SQ8BitGemmPackQuantBDataAndBlkSum = nullptr;
 
+    /**
+     * @brief Packs quantized B data containing 2-bit integers. See MlasQNBitGemmPackQuantBData().
+     *        The packed data has the same size as the source data. Scales and zero points are not packed.
+     */
+    typedef void(Q2BitGemmPackQuantBData_Fn)(
+        size_t N,
+        size_t K,
+        size_t BlkLen,
+        MLAS_QNBIT_GEMM_COMPUTE_TYPE ComputeType,
+        const std::byte* QuantBDataBegin,
+        std::byte* PackedQuantBDataBegin,
+        MLAS_THREADPOOL* ThreadPool
+    );
+
+    Q2BitGemmPackQuantBData_Fn* SQ2BitGemmPackQuantBData = nullptr;
+
     //
     // Workspace size calculation function prototypes.
     //
@@ -168,6 +197,7 @@ struct MLAS_QNBIT_GEMM_DISPATCH {
      * @param[in]   M               row size of matrix A and C
      * @param[in]   N               column size of matrix B and C
      * @param[in]   K               column size of matrix A and row size of matrix B
+     * @param[in]   BlkBitWidth     quantized value bit width (e.g., 4 means 4 bit ints)
      * @param[in]   BlkLen          number of quantized values per block
      * @param[in]   HasZeroPoint    whether zero points are provided
      * @param[in]   ComputeType     GEMM compute type (e.g., multiplying float or int8 values)
@@ -176,6 +206,7 @@ struct MLAS_QNBIT_GEMM_DISPATCH {
         size_t M,
         size_t N,
         size_t K,
+        size_t BlkBitWidth,
         size_t BlkLen,
         bool HasZeroPoint,
         MLAS_QNBIT_GEMM_COMPUTE_TYPE ComputeType
@@ -262,6 +293,18 @@ struct MLAS_QNBIT_GEMM_DISPATCH {
 
     Q4BitBlkDequantBForSgemm_CompFp32_Fn* SQ4BitBlkDequantBForSgemm_CompFp32 = nullptr;
 
+    /**
+     * @brief Multiply float matrix A with quantized 2-bit integer matrix B.
+     *        Same as SQ4BitGemmM1Kernel_CompFp32, but B is packed with SQ2BitGemmPackQuantBData.
+     */
+    SQ4BitGemmM1Kernel_CompFp32_Fn* SQ2BitGemmM1Kernel_CompFp32 = nullptr;
+
+    /**
+     * @brief Dequantize B into the format expected by the Sgemm kernel.
+     *        Same as SQ4BitBlkDequantBForSgemm_CompFp32, but B is packed with SQ2BitGemmPackQuantBData.
+     */
+    Q4BitBlkDequantBForSgemm_CompFp32_Fn* SQ2BitBlkDequantBForSgemm_CompFp32 = nullptr;
+
     /**
      * @brief Dequantize B into the format expected by the Sgemm kernel.
      *        B is a quantized 4-bit integer matrix that is block quantized and column major.
@@ -445,6 +488,49 @@ struct MLAS_QNBIT_GEMM_DISPATCH {
 
     SQ4BitGemmKernel_CompInt8_Fn* SQ4BitGemmKernel_CompInt8 = nullptr;
 
+    /**
+     * @brief Multiply quantized 8-bit integer matrix A with quantized 2-bit integer matrix B.
+     *        A and B are block quantized and B is column major.
+     *        A is quantized with QuantizeARowComputeBlkSum_CompInt8 if available, otherwise with
+     *        QuantizeARow_CompInt8, in which case the A scales are stored with the A blocks.
+     *
+     * @param       BlkLen              Number of values in a block.
+     * @param       QuantA              Supplies the quantized A matrix.
+     * @param       QuantAScale         Supplies the A block scales. nullptr if stored with the A blocks.
+     * @param       ABlockSum           Supplies the A block scale times the sum of the block values.
+     *                                  nullptr if the A scales are stored with the A blocks.
+     * @param       QuantBData          Supplies the packed quantized B matrix block data.
+     * @param       QuantBScale         Supplies the quantized B matrix block scale values.
+     * @param       QuantBZeroPoint     Supplies the quantized B matrix block zero point values. Optional.
+     * @param[out]  C                   Supplies the output C matrix.
+     * @param       CountM              Number of rows of A and C to process, an upper bound.
+     * @param       CountN              Number of columns of B and C to process.
+     * @param       CountK              Number of columns of A and rows of B.
+     * @param       BlockCountK         Number of blocks in one row of A and one column of B.
+     * @param       ldc                 Number of elements between adjacent rows of C.
+     * @param       Bias                Bias vector of length N.
+     *
+     * @return                          The number of rows of A and C that were processed, at most CountM.
+     */
+    typedef size_t(SQ2BitGemmKernel_CompInt8_Fn)(
+        size_t BlkLen,
+        const std::byte* QuantA,
+        const float* QuantAScale,
+        const float* ABlockSum,
+        const std::byte* QuantBData,
+        const float* QuantBScale,
+        const std::byte* QuantBZeroPoint,
+        float* C,
+        size_t CountM,
+        size_t CountN,
+        size_t CountK,
+        size_t BlockCountK,
+        size_t ldc,
+        const float* Bias
+    );
+
+    SQ2BitGemmKernel_CompInt8_Fn* SQ2BitGemmKernel_CompInt8 = nullptr;
+
     /**
      * @brief Whether to use SQ4BitGemmKernel_Packed_CompInt8 for this problem.
      */
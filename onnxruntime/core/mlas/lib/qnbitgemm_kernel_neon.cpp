@@ -145,6 +145,87 @@ SQ4BitGemmPackQuantBData(
     );
 }
 
+size_t
+Q2BitGemmPackQuantBDataSize(
+    size_t N,
+    size_t K,
+    size_t BlkLen,
+    bool HasZeroPoint,
+    MLAS_QNBIT_GEMM_COMPUTE_TYPE ComputeType
+)
+{
+    MLAS_UNREFERENCED_PARAMETER(HasZeroPoint);
+    MLAS_UNREFERENCED_PARAMETER(ComputeType);  // same size regardless of ComputeType
+
+    constexpr size_t BlkBitWidth = 2;
+
+    const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
+    const size_t PackedQuantBDataSize = N * BlockCountK * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    return PackedQuantBDataSize;
+}
+
+void
+SQ2BitGemmPackQuantBData(
+    size_t N,
+    size_t K,
+    size_t BlkLen,
+    MLAS_QNBIT_GEMM_COMPUTE_TYPE ComputeType,
+    const std::byte* QuantBDataBegin,
+    std::byte* PackedQuantBDataBegin,
+    MLAS_THREADPOOL* ThreadPool
+)
+{
+    MLAS_UNREFERENCED_PARAMETER(ComputeType);  // same layout regardless of ComputeType
+
+    constexpr size_t BlkBitWidth = 2;
+
+    assert(BlkLen >= 16 && BlkLen % 16 == 0);
+
+    const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
+    const size_t BlkDataSize = MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t Iterations = N * BlockCountK;  // one iteration per block
+
+    constexpr size_t SubBlkLen = 16;
+    constexpr size_t SubBlkDataSize = SubBlkLen / 4;
+
+    //
+    // Pack 16 2-bit values (4 bytes) at a time like this (values of a byte are listed from the low bits):
+    //
+    // src: | v0 v1 v2 v3 | v4 v5 v6 v7 | v8 v9 vA vB | vC vD vE vF |
+    //   =>
+    // dst: | v0 v4 v8 vC | v1 v5 v9 vD | v2 v6 vA vE | v3 v7 vB vF |
+    //
+    // Shifting the 4 bytes as a 32-bit value right by 0, 2, 4 and 6 bits then puts v0-v3, v4-v7, v8-vB and vC-vF
+    // in the low bits of consecutive bytes.
+    //
+
+    MlasTrySimpleParallel(
+        ThreadPool, Iterations,
+        [&](ptrdiff_t tid) {
+            const size_t n = tid / BlockCountK;
+            const size_t k_blk = tid % BlockCountK;
+
+            const size_t data_offset = n * BlockCountK * BlkDataSize + k_blk * BlkDataSize;
+            const std::byte* QuantBData = QuantBDataBegin + data_offset;
+            std::byte* PackedQuantBData = PackedQuantBDataBegin + data_offset;
+
+            for (size_t kk = 0; kk < BlkLen; kk += SubBlkLen) {
+                for (size_t j = 0; j < SubBlkDataSize; ++j) {
+                    std::byte dst{0};
+                    for (size_t s = 0; s < 4; ++s) {
+                        const std::byte v = (QuantBData[s] >> (2 * j)) & std::byte{0x03};
+                        dst |= v << (2 * s);
+                    }
+                    PackedQuantBData[j] = dst;
+                }
+
+                QuantBData += SubBlkDataSize;
+                PackedQuantBData += SubBlkDataSize;
+            }
+        }
+    );
+}
+
 void
 SQ4BitGemmPackQuantBDataAndBlkSum(
     size_t N,
@@ -208,6 +289,7 @@ QNBitGemmPerGemmWorkspaceSize(
     size_t M,
     size_t N,
     size_t K,
+    size_t BlkBitWidth,
     size_t BlkLen,
     bool HasZeroPoint,
     MLAS_QNBIT_GEMM_COMPUTE_TYPE ComputeType
@@ -215,6 +297,7 @@ QNBitGemmPerGemmWorkspaceSize(
 {
     MLAS_UNREFERENCED_PARAMETER(N);
 #ifndef USE_KLEIDIAI
+    MLAS_UNREFERENCED_PARAMETER(BlkBitWidth);
     MLAS_UNREFERENCED_PARAMETER(HasZeroPoint);
 #endif
 
@@ -222,7 +305,7 @@ QNBitGemmPerGemmWorkspaceSize(
         case SQNBIT_CompInt8: {
             // workspace buffer is used for block quantization of A to int8
 #ifdef USE_KLEIDIAI
-            if (UseKleidiAI(K, BlkLen, HasZeroPoint)) {
+            if (BlkBitWidth == 4 && UseKleidiAI(K, BlkLen, HasZeroPoint)) {
                 const kai_matmul_clamp_f32_qai8dxp_qsi4c32p_ukernel& ukernel =
                     M == 1? GetKleidiAIGemvUKernel() : GetKleidiAIGemmUKernel();
 
@@ -298,15 +381,20 @@ GetMlasQNBitGemmDispatchNeon(
         d.Q4BitGemmPackQuantBDataSize = sqnbitgemm_neon::Q4BitGemmPackQuantBDataSize;
         d.SQ4BitGemmPackQuantBData = sqnbitgemm_neon::SQ4BitGemmPackQuantBData;
         d.SQ4BitGemmPackQuantBDataAndBlkSum = sqnbitgemm_neon::SQ4BitGemmPackQuantBDataAndBlkSum;
+        d.Q2BitGemmPackQuantBDataSize = sqnbitgemm_neon::Q2BitGemmPackQuantBDataSize;
+        d.SQ2BitGemmPackQuantBData = sqnbitgemm_neon::SQ2BitGemmPackQuantBData;
 
         d.QNBitGemmPerGemmWorkspaceSize = sqnbitgemm_neon::QNBitGemmPerGemmWorkspaceSize;
         d.QNBitGemmPerGemmWorkspaceAlignment = sqnbitgemm_neon::QNBitGemmPerGemmWorkspaceAlignment;
 
         d.SQ4BitGemmM1Kernel_CompFp32 = sqnbitgemm_neon::SQ4BitGemmM1Kernel_CompFp32;
         d.SQ4BitBlkDequantBForSgemm_CompFp32 = sqnbitgemm_neon::SQ4BitBlkDequantBForSgemm_CompFp32;
+        d.SQ2BitGemmM1Kernel_CompFp32 = sqnbitgemm_neon::SQ2BitGemmM1Kernel_CompFp32;
+        d.SQ2BitBlkDequantBForSgemm_CompFp32 = sqnbitgemm_neon::SQ2BitBlkDequantBForSgemm_CompFp32;
 
         if (InitializeWithDotSupport) {
             d.SQ4BitGemmKernel_CompInt8 = sqnbitgemm_neon::SQ4BitGemmKernel_CompInt8;
+            d.SQ2BitGemmKernel_CompInt8 = sqnbitgemm_neon::SQ2BitGemmKernel_CompInt8;
             d.QuantizeARow_CompInt8 = sqnbitgemm_neon::QuantizeARow_CompInt8;
             d.UsePacked_CompInt8 = sqnbitgemm_neon::UsePacked_CompInt8;
 
@@ -21,6 +21,7 @@ Abstract:
 
 #include <cassert>
 #include <cstddef>
+#include <cstring>
 #include <utility>
 
 #include "mlas_qnbit.h"
@@ -65,6 +66,32 @@ SQ4BitBlkDequantBForSgemm_CompFp32(
     size_t BlockCountK
 );
 
+void
+SQ2BitGemmM1Kernel_CompFp32(
+    size_t BlkLen,
+    const float* A,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    const float* Bias
+);
+
+void
+SQ2BitBlkDequantBForSgemm_CompFp32(
+    size_t BlkLen,
+    float* FpData,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK
+);
+
 // HQNBIT_CompFp16 declarations
 #if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
 void
@@ -139,6 +166,24 @@ SQ4BitGemmKernel_CompInt8(
     const float* Bias
 );
 
+size_t
+SQ2BitGemmKernel_CompInt8(
+    size_t BlkLen,
+    const std::byte* QuantA,
+    const float* QuantAScale,
+    const float* ABlockSum,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    size_t ldc,
+    const float* Bias
+);
+
 #ifdef USE_KLEIDIAI
 void
 QuantizeA_Packed_CompInt8(
@@ -219,4 +264,24 @@ LoadFloatData(const float* src, size_t count, float32x4_t (&dst)[Capacity / 4])
     }
 }
 
+// Unpacks 16 2-bit values packed by SQ2BitGemmPackQuantBData into 16 bytes.
+MLAS_FORCEINLINE uint8x16_t
+Unpack16x2BitValues(const std::byte* QuantBDataPtr)
+{
+    uint32_t packed;
+    std::memcpy(&packed, QuantBDataPtr, sizeof(packed));
+
+    // negative shift counts shift right
+    static const int32_t Shifts[4] = {0, -2, -4, -6};
+    const uint32x4_t shifted = vshlq_u32(vdupq_n_u32(packed), vld1q_s32(Shifts));
+    return vandq_u8(vreinterpretq_u8_u32(shifted), vdupq_n_u8(0x03));
+}
+
+// Gets the zero point of block `k_blk` from a column of 2-bit zero points, 4 zero points are packed in a byte.
+MLAS_FORCEINLINE uint8_t
+Get2BitZeroPoint(const std::byte* QuantBZeroPointColPtr, size_t k_blk)
+{
+    return std::to_integer<uint8_t>((QuantBZeroPointColPtr[k_blk / 4] >> (2 * (k_blk % 4))) & std::byte{0x03});
+}
+
 }  // namespace sqnbitgemm_neon
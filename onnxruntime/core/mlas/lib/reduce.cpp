@@ -0,0 +1,1005 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce.cpp
+
+Abstract:
+
+    This module implements routines to reduce a tensor along a single strided
+    axis.
+
+    The input tensor is viewed as [OuterCount][ReduceCount][InnerCount] and
+    the output tensor as [OuterCount][InnerCount]. An InnerCount of one
+    reduces contiguous rows using the platform reduction kernels. Otherwise,
+    blocks of adjacent output elements are accumulated across the rows of the
+    reduced axis.
+
+    If there are fewer output blocks than threads, the reduced axis is also
+    split into segments that are reduced by different threads into partial
+    results, which are then combined.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of adjacent output elements that are accumulated as a
+// single block when the reduced axis is not the innermost axis.
+//
+
+#define MLAS_REDUCE_INNER_BLOCK_SIZE        256
+
+//
+// Define the number of elements that are converted from half precision as a
+// single block when the reduced axis is the innermost axis.
+//
+
+#define MLAS_REDUCE_CONVERT_BLOCK_SIZE      1024
+
+//
+// Define the structure used to pass the parameters of a reduction to worker
+// threads.
+//
+
+template<typename T>
+struct MLAS_REDUCE_WORK_BLOCK {
+    MLAS_REDUCE_KIND ReduceKind;
+    const T* Input;
+    T* Output;
+    size_t OuterCount;
+    size_t ReduceCount;
+    size_t InnerCount;
+    size_t InnerBlockCount;
+    size_t SegmentCount;
+    float* Partial;
+    ptrdiff_t ThreadCount;
+};
+
+float
+MLASCALL
+MlasReduceSumF32Kernel(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to find the sum of the supplied
+    buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    Returns the sum of the supplied buffer.
+
+--*/
+{
+    float Sum = 0.0f;
+
+    if (N >= 4) {
+        MLAS_FLOAT32X4 SumVector0 = MlasZeroFloat32x4();
+
+        if (N >= 16) {
+            MLAS_FLOAT32X4 SumVector1 = SumVector0;
+            MLAS_FLOAT32X4 SumVector2 = SumVector0;
+            MLAS_FLOAT32X4 SumVector3 = SumVector0;
+
+            while (N >= 16) {
+                SumVector0 = MlasAddFloat32x4(SumVector0, MlasLoadFloat32x4(Input));
+                SumVector1 = MlasAddFloat32x4(SumVector1, MlasLoadFloat32x4(Input + 4));
+                SumVector2 = MlasAddFloat32x4(SumVector2, MlasLoadFloat32x4(Input + 8));
+                SumVector3 = MlasAddFloat32x4(SumVector3, MlasLoadFloat32x4(Input + 12));
+
+                Input += 16;
+                N -= 16;
+            }
+
+            SumVector0 = MlasAddFloat32x4(SumVector0, SumVector1);
+            SumVector2 = MlasAddFloat32x4(SumVector2, SumVector3);
+            SumVector0 = MlasAddFloat32x4(SumVector0, SumVector2);
+        }
+
+        while (N >= 4) {
+            SumVector0 = MlasAddFloat32x4(SumVector0, MlasLoadFloat32x4(Input));
+
+            Input += 4;
+            N -= 4;
+        }
+
+        Sum = MlasReduceAddFloat32x4(SumVector0);
+    }
+
+    while (N > 0) {
+        Sum += *Input;
+
+        Input += 1;
+        N -= 1;
+    }
+
+    return Sum;
+}
+
+MLAS_FORCEINLINE
+float
+MlasReduceMaximumPropagateNaN(
+    float Value1,
+    float Value2
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the maximum of two values. Unlike std::max, NaN is
+    propagated from either value, as by MlasPropagateNaNFloat32x4.
+
+Arguments:
+
+    Value1 - Supplies the first value.
+
+    Value2 - Supplies the second value.
+
+Return Value:
+
+    Returns the maximum value.
+
+--*/
+{
+    if (std::isnan(Value1) || std::isnan(Value2)) {
+        return Value1 + Value2;
+    }
+
+    return std::max(Value1, Value2);
+}
+
+bool
+MlasReduceIsFiniteF32(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine determines whether the supplied buffer only holds finite
+    values. The difference of an element with itself is zero unless the
+    element is NaN or infinite, which makes the sum of the differences NaN.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    Returns true if all elements are finite, else false.
+
+--*/
+{
+    float Check = 0.0f;
+
+    if (N >= 4) {
+
+        MLAS_FLOAT32X4 CheckVector = MlasZeroFloat32x4();
+
+        while (N >= 4) {
+
+            MLAS_FLOAT32X4 InputVector = MlasLoadFloat32x4(Input);
+            CheckVector = MlasAddFloat32x4(CheckVector, MlasSubtractFloat32x4(InputVector, InputVector));
+
+            Input += 4;
+            N -= 4;
+        }
+
+        Check = MlasReduceAddFloat32x4(CheckVector);
+    }
+
+    while (N > 0) {
+
+        Check += *Input - *Input;
+
+        Input += 1;
+        N -= 1;
+    }
+
+    return Check == 0.0f;
+}
+
+float
+MlasReduceMaximumF32(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine finds the maximum value of the supplied buffer, which is NaN
+    if any element is NaN.
+
+    The platform kernels start from the lowest finite value and do not
+    propagate NaN, so a buffer that only holds negative infinities or that
+    holds any NaN or infinite element is rescanned.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    Returns the maximum value of the supplied buffer.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
+    float Maximum = GetMlasPlatform().ReduceMaximumF32Kernel(Input, N);
+#else
+    float Maximum = MlasReduceMaximumF32Kernel(Input, N);
+#endif
+
+    if (Maximum == std::numeric_limits<float>::lowest() || !MlasReduceIsFiniteF32(Input, N)) {
+
+        Maximum = -std::numeric_limits<float>::infinity();
+
+        for (size_t n = 0; n < N && !std::isnan(Maximum); n++) {
+            Maximum = MlasReduceMaximumPropagateNaN(Maximum, Input[n]);
+        }
+    }
+
+    return Maximum;
+}
+
+MLAS_FORCEINLINE
+float
+MlasReduceSumExpF32(
+    const float* Input,
+    size_t N,
+    float NegativeMaximum
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    return GetMlasPlatform().ComputeSumExpF32Kernel(Input, nullptr, N, &NegativeMaximum);
+#else
+    return MlasComputeSumExpF32Kernel(Input, nullptr, N, &NegativeMaximum);
+#endif
+}
+
+MLAS_FORCEINLINE
+float
+MlasReduceLogSumExpShift(
+    float Maximum
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the value subtracted from the elements before their
+    exponentials are summed for a log sum exp reduction. Infinite maximums are
+    not used so that the subtraction does not produce NaN.
+
+Arguments:
+
+    Maximum - Supplies the maximum value of the reduced elements.
+
+Return Value:
+
+    Returns the value to subtract from the elements.
+
+--*/
+{
+    return std::isinf(Maximum) ? 0.0f : Maximum;
+}
+
+MLAS_FORCEINLINE
+const float*
+MlasReduceLoadBlock(
+    const float* Input,
+    float* Buffer,
+    size_t N
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(Buffer);
+    MLAS_UNREFERENCED_PARAMETER(N);
+
+    return Input;
+}
+
+MLAS_FORCEINLINE
+const float*
+MlasReduceLoadBlock(
+    const MLAS_FP16* Input,
+    float* Buffer,
+    size_t N
+    )
+{
+    MlasConvertHalfToFloatBuffer(Input, Buffer, N);
+
+    return Buffer;
+}
+
+MLAS_FORCEINLINE
+void
+MlasReduceStoreBlock(
+    const float* Buffer,
+    float* Output,
+    size_t N
+    )
+{
+    if (Buffer != Output) {
+        std::copy_n(Buffer, N, Output);
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasReduceStoreBlock(
+    const float* Buffer,
+    MLAS_FP16* Output,
+    size_t N
+    )
+{
+    MlasConvertFloatToHalfBuffer(Buffer, Output, N);
+}
+
+template<typename T>
+float
+MlasReduceRow(
+    MLAS_REDUCE_KIND ReduceKind,
+    const T* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces a contiguous row of elements.
+
+Arguments:
+
+    ReduceKind - Supplies the kind of reduction.
+
+    Input - Supplies the input row.
+
+    N - Supplies the number of elements in the row.
+
+Return Value:
+
+    Returns the reduced value.
+
+--*/
+{
+    //
+    // Single precision rows are reduced in place as a single block.
+    //
+
+    float Buffer[std::is_same_v<T, float> ? 1 : MLAS_REDUCE_CONVERT_BLOCK_SIZE];
+    const size_t BlockSize = std::is_same_v<T, float> ? N : MLAS_REDUCE_CONVERT_BLOCK_SIZE;
+
+    //
+    // Find the maximum value of the row, which is also the first pass of a
+    // log sum exp reduction.
+    //
+
+    float Maximum = -std::numeric_limits<float>::infinity();
+
+    if (ReduceKind == MlasReduceMaximum || ReduceKind == MlasReduceLogSumExp) {
+
+        if (N == 0) {
+            return -std::numeric_limits<float>::infinity();
+        }
+
+        for (size_t n = 0; n < N; n += BlockSize) {
+            const size_t CountN = std::min(N - n, BlockSize);
+            const float* block = MlasReduceLoadBlock(Input + n, Buffer, CountN);
+            Maximum = MlasReduceMaximumPropagateNaN(Maximum, MlasReduceMaximumF32(block, CountN));
+        }
+
+        if (ReduceKind == MlasReduceMaximum) {
+            return Maximum;
+        }
+
+        Maximum = MlasReduceLogSumExpShift(Maximum);
+    }
+
+    float Sum = 0.0f;
+
+    for (size_t n = 0; n < N; n += BlockSize) {
+        const size_t CountN = std::min(N - n, BlockSize);
+        const float* block = MlasReduceLoadBlock(Input + n, Buffer, CountN);
+
+        if (ReduceKind == MlasReduceLogSumExp) {
+            Sum += MlasReduceSumExpF32(block, CountN, -Maximum);
+        } else {
+            Sum += MlasReduceSumF32Kernel(block, CountN);
+        }
+    }
+
+    if (ReduceKind == MlasReduceMean) {
+        return Sum / float(N);
+    }
+
+    if (ReduceKind == MlasReduceLogSumExp) {
+        return std::log(Sum) + Maximum;
+    }
+
+    return Sum;
+}
+
+void
+MlasReduceAccumulateBlock(
+    MLAS_REDUCE_KIND ReduceKind,
+    float* Accumulator,
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine accumulates a row of a block of output elements.
+
+Arguments:
+
+    ReduceKind - Supplies the kind of reduction. A log sum exp reduction
+        accumulates the maximum.
+
+    Accumulator - Supplies the accumulators for the block.
+
+    Input - Supplies the input row for the block.
+
+    N - Supplies the number of elements in the block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const bool Maximum = (ReduceKind == MlasReduceMaximum || ReduceKind == MlasReduceLogSumExp);
+
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 AccumulatorVector = MlasLoadFloat32x4(Accumulator);
+        MLAS_FLOAT32X4 InputVector = MlasLoadFloat32x4(Input);
+
+        if (Maximum) {
+            AccumulatorVector = MlasPropagateNaNFloat32x4(AccumulatorVector, InputVector,
+                MlasMaximumFloat32x4(AccumulatorVector, InputVector));
+        } else {
+            AccumulatorVector = MlasAddFloat32x4(AccumulatorVector, InputVector);
+        }
+
+        MlasStoreFloat32x4(Accumulator, AccumulatorVector);
+
+        Accumulator += 4;
+        Input += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        if (Maximum) {
+            *Accumulator = MlasReduceMaximumPropagateNaN(*Accumulator, *Input);
+        } else {
+            *Accumulator += *Input;
+        }
+
+        Accumulator += 1;
+        Input += 1;
+        N -= 1;
+    }
+}
+
+void
+MlasReduceAccumulateExpBlock(
+    float* Accumulator,
+    const float* Input,
+    const float* Maximum,
+    float* Temp,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine accumulates the exponentials of a row of a block of output
+    elements for a log sum exp reduction.
+
+Arguments:
+
+    Accumulator - Supplies the accumulators for the block.
+
+    Input - Supplies the input row for the block.
+
+    Maximum - Supplies the maximum values for the block.
+
+    Temp - Supplies a scratch buffer for the block.
+
+    N - Supplies the number of elements in the block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t n = 0;
+
+    for (; n + 4 <= N; n += 4) {
+        MlasStoreFloat32x4(Temp + n,
+            MlasSubtractFloat32x4(MlasLoadFloat32x4(Input + n), MlasLoadFloat32x4(Maximum + n)));
+    }
+
+    for (; n < N; n++) {
+        Temp[n] = Input[n] - Maximum[n];
+    }
+
+    MlasComputeExp(Temp, Temp, N);
+
+    MlasReduceAccumulateBlock(MlasReduceSum, Accumulator, Temp, N);
+}
+
+template<typename T, typename OutputT>
+void
+MlasReduceInnerBlock(
+    MLAS_REDUCE_KIND ReduceKind,
+    const T* Input,
+    OutputT* Output,
+    size_t ReduceCount,
+    size_t InnerCount,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces a block of adjacent output elements across the rows
+    of the reduced axis.
+
+Arguments:
+
+    ReduceKind - Supplies the kind of reduction.
+
+    Input - Supplies the first input row for the block.
+
+    Output - Supplies the output block.
+
+    ReduceCount - Supplies the number of rows of the reduced axis.
+
+    InnerCount - Supplies the number of elements between rows.
+
+    N - Supplies the number of elements in the block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float Accumulator[MLAS_REDUCE_INNER_BLOCK_SIZE], 64);
+    MLAS_DECLSPEC_ALIGN(float Buffer[MLAS_REDUCE_INNER_BLOCK_SIZE], 64);
+
+    if (ReduceKind == MlasReduceSum || ReduceKind == MlasReduceMean) {
+        std::fill_n(Accumulator, N, 0.0f);
+    } else {
+        std::fill_n(Accumulator, N, -std::numeric_limits<float>::infinity());
+    }
+
+    for (size_t r = 0; r < ReduceCount; r++) {
+        const float* row = MlasReduceLoadBlock(Input + r * InnerCount, Buffer, N);
+        MlasReduceAccumulateBlock(ReduceKind, Accumulator, row, N);
+    }
+
+    if (ReduceKind == MlasReduceMean) {
+
+        const float Scale = 1.0f / float(ReduceCount);
+
+        for (size_t n = 0; n < N; n++) {
+            Accumulator[n] *= Scale;
+        }
+
+    } else if (ReduceKind == MlasReduceLogSumExp) {
+
+        //
+        // Accumulate the exponentials relative to the maximums found above.
+        //
+
+        MLAS_DECLSPEC_ALIGN(float Maximum[MLAS_REDUCE_INNER_BLOCK_SIZE], 64);
+        MLAS_DECLSPEC_ALIGN(float Temp[MLAS_REDUCE_INNER_BLOCK_SIZE], 64);
+
+        for (size_t n = 0; n < N; n++) {
+            Maximum[n] = MlasReduceLogSumExpShift(Accumulator[n]);
+            Accumulator[n] = 0.0f;
+        }
+
+        for (size_t r = 0; r < ReduceCount; r++) {
+            const float* row = MlasReduceLoadBlock(Input + r * InnerCount, Buffer, N);
+            MlasReduceAccumulateExpBlock(Accumulator, row, Maximum, Temp, N);
+        }
+
+        for (size_t n = 0; n < N; n++) {
+            Accumulator[n] = std::log(Accumulator[n]) + Maximum[n];
+        }
+    }
+
+    MlasReduceStoreBlock(Accumulator, Output, N);
+}
+
+template<typename T>
+void
+MlasReduceThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    reduction.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_REDUCE_WORK_BLOCK<T>*)Context;
+
+    const MLAS_REDUCE_KIND ReduceKind = WorkBlock->ReduceKind;
+    const size_t ReduceCount = WorkBlock->ReduceCount;
+    const size_t InnerCount = WorkBlock->InnerCount;
+    const size_t InnerBlockCount = WorkBlock->InnerBlockCount;
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount, WorkBlock->OuterCount * InnerBlockCount,
+        &WorkIndex, &WorkRemaining);
+
+    if (InnerCount == 1) {
+
+        //
+        // Reduce contiguous rows.
+        //
+
+        const T* Input = WorkBlock->Input + WorkIndex * ReduceCount;
+        T* Output = WorkBlock->Output + WorkIndex;
+
+        while (WorkRemaining > 0) {
+
+            const float Value = MlasReduceRow(ReduceKind, Input, ReduceCount);
+
+            if constexpr (std::is_same_v<T, float>) {
+                *Output = Value;
+            } else {
+                *Output = MLAS_FP16(Value);
+            }
+
+            Input += ReduceCount;
+            Output += 1;
+            WorkRemaining--;
+        }
+
+        return;
+    }
+
+    //
+    // Reduce blocks of adjacent output elements across the rows of the reduced
+    // axis.
+    //
+
+    while (WorkRemaining > 0) {
+
+        const size_t outer = WorkIndex / InnerBlockCount;
+        const size_t inner = (WorkIndex % InnerBlockCount) * MLAS_REDUCE_INNER_BLOCK_SIZE;
+        const size_t CountN = std::min(InnerCount - inner, size_t(MLAS_REDUCE_INNER_BLOCK_SIZE));
+
+        MlasReduceInnerBlock(ReduceKind,
+            WorkBlock->Input + outer * ReduceCount * InnerCount + inner,
+            WorkBlock->Output + outer * InnerCount + inner,
+            ReduceCount,
+            InnerCount,
+            CountN);
+
+        WorkIndex++;
+        WorkRemaining--;
+    }
+}
+
+template<typename T>
+void
+MlasReduceSegmentsThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to reduce segments of the
+    reduced axis into partial results.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_REDUCE_WORK_BLOCK<T>*)Context;
+
+    const size_t ReduceCount = WorkBlock->ReduceCount;
+    const size_t InnerCount = WorkBlock->InnerCount;
+    const size_t InnerBlockCount = WorkBlock->InnerBlockCount;
+    const size_t SegmentCount = WorkBlock->SegmentCount;
+
+    //
+    // The partial results of a mean reduction are sums that are scaled once
+    // they are combined.
+    //
+
+    const MLAS_REDUCE_KIND ReduceKind =
+        (WorkBlock->ReduceKind == MlasReduceMean) ? MlasReduceSum : WorkBlock->ReduceKind;
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount,
+        WorkBlock->OuterCount * SegmentCount * InnerBlockCount, &WorkIndex, &WorkRemaining);
+
+    while (WorkRemaining > 0) {
+
+        const size_t OuterSegment = WorkIndex / InnerBlockCount;
+        const size_t outer = OuterSegment / SegmentCount;
+        const size_t inner = (WorkIndex % InnerBlockCount) * MLAS_REDUCE_INNER_BLOCK_SIZE;
+        const size_t CountN = std::min(InnerCount - inner, size_t(MLAS_REDUCE_INNER_BLOCK_SIZE));
+
+        size_t RowIndex;
+        size_t RowCount;
+
+        MlasPartitionWork(ptrdiff_t(OuterSegment % SegmentCount), ptrdiff_t(SegmentCount), ReduceCount,
+            &RowIndex, &RowCount);
+
+        const T* Input = WorkBlock->Input + (outer * ReduceCount + RowIndex) * InnerCount + inner;
+        float* Partial = WorkBlock->Partial + OuterSegment * InnerCount + inner;
+
+        if (InnerCount == 1) {
+            *Partial = MlasReduceRow(ReduceKind, Input, RowCount);
+        } else {
+            MlasReduceInnerBlock(ReduceKind, Input, Partial, RowCount, InnerCount, CountN);
+        }
+
+        WorkIndex++;
+        WorkRemaining--;
+    }
+}
+
+template<typename T>
+void
+MlasReduceSegments(
+    MLAS_REDUCE_WORK_BLOCK<T>* WorkBlock,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces the segments of the reduced axis into partial results
+    on the worker threads, then combines the partial results into the output
+    on the calling thread.
+
+Arguments:
+
+    WorkBlock - Supplies the parameters of the reduction.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t OuterCount = WorkBlock->OuterCount;
+    const size_t InnerCount = WorkBlock->InnerCount;
+    const size_t SegmentCount = WorkBlock->SegmentCount;
+    const size_t PartialCount = OuterCount * SegmentCount * InnerCount;
+
+    MlasThreadedBufAlloc(PartialCount * sizeof(float));
+
+    WorkBlock->Partial = reinterpret_cast<float*>(ThreadedBufHolder.get());
+
+    MlasExecuteThreaded(MlasReduceSegmentsThreaded<T>, WorkBlock, WorkBlock->ThreadCount, ThreadPool);
+
+    //
+    // Sums, maximums and log sum exps of the segments combine with the same
+    // reduction. The partial sums of a mean reduction are scaled first.
+    //
+
+    MLAS_REDUCE_KIND ReduceKind = WorkBlock->ReduceKind;
+
+    if (ReduceKind == MlasReduceMean) {
+
+        const float Scale = 1.0f / float(WorkBlock->ReduceCount);
+
+        for (size_t n = 0; n < PartialCount; n++) {
+            WorkBlock->Partial[n] *= Scale;
+        }
+
+        ReduceKind = MlasReduceSum;
+    }
+
+    for (size_t outer = 0; outer < OuterCount; outer++) {
+
+        for (size_t inner = 0; inner < InnerCount; inner += MLAS_REDUCE_INNER_BLOCK_SIZE) {
+
+            const size_t CountN = std::min(InnerCount - inner, size_t(MLAS_REDUCE_INNER_BLOCK_SIZE));
+
+            MlasReduceInnerBlock(ReduceKind,
+                WorkBlock->Partial + outer * SegmentCount * InnerCount + inner,
+                WorkBlock->Output + outer * InnerCount + inner,
+                SegmentCount,
+                InnerCount,
+                CountN);
+        }
+    }
+}
+
+template<typename T>
+void
+MLASCALL
+MlasReduce(
+    MLAS_REDUCE_KIND ReduceKind,
+    const T* Input,
+    T* Output,
+    size_t OuterCount,
+    size_t ReduceCount,
+    size_t InnerCount,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces a tensor along a single strided axis.
+
+Arguments:
+
+    ReduceKind - Supplies the kind of reduction.
+
+    Input - Supplies the input tensor viewed as [OuterCount][ReduceCount]
+        [InnerCount].
+
+    Output - Supplies the output tensor viewed as [OuterCount][InnerCount].
+
+    OuterCount - Supplies the product of the dimensions before the reduced
+        axis.
+
+    ReduceCount - Supplies the number of elements of the reduced axis.
+
+    InnerCount - Supplies the product of the dimensions after the reduced
+        axis.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (OuterCount == 0 || InnerCount == 0) {
+        return;
+    }
+
+    MLAS_REDUCE_WORK_BLOCK<T> WorkBlock;
+
+    WorkBlock.ReduceKind = ReduceKind;
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.OuterCount = OuterCount;
+    WorkBlock.ReduceCount = ReduceCount;
+    WorkBlock.InnerCount = InnerCount;
+    WorkBlock.InnerBlockCount = (InnerCount == 1) ? 1 :
+        (InnerCount + MLAS_REDUCE_INNER_BLOCK_SIZE - 1) / MLAS_REDUCE_INNER_BLOCK_SIZE;
+    WorkBlock.SegmentCount = 1;
+    WorkBlock.Partial = nullptr;
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // reduction. Try to keep each thread processing a minimum number of
+    // elements before using another thread.
+    //
+
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    constexpr size_t MinimumElementsPerThread = 16384;
+
+    size_t BlockCount = ((OuterCount * ReduceCount * InnerCount) / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCount) > BlockCount) {
+        ThreadCount = ptrdiff_t(BlockCount);
+    }
+
+    //
+    // Limit the number of threads to the number of output blocks. If there
+    // are fewer output blocks than threads, split the reduced axis into
+    // segments so that each thread has a work item.
+    //
+
+    const size_t WorkCount = OuterCount * WorkBlock.InnerBlockCount;
+
+    if (size_t(ThreadCount) > WorkCount) {
+
+        const size_t SegmentCount =
+            std::min((size_t(ThreadCount) + WorkCount - 1) / WorkCount, ReduceCount);
+
+        if (SegmentCount > 1) {
+
+            WorkBlock.SegmentCount = SegmentCount;
+            WorkBlock.ThreadCount = std::min(ThreadCount, ptrdiff_t(WorkCount * SegmentCount));
+
+            MlasReduceSegments(&WorkBlock, ThreadPool);
+            return;
+        }
+
+        ThreadCount = ptrdiff_t(WorkCount);
+    }
+
+    WorkBlock.ThreadCount = ThreadCount;
+
+    MlasExecuteThreaded(MlasReduceThreaded<T>, &WorkBlock, ThreadCount, ThreadPool);
+}
+
+template
+void
+MLASCALL
+MlasReduce<float>(
+    MLAS_REDUCE_KIND ReduceKind,
+    const float* Input,
+    float* Output,
+    size_t OuterCount,
+    size_t ReduceCount,
+    size_t InnerCount,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasReduce<MLAS_FP16>(
+    MLAS_REDUCE_KIND ReduceKind,
+    const MLAS_FP16* Input,
+    MLAS_FP16* Output,
+    size_t OuterCount,
+    size_t ReduceCount,
+    size_t InnerCount,
+    MLAS_THREADPOOL* ThreadPool
+    );
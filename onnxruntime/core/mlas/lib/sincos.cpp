@@ -0,0 +1,387 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sincos.cpp
+
+Abstract:
+
+    This module implements routines to compute the sine and cosine functions.
+
+    This implementation uses the same polynomial coefficients and algorithm as
+    found in Cephes sinf() and cosf(). The input is reduced by multiples of
+    pi/2 using a three part extended precision constant and the quadrant
+    selects between the sine and cosine polynomials. Inputs with a magnitude
+    beyond the range where the reduction is accurate are computed with the C
+    runtime.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Bundles the floating point constants for use by kernels written in assembly.
+//
+
+MLAS_INTERNAL_DATA const struct {
+    float ReductionLimit;
+    float TwoOverPi;
+    float RoundingBias;
+    float PiOver2_1;
+    float PiOver2_2;
+    float PiOver2_3;
+    float sin_p0;
+    float sin_p1;
+    float sin_p2;
+    float cos_p0;
+    float cos_p1;
+    float cos_p2;
+    float OneHalf;
+    float One;
+} MlasSinCosConstants = {
+    8192.0f,
+    0.636619772367581343f,
+    MLAS_ROUNDING_BIAS_MAGIC,
+    1.5703125f,
+    4.837512969970703125e-4f,
+    7.54978995489188216e-8f,
+    -1.9515295891e-4f,
+    8.3321608736e-3f,
+    -1.6666654611e-1f,
+    2.443315711809948e-5f,
+    -1.388731625493765e-3f,
+    4.166664568298827e-2f,
+    0.5f,
+    1.0f,
+};
+
+template<bool IsCosine>
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasComputeSinCosVector(
+    MLAS_FLOAT32X4 Value
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the sine or cosine function for the supplied vector.
+
+    N.B. The result is only accurate for inputs with a magnitude below the
+    reduction limit. Infinity and NaN produce NaN.
+
+Arguments:
+
+    Value - Supplies the values to operate on.
+
+Return Value:
+
+    Returns the sine or cosine of the input.
+
+--*/
+{
+    const MLAS_FLOAT32X4 NegativeZero = MlasBroadcastFloat32x4(-0.0f);
+
+    MLAS_FLOAT32X4 AbsValue = MlasAndNotFloat32x4(NegativeZero, Value);
+
+    //
+    // Round |x| * 2/pi to the nearest integer q with the rounding bias trick,
+    // which leaves q in the low bits of the biased representation.
+    //
+
+    const MLAS_FLOAT32X4 RoundingBias = MlasBroadcastFloat32x4(MlasSinCosConstants.RoundingBias);
+
+    MLAS_FLOAT32X4 Biased = MlasMultiplyAddFloat32x4(AbsValue, MlasSinCosConstants.TwoOverPi, RoundingBias);
+    MLAS_FLOAT32X4 q = MlasSubtractFloat32x4(Biased, RoundingBias);
+    MLAS_INT32X4 Quadrant = MlasReinterpretAsInt32x4(Biased);
+
+    //
+    // Compute r = |x| - q * pi/2 with the extended precision constant.
+    //
+
+    MLAS_FLOAT32X4 r = MlasMultiplyAddFloat32x4(q, -MlasSinCosConstants.PiOver2_1, AbsValue);
+    r = MlasMultiplyAddFloat32x4(q, -MlasSinCosConstants.PiOver2_2, r);
+    r = MlasMultiplyAddFloat32x4(q, -MlasSinCosConstants.PiOver2_3, r);
+
+    MLAS_FLOAT32X4 z = MlasMultiplyFloat32x4(r, r);
+
+    MLAS_FLOAT32X4 SinValue = MlasBroadcastFloat32x4(MlasSinCosConstants.sin_p0);
+    SinValue = MlasMultiplyAddFloat32x4(SinValue, z, MlasSinCosConstants.sin_p1);
+    SinValue = MlasMultiplyAddFloat32x4(SinValue, z, MlasSinCosConstants.sin_p2);
+    SinValue = MlasMultiplyFloat32x4(SinValue, MlasMultiplyFloat32x4(z, r));
+    SinValue = MlasAddFloat32x4(SinValue, r);
+
+    MLAS_FLOAT32X4 CosValue = MlasBroadcastFloat32x4(MlasSinCosConstants.cos_p0);
+    CosValue = MlasMultiplyAddFloat32x4(CosValue, z, MlasSinCosConstants.cos_p1);
+    CosValue = MlasMultiplyAddFloat32x4(CosValue, z, MlasSinCosConstants.cos_p2);
+    CosValue = MlasMultiplyFloat32x4(CosValue, MlasMultiplyFloat32x4(z, z));
+    CosValue = MlasMultiplyAddFloat32x4(z, -MlasSinCosConstants.OneHalf, CosValue);
+    CosValue = MlasAddFloat32x4(CosValue, MlasBroadcastFloat32x4(MlasSinCosConstants.One));
+
+    //
+    // Odd quadrants swap the sine and cosine polynomials. The sign of the
+    // result flips in the upper two quadrants (shifted by one quadrant for the
+    // cosine) and, for the sine, follows the sign of the input.
+    //
+
+    MLAS_FLOAT32X4 SwapMask = MlasGreaterThanFloat32x4(
+        MlasCastToFloat32x4(MlasAndInt32x4(Quadrant, MlasBroadcastInt32x4(1))),
+        MlasBroadcastFloat32x4(MlasSinCosConstants.OneHalf));
+
+    MLAS_FLOAT32X4 Result;
+    MLAS_INT32X4 SignQuadrant;
+
+    if constexpr (IsCosine) {
+        Result = MlasBlendFloat32x4(CosValue, SinValue, SwapMask);
+        SignQuadrant = MlasAddInt32x4(Quadrant, MlasBroadcastInt32x4(1));
+    } else {
+        Result = MlasBlendFloat32x4(SinValue, CosValue, SwapMask);
+        SignQuadrant = Quadrant;
+    }
+
+    MLAS_FLOAT32X4 Sign = MlasReinterpretAsFloat32x4(
+        MlasShiftLeftInt32x4<30>(MlasAndInt32x4(SignQuadrant, MlasBroadcastInt32x4(2))));
+
+    if constexpr (!IsCosine) {
+        Sign = MlasXorFloat32x4(Sign, MlasAndFloat32x4(Value, NegativeZero));
+    }
+
+    Result = MlasXorFloat32x4(Result, Sign);
+
+    //
+    // Multiplying the input by zero produces NaN for infinity and NaN inputs.
+    //
+
+    return MlasAddFloat32x4(Result, MlasMultiplyFloat32x4(Value, MlasZeroFloat32x4()));
+}
+
+template<bool IsCosine>
+void
+MlasSinCosKernel(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the sine and cosine
+    functions.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 NegativeZero = MlasBroadcastFloat32x4(-0.0f);
+    const MLAS_FLOAT32X4 ReductionLimit = MlasBroadcastFloat32x4(MlasSinCosConstants.ReductionLimit);
+    const MLAS_FLOAT32X4 One = MlasBroadcastFloat32x4(MlasSinCosConstants.One);
+
+    while (N > 0) {
+        float Buffer[4];
+        const size_t count = std::min(N, size_t(4));
+
+        MLAS_FLOAT32X4 Value;
+
+        if (count == 4) {
+            Value = MlasLoadFloat32x4(Input);
+        } else {
+            Buffer[0] = Buffer[1] = Buffer[2] = Buffer[3] = 0.0f;
+            std::copy_n(Input, count, Buffer);
+            Value = MlasLoadFloat32x4(Buffer);
+        }
+
+        MlasStoreFloat32x4(Buffer, MlasComputeSinCosVector<IsCosine>(Value));
+
+        //
+        // Recompute any elements outside of the reduction range (including
+        // infinity and NaN, which compare false) with the C runtime.
+        //
+
+        MLAS_FLOAT32X4 InRangeMask = MlasGreaterThanFloat32x4(ReductionLimit, MlasAndNotFloat32x4(NegativeZero, Value));
+
+        if (MlasReduceMaximumFloat32x4(MlasAndNotFloat32x4(InRangeMask, One)) != 0.0f) {
+            for (size_t i = 0; i < count; i++) {
+                if (!(std::fabs(Input[i]) < MlasSinCosConstants.ReductionLimit)) {
+                    Buffer[i] = IsCosine ? std::cos(Input[i]) : std::sin(Input[i]);
+                }
+            }
+        }
+
+        std::copy_n(Buffer, count, Output);
+
+        Input += count;
+        Output += count;
+        N -= count;
+    }
+}
+
+void
+MLASCALL
+MlasSinKernel(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+{
+    MlasSinCosKernel<false>(Input, Output, N);
+}
+
+void
+MLASCALL
+MlasCosKernel(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+{
+    MlasSinCosKernel<true>(Input, Output, N);
+}
+
+template<bool IsCosine>
+void
+MlasSinCosHalf(
+    const MLAS_FP16* Input,
+    MLAS_FP16* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the sine or cosine function for half precision
+    values by staging blocks of the input in single precision.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t BlockSize = 256;
+    float Buffer[BlockSize];
+
+    while (N > 0) {
+        const size_t count = std::min(N, BlockSize);
+
+        MlasConvertHalfToFloatBuffer(Input, Buffer, count);
+        MlasSinCosKernel<IsCosine>(Buffer, Buffer, count);
+        MlasConvertFloatToHalfBuffer(Buffer, Output, count);
+
+        Input += count;
+        Output += count;
+        N -= count;
+    }
+}
+
+template <>
+void
+MLASCALL
+MlasComputeSin<float>(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the sine function.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasSinKernel(Input, Output, N);
+}
+
+template <>
+void
+MLASCALL
+MlasComputeSin<MLAS_FP16>(
+    const MLAS_FP16* Input,
+    MLAS_FP16* Output,
+    size_t N
+    )
+{
+    MlasSinCosHalf<false>(Input, Output, N);
+}
+
+template <>
+void
+MLASCALL
+MlasComputeCos<float>(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the cosine function.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasCosKernel(Input, Output, N);
+}
+
+template <>
+void
+MLASCALL
+MlasComputeCos<MLAS_FP16>(
+    const MLAS_FP16* Input,
+    MLAS_FP16* Output,
+    size_t N
+    )
+{
+    MlasSinCosHalf<true>(Input, Output, N);
+}
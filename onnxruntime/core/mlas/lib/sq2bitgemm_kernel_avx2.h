@@ -0,0 +1,564 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sq2bitgemm_kernel_avx2.h
+
+Abstract:
+
+    This module implements the float/quantized 2-bit integer matrix
+    multiplication kernels for x64 avx2.
+
+    The quantized B data is expected to be packed with SQ2BitGemmPackQuantBData.
+
+--*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "qnbitgemm.h"
+#include "sqnbitgemm_kernel_avx_common.h"
+
+//
+// SQNBIT_CompFp32 kernel implementation.
+//
+
+template <size_t NCols, bool HasZeroPoint>
+static MLAS_FORCEINLINE void
+ComputeDotProducts_BlkBitWidth2_CompFp32_avx2(
+    size_t BlkLen,
+    const float* ARowPtr,
+    const std::byte* QuantBDataColPtr,
+    const float* QuantBScaleColPtr,
+    const std::byte* QuantBZeroPointColPtr,
+    float* SumPtr,
+    size_t CountK,
+    size_t StrideQuantBData,
+    size_t StrideQuantBScale,
+    size_t StrideQuantBZeroPoint,
+    const float* BiasPtr
+)
+{
+    constexpr size_t SubBlkLen16 = 16;
+
+    __m256 acc[NCols];
+    UnrolledLoop<NCols>([&](size_t i) { acc[i] = _mm256_setzero_ps(); });
+
+    for (size_t k = 0, k_blk = 0; k < CountK; k += BlkLen, ++k_blk) {
+        const size_t k_blk_len = std::min(CountK - k, BlkLen);
+
+        // sum of the A values and of the products of A and the quantized B values of the block
+        __m256 acc_a = _mm256_setzero_ps();
+        __m256 acc_blk[NCols];
+        UnrolledLoop<NCols>([&](size_t i) { acc_blk[i] = _mm256_setzero_ps(); });
+
+        for (size_t kk = 0; kk < k_blk_len; kk += SubBlkLen16) {
+            const float* a = ARowPtr + k + kk;
+
+            // zero pad the A values past CountK
+            float a_tail[SubBlkLen16];
+            if (k_blk_len - kk < SubBlkLen16) {
+                std::fill_n(a_tail, SubBlkLen16, 0.0f);
+                std::copy_n(a, k_blk_len - kk, a_tail);
+                a = a_tail;
+            }
+
+            const __m256 av0_8_ps = _mm256_loadu_ps(a);
+            const __m256 av1_8_ps = _mm256_loadu_ps(a + 8);
+            acc_a = _mm256_add_ps(acc_a, _mm256_add_ps(av0_8_ps, av1_8_ps));
+
+            UnrolledLoop<NCols>([&](size_t i) {
+                const __m128i bv_16_epu8 = unpack_16_2bit_epu8(QuantBDataColPtr + i * StrideQuantBData + (k + kk) / 4);
+                const __m256 bv0_8_ps = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(bv_16_epu8));
+                const __m256 bv1_8_ps = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(bv_16_epu8, 8)));
+                acc_blk[i] = _mm256_fmadd_ps(av0_8_ps, bv0_8_ps, acc_blk[i]);
+                acc_blk[i] = _mm256_fmadd_ps(av1_8_ps, bv1_8_ps, acc_blk[i]);
+            });
+        }
+
+        // acc += scale * (sum(a * b) - zp * sum(a))
+        UnrolledLoop<NCols>([&](size_t i) {
+            const float zp = [&]() -> float {
+                if constexpr (HasZeroPoint) {
+                    return get_2bit_zp(QuantBZeroPointColPtr + i * StrideQuantBZeroPoint, k_blk);
+                } else {
+                    return 2.0f;
+                }
+            }();
+            const __m256 scale_8_ps = _mm256_set1_ps(QuantBScaleColPtr[i * StrideQuantBScale + k_blk]);
+            const __m256 blk_8_ps = _mm256_fnmadd_ps(_mm256_set1_ps(zp), acc_a, acc_blk[i]);
+            acc[i] = _mm256_fmadd_ps(blk_8_ps, scale_8_ps, acc[i]);
+        });
+    }
+
+    if constexpr (NCols == 4) {
+        __m128 acc_x = FoldAccumulators(acc[0], acc[1], acc[2], acc[3]);
+        if (BiasPtr != nullptr) {
+            acc_x = _mm_add_ps(acc_x, _mm_loadu_ps(BiasPtr));
+        }
+        _mm_storeu_ps(SumPtr, acc_x);
+    } else {
+        UnrolledLoop<NCols>([&](size_t i) {
+            SumPtr[i] = hsum_float_8(acc[i]) + (BiasPtr != nullptr ? BiasPtr[i] : 0.0f);
+        });
+    }
+}
+
+template <bool HasZeroPoint>
+static void
+SQ2BitGemmM1Kernel_CompFp32_avx2_Impl(
+    size_t BlkLen,
+    const float* A,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    const float* Bias
+)
+{
+    constexpr size_t BlkBitWidth2 = 2;
+    constexpr size_t NCols4 = 4;
+
+    const size_t StrideQuantBData = BlockCountK * MlasQNBitBlkDataSizeInBytes(BlkBitWidth2, BlkLen);
+    const size_t StrideQuantBScale = BlockCountK;
+    const size_t StrideQuantBZeroPoint = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth2>(BlockCountK);
+
+    const float* BiasPtr = Bias;
+
+    const std::byte* QuantBDataColPtr = QuantBData;
+    const float* QuantBScaleColPtr = QuantBScale;
+    const std::byte* QuantBZeroPointColPtr = QuantBZeroPoint;
+
+    float* SumPtr = C;
+
+    int64_t nblk = static_cast<int64_t>(CountN) - NCols4;
+    while (nblk >= 0) {
+        ComputeDotProducts_BlkBitWidth2_CompFp32_avx2<NCols4, HasZeroPoint>(
+            BlkLen,
+            A, QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, SumPtr, CountK,
+            StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint,
+            BiasPtr
+        );
+
+        // move to next `NCols` columns
+
+        QuantBDataColPtr += NCols4 * StrideQuantBData;
+        QuantBScaleColPtr += NCols4 * StrideQuantBScale;
+        if constexpr (HasZeroPoint) {
+            QuantBZeroPointColPtr += NCols4 * StrideQuantBZeroPoint;
+        }
+
+        BiasPtr += BiasPtr != nullptr ? NCols4 : 0;
+        SumPtr += NCols4;
+
+        nblk -= NCols4;
+    }
+
+    // left over columns less than `NCols`?
+    nblk += NCols4;
+    for (int64_t n = 0; n < nblk; ++n) {
+        ComputeDotProducts_BlkBitWidth2_CompFp32_avx2<1, HasZeroPoint>(
+            BlkLen,
+            A, QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, SumPtr, CountK,
+            StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint,
+            BiasPtr
+        );
+
+        // move to next column
+
+        QuantBDataColPtr += StrideQuantBData;
+        QuantBScaleColPtr += StrideQuantBScale;
+        if constexpr (HasZeroPoint) {
+            QuantBZeroPointColPtr += StrideQuantBZeroPoint;
+        }
+
+        BiasPtr += BiasPtr != nullptr ? 1 : 0;
+        SumPtr += 1;
+    }
+}
+
+static void
+SQ2BitGemmM1Kernel_CompFp32_avx2(
+    size_t BlkLen,
+    const float* A,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    const float* Bias
+)
+{
+    if (QuantBZeroPoint != nullptr) {
+        SQ2BitGemmM1Kernel_CompFp32_avx2_Impl<true>(
+            BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK, BlockCountK, Bias
+        );
+    } else {
+        SQ2BitGemmM1Kernel_CompFp32_avx2_Impl<false>(
+            BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK, BlockCountK, Bias
+        );
+    }
+}
+
+static MLAS_FORCEINLINE void
+Transpose8x8_avx2(__m256 (&v)[8])
+{
+    const __m256 a0 = _mm256_unpacklo_ps(v[0], v[1]);
+    const __m256 a1 = _mm256_unpackhi_ps(v[0], v[1]);
+    const __m256 a2 = _mm256_unpacklo_ps(v[2], v[3]);
+    const __m256 a3 = _mm256_unpackhi_ps(v[2], v[3]);
+    const __m256 a4 = _mm256_unpacklo_ps(v[4], v[5]);
+    const __m256 a5 = _mm256_unpackhi_ps(v[4], v[5]);
+    const __m256 a6 = _mm256_unpacklo_ps(v[6], v[7]);
+    const __m256 a7 = _mm256_unpackhi_ps(v[6], v[7]);
+
+    const __m256 b0 = _mm256_shuffle_ps(a0, a2, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 b1 = _mm256_shuffle_ps(a0, a2, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 b2 = _mm256_shuffle_ps(a1, a3, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 b3 = _mm256_shuffle_ps(a1, a3, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 b4 = _mm256_shuffle_ps(a4, a6, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 b5 = _mm256_shuffle_ps(a4, a6, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 b6 = _mm256_shuffle_ps(a5, a7, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 b7 = _mm256_shuffle_ps(a5, a7, _MM_SHUFFLE(3, 2, 3, 2));
+
+    v[0] = _mm256_permute2f128_ps(b0, b4, 0x20);
+    v[1] = _mm256_permute2f128_ps(b1, b5, 0x20);
+    v[2] = _mm256_permute2f128_ps(b2, b6, 0x20);
+    v[3] = _mm256_permute2f128_ps(b3, b7, 0x20);
+    v[4] = _mm256_permute2f128_ps(b0, b4, 0x31);
+    v[5] = _mm256_permute2f128_ps(b1, b5, 0x31);
+    v[6] = _mm256_permute2f128_ps(b2, b6, 0x31);
+    v[7] = _mm256_permute2f128_ps(b3, b7, 0x31);
+}
+
+template <bool HasZeroPoint>
+static void
+SQ2BitBlkDequantBForSgemm_CompFp32_avx2_Impl(
+    size_t BlkLen,
+    float* FpData,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK
+)
+{
+    constexpr size_t BlkBitWidth2 = 2;
+    constexpr size_t NCols8 = 8;                   // dequantize NCols8 columns of QuantB at a time
+    constexpr size_t GemmFloatKernelWidth16 = 16;  // mlas GemmFloatKernel requires B with width 16
+    constexpr size_t SubBlkLen16 = 16;
+
+    const size_t StrideQuantBData = BlockCountK * MlasQNBitBlkDataSizeInBytes(BlkBitWidth2, BlkLen);
+    [[maybe_unused]] const size_t StrideQuantBZeroPoint =  // only used if HasZeroPoint is true
+        MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth2>(BlockCountK);
+
+    float* Dst = FpData;
+
+    //
+    // Proceed down 16 column-wide regions of B. Dequantize and write output 16 x 16 elements at a time.
+    // Columns past CountN are written as zeros.
+    //
+
+    for (size_t n = 0; n < CountN; n += GemmFloatKernelWidth16) {
+        const size_t cols = std::min(CountN - n, GemmFloatKernelWidth16);
+
+        const std::byte* QuantBDataCol = QuantBData + n * StrideQuantBData;
+        const float* QuantBScaleCol = QuantBScale + n * BlockCountK;
+
+        for (size_t k = 0, k_blk = 0; k < CountK; k += BlkLen, ++k_blk) {
+            // b = q * scale - zp * scale
+            float scale[GemmFloatKernelWidth16]{};
+            float offset[GemmFloatKernelWidth16]{};
+            for (size_t nn = 0; nn < cols; ++nn) {
+                scale[nn] = QuantBScaleCol[nn * BlockCountK + k_blk];
+                const float zp = [&]() -> float {
+                    if constexpr (HasZeroPoint) {
+                        return get_2bit_zp(QuantBZeroPoint + (n + nn) * StrideQuantBZeroPoint, k_blk);
+                    } else {
+                        return 2.0f;
+                    }
+                }();
+                offset[nn] = -zp * scale[nn];
+            }
+
+            const size_t k_blk_len = std::min(CountK - k, BlkLen);
+
+            for (size_t kk = 0; kk < k_blk_len; kk += SubBlkLen16) {
+                for (size_t nn = 0; nn < GemmFloatKernelWidth16; nn += NCols8) {
+                    __m256 bv_lo[NCols8];  // rows 0-7 of NCols8 columns
+                    __m256 bv_hi[NCols8];  // rows 8-15 of NCols8 columns
+                    UnrolledLoop<NCols8>([&](size_t i) {
+                        if (nn + i < cols) {
+                            const __m128i bv_16_epu8 =
+                                unpack_16_2bit_epu8(QuantBDataCol + (nn + i) * StrideQuantBData + (k + kk) / 4);
+                            const __m256 scale_8_ps = _mm256_set1_ps(scale[nn + i]);
+                            const __m256 offset_8_ps = _mm256_set1_ps(offset[nn + i]);
+                            bv_lo[i] = _mm256_fmadd_ps(
+                                _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(bv_16_epu8)), scale_8_ps, offset_8_ps
+                            );
+                            bv_hi[i] = _mm256_fmadd_ps(
+                                _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(bv_16_epu8, 8))),
+                                scale_8_ps, offset_8_ps
+                            );
+                        } else {
+                            bv_lo[i] = _mm256_setzero_ps();
+                            bv_hi[i] = _mm256_setzero_ps();
+                        }
+                    });
+
+                    Transpose8x8_avx2(bv_lo);
+                    Transpose8x8_avx2(bv_hi);
+
+                    UnrolledLoop<8>([&](size_t r) {
+                        _mm256_storeu_ps(Dst + r * GemmFloatKernelWidth16 + nn, bv_lo[r]);
+                        _mm256_storeu_ps(Dst + (r + 8) * GemmFloatKernelWidth16 + nn, bv_hi[r]);
+                    });
+                }
+
+                // rows past CountK are overwritten by the next region or are extra space of FpData
+                Dst += GemmFloatKernelWidth16 * std::min(k_blk_len - kk, SubBlkLen16);
+            }
+        }
+    }
+}
+
+//
+// SQNBIT_CompInt8 kernel implementation.
+//
+
+// accumulate the sums of the products of 4 adjacent unsigned and signed int8 values
+template <bool vnni>
+static MLAS_FORCEINLINE __m256i
+dot_quads_u8s8_avx2(const __m256i acc, const __m256i bv_32_epu8, const __m256i av_32_epi8)
+{
+    if constexpr (vnni) {
+        return _mm256_dpbusd_avx_epi32(acc, bv_32_epu8, av_32_epi8);
+    } else {
+        // the products of 2-bit and int8 values do not saturate int16
+        const __m256i dot_16_epi16 = _mm256_maddubs_epi16(bv_32_epu8, av_32_epi8);
+        return _mm256_add_epi32(acc, _mm256_madd_epi16(dot_16_epi16, _mm256_set1_epi16(1)));
+    }
+}
+
+template <size_t NCols, bool HasZeroPoint, bool vnni>
+static MLAS_FORCEINLINE void
+ComputeDotProducts_BlkBitWidth2_CompInt8_avx2(
+    size_t BlkLen,
+    const std::byte* QuantARowPtr,
+    const float* QuantAScaleRowPtr,
+    const float* ABlockSumRowPtr,
+    const std::byte* QuantBDataColPtr,
+    const float* QuantBScaleColPtr,
+    const std::byte* QuantBZeroPointColPtr,
+    float* SumPtr,
+    size_t BlockCountK,
+    size_t StrideQuantBData,
+    size_t StrideQuantBScale,
+    size_t StrideQuantBZeroPoint,
+    const float* BiasPtr
+)
+{
+    constexpr size_t BlkBitWidth2 = 2;
+    const size_t BlkDataSize = MlasQNBitBlkDataSizeInBytes(BlkBitWidth2, BlkLen);
+
+    __m256 acc[NCols];
+    UnrolledLoop<NCols>([&](size_t i) { acc[i] = _mm256_setzero_ps(); });
+
+    // sum of b_scale * zp * a_scale * sum(a) of the blocks, subtracted from the result
+    float acc_zp[NCols]{};
+
+    const int8_t* QuantAPtr = reinterpret_cast<const int8_t*>(QuantARowPtr);
+
+    for (size_t k_blk = 0; k_blk < BlockCountK; ++k_blk) {
+        __m256i dot[NCols];
+        UnrolledLoop<NCols>([&](size_t i) { dot[i] = _mm256_setzero_si256(); });
+
+        const std::byte* QuantBDataPtr = QuantBDataColPtr + k_blk * BlkDataSize;
+
+        size_t kk = 0;
+        for (; kk + 32 <= BlkLen; kk += 32) {
+            const __m256i av_32_epi8 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(QuantAPtr + kk));
+            UnrolledLoop<NCols>([&](size_t i) {
+                const __m256i bv_32_epu8 = unpack_32_2bit_epu8(QuantBDataPtr + i * StrideQuantBData + kk / 4);
+                dot[i] = dot_quads_u8s8_avx2<vnni>(dot[i], bv_32_epu8, av_32_epi8);
+            });
+        }
+        if (kk < BlkLen) {
+            // BlkLen is 16
+            const __m256i av_32_epi8 = _mm256_inserti128_si256(
+                _mm256_setzero_si256(), _mm_loadu_si128(reinterpret_cast<const __m128i*>(QuantAPtr + kk)), 0
+            );
+            UnrolledLoop<NCols>([&](size_t i) {
+                const __m256i bv_32_epu8 = _mm256_inserti128_si256(
+                    _mm256_setzero_si256(), unpack_16_2bit_epu8(QuantBDataPtr + i * StrideQuantBData + kk / 4), 0
+                );
+                dot[i] = dot_quads_u8s8_avx2<vnni>(dot[i], bv_32_epu8, av_32_epi8);
+            });
+        }
+
+        const float a_scale = QuantAScaleRowPtr[k_blk];
+        const float a_blk_sum = ABlockSumRowPtr[k_blk];
+        UnrolledLoop<NCols>([&](size_t i) {
+            const float b_scale = QuantBScaleColPtr[i * StrideQuantBScale + k_blk];
+            const float zp = [&]() -> float {
+                if constexpr (HasZeroPoint) {
+                    return get_2bit_zp(QuantBZeroPointColPtr + i * StrideQuantBZeroPoint, k_blk);
+                } else {
+                    return 2.0f;
+                }
+            }();
+            acc[i] = _mm256_fmadd_ps(_mm256_cvtepi32_ps(dot[i]), _mm256_set1_ps(a_scale * b_scale), acc[i]);
+            acc_zp[i] += b_scale * zp * a_blk_sum;
+        });
+
+        QuantAPtr += BlkLen;
+    }
+
+    if constexpr (NCols == 4) {
+        __m128 acc_x = _mm_sub_ps(FoldAccumulators(acc[0], acc[1], acc[2], acc[3]), _mm_loadu_ps(acc_zp));
+        if (BiasPtr != nullptr) {
+            acc_x = _mm_add_ps(acc_x, _mm_loadu_ps(BiasPtr));
+        }
+        _mm_storeu_ps(SumPtr, acc_x);
+    } else {
+        UnrolledLoop<NCols>([&](size_t i) {
+            SumPtr[i] = hsum_float_8(acc[i]) - acc_zp[i] + (BiasPtr != nullptr ? BiasPtr[i] : 0.0f);
+        });
+    }
+}
+
+template <bool HasZeroPoint, bool vnni>
+static void
+SQ2BitGemmKernel_CompInt8_avx2_Impl(
+    size_t BlkLen,
+    const std::byte* QuantA,
+    const float* QuantAScale,
+    const float* ABlockSum,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t BlockCountK,
+    size_t ldc,
+    const float* Bias
+)
+{
+    constexpr size_t BlkBitWidth2 = 2;
+    constexpr size_t NCols4 = 4;
+
+    const size_t StrideQuantA = BlockCountK * BlkLen;
+    const size_t StrideQuantBData = BlockCountK * MlasQNBitBlkDataSizeInBytes(BlkBitWidth2, BlkLen);
+    const size_t StrideQuantBScale = BlockCountK;
+    const size_t StrideQuantBZeroPoint = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth2>(BlockCountK);
+
+    for (size_t m = 0; m < CountM; ++m) {
+        const std::byte* QuantARowPtr = QuantA + m * StrideQuantA;
+        const float* QuantAScaleRowPtr = QuantAScale + m * BlockCountK;
+        const float* ABlockSumRowPtr = ABlockSum + m * BlockCountK;
+
+        const std::byte* QuantBDataColPtr = QuantBData;
+        const float* QuantBScaleColPtr = QuantBScale;
+        const std::byte* QuantBZeroPointColPtr = QuantBZeroPoint;
+
+        const float* BiasPtr = Bias;
+        float* SumPtr = C + m * ldc;
+
+        int64_t nblk = static_cast<int64_t>(CountN) - NCols4;
+        while (nblk >= 0) {
+            ComputeDotProducts_BlkBitWidth2_CompInt8_avx2<NCols4, HasZeroPoint, vnni>(
+                BlkLen,
+                QuantARowPtr, QuantAScaleRowPtr, ABlockSumRowPtr,
+                QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, SumPtr, BlockCountK,
+                StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint,
+                BiasPtr
+            );
+
+            // move to next `NCols` columns
+
+            QuantBDataColPtr += NCols4 * StrideQuantBData;
+            QuantBScaleColPtr += NCols4 * StrideQuantBScale;
+            if constexpr (HasZeroPoint) {
+                QuantBZeroPointColPtr += NCols4 * StrideQuantBZeroPoint;
+            }
+
+            BiasPtr += BiasPtr != nullptr ? NCols4 : 0;
+            SumPtr += NCols4;
+
+            nblk -= NCols4;
+        }
+
+        // left over columns less than `NCols`?
+        nblk += NCols4;
+        for (int64_t n = 0; n < nblk; ++n) {
+            ComputeDotProducts_BlkBitWidth2_CompInt8_avx2<1, HasZeroPoint, vnni>(
+                BlkLen,
+                QuantARowPtr, QuantAScaleRowPtr, ABlockSumRowPtr,
+                QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, SumPtr, BlockCountK,
+                StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint,
+                BiasPtr
+            );
+
+            // move to next column
+
+            QuantBDataColPtr += StrideQuantBData;
+            QuantBScaleColPtr += StrideQuantBScale;
+            if constexpr (HasZeroPoint) {
+                QuantBZeroPointColPtr += StrideQuantBZeroPoint;
+            }
+
+            BiasPtr += BiasPtr != nullptr ? 1 : 0;
+            SumPtr += 1;
+        }
+    }
+}
+
+template <bool vnni>
+static size_t
+SQ2BitGemmKernel_CompInt8_avx2(
+    size_t BlkLen,
+    const std::byte* QuantA,
+    const float* QuantAScale,
+    const float* ABlockSum,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t /*CountK*/,
+    size_t BlockCountK,
+    size_t ldc,
+    const float* Bias
+)
+{
+    assert(BlkLen % 16 == 0);
+
+    if (QuantBZeroPoint != nullptr) {
+        SQ2BitGemmKernel_CompInt8_avx2_Impl<true, vnni>(
+            BlkLen, QuantA, QuantAScale, ABlockSum, QuantBData, QuantBScale, QuantBZeroPoint,
+            C, CountM, CountN, BlockCountK, ldc, Bias
+        );
+    } else {
+        SQ2BitGemmKernel_CompInt8_avx2_Impl<false, vnni>(
+            BlkLen, QuantA, QuantAScale, ABlockSum, QuantBData, QuantBScale, QuantBZeroPoint,
+            C, CountM, CountN, BlockCountK, ldc, Bias
+        );
+    }
+
+    return CountM;
+}
@@ -0,0 +1,431 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sq2bitgemm_kernel_avx512.h
+
+Abstract:
+
+    This module implements the float/quantized 2-bit integer matrix
+    multiplication kernels for x64 avx512 and avx512vnni.
+
+    The quantized B data is expected to be packed with SQ2BitGemmPackQuantBData.
+
+--*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+
+#include "qnbitgemm.h"
+#include "sqnbitgemm_kernel_avx_common.h"
+
+// unpack 64 2-bit values packed by SQ2BitGemmPackQuantBData (16 bytes) into 64 bytes
+static MLAS_FORCEINLINE __m512i
+unpack_64_2bit_epu8(const __m128i bv_packed_16_epu8)
+{
+    const __m512i bv_packed = _mm512_castsi128_si512(bv_packed_16_epu8);
+    const __m512i bv_dup = _mm512_permutexvar_epi32(
+        _mm512_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3), bv_packed
+    );
+    const __m512i bv_shifted = _mm512_srlv_epi32(
+        bv_dup, _mm512_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6, 0, 2, 4, 6, 0, 2, 4, 6)
+    );
+    return _mm512_and_si512(bv_shifted, _mm512_set1_epi8(0x03));
+}
+
+//
+// SQNBIT_CompFp32 kernel implementation.
+//
+
+template <size_t NCols, bool HasZeroPoint>
+static MLAS_FORCEINLINE void
+ComputeDotProducts_BlkBitWidth2_CompFp32_avx512(
+    size_t BlkLen,
+    const float* ARowPtr,
+    const std::byte* QuantBDataColPtr,
+    const float* QuantBScaleColPtr,
+    const std::byte* QuantBZeroPointColPtr,
+    float* SumPtr,
+    size_t CountK,
+    size_t StrideQuantBData,
+    size_t StrideQuantBScale,
+    size_t StrideQuantBZeroPoint,
+    const float* BiasPtr
+)
+{
+    constexpr size_t SubBlkLen16 = 16;
+
+    __m512 acc[NCols];
+    UnrolledLoop<NCols>([&](size_t i) { acc[i] = _mm512_setzero_ps(); });
+
+    for (size_t k = 0, k_blk = 0; k < CountK; k += BlkLen, ++k_blk) {
+        const size_t k_blk_len = std::min(CountK - k, BlkLen);
+
+        // sum of the A values and of the products of A and the quantized B values of the block
+        __m512 acc_a = _mm512_setzero_ps();
+        __m512 acc_blk[NCols];
+        UnrolledLoop<NCols>([&](size_t i) { acc_blk[i] = _mm512_setzero_ps(); });
+
+        for (size_t kk = 0; kk < k_blk_len; kk += SubBlkLen16) {
+            const size_t kklen = std::min(k_blk_len - kk, SubBlkLen16);
+
+            // the A values past CountK are loaded as zeros
+            const __mmask16 load_mask = static_cast<__mmask16>(0xFFFF >> (SubBlkLen16 - kklen));
+            const __m512 av_16_ps = _mm512_maskz_loadu_ps(load_mask, ARowPtr + k + kk);
+            acc_a = _mm512_add_ps(acc_a, av_16_ps);
+
+            UnrolledLoop<NCols>([&](size_t i) {
+                const __m128i bv_16_epu8 = unpack_16_2bit_epu8(QuantBDataColPtr + i * StrideQuantBData + (k + kk) / 4);
+                const __m512 bv_16_ps = _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(bv_16_epu8));
+                acc_blk[i] = _mm512_fmadd_ps(av_16_ps, bv_16_ps, acc_blk[i]);
+            });
+        }
+
+        // acc += scale * (sum(a * b) - zp * sum(a))
+        UnrolledLoop<NCols>([&](size_t i) {
+            const float zp = [&]() -> float {
+                if constexpr (HasZeroPoint) {
+                    return get_2bit_zp(QuantBZeroPointColPtr + i * StrideQuantBZeroPoint, k_blk);
+                } else {
+                    return 2.0f;
+                }
+            }();
+            const __m512 scale_16_ps = _mm512_set1_ps(QuantBScaleColPtr[i * StrideQuantBScale + k_blk]);
+            const __m512 blk_16_ps = _mm512_fnmadd_ps(_mm512_set1_ps(zp), acc_a, acc_blk[i]);
+            acc[i] = _mm512_fmadd_ps(blk_16_ps, scale_16_ps, acc[i]);
+        });
+    }
+
+    UnrolledLoop<NCols>([&](size_t i) {
+        SumPtr[i] = _mm512_reduce_add_ps(acc[i]) + (BiasPtr != nullptr ? BiasPtr[i] : 0.0f);
+    });
+}
+
+template <bool HasZeroPoint>
+static void
+SQ2BitGemmM1Kernel_CompFp32_avx512_Impl(
+    size_t BlkLen,
+    const float* A,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    const float* Bias
+)
+{
+    constexpr size_t BlkBitWidth2 = 2;
+    constexpr size_t NCols4 = 4;
+
+    const size_t StrideQuantBData = BlockCountK * MlasQNBitBlkDataSizeInBytes(BlkBitWidth2, BlkLen);
+    const size_t StrideQuantBScale = BlockCountK;
+    const size_t StrideQuantBZeroPoint = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth2>(BlockCountK);
+
+    const float* BiasPtr = Bias;
+
+    const std::byte* QuantBDataColPtr = QuantBData;
+    const float* QuantBScaleColPtr = QuantBScale;
+    const std::byte* QuantBZeroPointColPtr = QuantBZeroPoint;
+
+    float* SumPtr = C;
+
+    int64_t nblk = static_cast<int64_t>(CountN) - NCols4;
+    while (nblk >= 0) {
+        ComputeDotProducts_BlkBitWidth2_CompFp32_avx512<NCols4, HasZeroPoint>(
+            BlkLen,
+            A, QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, SumPtr, CountK,
+            StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint,
+            BiasPtr
+        );
+
+        // move to next `NCols` columns
+
+        QuantBDataColPtr += NCols4 * StrideQuantBData;
+        QuantBScaleColPtr += NCols4 * StrideQuantBScale;
+        if constexpr (HasZeroPoint) {
+            QuantBZeroPointColPtr += NCols4 * StrideQuantBZeroPoint;
+        }
+
+        BiasPtr += BiasPtr != nullptr ? NCols4 : 0;
+        SumPtr += NCols4;
+
+        nblk -= NCols4;
+    }
+
+    // left over columns less than `NCols`?
+    nblk += NCols4;
+    for (int64_t n = 0; n < nblk; ++n) {
+        ComputeDotProducts_BlkBitWidth2_CompFp32_avx512<1, HasZeroPoint>(
+            BlkLen,
+            A, QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, SumPtr, CountK,
+            StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint,
+            BiasPtr
+        );
+
+        // move to next column
+
+        QuantBDataColPtr += StrideQuantBData;
+        QuantBScaleColPtr += StrideQuantBScale;
+        if constexpr (HasZeroPoint) {
+            QuantBZeroPointColPtr += StrideQuantBZeroPoint;
+        }
+
+        BiasPtr += BiasPtr != nullptr ? 1 : 0;
+        SumPtr += 1;
+    }
+}
+
+static void
+SQ2BitGemmM1Kernel_CompFp32_avx512(
+    size_t BlkLen,
+    const float* A,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    const float* Bias
+)
+{
+    if (QuantBZeroPoint != nullptr) {
+        SQ2BitGemmM1Kernel_CompFp32_avx512_Impl<true>(
+            BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK, BlockCountK, Bias
+        );
+    } else {
+        SQ2BitGemmM1Kernel_CompFp32_avx512_Impl<false>(
+            BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK, BlockCountK, Bias
+        );
+    }
+}
+
+//
+// SQNBIT_CompInt8 kernel implementation.
+//
+
+// accumulate the sums of the products of 4 adjacent unsigned and signed int8 values
+template <bool vnni>
+static MLAS_FORCEINLINE __m512i
+dot_quads_u8s8_avx512(const __m512i acc, const __m512i bv_64_epu8, const __m512i av_64_epi8)
+{
+    if constexpr (vnni) {
+        return _mm512_dpbusd_epi32(acc, bv_64_epu8, av_64_epi8);
+    } else {
+        // the products of 2-bit and int8 values do not saturate int16
+        const __m512i dot_32_epi16 = _mm512_maddubs_epi16(bv_64_epu8, av_64_epi8);
+        return _mm512_add_epi32(acc, _mm512_madd_epi16(dot_32_epi16, _mm512_set1_epi16(1)));
+    }
+}
+
+template <size_t NCols, bool HasZeroPoint, bool vnni>
+static MLAS_FORCEINLINE void
+ComputeDotProducts_BlkBitWidth2_CompInt8_avx512(
+    size_t BlkLen,
+    const std::byte* QuantARowPtr,
+    const float* QuantAScaleRowPtr,
+    const float* ABlockSumRowPtr,
+    const std::byte* QuantBDataColPtr,
+    const float* QuantBScaleColPtr,
+    const std::byte* QuantBZeroPointColPtr,
+    float* SumPtr,
+    size_t BlockCountK,
+    size_t StrideQuantBData,
+    size_t StrideQuantBScale,
+    size_t StrideQuantBZeroPoint,
+    const float* BiasPtr
+)
+{
+    constexpr size_t BlkBitWidth2 = 2;
+    const size_t BlkDataSize = MlasQNBitBlkDataSizeInBytes(BlkBitWidth2, BlkLen);
+
+    __m512 acc[NCols];
+    UnrolledLoop<NCols>([&](size_t i) { acc[i] = _mm512_setzero_ps(); });
+
+    // sum of b_scale * zp * a_scale * sum(a) of the blocks, subtracted from the result
+    float acc_zp[NCols]{};
+
+    const int8_t* QuantAPtr = reinterpret_cast<const int8_t*>(QuantARowPtr);
+
+    for (size_t k_blk = 0; k_blk < BlockCountK; ++k_blk) {
+        __m512i dot[NCols];
+        UnrolledLoop<NCols>([&](size_t i) { dot[i] = _mm512_setzero_si512(); });
+
+        const std::byte* QuantBDataPtr = QuantBDataColPtr + k_blk * BlkDataSize;
+
+        size_t kk = 0;
+        for (; kk + 64 <= BlkLen; kk += 64) {
+            const __m512i av_64_epi8 = _mm512_loadu_si512(QuantAPtr + kk);
+            UnrolledLoop<NCols>([&](size_t i) {
+                const __m512i bv_64_epu8 = unpack_64_2bit_epu8(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(QuantBDataPtr + i * StrideQuantBData + kk / 4))
+                );
+                dot[i] = dot_quads_u8s8_avx512<vnni>(dot[i], bv_64_epu8, av_64_epi8);
+            });
+        }
+        if (kk < BlkLen) {
+            // BlkLen is 16 or 32, the values past BlkLen are loaded as zeros
+            const __mmask64 a_load_mask = ~uint64_t{0} >> (64 - (BlkLen - kk));
+            const __mmask16 b_load_mask = static_cast<__mmask16>(0xFFFF >> (16 - (BlkLen - kk) / 4));
+            const __m512i av_64_epi8 = _mm512_maskz_loadu_epi8(a_load_mask, QuantAPtr + kk);
+            UnrolledLoop<NCols>([&](size_t i) {
+                const __m512i bv_64_epu8 = unpack_64_2bit_epu8(
+                    _mm_maskz_loadu_epi8(b_load_mask, QuantBDataPtr + i * StrideQuantBData + kk / 4)
+                );
+                dot[i] = dot_quads_u8s8_avx512<vnni>(dot[i], bv_64_epu8, av_64_epi8);
+            });
+        }
+
+        const float a_scale = QuantAScaleRowPtr[k_blk];
+        const float a_blk_sum = ABlockSumRowPtr[k_blk];
+        UnrolledLoop<NCols>([&](size_t i) {
+            const float b_scale = QuantBScaleColPtr[i * StrideQuantBScale + k_blk];
+            const float zp = [&]() -> float {
+                if constexpr (HasZeroPoint) {
+                    return get_2bit_zp(QuantBZeroPointColPtr + i * StrideQuantBZeroPoint, k_blk);
+                } else {
+                    return 2.0f;
+                }
+            }();
+            acc[i] = _mm512_fmadd_ps(_mm512_cvtepi32_ps(dot[i]), _mm512_set1_ps(a_scale * b_scale), acc[i]);
+            acc_zp[i] += b_scale * zp * a_blk_sum;
+        });
+
+        QuantAPtr += BlkLen;
+    }
+
+    UnrolledLoop<NCols>([&](size_t i) {
+        SumPtr[i] = _mm512_reduce_add_ps(acc[i]) - acc_zp[i] + (BiasPtr != nullptr ? BiasPtr[i] : 0.0f);
+    });
+}
+
+template <bool HasZeroPoint, bool vnni>
+static void
+SQ2BitGemmKernel_CompInt8_avx512_Impl(
+    size_t BlkLen,
+    const std::byte* QuantA,
+    const float* QuantAScale,
+    const float* ABlockSum,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t BlockCountK,
+    size_t ldc,
+    const float* Bias
+)
+{
+    constexpr size_t BlkBitWidth2 = 2;
+    constexpr size_t NCols4 = 4;
+
+    const size_t StrideQuantA = BlockCountK * BlkLen;
+    const size_t StrideQuantBData = BlockCountK * MlasQNBitBlkDataSizeInBytes(BlkBitWidth2, BlkLen);
+    const size_t StrideQuantBScale = BlockCountK;
+    const size_t StrideQuantBZeroPoint = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth2>(BlockCountK);
+
+    for (size_t m = 0; m < CountM; ++m) {
+        const std::byte* QuantARowPtr = QuantA + m * StrideQuantA;
+        const float* QuantAScaleRowPtr = QuantAScale + m * BlockCountK;
+        const float* ABlockSumRowPtr = ABlockSum + m * BlockCountK;
+
+        const std::byte* QuantBDataColPtr = QuantBData;
+        const float* QuantBScaleColPtr = QuantBScale;
+        const std::byte* QuantBZeroPointColPtr = QuantBZeroPoint;
+
+        const float* BiasPtr = Bias;
+        float* SumPtr = C + m * ldc;
+
+        int64_t nblk = static_cast<int64_t>(CountN) - NCols4;
+        while (nblk >= 0) {
+            ComputeDotProducts_BlkBitWidth2_CompInt8_avx512<NCols4, HasZeroPoint, vnni>(
+                BlkLen,
+                QuantARowPtr, QuantAScaleRowPtr, ABlockSumRowPtr,
+                QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, SumPtr, BlockCountK,
+                StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint,
+                BiasPtr
+            );
+
+            // move to next `NCols` columns
+
+            QuantBDataColPtr += NCols4 * StrideQuantBData;
+            QuantBScaleColPtr += NCols4 * StrideQuantBScale;
+            if constexpr (HasZeroPoint) {
+                QuantBZeroPointColPtr += NCols4 * StrideQuantBZeroPoint;
+            }
+
+            BiasPtr += BiasPtr != nullptr ? NCols4 : 0;
+            SumPtr += NCols4;
+
+            nblk -= NCols4;
+        }
+
+        // left over columns less than `NCols`?
+        nblk += NCols4;
+        for (int64_t n = 0; n < nblk; ++n) {
+            ComputeDotProducts_BlkBitWidth2_CompInt8_avx512<1, HasZeroPoint, vnni>(
+                BlkLen,
+                QuantARowPtr, QuantAScaleRowPtr, ABlockSumRowPtr,
+                QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, SumPtr, BlockCountK,
+                StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint,
+                BiasPtr
+            );
+
+            // move to next column
+
+            QuantBDataColPtr += StrideQuantBData;
+            QuantBScaleColPtr += StrideQuantBScale;
+            if constexpr (HasZeroPoint) {
+                QuantBZeroPointColPtr += StrideQuantBZeroPoint;
+            }
+
+            BiasPtr += BiasPtr != nullptr ? 1 : 0;
+            SumPtr += 1;
+        }
+    }
+}
+
+template <bool vnni>
+static size_t
+SQ2BitGemmKernel_CompInt8_avx512(
+    size_t BlkLen,
+    const std::byte* QuantA,
+    const float* QuantAScale,
+    const float* ABlockSum,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t /*CountK*/,
+    size_t BlockCountK,
+    size_t ldc,
+    const float* Bias
+)
+{
+    assert(BlkLen % 16 == 0);
+
+    if (QuantBZeroPoint != nullptr) {
+        SQ2BitGemmKernel_CompInt8_avx512_Impl<true, vnni>(
+            BlkLen, QuantA, QuantAScale, ABlockSum, QuantBData, QuantBScale, QuantBZeroPoint,
+            C, CountM, CountN, BlockCountK, ldc, Bias
+        );
+    } else {
+        SQ2BitGemmKernel_CompInt8_avx512_Impl<false, vnni>(
+            BlkLen, QuantA, QuantAScale, ABlockSum, QuantBData, QuantBScale, QuantBZeroPoint,
+            C, CountM, CountN, BlockCountK, ldc, Bias
+        );
+    }
+
+    return CountM;
+}
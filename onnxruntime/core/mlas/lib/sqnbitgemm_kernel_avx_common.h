@@ -1,4 +1,6 @@
 #pragma once
+#include <cstring>
+
 #include "qnbitgemm.h"
 #include "sqnbitgemm_q8_block.h"
 
@@ -112,6 +114,82 @@ SQ4BitGemmPackQuantBData(
     );
 }
 
+static size_t
+Q2BitGemmPackQuantBDataSize(
+    size_t N,
+    size_t K,
+    size_t BlkLen,
+    bool /* HasZeroPoint */,
+    MLAS_QNBIT_GEMM_COMPUTE_TYPE /* ComputeType */
+)
+{
+    constexpr size_t BlkBitWidth = 2;
+
+    // same size regardless of ComputeType, block sums of B are not used by the 2-bit kernels
+    const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
+    return N * BlockCountK * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+}
+
+static void
+SQ2BitGemmPackQuantBData(
+    size_t N,
+    size_t K,
+    size_t BlkLen,
+    MLAS_QNBIT_GEMM_COMPUTE_TYPE /* ComputeType*/,
+    const std::byte* QuantBDataBegin,
+    std::byte* PackedQuantBDataBegin,
+    MLAS_THREADPOOL* ThreadPool
+)
+{
+    constexpr size_t BlkBitWidth = 2;
+
+    assert(BlkLen >= 16 && BlkLen % 16 == 0);
+
+    const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
+    const size_t BlkDataSize = MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t Iterations = N * BlockCountK;  // one iteration per block
+
+    constexpr size_t SubBlkLen = 16;
+    constexpr size_t SubBlkDataSize = SubBlkLen / 4;
+
+    //
+    // Pack 16 2-bit values (4 bytes) at a time like this (values of a byte are listed from the low bits):
+    //
+    // src: | v0 v1 v2 v3 | v4 v5 v6 v7 | v8 v9 vA vB | vC vD vE vF |
+    //   =>
+    // dst: | v0 v4 v8 vC | v1 v5 v9 vD | v2 v6 vA vE | v3 v7 vB vF |
+    //
+    // Shifting the 4 bytes as a 32-bit value right by 0, 2, 4 and 6 bits then puts v0-v3, v4-v7, v8-vB and vC-vF
+    // in the low bits of consecutive bytes.
+    //
+
+    MlasTrySimpleParallel(
+        ThreadPool, Iterations,
+        [&](ptrdiff_t tid) {
+            const size_t n = tid / BlockCountK;
+            const size_t k_blk = tid % BlockCountK;
+
+            const size_t data_offset = n * BlockCountK * BlkDataSize + k_blk * BlkDataSize;
+            const std::byte* QuantBData = QuantBDataBegin + data_offset;
+            std::byte* PackedQuantBData = PackedQuantBDataBegin + data_offset;
+
+            for (size_t kk = 0; kk < BlkLen; kk += SubBlkLen) {
+                for (size_t j = 0; j < SubBlkDataSize; ++j) {
+                    std::byte dst{0};
+                    for (size_t s = 0; s < 4; ++s) {
+                        const std::byte v = (QuantBData[s] >> (2 * j)) & std::byte{0x03};
+                        dst |= v << (2 * s);
+                    }
+                    PackedQuantBData[j] = dst;
+                }
+
+                QuantBData += SubBlkDataSize;
+                PackedQuantBData += SubBlkDataSize;
+            }
+        }
+    );
+}
+
 static size_t
 GetContinueLayoutOffsetSubBlk(size_t N, const size_t n, const size_t SubOrBlkCountK, const size_t k_sub_or_blk)
 {
@@ -467,12 +545,14 @@ QNBitGemmPerGemmWorkspaceSize(
     size_t M,
     size_t N,
     size_t K,
+    size_t BlkBitWidth,
     size_t BlkLen,
     bool /* HasZeroPoint */,
     MLAS_QNBIT_GEMM_COMPUTE_TYPE ComputeType
 )
 {
     MLAS_UNREFERENCED_PARAMETER(N);
+    MLAS_UNREFERENCED_PARAMETER(BlkBitWidth);
 
     switch(ComputeType) {
         case SQNBIT_CompInt8: {
@@ -518,6 +598,18 @@ Q4BitBlkDequantBForSgemm_CompFp32_avx2(
     const size_t BlockStrideQuantB
 );
 
+void
+SQ2BitBlkDequantBForSgemm_CompFp32_avx2(
+    size_t BlkLen,
+    float* FpData,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK
+);
+
 size_t
 SQ4BitGemmKernel_CompInt8_avx2(
     size_t BlkLen,
@@ -678,6 +770,13 @@ get_zp(bool is_lower_half_byte_zp, const std::byte* QuantBZeroPointPtr)
     }
 }
 
+// get the zero point of block k_blk from a column of 2-bit zero points, 4 zero points are packed in a byte
+static MLAS_FORCEINLINE int
+get_2bit_zp(const std::byte* QuantBZeroPointColPtr, size_t k_blk)
+{
+    return std::to_integer<int>((QuantBZeroPointColPtr[k_blk / 4] >> (2 * (k_blk % 4))) & std::byte{0x03});
+}
+
 // this function load and unpack 32 4b weights (packed for BlkLen32) and dot product it with 32
 // epi8 input. dot products are accumulated into acc0.
 // This function is called for Int8 precision with BlkLen = 32.
@@ -804,6 +903,26 @@ convert_2_ps_to_epi8(__m256 v0, __m256 v1)
     return _mm_packs_epi16(v0_8_epi16, v1_8_epi16);
 }
 
+// unpack 16 2-bit values packed by SQ2BitGemmPackQuantBData into 16 bytes
+static MLAS_FORCEINLINE __m128i
+unpack_16_2bit_epu8(const std::byte* QuantBDataPtr)
+{
+    int32_t bv_packed;
+    memcpy(&bv_packed, QuantBDataPtr, sizeof(bv_packed));
+    const __m128i bv_shifted = _mm_srlv_epi32(_mm_set1_epi32(bv_packed), _mm_setr_epi32(0, 2, 4, 6));
+    return _mm_and_si128(bv_shifted, _mm_set1_epi8(0x03));
+}
+
+// unpack 32 2-bit values packed by SQ2BitGemmPackQuantBData into 32 bytes
+static MLAS_FORCEINLINE __m256i
+unpack_32_2bit_epu8(const std::byte* QuantBDataPtr)
+{
+    const __m256i bv_packed = _mm256_castsi128_si256(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(QuantBDataPtr)));
+    const __m256i bv_dup = _mm256_permutevar8x32_epi32(bv_packed, _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1));
+    const __m256i bv_shifted = _mm256_srlv_epi32(bv_dup, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6));
+    return _mm256_and_si256(bv_shifted, _mm256_set1_epi8(0x03));
+}
+
 // horizontally add 8 int32_t
 static MLAS_FORCEINLINE int
 hsum_8_epi32(const __m256i a_8_epi32)
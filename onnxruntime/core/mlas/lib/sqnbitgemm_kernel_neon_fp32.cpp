@@ -644,4 +644,315 @@ SQ4BitBlkDequantBForSgemm_CompFp32(
     }
 }
 
+namespace
+{
+
+//
+// 2-bit quantized B kernels. The quantized B data is expected to be packed with SQ2BitGemmPackQuantBData.
+//
+
+// Converts 16 unpacked 2-bit values to floats.
+MLAS_FORCEINLINE void
+Convert16x2BitValuesToFloat(uint8x16_t bv_u8, float32x4_t (&bv)[4])
+{
+    const uint16x8_t bv_lo_u16 = vmovl_u8(vget_low_u8(bv_u8));
+    const uint16x8_t bv_hi_u16 = vmovl_high_u8(bv_u8);
+    bv[0] = vcvtq_f32_u32(vmovl_u16(vget_low_u16(bv_lo_u16)));
+    bv[1] = vcvtq_f32_u32(vmovl_high_u16(bv_lo_u16));
+    bv[2] = vcvtq_f32_u32(vmovl_u16(vget_low_u16(bv_hi_u16)));
+    bv[3] = vcvtq_f32_u32(vmovl_high_u16(bv_hi_u16));
+}
+
+template <size_t NCols, bool HasZeroPoint>
+MLAS_FORCEINLINE void
+ComputeDotProducts_BlkBitWidth2_CompFp32(
+    size_t BlkLen,
+    const float* ARowPtr,
+    const std::byte* QuantBDataColPtr,
+    const float* QuantBScaleColPtr,
+    const std::byte* QuantBZeroPointColPtr,
+    float* SumPtr,
+    size_t CountK,
+    size_t StrideQuantBData,
+    size_t StrideQuantBScale,
+    size_t StrideQuantBZeroPoint,
+    const float* BiasPtr
+)
+{
+    constexpr size_t SubBlkLen = 16;
+
+    static_assert(NCols == 1 || NCols == 4, "NCols must be 1 or 4");
+
+    assert(BlkLen >= SubBlkLen && BlkLen % SubBlkLen == 0);
+
+    float32x4_t acc[NCols]{};
+
+    for (size_t k = 0, k_blk = 0; k < CountK; k += BlkLen, ++k_blk) {
+        const size_t k_blk_len = std::min(CountK - k, BlkLen);
+
+        // sum of the A values and of the products of A and the quantized B values of the block
+        float32x4_t acc_a{};
+        float32x4_t acc_blk[NCols]{};
+
+        for (size_t kk = 0; kk < k_blk_len; kk += SubBlkLen) {
+            const size_t kklen = std::min(k_blk_len - kk, SubBlkLen);
+
+            // load A row vector elements
+            float32x4_t av[4]{};
+            LoadFloatData<SubBlkLen>(ARowPtr + k + kk, kklen, av);
+
+            acc_a = vaddq_f32(acc_a, vaddq_f32(vaddq_f32(av[0], av[1]), vaddq_f32(av[2], av[3])));
+
+            UnrolledLoop<NCols>([&](size_t i) {
+                float32x4_t bv[4];
+                Convert16x2BitValuesToFloat(
+                    Unpack16x2BitValues(QuantBDataColPtr + i * StrideQuantBData + (k + kk) / 4), bv
+                );
+                UnrolledLoop<4>([&](size_t j) { acc_blk[i] = vfmaq_f32(acc_blk[i], av[j], bv[j]); });
+            });
+        }
+
+        // acc += scale * (sum(a * b) - zp * sum(a))
+        UnrolledLoop<NCols>([&](size_t i) {
+            const float zp = [&]() -> float {
+                if constexpr (HasZeroPoint) {
+                    return Get2BitZeroPoint(QuantBZeroPointColPtr + i * StrideQuantBZeroPoint, k_blk);
+                } else {
+                    return 2.0f;
+                }
+            }();
+            const float32x4_t blk = vfmsq_f32(acc_blk[i], acc_a, vdupq_n_f32(zp));
+            acc[i] = vfmaq_n_f32(acc[i], blk, QuantBScaleColPtr[i * StrideQuantBScale + k_blk]);
+        });
+    }
+
+    if constexpr (NCols == 4) {
+        float32x4_t sum = FoldAccumulators(acc[0], acc[1], acc[2], acc[3]);
+
+        if (BiasPtr != nullptr) {
+            sum = vaddq_f32(sum, vld1q_f32(BiasPtr));
+        }
+
+        vst1q_f32(SumPtr, sum);
+    } else {
+        for (size_t i = 0; i < NCols; ++i) {
+            SumPtr[i] = vaddvq_f32(acc[i]);
+            if (BiasPtr != nullptr) {
+                SumPtr[i] += BiasPtr[i];
+            }
+        }
+    }
+}
+
+template <bool HasZeroPoint>
+void
+SQ2BitGemmM1Kernel_CompFp32_Impl(
+    size_t BlkLen,
+    const float* A,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    const float* Bias
+)
+{
+    constexpr size_t BlkBitWidth = 2;
+    constexpr size_t NCols = 4;
+
+    const size_t StrideQuantBData = BlockCountK * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t StrideQuantBScale = BlockCountK;
+    const size_t StrideQuantBZeroPoint = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockCountK);
+
+    const float* BiasPtr = Bias;
+
+    const std::byte* QuantBDataColPtr = QuantBData;
+    const float* QuantBScaleColPtr = QuantBScale;
+    const std::byte* QuantBZeroPointColPtr = QuantBZeroPoint;
+
+    float* SumPtr = C;
+
+    int64_t nblk = static_cast<int64_t>(CountN) - NCols;
+
+    while (nblk >= 0) {
+        ComputeDotProducts_BlkBitWidth2_CompFp32<NCols, HasZeroPoint>(
+            BlkLen,
+            A, QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, SumPtr, CountK,
+            StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint,
+            BiasPtr
+        );
+
+        // move to next `NCols` columns
+
+        QuantBDataColPtr += NCols * StrideQuantBData;
+        QuantBScaleColPtr += NCols * StrideQuantBScale;
+        if constexpr (HasZeroPoint) {
+            QuantBZeroPointColPtr += NCols * StrideQuantBZeroPoint;
+        }
+
+        BiasPtr += BiasPtr != nullptr ? NCols : 0;
+        SumPtr += NCols;
+
+        nblk -= NCols;
+    }
+
+    // left over columns less than `NCols`?
+    nblk += NCols;
+    for (int64_t n = 0; n < nblk; ++n) {
+        ComputeDotProducts_BlkBitWidth2_CompFp32<1, HasZeroPoint>(
+            BlkLen,
+            A, QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, SumPtr, CountK,
+            StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint,
+            BiasPtr
+        );
+
+        // move to next column
+
+        QuantBDataColPtr += StrideQuantBData;
+        QuantBScaleColPtr += StrideQuantBScale;
+        if constexpr (HasZeroPoint) {
+            QuantBZeroPointColPtr += StrideQuantBZeroPoint;
+        }
+
+        BiasPtr += BiasPtr != nullptr ? 1 : 0;
+        SumPtr += 1;
+    }
+}
+
+template <bool HasZeroPoint>
+void
+SQ2BitBlkDequantBForSgemm_CompFp32_Impl(
+    size_t BlkLen,
+    float* FpData,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK
+)
+{
+    constexpr size_t BlkBitWidth = 2;
+    constexpr size_t NCols = 4;
+
+    const size_t StrideQuantBData = BlockCountK * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    [[maybe_unused]] const size_t StrideQuantBZeroPoint =  // only used if HasZeroPoint is true
+        MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockCountK);
+
+    float* Dst = FpData;
+
+    //
+    // Proceed down 16 column-wide regions of B. Dequantize and write output 16 x 16 elements at a time.
+    // Columns past CountN are written as zeros.
+    //
+
+    for (size_t n = 0; n < CountN; n += 16) {
+        const size_t cols = std::min(CountN - n, size_t{16});
+
+        const std::byte* QuantBDataCol = QuantBData + n * StrideQuantBData;
+        const float* QuantBScaleCol = QuantBScale + n * BlockCountK;
+
+        for (size_t k = 0, k_blk = 0; k < CountK; k += BlkLen, ++k_blk) {
+            // b = q * scale - zp * scale
+            float scale[16]{};
+            float offset[16]{};
+            for (size_t nn = 0; nn < cols; ++nn) {
+                scale[nn] = QuantBScaleCol[nn * BlockCountK + k_blk];
+                const float zp = [&]() -> float {
+                    if constexpr (HasZeroPoint) {
+                        return Get2BitZeroPoint(QuantBZeroPoint + (n + nn) * StrideQuantBZeroPoint, k_blk);
+                    } else {
+                        return 2.0f;
+                    }
+                }();
+                offset[nn] = -zp * scale[nn];
+            }
+
+            const size_t kklen = std::min(CountK - k, BlkLen);
+
+            for (size_t kk = 0; kk < kklen; kk += 16) {
+                for (size_t nn = 0; nn < 16; nn += NCols) {
+                    // `SubBlkLen` floats of NCols columns of B
+                    float32x4_t bv[NCols][4]{};
+                    UnrolledLoop<NCols>([&](size_t i) {
+                        if (nn + i < cols) {
+                            Convert16x2BitValuesToFloat(
+                                Unpack16x2BitValues(QuantBDataCol + (nn + i) * StrideQuantBData + (k + kk) / 4), bv[i]
+                            );
+                            const float32x4_t offset_v = vdupq_n_f32(offset[nn + i]);
+                            UnrolledLoop<4>([&](size_t j) {
+                                bv[i][j] = vfmaq_n_f32(offset_v, bv[i][j], scale[nn + i]);
+                            });
+                        }
+                    });
+
+                    // write, transposed, 16 x NCols values
+                    UnrolledLoop<4>([&](size_t j) {
+                        Transpose4x4(bv[0][j], bv[1][j], bv[2][j], bv[3][j]);
+
+                        vst1q_f32(&Dst[(j * 4 + 0) * 16 + nn], bv[0][j]);
+                        vst1q_f32(&Dst[(j * 4 + 1) * 16 + nn], bv[1][j]);
+                        vst1q_f32(&Dst[(j * 4 + 2) * 16 + nn], bv[2][j]);
+                        vst1q_f32(&Dst[(j * 4 + 3) * 16 + nn], bv[3][j]);
+                    });
+                }
+
+                Dst += 16 * std::min(kklen - kk, size_t{16});
+            }
+        }
+    }
+}
+
+}  // namespace
+
+void
+SQ2BitGemmM1Kernel_CompFp32(
+    size_t BlkLen,
+    const float* A,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    const float* Bias
+)
+{
+    if (QuantBZeroPoint != nullptr) {
+        SQ2BitGemmM1Kernel_CompFp32_Impl<true>(
+            BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK, BlockCountK, Bias
+        );
+    } else {
+        SQ2BitGemmM1Kernel_CompFp32_Impl<false>(
+            BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK, BlockCountK, Bias
+        );
+    }
+}
+
+void
+SQ2BitBlkDequantBForSgemm_CompFp32(
+    size_t BlkLen,
+    float* FpData,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK
+)
+{
+    if (QuantBZeroPoint != nullptr) {
+        SQ2BitBlkDequantBForSgemm_CompFp32_Impl<true>(
+            BlkLen, FpData, QuantBData, QuantBScale, QuantBZeroPoint, CountN, CountK, BlockCountK
+        );
+    } else {
+        SQ2BitBlkDequantBForSgemm_CompFp32_Impl<false>(
+            BlkLen, FpData, QuantBData, QuantBScale, QuantBZeroPoint, CountN, CountK, BlockCountK
+        );
+    }
+}
+
 }  // namespace sqnbitgemm_neon
@@ -1439,6 +1439,193 @@ SQ4BitGemmKernel_CompInt8(
     return CountM;
 }
 
+namespace
+{
+
+//
+// 2-bit quantized B kernels. The quantized B data is expected to be packed with SQ2BitGemmPackQuantBData.
+//
+
+template <size_t NCols, bool HasZeroPoint>
+MLAS_FORCEINLINE void
+SQ2BitGemm_CompInt8_Compute1xNCols(
+    size_t BlkLen,
+    const std::byte* QuantARowPtr,
+    const std::byte* QuantBDataColPtr,
+    const float* QuantBScaleColPtr,
+    const std::byte* QuantBZeroPointColPtr,
+    const float* BiasPtr,
+    float* SumPtr,
+    size_t BlockCountK,
+    size_t StrideQuantBData,
+    size_t StrideQuantBScale,
+    size_t StrideQuantBZeroPoint
+)
+{
+    constexpr size_t BlkBitWidth = 2;
+    constexpr size_t SubBlkLen = 16;
+
+    const size_t BlkDataSize = MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+
+    const std::byte* QuantAPtr = QuantARowPtr;
+
+    float32x4_t acc[NCols]{};
+
+    for (size_t k_blk_idx = 0; k_blk_idx < BlockCountK; ++k_blk_idx) {
+        const float a_scale = Q8BlkScale(QuantAPtr);
+        const int8_t* QuantADataPtr = Q8BlkData(QuantAPtr);
+
+        // load B zero points
+        int8x16_t bzp[NCols];
+        UnrolledLoop<NCols>([&](size_t i) {
+            if constexpr (HasZeroPoint) {
+                bzp[i] = vdupq_n_s8(Get2BitZeroPoint(QuantBZeroPointColPtr + i * StrideQuantBZeroPoint, k_blk_idx));
+            } else {
+                bzp[i] = vdupq_n_s8(2);
+            }
+        });
+
+        const std::byte* QuantBDataPtr = QuantBDataColPtr + k_blk_idx * BlkDataSize;
+
+        int32x4_t dot[NCols]{};
+
+        for (size_t kk = 0; kk < BlkLen; kk += SubBlkLen) {
+            // load A
+            const int8x16_t av = vld1q_s8(QuantADataPtr + kk);
+
+            UnrolledLoop<NCols>([&](size_t i) {
+                // load B and subtract B zero point
+                const int8x16_t bv = vsubq_s8(
+                    vreinterpretq_s8_u8(Unpack16x2BitValues(QuantBDataPtr + i * StrideQuantBData + kk / 4)), bzp[i]
+                );
+
+                // quantized dot product
+                dot[i] = vdotq_s32(dot[i], av, bv);
+            });
+        }
+
+        // multiply by combined scale and update accumulator
+        UnrolledLoop<NCols>([&](size_t i) {
+            const float scale = a_scale * QuantBScaleColPtr[i * StrideQuantBScale + k_blk_idx];
+            acc[i] = vfmaq_n_f32(acc[i], vcvtq_f32_s32(dot[i]), scale);
+        });
+
+        QuantAPtr += Q8BlkSize(BlkLen);
+    }
+
+    UnrolledLoop<NCols>([&](size_t i) {
+        SumPtr[i] = vaddvq_f32(acc[i]);
+        if (BiasPtr != nullptr) {
+            SumPtr[i] += BiasPtr[i];
+        }
+    });
+}
+
+template <bool HasZeroPoint>
+void
+SQ2BitGemmKernel_CompInt8_Impl(
+    size_t BlkLen,
+    const std::byte* QuantA,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t BlockCountK,
+    size_t ldc,
+    const float* Bias
+)
+{
+    constexpr size_t BlkBitWidth = 2;
+    constexpr size_t NCols = 4;
+
+    const size_t StrideQuantA = BlockCountK * Q8BlkSize(BlkLen);
+
+    const size_t StrideQuantBData = BlockCountK * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t StrideQuantBScale = BlockCountK;
+    const size_t StrideQuantBZeroPoint = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockCountK);
+
+    const std::byte* QuantARowPtr = QuantA;
+    float* SumRowPtr = C;
+
+    for (size_t m = 0; m < CountM; ++m) {
+        const std::byte* QuantBDataColPtr = QuantBData;
+        const float* QuantBScaleColPtr = QuantBScale;
+        const std::byte* QuantBZeroPointColPtr = QuantBZeroPoint;
+        const float* BiasPtr = Bias;
+        float* SumPtr = SumRowPtr;
+
+        size_t n_remaining = CountN;
+        while (n_remaining > NCols - 1) {
+            SQ2BitGemm_CompInt8_Compute1xNCols<NCols, HasZeroPoint>(
+                BlkLen,
+                QuantARowPtr, QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, BiasPtr, SumPtr,
+                BlockCountK, StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint
+            );
+
+            AdvanceColPtrs<NCols, HasZeroPoint>(
+                StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint,
+                QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, BiasPtr, SumPtr
+            );
+
+            n_remaining -= NCols;
+        }
+
+        while (n_remaining > 0) {
+            SQ2BitGemm_CompInt8_Compute1xNCols<1, HasZeroPoint>(
+                BlkLen,
+                QuantARowPtr, QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, BiasPtr, SumPtr,
+                BlockCountK, StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint
+            );
+
+            AdvanceColPtrs<1, HasZeroPoint>(
+                StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint,
+                QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, BiasPtr, SumPtr
+            );
+
+            n_remaining -= 1;
+        }
+
+        AdvanceRowPtrs<1>(StrideQuantA, ldc, QuantARowPtr, SumRowPtr);
+    }
+}
+
+}  // namespace
+
+size_t
+SQ2BitGemmKernel_CompInt8(
+    size_t BlkLen,
+    const std::byte* QuantA,
+    const float* /*QuantAScale*/,
+    const float* /*ABlockSum*/,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t /*CountK*/,
+    size_t BlockCountK,
+    size_t ldc,
+    const float* Bias
+)
+{
+    assert(BlkLen >= 16 && BlkLen % 16 == 0);
+
+    if (QuantBZeroPoint != nullptr) {
+        SQ2BitGemmKernel_CompInt8_Impl<true>(
+            BlkLen, QuantA, QuantBData, QuantBScale, QuantBZeroPoint, C, CountM, CountN, BlockCountK, ldc, Bias
+        );
+    } else {
+        SQ2BitGemmKernel_CompInt8_Impl<false>(
+            BlkLen, QuantA, QuantBData, QuantBScale, QuantBZeroPoint, C, CountM, CountN, BlockCountK, ldc, Bias
+        );
+    }
+
+    return CountM;
+}
+
 #ifdef USE_KLEIDIAI
 void
 SQ4BitGemmKernel_Packed_CompInt8(
@@ -0,0 +1,263 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_chain_fusion.h"
+
+#include <algorithm>
+#include <array>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+
+namespace {
+
+struct ElementwiseOp {
+  std::string_view op_type;
+  std::vector<ONNX_NAMESPACE::OperatorSetVersion> versions;
+  size_t input_count;
+};
+
+// The ONNX operators that the FusedElementwise kernel can execute.
+const std::vector<ElementwiseOp>& SupportedOps() {
+  static const std::vector<ElementwiseOp> ops = {
+      {"Add", {7, 13, 14}, 2},
+      {"Sub", {7, 13, 14}, 2},
+      {"Mul", {7, 13, 14}, 2},
+      {"Div", {7, 13, 14}, 2},
+      {"Max", {8, 12, 13}, 2},
+      {"Min", {8, 12, 13}, 2},
+      {"Relu", {6, 13, 14}, 1},
+      {"Sigmoid", {6, 13}, 1},
+      {"Tanh", {6, 13}, 1},
+      {"Exp", {6, 13}, 1},
+      {"Log", {6, 13}, 1},
+      {"Erf", {9, 13}, 1},
+      {"Neg", {6, 13}, 1},
+      {"Abs", {6, 13}, 1},
+      {"Sqrt", {6, 13}, 1},
+      {"Reciprocal", {6, 13}, 1},
+  };
+  return ops;
+}
+
+bool IsFloatTensor(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() == TensorProto_DataType_FLOAT;
+}
+
+bool DimsAreEqual(const TensorShapeProto_Dimension& a, const TensorShapeProto_Dimension& b) {
+  if (utils::HasDimValue(a) && utils::HasDimValue(b)) {
+    return a.dim_value() == b.dim_value();
+  }
+  return utils::HasDimParam(a) && utils::HasDimParam(b) && a.dim_param() == b.dim_param();
+}
+
+bool ShapesAreEqual(const TensorShapeProto& a, const TensorShapeProto& b) {
+  if (a.dim_size() != b.dim_size()) {
+    return false;
+  }
+  for (int i = 0; i < a.dim_size(); ++i) {
+    if (!DimsAreEqual(a.dim(i), b.dim(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns true if the input repeats over the output: after removing its leading ones, the dimensions of the input
+// match the trailing dimensions of the output. This covers inputs with the shape of the output and scalars.
+bool RepeatsOver(const TensorShapeProto& input, const TensorShapeProto& output) {
+  if (input.dim_size() > output.dim_size()) {
+    return false;
+  }
+
+  int first = 0;
+  while (first < input.dim_size() && utils::HasDimValue(input.dim(first)) && input.dim(first).dim_value() == 1) {
+    ++first;
+  }
+
+  const int offset = output.dim_size() - input.dim_size();
+  for (int i = first; i < input.dim_size(); ++i) {
+    if (!DimsAreEqual(input.dim(i), output.dim(offset + i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsFusibleNode(const Node& node, const InlinedHashSet<std::string_view>& compatible_providers) {
+  if (!graph_utils::IsSupportedProvider(node, compatible_providers)) {
+    return false;
+  }
+
+  const auto& ops = SupportedOps();
+  auto op = std::find_if(ops.begin(), ops.end(), [&node](const ElementwiseOp& candidate) {
+    return graph_utils::IsSupportedOptypeVersionAndDomain(node, candidate.op_type, candidate.versions);
+  });
+  if (op == ops.end() || node.InputDefs().size() != op->input_count || node.OutputDefs().size() != 1) {
+    return false;
+  }
+
+  const NodeArg& output = *node.OutputDefs()[0];
+  const auto* output_shape = output.Shape();
+  if (output_shape == nullptr || !IsFloatTensor(output)) {
+    return false;
+  }
+
+  for (const NodeArg* input : node.InputDefs()) {
+    if (!input->Exists() || !IsFloatTensor(*input) || input->Shape() == nullptr ||
+        !RepeatsOver(*input->Shape(), *output_shape)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+/**
+Fuse chains of elementwise operators into a FusedElementwise node.
+
+Starting from the last node of a chain, producers are added to the group while all of their consumers are already in
+the group, they produce a tensor of the final output shape, and they do not produce a graph output. Only the output
+of the last node is visible outside of the group, so the group can be replaced by a single node.
+*/
+Status ElementwiseChainFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                         const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  InlinedHashMap<NodeIndex, size_t> topology_position;
+  for (size_t i = 0; i < node_topology_list.size(); ++i) {
+    topology_position[node_topology_list[i]] = i;
+  }
+
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    ORT_RETURN_IF_ERROR(Recurse(*p_node, modified, graph_level, logger));
+  }
+
+  // Visit the nodes from the end of the graph so that each chain is grown from its last node.
+  for (auto it = node_topology_list.rbegin(); it != node_topology_list.rend(); ++it) {
+    auto* p_sink = graph.GetNode(*it);
+    if (!p_sink || !IsFusibleNode(*p_sink, GetCompatibleExecutionProviders())) continue;
+
+    Node& sink = *p_sink;
+    const auto& sink_shape = *sink.OutputDefs()[0]->Shape();
+
+    InlinedVector<Node*> group{&sink};
+    InlinedHashSet<NodeIndex> in_group{sink.Index()};
+
+    bool grown = true;
+    while (grown) {
+      grown = false;
+      for (size_t g = 0; g < group.size(); ++g) {
+        for (auto input_edge = group[g]->InputEdgesBegin(); input_edge != group[g]->InputEdgesEnd(); ++input_edge) {
+          const Node& producer = input_edge->GetNode();
+          if (in_group.count(producer.Index()) != 0 ||
+              producer.GetExecutionProviderType() != sink.GetExecutionProviderType() ||
+              !IsFusibleNode(producer, GetCompatibleExecutionProviders()) ||
+              graph.NodeProducesGraphOutput(producer) ||
+              !ShapesAreEqual(*producer.OutputDefs()[0]->Shape(), sink_shape)) {
+            continue;
+          }
+
+          bool consumed_by_group = true;
+          for (auto output_edge = producer.OutputEdgesBegin(); output_edge != producer.OutputEdgesEnd();
+               ++output_edge) {
+            if (in_group.count(output_edge->GetNode().Index()) == 0) {
+              consumed_by_group = false;
+              break;
+            }
+          }
+          if (!consumed_by_group) continue;
+
+          group.push_back(graph.GetNode(producer.Index()));
+          in_group.insert(producer.Index());
+          grown = true;
+        }
+      }
+    }
+
+    if (group.size() < 2) continue;
+
+    std::sort(group.begin(), group.end(), [&topology_position](const Node* a, const Node* b) {
+      return topology_position[a->Index()] < topology_position[b->Index()];
+    });
+
+    // The values produced inside the group are the outputs of the group nodes. Every other value read by the group
+    // becomes an input of the fused node, in the order it is first read.
+    InlinedHashSet<std::string_view> produced;
+    for (const Node* node : group) {
+      produced.insert(node->OutputDefs()[0]->Name());
+    }
+
+    InlinedVector<NodeArg*> fused_inputs;
+    InlinedHashMap<std::string_view, int64_t> registers;
+    for (Node* node : group) {
+      for (NodeArg* input : node->MutableInputDefs()) {
+        if (produced.count(input->Name()) == 0 && registers.count(input->Name()) == 0) {
+          registers[input->Name()] = static_cast<int64_t>(fused_inputs.size());
+          fused_inputs.push_back(input);
+        }
+      }
+    }
+
+    // Each operator writes a new register that follows the input registers. Unary operators have no second operand.
+    std::vector<std::string> operators;
+    std::vector<int64_t> operands;
+    for (const Node* node : group) {
+      const auto& input_defs = node->InputDefs();
+      operators.push_back(node->OpType());
+      operands.push_back(registers[input_defs[0]->Name()]);
+      operands.push_back(input_defs.size() > 1 ? registers[input_defs[1]->Name()] : -1);
+      registers[node->OutputDefs()[0]->Name()] = static_cast<int64_t>(fused_inputs.size() + operators.size() - 1);
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName(sink.Name() + "/ElementwiseChainFusion/"),
+                                     "FusedElementwise", "fused elementwise chain", fused_inputs,
+                                     std::array{sink.MutableOutputDefs()[0]}, nullptr, kMSDomain);
+    fused_node.AddAttribute("operators", gsl::span<const std::string>(operators));
+    fused_node.AddAttribute("operands", gsl::span<const int64_t>(operands));
+    fused_node.SetExecutionProviderType(sink.GetExecutionProviderType());
+
+    // Connect the producers of the fused inputs to the fused node.
+    InlinedHashSet<int64_t> connected_inputs;
+    for (const Node* node : group) {
+      for (auto input_edge = node->InputEdgesBegin(); input_edge != node->InputEdgesEnd(); ++input_edge) {
+        const Node& producer = input_edge->GetNode();
+        if (in_group.count(producer.Index()) != 0) continue;
+
+        const int64_t fused_input = registers[node->InputDefs()[input_edge->GetDstArgIndex()]->Name()];
+        if (connected_inputs.insert(fused_input).second) {
+          graph.AddEdge(producer.Index(), fused_node.Index(), input_edge->GetSrcArgIndex(),
+                        static_cast<int>(fused_input));
+        }
+      }
+    }
+
+    // Move the consumers of the sink to the fused node and remove the group.
+    const auto output_edges = graph_utils::GraphEdge::GetNodeOutputEdges(sink);
+    for (const auto& output_edge : output_edges) {
+      graph.AddEdge(fused_node.Index(), output_edge.dst_node, output_edge.src_arg_index, output_edge.dst_arg_index);
+    }
+
+    for (Node* node : group) {
+      graph_utils::RemoveNodeOutputEdges(graph, *node);
+      graph.RemoveNode(node->Index());
+    }
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
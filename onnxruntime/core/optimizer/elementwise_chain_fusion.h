@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+ * @brief Fuse a chain of elementwise operators that produces a single output into one FusedElementwise node.
+ *
+ * The fused node carries the chain as a small register program that is executed tile by tile, so the intermediate
+ * tensors of the chain are never written to memory. Every input of the chain must either have the shape of the
+ * output or repeat over it, e.g. a bias that matches the trailing dimensions of the output.
+ */
+class ElementwiseChainFusion : public GraphTransformer {
+ public:
+  ElementwiseChainFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ElementwiseChainFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -36,6 +36,7 @@
 #include "core/optimizer/double_qdq_pairs_remover.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_chain_fusion.h"
 #include "core/optimizer/embed_layer_norm_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
@@ -442,6 +443,13 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       // PR #6351 implemented similar fusion-pattern for CUDA only, and can only fuse conv-add-relu,
       // while we can fuse more activation.
       transformers.emplace_back(std::make_unique<ConvAddActivationFusion>(cpu_ep));
+
+      // The elementwise chain fusion runs last so that the fusions above, which target specific patterns with
+      // dedicated kernels, take precedence over the generic FusedElementwise kernel.
+      if (session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableElementwiseChainFusion, "0") ==
+          "1") {
+        transformers.emplace_back(std::make_unique<ElementwiseChainFusion>(cpu_ep));
+      }
 #else
       ORT_UNUSED_PARAMETER(logger);
 #endif
@@ -90,6 +90,20 @@ struct ThreadOptions {
   void* custom_thread_creation_options = nullptr;
   OrtCustomJoinThreadFn custom_join_thread_fn = nullptr;
   int dynamic_block_base_ = 0;
+
+  // Enable NUMA-aware work distribution.  Workers are grouped by the NUMA node of their affinity, steal from
+  // siblings on the same node first, and parallel sections keep their loops on a single node where possible.
+  // Requires thread affinities to be set; the pool falls back to the default behavior on single-node systems.
+  bool numa_aware = false;
+
+  // NUMA node of each worker thread created by the pool.  If empty and numa_aware is set, the thread pool
+  // populates it from `affinities` via Env::GetNumaNodeOfLogicalProcessor.  A value of -1 means unknown.
+  std::vector<int> numa_nodes;
+
+  // If positive, workers use an adaptive spin-then-park policy instead of a fixed spin count.  Each worker
+  // measures its idle gaps and spins only for as long as it expects work to arrive, up to this many
+  // microseconds.  Only takes effect if spinning is allowed.
+  int adaptive_spin_target_us = 0;
 };
 
 std::ostream& operator<<(std::ostream& os, const LogicalProcessors&);
@@ -148,6 +162,13 @@ class Env {
 
   virtual int GetL2CacheSize() const = 0;
 
+  /// <summary>
+  /// Returns the NUMA node that a logical processor belongs to.
+  /// </summary>
+  /// <param name="logical_processor_id">Logical processor id, starting from 0.</param>
+  /// <returns>The NUMA node id, or -1 if it cannot be determined.</returns>
+  virtual int GetNumaNodeOfLogicalProcessor(int /*logical_processor_id*/) const { return -1; }
+
   /// \brief Returns the number of micro-seconds since the Unix epoch.
   virtual uint64_t NowMicros() const {
     return env_time_->NowMicros();
@@ -17,6 +17,7 @@ limitations under the License.
 #include "core/platform/env.h"
 
 #include <assert.h>
+#include <dirent.h>
 #include <dlfcn.h>
 #include <fcntl.h>
 #include <ftw.h>
@@ -31,6 +32,7 @@ limitations under the License.
 #endif
 #include <unistd.h>
 
+#include <algorithm>
 #include <iostream>
 #include <optional>
 #include <thread>
@@ -315,6 +317,31 @@ class PosixEnv : public Env {
 #endif
   }
 
+  int GetNumaNodeOfLogicalProcessor(int logical_processor_id) const override {
+#if defined(__linux__) && !defined(__ANDROID__)
+    // The sysfs directory of each cpu holds a "node<N>" link to the NUMA node that it belongs to.
+    const std::string cpu_dir = "/sys/devices/system/cpu/cpu" + std::to_string(logical_processor_id);
+    DIR* dir = opendir(cpu_dir.c_str());
+    if (dir == nullptr) {
+      return -1;
+    }
+    int node = -1;
+    while (const dirent* entry = readdir(dir)) {
+      const char* name = entry->d_name;
+      if (strncmp(name, "node", 4) == 0 && name[4] != '\0' &&
+          std::all_of(name + 4, name + strlen(name), [](char c) { return c >= '0' && c <= '9'; })) {
+        node = atoi(name + 4);
+        break;
+      }
+    }
+    closedir(dir);
+    return node;
+#else
+    ORT_UNUSED_PARAMETER(logical_processor_id);
+    return -1;
+#endif
+  }
+
   void SleepForMicroseconds(int64_t micros) const override {
     while (micros > 0) {
       timespec sleep_time;
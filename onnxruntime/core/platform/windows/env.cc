@@ -306,6 +306,21 @@ WindowsEnv& WindowsEnv::Instance() {
   return default_env;
 }
 
+int WindowsEnv::GetNumaNodeOfLogicalProcessor(int logical_processor_id) const {
+  auto processor_info = GetProcessorAffinityMask(logical_processor_id);
+  if (processor_info.group_id < 0) {
+    return -1;
+  }
+  PROCESSOR_NUMBER processor_number = {};
+  processor_number.Group = static_cast<WORD>(processor_info.group_id);
+  processor_number.Number = static_cast<BYTE>(processor_info.local_processor_id);
+  USHORT node_number = 0;
+  if (!GetNumaProcessorNodeEx(&processor_number, &node_number) || node_number == MAXUSHORT) {
+    return -1;
+  }
+  return static_cast<int>(node_number);
+}
+
 PIDType WindowsEnv::GetSelfPid() const {
   return GetCurrentProcessId();
 }
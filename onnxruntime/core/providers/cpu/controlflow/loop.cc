@@ -21,6 +21,7 @@
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/framework/session_options.h"
 #include "core/framework/TensorSeq.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/utils.h"
 
 #include <gsl/gsl>
@@ -515,6 +516,10 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
   auto& iter_num_value = *iter_num_mlvalue_.GetMutable<Tensor>()->MutableData<int64_t>();
 
   while (iter_num_value < max_trip_count_ && *condition_mlvalue_.GetMutable<Tensor>()->MutableData<bool>()) {
+    // stop between iterations if the Run was terminated or its deadline has passed
+    ORT_RETURN_IF(context_.GetTerminateFlag(), "Exiting due to terminate flag being set to true.");
+    ORT_RETURN_IF(concurrency::ThreadPool::IsCancelled(), "Exiting because the deadline of the Run has passed.");
+
     if (iter_num_value != 0) {
       SaveOutputsAndUpdateFeeds(fetches, feeds);
       fetches.clear();
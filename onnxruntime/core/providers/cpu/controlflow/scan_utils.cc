@@ -19,6 +19,7 @@
 #include "core/framework/utils.h"
 #include "core/providers/cpu/controlflow/utils.h"
 #include "core/framework/session_options.h"
+#include "core/platform/threadpool.h"
 
 #ifdef _MSC_VER
 #pragma warning(pop)
@@ -210,6 +211,10 @@ Status IterateSequence(OpKernelContextInternal& context, const SessionState& ses
 
   int64_t seq_no = 0;
   for (; seq_no < seq_length; ++seq_no) {
+    // stop between iterations if the Run was terminated or its deadline has passed
+    ORT_RETURN_IF(context.GetTerminateFlag(), "Exiting due to terminate flag being set to true.");
+    ORT_RETURN_IF(concurrency::ThreadPool::IsCancelled(), "Exiting because the deadline of the Run has passed.");
+
     for (int input = 0; input < num_variadic_inputs; ++input) {
       if (input < num_loop_state_variables) {
         // add loop state variable input
@@ -74,6 +74,13 @@ void Exp<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
   float* output_ptr = output + first;
   MlasComputeExp(input + first, output_ptr, static_cast<size_t>(len));
 }
+
+template <>
+void Log<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
+  ptrdiff_t len = last - first;
+  float* output_ptr = output + first;
+  MlasComputeLog(input + first, output_ptr, static_cast<size_t>(len));
+}
 }  // namespace functors
 
 #define REG_ELEMENTWISE_TYPED_KERNEL(OP_TYPE, VERSION, TYPE, KERNEL_CLASS)         \
@@ -112,6 +119,31 @@ void Exp<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
           .TypeConstraint("T1", DataTypeImpl::GetTensorType<bool>()),                                           \
       KERNEL_CLASS<TYPE>);
 
+// The arithmetic and unary math kernels read each input element before writing the output element at the same
+// offset, so the output may reuse the buffer of an input of the same size (i.e. one that is not broadcast).
+// The allocation planner only does so if the input is not used after the node. Unary operators have no input 1.
+#define REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(OP_TYPE, VERSION, TYPE, KERNEL_CLASS) \
+  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                  \
+      OP_TYPE,                                                                     \
+      VERSION,                                                                     \
+      TYPE,                                                                        \
+      KernelDefBuilder()                                                           \
+          .MayInplace(0, 0)                                                        \
+          .MayInplace(1, 0)                                                        \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()),               \
+      KERNEL_CLASS<TYPE>);
+
+#define REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(OP_TYPE, VERSION_FROM, VERSION_TO, TYPE, KERNEL_CLASS) \
+  ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(                                                                   \
+      OP_TYPE,                                                                                                \
+      VERSION_FROM, VERSION_TO,                                                                               \
+      TYPE,                                                                                                   \
+      KernelDefBuilder()                                                                                      \
+          .MayInplace(0, 0)                                                                                   \
+          .MayInplace(1, 0)                                                                                   \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()),                                          \
+      KERNEL_CLASS<TYPE>);
+
 #define REG_ELEMENTWISE_KERNEL_NONT(OP_TYPE, VERSION, KERNEL_CLASS, CONSTRAINTS) \
   ONNX_CPU_OPERATOR_KERNEL(                                                      \
       OP_TYPE,                                                                   \
@@ -153,152 +185,152 @@ void Exp<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
           .TypeConstraint("T1", T2_CONSTRAINTS),                                                 \
       KERNEL_CLASS);
 
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, float, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, double, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, int32_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, int64_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, uint32_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, uint64_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, float, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, double, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, int32_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, int64_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, uint32_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, uint64_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, float, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, double, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, int8_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, int16_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, int32_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, int64_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, uint8_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, uint16_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, uint32_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, uint64_t, Add);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, float, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, double, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int32_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int64_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, uint32_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, uint64_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, float, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, double, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, int32_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, int64_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, uint32_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, uint64_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, float, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, double, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, int8_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, int16_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, int32_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, int64_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, uint8_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, uint16_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, uint32_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, uint64_t, Sub);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, float, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, double, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int32_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int64_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, uint32_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, uint64_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, float, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, double, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, int32_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, int64_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, uint32_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, uint64_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, float, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, double, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, int8_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, int16_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, int32_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, int64_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, uint8_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, uint16_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, uint32_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, uint64_t, Mul);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, float, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, double, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, int32_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, int64_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, uint32_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, uint64_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, float, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, double, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, int32_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, int64_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, uint32_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, uint64_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, float, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, double, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, int8_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, int16_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, int32_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, int64_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, uint8_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, uint16_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, uint32_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, uint64_t, Div);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, float, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, double, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int8_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int16_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int32_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int64_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint8_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint16_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint32_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint64_t, Abs);
-
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, float, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, double, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, int8_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, int16_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, int32_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, int64_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, uint8_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, uint16_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, uint32_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, uint64_t, Abs);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, float, Neg);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, double, Neg);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int8_t, Neg);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int16_t, Neg);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int32_t, Neg);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int64_t, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 13, float, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 13, double, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 13, int8_t, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 13, int16_t, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 13, int32_t, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 13, int64_t, Neg);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Floor, 6, 12, float, Floor);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Floor, 6, 12, double, Floor);
-REG_ELEMENTWISE_TYPED_KERNEL(Floor, 13, float, Floor);
-REG_ELEMENTWISE_TYPED_KERNEL(Floor, 13, double, Floor);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Ceil, 6, 12, float, Ceil);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Ceil, 6, 12, double, Ceil);
-REG_ELEMENTWISE_TYPED_KERNEL(Ceil, 13, float, Ceil);
-REG_ELEMENTWISE_TYPED_KERNEL(Ceil, 13, double, Ceil);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Reciprocal, 6, 12, float, Reciprocal);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Reciprocal, 6, 12, double, Reciprocal);
-REG_ELEMENTWISE_TYPED_KERNEL(Reciprocal, 13, float, Reciprocal);
-REG_ELEMENTWISE_TYPED_KERNEL(Reciprocal, 13, double, Reciprocal);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sqrt, 6, 12, float, Sqrt);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sqrt, 6, 12, double, Sqrt);
-REG_ELEMENTWISE_TYPED_KERNEL(Sqrt, 13, float, Sqrt);
-REG_ELEMENTWISE_TYPED_KERNEL(Sqrt, 13, double, Sqrt);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 7, 12, float, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 7, 12, double, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 7, 12, int32_t, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 7, 12, int64_t, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 7, 12, uint32_t, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 7, 12, uint64_t, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 13, 13, float, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 13, 13, double, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 13, 13, int32_t, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 13, 13, int64_t, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 13, 13, uint32_t, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 13, 13, uint64_t, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, float, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, double, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, int8_t, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, int16_t, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, int32_t, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, int64_t, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, uint8_t, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, uint16_t, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, uint32_t, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, uint64_t, Add);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, float, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, double, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int32_t, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int64_t, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, uint32_t, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, uint64_t, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, float, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, double, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, int32_t, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, int64_t, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, uint32_t, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, uint64_t, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, float, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, double, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, int8_t, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, int16_t, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, int32_t, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, int64_t, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, uint8_t, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, uint16_t, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, uint32_t, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, uint64_t, Sub);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, float, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, double, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int32_t, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int64_t, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, uint32_t, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, uint64_t, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, float, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, double, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, int32_t, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, int64_t, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, uint32_t, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, uint64_t, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, float, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, double, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, int8_t, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, int16_t, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, int32_t, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, int64_t, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, uint8_t, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, uint16_t, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, uint32_t, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, uint64_t, Mul);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 7, 12, float, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 7, 12, double, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 7, 12, int32_t, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 7, 12, int64_t, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 7, 12, uint32_t, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 7, 12, uint64_t, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 13, 13, float, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 13, 13, double, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 13, 13, int32_t, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 13, 13, int64_t, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 13, 13, uint32_t, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 13, 13, uint64_t, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, float, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, double, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, int8_t, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, int16_t, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, int32_t, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, int64_t, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, uint8_t, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, uint16_t, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, uint32_t, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, uint64_t, Div);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, float, Abs);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, double, Abs);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int8_t, Abs);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int16_t, Abs);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int32_t, Abs);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int64_t, Abs);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint8_t, Abs);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint16_t, Abs);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint32_t, Abs);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint64_t, Abs);
+
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 13, float, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 13, double, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 13, int8_t, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 13, int16_t, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 13, int32_t, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 13, int64_t, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 13, uint8_t, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 13, uint16_t, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 13, uint32_t, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 13, uint64_t, Abs);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, float, Neg);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, double, Neg);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int8_t, Neg);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int16_t, Neg);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int32_t, Neg);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int64_t, Neg);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Neg, 13, float, Neg);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Neg, 13, double, Neg);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Neg, 13, int8_t, Neg);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Neg, 13, int16_t, Neg);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Neg, 13, int32_t, Neg);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Neg, 13, int64_t, Neg);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Floor, 6, 12, float, Floor);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Floor, 6, 12, double, Floor);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Floor, 13, float, Floor);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Floor, 13, double, Floor);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Ceil, 6, 12, float, Ceil);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Ceil, 6, 12, double, Ceil);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Ceil, 13, float, Ceil);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Ceil, 13, double, Ceil);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Reciprocal, 6, 12, float, Reciprocal);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Reciprocal, 6, 12, double, Reciprocal);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Reciprocal, 13, float, Reciprocal);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Reciprocal, 13, double, Reciprocal);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sqrt, 6, 12, float, Sqrt);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sqrt, 6, 12, double, Sqrt);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sqrt, 13, float, Sqrt);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sqrt, 13, double, Sqrt);
 
 REG_ELEMENTWISE_VERSIONED_KERNEL_NONT(Pow, 7, 11, Pow,
                                       BuildKernelDefConstraintsFromTypeList<EnabledPow7Types>());
@@ -315,15 +347,15 @@ REG_ELEMENTWISE_KERNEL_NONT_2(Pow, 15, Pow,
                               BuildKernelDefConstraintsFromTypeList<EnabledPow12BaseTypes>(),
                               BuildKernelDefConstraintsFromTypeList<EnabledPow12ExpTypes>());
 
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Exp, 6, 12, float, Exp);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Exp, 6, 12, double, Exp);
-REG_ELEMENTWISE_TYPED_KERNEL(Exp, 13, float, Exp);
-REG_ELEMENTWISE_TYPED_KERNEL(Exp, 13, double, Exp);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Exp, 6, 12, float, Exp);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Exp, 6, 12, double, Exp);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Exp, 13, float, Exp);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Exp, 13, double, Exp);
 
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Log, 6, 12, float, Log);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Log, 6, 12, double, Log);
-REG_ELEMENTWISE_TYPED_KERNEL(Log, 13, float, Log);
-REG_ELEMENTWISE_TYPED_KERNEL(Log, 13, double, Log);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Log, 6, 12, float, Log);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Log, 6, 12, double, Log);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Log, 13, float, Log);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Log, 13, double, Log);
 
 REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sum, 6, 7, float, Sum_6);
 REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sum, 6, 7, double, Sum_6);
@@ -673,6 +705,8 @@ void PowImpl(OpKernelContext& context) {
                          [](T x) {
                            return static_cast<T>(x * x * x);
                          });
+        } else if constexpr (std::is_same_v<T, float> && std::is_same_v<E, float>) {
+          MlasComputePow(X.data(), Y, output.data(), X.size());
         } else {
           std::transform(X.begin(), X.end(), output.begin(),
                          [Y](T x) {
@@ -1431,6 +1465,19 @@ Status BitwiseXor<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+// Applies an MLAS elementwise float routine to X, splitting the work across the operator thread pool.
+static void ComputeUnaryWithMlas(OpKernelContext* context, const Tensor& X, Tensor& Y,
+                                 void(MLASCALL* routine)(const float*, float*, size_t)) {
+  const float* input = X.Data<float>();
+  float* output = Y.MutableData<float>();
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), narrow<std::ptrdiff_t>(X.Shape().Size()),
+      TensorOpCost{static_cast<double>(sizeof(float)), static_cast<double>(sizeof(float)), 20.0},
+      [input, output, routine](std::ptrdiff_t first, std::ptrdiff_t last) {
+        routine(input + first, output + first, static_cast<size_t>(last - first));
+      });
+}
+
 template <typename T>
 class Sin final : public OpKernel {
  public:
@@ -1440,7 +1487,11 @@ class Sin final : public OpKernel {
   Status Compute(OpKernelContext* context) const override {
     auto& X = *context->Input<Tensor>(0);
     auto& Y = *context->Output(0, X.Shape());
-    MakeEigenArrayMap<T>(Y) = MakeEigenArrayMap<T>(X).sin();
+    if constexpr (std::is_same_v<T, float>) {
+      ComputeUnaryWithMlas(context, X, Y, MlasComputeSin<float>);
+    } else {
+      MakeEigenArrayMap<T>(Y) = MakeEigenArrayMap<T>(X).sin();
+    }
     return Status::OK();
   }
 };
@@ -1482,7 +1533,7 @@ class Cos final : public OpKernel {
   Status Compute(OpKernelContext* context) const override {
     auto& X = *context->Input<Tensor>(0);
     auto& Y = *context->Output(0, X.Shape());
-    MakeEigenArrayMap<float>(Y) = MakeEigenArrayMap<float>(X).cos();
+    ComputeUnaryWithMlas(context, X, Y, MlasComputeCos<float>);
     return Status::OK();
   }
 };
@@ -19,6 +19,7 @@
 
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
+#include "core/framework/tensorprotoutils.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -153,20 +154,151 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+Status Conv<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                            /*out*/ bool& is_packed,
+                            /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // Only pack the filter of a 2D 3x3 stride 1 convolution, which may use the
+  // MLAS Winograd algorithm.
+  if (input_idx != 1) {
+    return Status::OK();
+  }
+
+  const auto& shape = tensor.Shape();
+  if (shape.NumDimensions() != 4 || shape[2] != 3 || shape[3] != 3) {
+    return Status::OK();
+  }
+
+  TensorShapeVector kernel_shape;
+  if (!conv_attrs_.ComputeKernelShape(shape, kernel_shape).IsOK() ||
+      kernel_shape.size() != 2 || kernel_shape[0] != 3 || kernel_shape[1] != 3) {
+    return Status::OK();
+  }
+
+  for (int64_t stride : conv_attrs_.strides) {
+    if (stride != 1) {
+      return Status::OK();
+    }
+  }
+
+  for (int64_t dilation : conv_attrs_.dilations) {
+    if (dilation != 1) {
+      return Status::OK();
+    }
+  }
+
+  const int64_t M = shape[0];
+  if (conv_attrs_.group <= 0 || M % conv_attrs_.group != 0) {
+    return Status::OK();
+  }
+
+  const size_t group_count = static_cast<size_t>(conv_attrs_.group);
+  const size_t input_channels = static_cast<size_t>(shape[1]);
+  const size_t filter_count = static_cast<size_t>(M) / group_count;
+
+  const size_t packed_W_size = MlasConvWinogradPackedFilterSize(group_count, input_channels, filter_count);
+  if (packed_W_size == 0) {
+    return Status::OK();
+  }
+
+  // Given a packed filter, the algorithm selected by MlasConvPrepare only depends on the spatial shape of the input.
+  // If it is not known, keep the filter and transform it the first time Compute uses the Winograd algorithm.
+  const auto* X_shape_proto = Node().InputDefs()[0]->Shape();
+  const TensorShape X_shape = X_shape_proto != nullptr ? utils::GetTensorShapeFromTensorShapeProto(*X_shape_proto)
+                                                       : TensorShape();
+  if (X_shape.NumDimensions() != 4 || X_shape[2] < 0 || X_shape[3] < 0) {
+    pack_W_on_first_use_alloc_ = alloc;
+    return Status::OK();
+  }
+
+  const size_t packed_W_data_size = SafeInt<size_t>(packed_W_size) * sizeof(float);
+  auto packed_W_buffer = IAllocator::MakeUniquePtr<void>(alloc, packed_W_data_size, true);
+  MlasConvWinogradPackFilter(group_count, input_channels, filter_count, tensor.Data<float>(),
+                             static_cast<float*>(packed_W_buffer.get()));
+
+  ConvPadVector pads(conv_attrs_.pads);
+  if (pads.empty()) {
+    pads.resize(kernel_shape.size() * 2, 0);
+  }
+  TensorShapeVector dilations(kernel_shape.size(), 1);
+  TensorShapeVector strides(kernel_shape.size(), 1);
+
+  TensorShapeVector Y_dims({std::max<int64_t>(X_shape[0], 1), M});
+  const TensorShape input_shape = X_shape.Slice(2);
+  if (!conv_attrs_.InferPadsAndOutputShape(input_shape, kernel_shape, strides, dilations, pads, Y_dims).IsOK()) {
+    return Status::OK();
+  }
+  const TensorShape output_shape = TensorShape(Y_dims).Slice(2);
+
+  MLAS_CONV_PARAMETERS Parameters;
+  size_t WorkingBufferSize;
+  MlasConvPrepare(&Parameters,
+                  kernel_shape.size(),
+                  narrow<size_t>(Y_dims[0]),
+                  group_count,
+                  input_channels,
+                  input_shape.GetDims().data(),
+                  kernel_shape.data(),
+                  dilations.data(),
+                  pads.data(),
+                  strides.data(),
+                  output_shape.GetDims().data(),
+                  filter_count,
+                  &activation_,
+                  &WorkingBufferSize,
+                  0.0f,
+                  nullptr,
+                  static_cast<const float*>(packed_W_buffer.get()));
+
+  // Keep the original filter if the input is too small for the Winograd algorithm.
+  if (Parameters.Algorithm != MlasConvAlgorithmWinograd) {
+    return Status::OK();
+  }
+
+  packed_W_buffer_ = std::move(packed_W_buffer);
+  W_shape_ = shape;
+
+  if (prepacked_weights != nullptr) {
+    prepacked_weights->buffers_.push_back(std::move(packed_W_buffer_));
+    prepacked_weights->buffer_sizes_.push_back(packed_W_data_size);
+  }
+
+  is_W_packed_ = true;
+  is_packed = true;
+  return Status::OK();
+}
+
+Status Conv<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                              int input_idx,
+                                              /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_W_buffer_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
 Status Conv<float>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const Tensor* X = context->Input<Tensor>(0);
-  const Tensor* W = context->Input<Tensor>(1);
+  const Tensor* W = is_W_packed_ ? nullptr : context->Input<Tensor>(1);
+  const auto& W_shape = W ? W->Shape() : W_shape_;
+  // The Winograd algorithm only reads the packed filter.
+  const float* Wdata = W ? W->Data<float>() : nullptr;
   const Tensor* B = num_inputs >= 3 ? context->Input<Tensor>(2) : nullptr;
   const Tensor* Sum = num_inputs >= 4 ? context->Input<Tensor>(3) : nullptr;
   const int64_t N = X->Shape()[0];
   const int64_t C = X->Shape()[1];
-  const int64_t M = W->Shape()[0];
-  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X, W));
+  const int64_t M = W_shape[0];
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X->Shape(), W_shape));
 
   // kernel_shape is an optional attribute and has to be inferred from W if not provided
   TensorShapeVector kernel_shape;
-  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W->Shape(), kernel_shape));
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W_shape, kernel_shape));
 
   ConvPadVector pads(conv_attrs_.pads);
   if (pads.empty()) {
@@ -214,6 +346,14 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
   concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
 
   if (kernel_rank >= 1 && kernel_rank <= 3) {
+    const float* packed_W = nullptr;
+    if (is_W_packed_) {
+      packed_W = static_cast<const float*>(packed_W_buffer_.get());
+    } else if (pack_W_on_first_use_alloc_ != nullptr) {
+      std::lock_guard<std::mutex> lock(packed_W_mutex_);
+      packed_W = static_cast<const float*>(packed_W_buffer_.get());
+    }
+
     MLAS_CONV_PARAMETERS Parameters;
     size_t WorkingBufferSize;
     MlasConvPrepare(&Parameters,
@@ -231,7 +371,28 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
                     &activation_,
                     &WorkingBufferSize,
                     Beta,
-                    thread_pool);
+                    thread_pool,
+                    packed_W);
+
+    ORT_RETURN_IF(is_W_packed_ && Parameters.Algorithm != MlasConvAlgorithmWinograd,
+                  "The Conv filter was packed for the Winograd algorithm, which is not used for input shape ",
+                  X->Shape());
+
+    if (Parameters.Algorithm == MlasConvAlgorithmWinograd && packed_W == nullptr &&
+        pack_W_on_first_use_alloc_ != nullptr) {
+      std::lock_guard<std::mutex> lock(packed_W_mutex_);
+      if (!packed_W_buffer_) {
+        const size_t group_count = narrow<size_t>(conv_attrs_.group);
+        const size_t input_channels = narrow<size_t>(C / conv_attrs_.group);
+        const size_t filter_count = narrow<size_t>(M / conv_attrs_.group);
+        const size_t packed_W_size = MlasConvWinogradPackedFilterSize(group_count, input_channels, filter_count);
+        packed_W_buffer_ = IAllocator::MakeUniquePtr<void>(pack_W_on_first_use_alloc_,
+                                                           SafeInt<size_t>(packed_W_size) * sizeof(float), true);
+        MlasConvWinogradPackFilter(group_count, input_channels, filter_count, Wdata,
+                                   static_cast<float*>(packed_W_buffer_.get()));
+      }
+      Parameters.u.Winograd.PackedFilter = static_cast<const float*>(packed_W_buffer_.get());
+    }
 
     auto* working_data = WorkingBufferSize > 0 ? alloc->Alloc(sizeof(float) * SafeInt<size_t>(WorkingBufferSize))
                                                : nullptr;
@@ -239,7 +400,7 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
 
     MlasConv(&Parameters,
              Xdata.data(),
-             W->Data<float>(),
+             Wdata,
              Bdata,
              static_cast<float*>(working_buffer.get()),
              Ydata.data(),
@@ -250,12 +411,12 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
     const int64_t kernel_size = TensorShape(kernel_shape).Size();
     const SafeInt<int64_t> X_offset = SafeInt<int64_t>(C) / conv_attrs_.group * input_image_size;
     const SafeInt<int64_t> Y_offset = SafeInt<int64_t>(Y->Shape().Size()) / Y->Shape()[0] / conv_attrs_.group;
-    const SafeInt<int64_t> W_offset = SafeInt<int64_t>(W->Shape().Size()) / conv_attrs_.group;
+    const SafeInt<int64_t> W_offset = SafeInt<int64_t>(W_shape.Size()) / conv_attrs_.group;
     const SafeInt<int64_t> kernel_dim = SafeInt<int64_t>(C) / conv_attrs_.group * kernel_size;
     const int64_t col_buffer_size = kernel_dim * output_image_size;
 
     auto col_data = IAllocator::MakeUniquePtr<float>(alloc, narrow<size_t>(col_buffer_size));
-    auto w_data = W->DataAsSpan<float>();
+    auto w_data = gsl::make_span(Wdata, narrow<size_t>(W_shape.Size()));
     for (int image_id = 0; image_id < N; ++image_id) {
       for (int group_id = 0; group_id < conv_attrs_.group; ++group_id) {
         math::Im2col<float, StorageOrder::NCHW>()(
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/nn/conv_attributes.h"
 #include "core/mlas/inc/mlas.h"
@@ -28,12 +30,30 @@ class Conv<float> : public OpKernel {
     activation_.ActivationKind = MlasIdentityActivation;
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
 
  protected:
   MLAS_ACTIVATION activation_;
 
   ConvAttributes conv_attrs_;
+
+ private:
+  // The filter transformed for the MLAS Winograd algorithm. If the static input shape
+  // shows that MlasConvPrepare selects the Winograd algorithm, PrePack replaces the
+  // filter with it. Otherwise the filter is kept and, if the input shape is dynamic,
+  // transformed the first time MlasConvPrepare selects the Winograd algorithm.
+  TensorShape W_shape_;
+  mutable IAllocatorUniquePtr<void> packed_W_buffer_;
+  bool is_W_packed_{false};
+  AllocatorPtr pack_W_on_first_use_alloc_;
+  mutable std::mutex packed_W_mutex_;
 };
 
 }  // namespace onnxruntime
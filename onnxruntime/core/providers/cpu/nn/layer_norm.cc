@@ -6,9 +6,11 @@
 #include "core/providers/common.h"
 
 namespace onnxruntime {
+// Each row of Y is computed from a copy of the row of X, so Y may reuse the buffer of X.
 #define REGISTER_ONNX_KERNEL_TYPED(T)                                                            \
   ONNX_CPU_OPERATOR_TYPED_KERNEL(LayerNormalization, 17, T,                                      \
                                  KernelDefBuilder()                                              \
+                                     .MayInplace(0, 0)                                           \
                                      .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())      \
                                      .TypeConstraint("U", DataTypeImpl::GetTensorType<float>()), \
                                  LayerNorm);
@@ -383,6 +383,33 @@ void ReduceAggregatorBase::FastReduceRKR(const Tensor&, const gsl::span<const in
   ValidateMustBeOverloaded();
 }
 
+void MlasReduceFastShape(MLAS_REDUCE_KIND kind, const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                         Tensor& output, concurrency::ThreadPool* tp, FastReduceKind fast_kind) {
+  size_t outer_count;
+  size_t reduce_count;
+  size_t inner_count;
+  switch (fast_kind) {
+    case FastReduceKind::kKR:
+      outer_count = onnxruntime::narrow<size_t>(fast_shape[0]);
+      reduce_count = onnxruntime::narrow<size_t>(fast_shape[1]);
+      inner_count = 1;
+      break;
+    case FastReduceKind::kRK:
+      outer_count = 1;
+      reduce_count = onnxruntime::narrow<size_t>(fast_shape[0]);
+      inner_count = onnxruntime::narrow<size_t>(fast_shape[1]);
+      break;
+    case FastReduceKind::kKRK:
+      outer_count = onnxruntime::narrow<size_t>(fast_shape[0]);
+      reduce_count = onnxruntime::narrow<size_t>(fast_shape[1]);
+      inner_count = onnxruntime::narrow<size_t>(fast_shape[2]);
+      break;
+    default:
+      ORT_THROW("Unexpected fast reduction kind for MLAS reduction.");
+  }
+  MlasReduce(kind, input.Data<float>(), output.MutableData<float>(), outer_count, reduce_count, inner_count, tp);
+}
+
 void NoTransposePrepareForReduce(const TensorShape& new_input_shape,
                                  gsl::span<const int64_t> reduced_axes,
                                  ResultsNoTransposePrepareForReduce& results) {
@@ -102,6 +102,11 @@ std::unordered_map<std::string, std::string> OrtAllocatorImplWrappingIAllocator:
     entries.insert_or_assign("NumArenaExtensions", std::to_string(stats.num_arena_extensions));
     entries.insert_or_assign("NumArenaShrinkages", std::to_string(stats.num_arena_shrinkages));
     entries.insert_or_assign("MaxAllocSize", std::to_string(stats.max_alloc_size));
+    entries.insert_or_assign("NumCacheHits", std::to_string(stats.num_cache_hits));
+    entries.insert_or_assign("NumCacheMisses", std::to_string(stats.num_cache_misses));
+    entries.insert_or_assign("HugePageBytes", std::to_string(stats.huge_page_bytes));
+    entries.insert_or_assign("NumHugePageFallbacks", std::to_string(stats.num_huge_page_fallbacks));
+    entries.insert_or_assign("TotalReleased", std::to_string(stats.total_released_bytes));
   }
   return entries;
 }
@@ -183,6 +188,16 @@ void IAllocatorImplWrappingOrtAllocator::GetStats(AllocatorStats* stats) {
         stats->num_arena_shrinkages = std::stoll(values[i]);
       } else if (strcmp(keys[i], "MaxAllocSize") == 0) {
         stats->max_alloc_size = std::stoll(values[i]);
+      } else if (strcmp(keys[i], "NumCacheHits") == 0) {
+        stats->num_cache_hits = std::stoll(values[i]);
+      } else if (strcmp(keys[i], "NumCacheMisses") == 0) {
+        stats->num_cache_misses = std::stoll(values[i]);
+      } else if (strcmp(keys[i], "HugePageBytes") == 0) {
+        stats->huge_page_bytes = std::stoll(values[i]);
+      } else if (strcmp(keys[i], "NumHugePageFallbacks") == 0) {
+        stats->num_huge_page_fallbacks = std::stoll(values[i]);
+      } else if (strcmp(keys[i], "TotalReleased") == 0) {
+        stats->total_released_bytes = std::stoll(values[i]);
       }
     }
   }
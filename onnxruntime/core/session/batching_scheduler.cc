@@ -0,0 +1,305 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/batching_scheduler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#include "core/common/narrow.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+namespace {
+
+bool IsCpuDevice(const OrtDevice& device) {
+  return device.Type() == OrtDevice::CPU && device.MemType() == OrtDevice::MemType::DEFAULT;
+}
+
+// Returns a tensor that views `count` rows of `batched` starting at row `offset`.
+// The view holds a reference to `batched`, which keeps the underlying buffer alive.
+OrtValue SliceBatchedValue(const OrtValue& batched, int64_t offset, int64_t count) {
+  const Tensor& tensor = batched.Get<Tensor>();
+  TensorShapeVector dims = tensor.Shape().AsShapeVector();
+  const size_t row_size_in_bytes = tensor.SizeInBytes() / narrow<size_t>(dims[0]);
+  dims[0] = count;
+
+  auto* data = static_cast<uint8_t*>(const_cast<void*>(tensor.DataRaw())) + narrow<size_t>(offset) * row_size_in_bytes;
+  auto view = std::make_unique<Tensor>(tensor.DataType(), TensorShape(dims), data, tensor.Location());
+
+  OrtValue value;
+  value.Init(view.release(), DataTypeImpl::GetType<Tensor>(),
+             [batched](void* p) { delete static_cast<Tensor*>(p); });
+  return value;
+}
+
+}  // namespace
+
+BatchingScheduler::BatchingScheduler(int64_t max_batch_size, std::chrono::microseconds timeout,
+                                     InlinedHashSet<std::string> batched_inputs,
+                                     InlinedHashSet<std::string> batched_outputs,
+                                     AllocatorPtr cpu_allocator, RunFn run_fn)
+    : max_batch_size_(max_batch_size),
+      timeout_(timeout),
+      batched_inputs_(std::move(batched_inputs)),
+      batched_outputs_(std::move(batched_outputs)),
+      cpu_allocator_(std::move(cpu_allocator)),
+      run_fn_(std::move(run_fn)) {
+  ORT_ENFORCE(max_batch_size_ > 1, "The maximum batch size must be greater than 1.");
+  ORT_ENFORCE(cpu_allocator_ != nullptr && run_fn_ != nullptr);
+}
+
+bool BatchingScheduler::CanBatch(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                                 gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
+                                 const std::vector<OrtValue>& fetches,
+                                 const std::vector<OrtDevice>* fetches_device_info) const {
+  // Per-run settings other than the priority could differ between the requests of a batch.
+  if (run_options.terminate || run_options.only_execute_path_to_fetches ||
+      run_options.deadline != std::chrono::steady_clock::time_point::max() ||
+      !run_options.config_options.configurations.empty() || !run_options.active_adapters.empty()) {
+    return false;
+  }
+
+  if (feeds.empty() || feeds.size() != feed_names.size() || output_names.empty()) {
+    return false;
+  }
+
+  int64_t batch_size = -1;
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    if (batched_inputs_.count(feed_names[i]) == 0 || !feeds[i].IsTensor()) {
+      return false;
+    }
+
+    const Tensor& tensor = feeds[i].Get<Tensor>();
+    if (tensor.IsDataTypeString() || !IsCpuDevice(tensor.Location().device) || tensor.Shape().NumDimensions() == 0) {
+      return false;
+    }
+
+    const int64_t dim0 = tensor.Shape()[0];
+    if (dim0 < 1 || (batch_size != -1 && dim0 != batch_size)) {
+      return false;
+    }
+    batch_size = dim0;
+  }
+
+  if (batch_size >= max_batch_size_) {
+    return false;
+  }
+
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    if (batched_outputs_.count(output_names[i]) == 0 || (i < fetches.size() && fetches[i].IsAllocated())) {
+      return false;
+    }
+    if (fetches_device_info != nullptr && i < fetches_device_info->size() &&
+        !IsCpuDevice((*fetches_device_info)[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::string BatchingScheduler::MakeBatchKey(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                                            gsl::span<const OrtValue> feeds,
+                                            gsl::span<const std::string> output_names) const {
+  std::ostringstream key;
+  key << run_options.priority << ':' << run_options.run_log_severity_level << ':'
+      << run_options.run_log_verbosity_level;
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    const Tensor& tensor = feeds[i].Get<Tensor>();
+    key << '|' << feed_names[i] << ':' << tensor.GetElementType() << ':' << tensor.Shape().Slice(1);
+  }
+  for (const auto& output_name : output_names) {
+    key << '|' << output_name;
+  }
+  return key.str();
+}
+
+void BatchingScheduler::CloseBatchLocked(const std::string& key) {
+  auto it = open_batches_.find(key);
+  if (it != open_batches_.end()) {
+    it->second->closed = true;
+    it->second->leader_cv.notify_one();
+    open_batches_.erase(it);
+  }
+}
+
+void BatchingScheduler::NotifyLeadersLocked() {
+  for (auto& entry : open_batches_) {
+    entry.second->leader_cv.notify_one();
+  }
+}
+
+void BatchingScheduler::DispatchBatchLocked(Batch& batch) {
+  batch.dispatched = true;
+  waiting_requests_ -= batch.requests.size();
+
+  // The batched run logs with the settings shared by its requests and is tagged with the tags of all of them.
+  const Request& leader = *batch.requests.front();
+  batch.run_options.run_log_severity_level = leader.run_options->run_log_severity_level;
+  batch.run_options.run_log_verbosity_level = leader.run_options->run_log_verbosity_level;
+  batch.run_options.priority = leader.run_options->priority;
+  for (const Request* r : batch.requests) {
+    if (!r->run_options->run_tag.empty()) {
+      if (!batch.run_options.run_tag.empty()) {
+        batch.run_options.run_tag += ',';
+      }
+      batch.run_options.run_tag += r->run_options->run_tag;
+    }
+  }
+}
+
+Status BatchingScheduler::Run(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                              gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
+                              std::vector<OrtValue>& fetches) {
+  Request request{&run_options, feed_names, feeds, output_names, &fetches,
+                  feeds[0].Get<Tensor>().Shape()[0], Status::OK()};
+  const std::string key = MakeBatchKey(run_options, feed_names, feeds, output_names);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  ++in_flight_requests_;
+
+  auto it = open_batches_.find(key);
+  if (it != open_batches_.end() && it->second->batch_size + request.batch_size <= max_batch_size_) {
+    // Join the open batch and wait for its leader to run it.
+    std::shared_ptr<Batch> batch = it->second;
+    batch->requests.push_back(&request);
+    batch->batch_size += request.batch_size;
+    ++waiting_requests_;
+    if (batch->batch_size == max_batch_size_) {
+      CloseBatchLocked(key);
+    }
+
+    while (!request.done) {
+      done_cv_.wait_for(lock, kTerminatePollInterval);
+      if (request.done || !run_options.terminate) {
+        continue;
+      }
+
+      if (!batch->dispatched) {
+        // Leave the batch before it is run.
+        batch->requests.erase(std::find(batch->requests.begin(), batch->requests.end(), &request));
+        batch->batch_size -= request.batch_size;
+        --waiting_requests_;
+        break;
+      }
+
+      // A batched run can only be stopped as a whole, which is done once all of its requests are terminated.
+      if (std::all_of(batch->requests.begin(), batch->requests.end(),
+                      [](const Request* r) { return r->run_options->terminate; })) {
+        batch->run_options.terminate = true;
+      }
+    }
+  } else {
+    if (it != open_batches_.end()) {
+      // The request does not fit, so the open batch is run as it is and this request starts a new one.
+      CloseBatchLocked(key);
+    }
+
+    auto batch = std::make_shared<Batch>();
+    batch->requests.push_back(&request);
+    batch->batch_size = request.batch_size;
+    open_batches_.emplace(key, batch);
+    ++waiting_requests_;
+
+    // More requests are only waited for while other requests are running, as their callers are the ones likely to
+    // issue the next requests. A request that arrives while the session is idle is run right away.
+    const auto deadline = std::chrono::steady_clock::now() + timeout_;
+    while (!batch->closed) {
+      const auto now = std::chrono::steady_clock::now();
+      if (now >= deadline || run_options.terminate || in_flight_requests_ == waiting_requests_) {
+        CloseBatchLocked(key);
+        break;
+      }
+      batch->leader_cv.wait_until(
+          lock, std::min<std::chrono::steady_clock::time_point>(deadline, now + kTerminatePollInterval));
+    }
+    DispatchBatchLocked(*batch);
+
+    // No request can join or leave the batch anymore, so its request list is only accessed by the leader and the
+    // terminated followers from here on, which do not modify it.
+    lock.unlock();
+    RunBatch(*batch);
+    lock.lock();
+
+    for (Request* r : batch->requests) {
+      r->done = true;
+    }
+    done_cv_.notify_all();
+  }
+
+  if (run_options.terminate) {
+    fetches.clear();
+    request.status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+  }
+
+  --in_flight_requests_;
+  NotifyLeadersLocked();
+  return request.status;
+}
+
+void BatchingScheduler::RunBatch(Batch& batch) {
+  const Request& leader = *batch.requests.front();
+
+  Status status;
+  ORT_TRY {
+    if (batch.requests.size() == 1) {
+      status = run_fn_(*leader.run_options, leader.feed_names, leader.feeds, leader.output_names, *leader.fetches);
+    } else {
+      // Concatenate the feeds of all requests along the batch dimension.
+      std::vector<OrtValue> batched_feeds(leader.feeds.size());
+      for (size_t i = 0; i < leader.feeds.size(); ++i) {
+        const Tensor& first = leader.feeds[i].Get<Tensor>();
+        TensorShapeVector dims = first.Shape().AsShapeVector();
+        dims[0] = batch.batch_size;
+        Tensor::InitOrtValue(first.DataType(), TensorShape(dims), cpu_allocator_, batched_feeds[i]);
+
+        auto* dst = static_cast<uint8_t*>(batched_feeds[i].GetMutable<Tensor>()->MutableDataRaw());
+        for (const Request* r : batch.requests) {
+          const Tensor& src = r->feeds[i].Get<Tensor>();
+          std::memcpy(dst, src.DataRaw(), src.SizeInBytes());
+          dst += src.SizeInBytes();
+        }
+      }
+
+      std::vector<OrtValue> batched_fetches(leader.output_names.size());
+      status = run_fn_(batch.run_options, leader.feed_names, batched_feeds, leader.output_names, batched_fetches);
+
+      for (size_t i = 0; status.IsOK() && i < batched_fetches.size(); ++i) {
+        const OrtValue& fetch = batched_fetches[i];
+        if (!fetch.IsTensor() || fetch.Get<Tensor>().Shape().NumDimensions() == 0 ||
+            fetch.Get<Tensor>().Shape()[0] != batch.batch_size ||
+            !IsCpuDevice(fetch.Get<Tensor>().Location().device)) {
+          status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Output '", leader.output_names[i],
+                                   "' of a batched run does not have the batch size ", batch.batch_size,
+                                   " as its first dimension.");
+        }
+      }
+
+      if (status.IsOK()) {
+        // Hand each request the rows of the batched fetches that belong to it.
+        int64_t offset = 0;
+        for (Request* r : batch.requests) {
+          r->fetches->resize(batched_fetches.size());
+          for (size_t i = 0; i < batched_fetches.size(); ++i) {
+            (*r->fetches)[i] = SliceBatchedValue(batched_fetches[i], offset, r->batch_size);
+          }
+          offset += r->batch_size;
+        }
+      }
+    }
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exception during batched run: ", ex.what());
+    });
+  }
+
+  for (Request* r : batch.requests) {
+    r->status = status;
+  }
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,137 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_options.h"
+
+namespace onnxruntime {
+
+/**
+ * Joins concurrent Run() calls of an InferenceSession along the batch dimension.
+ *
+ * A request can be batched if all its feeds are CPU tensors of graph inputs that share the symbolic batch
+ * dimension of the model, and all its fetches are graph outputs with that batch dimension that the caller did
+ * not pre-allocate. Requests with the same feed names, element types, per-sample shapes, output names and
+ * priority are compatible.
+ *
+ * The first request of a batch becomes its leader. While other requests are running, it waits until the batch
+ * holds max_batch_size samples or the timeout expires; a request that arrives while no other request is running is
+ * run right away. The leader then concatenates the feeds, runs the session once and hands each request the rows of
+ * the fetches that belong to it. The rows are views of the batched fetches which keep them alive, so the outputs
+ * are not copied.
+ *
+ * Requests are only batched with requests of the same log severity and verbosity, and the batched run is tagged
+ * with the run tags of all its requests. A request whose terminate flag is set leaves its batch if the batch has not
+ * been run yet and fails with the usual terminate status otherwise. The batched run itself is terminated once all
+ * of its requests are.
+ *
+ * The caller is responsible for the model being batch-separable, i.e. the rows of the outputs only depend on the
+ * same rows of the inputs.
+ */
+class BatchingScheduler {
+ public:
+  using RunFn = std::function<Status(const RunOptions& run_options,
+                                     gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                     gsl::span<const std::string> output_names, std::vector<OrtValue>& fetches)>;
+
+  /**
+   * @param max_batch_size Maximum number of samples in a batch.
+   * @param timeout Maximum time the leader of a batch waits for other requests.
+   * @param batched_inputs Names of the graph inputs whose first dimension is the batch dimension.
+   * @param batched_outputs Names of the graph outputs whose first dimension is the batch dimension.
+   * @param cpu_allocator Allocator for the concatenated feeds.
+   * @param run_fn Runs the session for a batch. Fetches must be returned in CPU memory.
+   */
+  BatchingScheduler(int64_t max_batch_size, std::chrono::microseconds timeout,
+                    InlinedHashSet<std::string> batched_inputs, InlinedHashSet<std::string> batched_outputs,
+                    AllocatorPtr cpu_allocator, RunFn run_fn);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(BatchingScheduler);
+
+  /**
+   * Checks whether a Run() call can be joined with others.
+   * Requests that cannot be batched, or that already hold max_batch_size samples, should be run directly.
+   */
+  bool CanBatch(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
+                const std::vector<OrtValue>& fetches,
+                const std::vector<OrtDevice>* fetches_device_info) const;
+
+  /**
+   * Runs a request for which CanBatch() returned true, together with the compatible requests that arrive
+   * before the batch is full or the timeout expires. Blocks until the fetches of the request are available.
+   */
+  Status Run(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+             gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
+             std::vector<OrtValue>& fetches);
+
+ private:
+  struct Request {
+    const RunOptions* run_options;
+    gsl::span<const std::string> feed_names;
+    gsl::span<const OrtValue> feeds;
+    gsl::span<const std::string> output_names;
+    std::vector<OrtValue>* fetches;
+    int64_t batch_size;
+    Status status;
+    bool done = false;  // GUARDED_BY(mutex_)
+  };
+
+  struct Batch {
+    std::vector<Request*> requests;
+    int64_t batch_size = 0;
+    bool closed = false;      // GUARDED_BY(mutex_)
+    bool dispatched = false;  // GUARDED_BY(mutex_)
+    // The RunOptions of the batched run, set when the batch is dispatched.
+    RunOptions run_options;
+    std::condition_variable leader_cv;
+  };
+
+  // How often requests waiting for a batch check their terminate flag.
+  static constexpr std::chrono::milliseconds kTerminatePollInterval{1};
+
+  std::string MakeBatchKey(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                           gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names) const;
+
+  // Closes an open batch so that no more requests join it and wakes up its leader.
+  void CloseBatchLocked(const std::string& key);
+
+  // Wakes up the leaders of the open batches to re-evaluate whether they should wait for more requests.
+  void NotifyLeadersLocked();
+
+  // Marks a closed batch as being run, after which its requests cannot leave it, and sets its RunOptions.
+  void DispatchBatchLocked(Batch& batch);
+
+  // Runs the requests of a closed batch and sets their fetches and status.
+  void RunBatch(Batch& batch);
+
+  const int64_t max_batch_size_;
+  const std::chrono::microseconds timeout_;
+  const InlinedHashSet<std::string> batched_inputs_;
+  const InlinedHashSet<std::string> batched_outputs_;
+  const AllocatorPtr cpu_allocator_;
+  const RunFn run_fn_;
+
+  std::mutex mutex_;
+  std::condition_variable done_cv_;
+  // Batches that requests can still join, by compatibility key.
+  InlinedHashMap<std::string, std::shared_ptr<Batch>> open_batches_;  // GUARDED_BY(mutex_)
+  // Number of requests in Run(), and the number of them waiting in a batch that has not been dispatched.
+  size_t in_flight_requests_ = 0;  // GUARDED_BY(mutex_)
+  size_t waiting_requests_ = 0;    // GUARDED_BY(mutex_)
+};
+
+}  // namespace onnxruntime
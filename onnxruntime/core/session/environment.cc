@@ -224,6 +224,13 @@ Status Environment::CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, co
 
     OrtArenaCfg l_arena_cfg{max_mem, arena_extend_strategy, initial_chunk_size_bytes, max_dead_bytes_per_chunk,
                             initial_growth_chunk_size_bytes, max_power_of_two_extend_bytes};
+    if (arena_cfg) {
+      l_arena_cfg.thread_local_cache_max_bytes = arena_cfg->thread_local_cache_max_bytes;
+      l_arena_cfg.huge_page_mode = arena_cfg->huge_page_mode;
+      l_arena_cfg.trim_watermark_bytes = arena_cfg->trim_watermark_bytes;
+      l_arena_cfg.trim_idle_interval_ms = arena_cfg->trim_idle_interval_ms;
+      l_arena_cfg.trim_run_interval = arena_cfg->trim_run_interval;
+    }
     AllocatorCreationInfo alloc_creation_info{
         [mem_info](int) { return std::make_unique<CPUAllocator>(mem_info); },
         0,
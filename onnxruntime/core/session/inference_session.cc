@@ -417,6 +417,27 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
 
   use_per_session_threads_ = session_options.use_per_session_threads;
   force_spinning_stop_between_runs_ = session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigForceSpinningStop, "0") == "1";
+  {
+    const std::string max_dop_str =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpMaxDegreeOfParallelism, "0");
+    ORT_ENFORCE(TryParseStringWithClassicLocale<int>(max_dop_str, intra_op_max_degree_of_parallelism_) &&
+                    intra_op_max_degree_of_parallelism_ >= 0,
+                "Invalid value for ", kOrtSessionOptionsConfigIntraOpMaxDegreeOfParallelism, ": ", max_dop_str);
+  }
+  {
+    const std::string execution_order =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigExecutionOrder, "");
+    if (execution_order == "DEFAULT") {
+      session_options_.execution_order = ExecutionOrder::DEFAULT;
+    } else if (execution_order == "PRIORITY_BASED") {
+      session_options_.execution_order = ExecutionOrder::PRIORITY_BASED;
+    } else if (execution_order == "CRITICAL_PATH") {
+      session_options_.execution_order = ExecutionOrder::CRITICAL_PATH;
+    } else {
+      ORT_ENFORCE(execution_order.empty(), "Invalid value for ", kOrtSessionOptionsConfigExecutionOrder, ": ",
+                  execution_order, ". Valid values are DEFAULT, PRIORITY_BASED and CRITICAL_PATH.");
+    }
+  }
 
   if (use_per_session_threads_) {
     LOGS(*session_logger_, INFO) << "Creating and using per session threadpools since use_per_session_threads_ is true";
@@ -455,6 +476,10 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         to.auto_set_affinity = to.thread_pool_size == 0 &&
                                session_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL &&
                                to.affinity_str.empty();
+        to.numa_aware =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpNumaAware, "0") == "1";
+        to.adaptive_spin_target_us = std::stoi(
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpAdaptiveSpinTargetUs, "0"));
 
         if (to.custom_create_thread_fn) {
           ORT_ENFORCE(to.custom_join_thread_fn, "custom join thread function not set for intra op thread pool");
@@ -749,6 +774,20 @@ InferenceSession::~InferenceSession() {
     }
   }
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // Arenas shared with other sessions outlive this one, so they stop recording in the timeline of the session.
+  if (allocation_timeline_ != nullptr && session_state_ != nullptr) {
+    for (const auto& device_allocator : session_state_->GetAllocators()) {
+      if (device_allocator.second->Info().alloc_type == OrtAllocatorType::OrtArenaAllocator) {
+        auto* arena = static_cast<BFCArena*>(device_allocator.second.get());
+        if (arena->GetAllocationTimeline() == allocation_timeline_) {
+          arena->SetAllocationTimeline(nullptr);
+        }
+      }
+    }
+  }
+#endif
+
   // Unregister the session and ETW callbacks
 #ifdef _WIN32
   std::lock_guard<std::mutex> lock(active_sessions_mutex_);
@@ -1566,10 +1605,37 @@ static Status LoadOrtModelBytes(const PathString& model_uri,
   return Status::OK();
 }
 
+static Status MapOrtModelBytes(const PathString& model_uri,
+                               gsl::span<const uint8_t>& bytes,
+                               Env::MappedMemoryPtr& mapped_memory) {
+  size_t num_bytes = 0;
+  ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(model_uri.c_str(), num_bytes));
+  ORT_RETURN_IF(num_bytes == 0, "Load model from ", ToUTF8String(model_uri), " failed. The file is empty.");
+
+  ORT_RETURN_IF_ERROR(Env::Default().MapFileIntoMemory(model_uri.c_str(), 0, num_bytes, mapped_memory));
+
+  bytes = gsl::span<const uint8_t>(reinterpret_cast<const uint8_t*>(mapped_memory.get()), num_bytes);
+
+  return Status::OK();
+}
+
 Status InferenceSession::LoadOrtModel(const PathString& model_uri) {
   return LoadOrtModelWithLoader(
       [&]() {
         model_location_ = model_uri;
+
+        const auto& config_options = GetSessionOptions().config_options;
+        if (config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMapORTModelFile, "0") == "1") {
+          auto status = MapOrtModelBytes(model_location_, ort_format_model_bytes_, ort_format_model_mapped_memory_);
+          if (status.IsOK()) {
+            return Status::OK();
+          }
+
+          ort_format_model_mapped_memory_.reset();
+          LOGS(*session_logger_, INFO) << "Reading the model file into memory as it could not be mapped: "
+                                       << status.ErrorMessage();
+        }
+
         ORT_RETURN_IF_ERROR(
             LoadOrtModelBytes(model_location_, ort_format_model_bytes_, ort_format_model_bytes_data_holder_));
         return Status::OK();
@@ -1677,11 +1743,13 @@ Status InferenceSession::LoadOrtModelWithLoader(std::function<Status()> load_ort
   // provided an existing buffer of bytes when creating the InferenceSession, ort_format_model_bytes_data_holder_
   // will be empty.
   // if that is the case we also allow creating initializers that directly use those bytes.
+  // if the bytes are a mapping of the model file, the session owns the mapping so the initializers always use it.
   const auto& config_options = session_options_.config_options;
   using_ort_model_bytes_for_initializers_ =
       load_options.can_use_flatbuffer_for_initializers =
-          ort_format_model_bytes_data_holder_.empty() &&
-          config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseORTModelBytesForInitializers, "0") == "1";
+          ort_format_model_mapped_memory_ != nullptr ||
+          (ort_format_model_bytes_data_holder_.empty() &&
+           config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseORTModelBytesForInitializers, "0") == "1");
 
   // need to go from unique_ptr to shared_ptr when moving into model_
   std::unique_ptr<Model> tmp_model;
@@ -2140,6 +2208,12 @@ common::Status InferenceSession::Initialize() {
     }
 #endif
 
+    const bool share_initializers_by_content = session_options_.config_options.GetConfigOrDefault(
+                                                   kOrtSessionOptionsConfigShareInitializersByContent, "0") == "1";
+    if (share_initializers_by_content && prepacked_weights_container_ == nullptr) {
+      prepacked_weights_container_ = &environment_.GetSharedInitializerStore().GetPrepackedWeightsContainer();
+    }
+
     // now that we have all the execution providers, create the session state
     session_state_ = std::make_unique<SessionState>(
         model_->MainGraph(),
@@ -2153,6 +2227,10 @@ common::Status InferenceSession::Initialize() {
         session_options_,
         prepacked_weights_container_);
 
+    if (share_initializers_by_content) {
+      session_state_->SetSharedInitializerStore(&environment_.GetSharedInitializerStore());
+    }
+
     bool use_env_allocators =
         session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseEnvAllocators, "0") == "1";
     if (use_env_allocators) {
@@ -2176,6 +2254,45 @@ common::Status InferenceSession::Initialize() {
     }
 
     session_state_->SetNodeStatsRecorder(GetNodeStatsRecorder());
+
+    const std::string node_thread_counts_file = session_options_.config_options.GetConfigOrDefault(
+        kOrtSessionOptionsConfigNodeThreadCountsFile, "");
+    const std::string node_thread_counts_tuning_runs_str = session_options_.config_options.GetConfigOrDefault(
+        kOrtSessionOptionsConfigNodeThreadCountsTuningRuns, "0");
+    size_t node_thread_counts_tuning_runs = 0;
+    ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(node_thread_counts_tuning_runs_str,
+                                                      node_thread_counts_tuning_runs),
+                      "Invalid value for ", kOrtSessionOptionsConfigNodeThreadCountsTuningRuns, ": ",
+                      node_thread_counts_tuning_runs_str);
+
+    if (!node_thread_counts_file.empty() || node_thread_counts_tuning_runs > 0) {
+      const auto metrics = concurrency::ThreadPool::GetMetrics(session_state_->GetThreadPool());
+      node_thread_counts_.emplace(static_cast<int>(metrics.num_threads) + 1, node_thread_counts_tuning_runs);
+
+      const PathString node_thread_counts_path = ToPathString(node_thread_counts_file);
+      if (node_thread_counts_tuning_runs == 0) {
+        ORT_RETURN_IF_ERROR_SESSIONID_(node_thread_counts_->Load(node_thread_counts_path));
+      } else if (!node_thread_counts_file.empty()) {
+        // Nodes found in an existing file keep their thread count, the others are learned.
+        if (std::filesystem::exists(node_thread_counts_path)) {
+          ORT_RETURN_IF_ERROR_SESSIONID_(node_thread_counts_->Load(node_thread_counts_path));
+        }
+        node_thread_counts_output_file_ = node_thread_counts_path;
+      }
+      session_state_->SetNodeThreadCounts(&*node_thread_counts_);
+    }
+
+    const std::string allocation_timeline_file = session_options_.config_options.GetConfigOrDefault(
+        kOrtSessionOptionsConfigAllocationTimelineFile, "");
+    if (!allocation_timeline_file.empty()) {
+      allocation_timeline_ = std::make_shared<AllocationTimeline>(ToPathString(allocation_timeline_file));
+      for (const auto& device_allocator : session_state_->GetAllocators()) {
+        if (device_allocator.second->Info().alloc_type == OrtAllocatorType::OrtArenaAllocator) {
+          static_cast<BFCArena*>(device_allocator.second.get())->SetAllocationTimeline(allocation_timeline_);
+        }
+      }
+      session_state_->SetAllocationTimeline(allocation_timeline_.get());
+    }
 #endif
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
@@ -2510,6 +2627,8 @@ common::Status InferenceSession::Initialize() {
     // Resolve memory pattern flags of the main graph and subgraph session states
     ResolveMemoryPatternFlags(*session_state_);
 
+    CreateBatchingScheduler();
+
     is_inited_ = true;
 
     if (!using_ort_model_bytes_for_initializers_) {
@@ -2928,6 +3047,18 @@ Status InferenceSession::Run(const RunOptions& run_options,
                              gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
                              gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
                              const std::vector<OrtDevice>* p_fetches_device_info) {
+  if (batching_scheduler_ != nullptr && p_fetches != nullptr &&
+      batching_scheduler_->CanBatch(run_options, feed_names, feeds, output_names, *p_fetches, p_fetches_device_info)) {
+    return batching_scheduler_->Run(run_options, feed_names, feeds, output_names, *p_fetches);
+  }
+
+  return RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info);
+}
+
+Status InferenceSession::RunImpl(const RunOptions& run_options,
+                                 gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                 gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
+                                 const std::vector<OrtDevice>* p_fetches_device_info) {
   TimePoint tp = std::chrono::high_resolution_clock::now();
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.Start();
@@ -2960,6 +3091,13 @@ Status InferenceSession::Run(const RunOptions& run_options,
   auto* inter_tp = (control_spinning) ? inter_op_thread_pool_.get() : nullptr;
   ThreadPoolSpinningSwitch runs_refcounter_and_tp_spin_control(intra_tp, inter_tp, current_num_runs_);
 
+  // Apply the priority of this Run and the parallelism quota of the session to the intra op loops it issues.
+  // The priority is registered on the intra op pool so that lower priority Runs sharing it back off.
+  // The terminate flag and deadline let kernels stop their parallel loops early once the Run is cancelled.
+  concurrency::ThreadPool::ScopedSchedulingOptions scheduling_options_scope(
+      GetIntraOpThreadPoolToUse(), {run_options.priority, intra_op_max_degree_of_parallelism_,
+                                    &run_options.terminate, run_options.deadline});
+
   // Check if this Run() is simply going to be a CUDA Graph replay.
   if (cached_execution_provider_for_graph_replay_.IsGraphCaptured(graph_annotation_id)) {
     LOGS(*session_logger_, INFO) << "Replaying the captured "
@@ -3093,6 +3231,13 @@ Status InferenceSession::Run(const RunOptions& run_options,
     if (!arenas_to_shrink.empty()) {
       ShrinkMemoryArenas(arenas_to_shrink);
     }
+
+    // Arenas with a trim policy count the runs to trim themselves periodically.
+    for (const auto& device_allocator : session_state_->GetAllocators()) {
+      if (device_allocator.second->Info().alloc_type == OrtAllocatorType::OrtArenaAllocator) {
+        static_cast<BFCArena*>(device_allocator.second.get())->OnRunEnd();
+      }
+    }
   }
 
   // keep track of telemetry
@@ -3149,6 +3294,20 @@ Status InferenceSession::Run(const RunOptions& run_options,
     node_stats_recorder_->DumpStats(session_state_->GetGraphViewer().ModelPath());
     node_stats_recorder_->ResetPerRunNameDeduper();
   }
+
+  if (!node_thread_counts_output_file_.empty() && retval.IsOK()) {
+    auto save_status = node_thread_counts_->SaveIfUpdated(node_thread_counts_output_file_);
+    if (!save_status.IsOK()) {
+      LOGS(*session_logger_, WARNING) << save_status.ErrorMessage();
+    }
+  }
+
+  if (allocation_timeline_ != nullptr) {
+    auto flush_status = allocation_timeline_->Flush();
+    if (!flush_status.IsOK()) {
+      LOGS(*session_logger_, WARNING) << flush_status.ErrorMessage();
+    }
+  }
 #endif
 
   reset_saturation_count();
@@ -3163,7 +3322,7 @@ Status InferenceSession::Run(const RunOptions& run_options,
       cached_execution_provider_for_graph_replay_.AllowGraphCaptureOnRun(graph_annotation_id) &&
       !cached_execution_provider_for_graph_replay_.IsGraphCaptured(graph_annotation_id)) {
     LOGS(*session_logger_, INFO) << "Start another run for necessary memory allocation or graph capture.";
-    ORT_RETURN_IF_ERROR(Run(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info));
+    ORT_RETURN_IF_ERROR(RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info));
   }
 
   // Log runtime error telemetry if the return value is not OK
@@ -3171,6 +3330,81 @@ Status InferenceSession::Run(const RunOptions& run_options,
   return retval;
 }
 
+void InferenceSession::CreateBatchingScheduler() {
+  int64_t max_batch_size = 0;
+  const std::string max_batch_size_str =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBatchingMaxBatchSize, "0");
+  ORT_ENFORCE(TryParseStringWithClassicLocale(max_batch_size_str, max_batch_size) && max_batch_size >= 0,
+              "Invalid value for ", kOrtSessionOptionsConfigDynamicBatchingMaxBatchSize, ": ", max_batch_size_str);
+  if (max_batch_size <= 1) {
+    return;
+  }
+
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBatchingBatchSeparable,
+                                                         "0") != "1") {
+    LOGS(*session_logger_, WARNING) << "Dynamic batching is disabled because the model is not declared "
+                                       "batch-separable with "
+                                    << kOrtSessionOptionsConfigDynamicBatchingBatchSeparable << ".";
+    return;
+  }
+
+  int64_t timeout_us = 0;
+  const std::string timeout_us_str =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBatchingTimeoutUs, "1000");
+  ORT_ENFORCE(TryParseStringWithClassicLocale(timeout_us_str, timeout_us) && timeout_us >= 0,
+              "Invalid value for ", kOrtSessionOptionsConfigDynamicBatchingTimeoutUs, ": ", timeout_us_str);
+
+  // The batch dimension is the symbolic first dimension shared by all graph inputs.
+  const auto get_batch_dim_param = [](const NodeArg& node_arg) -> std::string {
+    const auto* shape = node_arg.Shape();
+    if (shape == nullptr || shape->dim_size() == 0 || !utils::HasDimParam(shape->dim(0))) {
+      return {};
+    }
+    return shape->dim(0).dim_param();
+  };
+
+  const GraphViewer& graph_viewer = session_state_->GetGraphViewer();
+  std::string batch_dim_param;
+  InlinedHashSet<std::string> batched_inputs;
+  for (const NodeArg* input : graph_viewer.GetInputs()) {
+    const std::string dim_param = get_batch_dim_param(*input);
+    if (dim_param.empty() || (!batch_dim_param.empty() && dim_param != batch_dim_param)) {
+      LOGS(*session_logger_, WARNING) << "Dynamic batching is disabled because input '" << input->Name()
+                                      << "' does not have the symbolic batch dimension of the model.";
+      return;
+    }
+    batch_dim_param = dim_param;
+    batched_inputs.insert(input->Name());
+  }
+
+  InlinedHashSet<std::string> batched_outputs;
+  for (const NodeArg* output : graph_viewer.GetOutputs()) {
+    if (!batch_dim_param.empty() && get_batch_dim_param(*output) == batch_dim_param) {
+      batched_outputs.insert(output->Name());
+    }
+  }
+
+  if (batched_inputs.empty() || batched_outputs.empty()) {
+    LOGS(*session_logger_, WARNING) << "Dynamic batching is disabled because the model has no symbolic batch "
+                                       "dimension shared by its inputs and outputs.";
+    return;
+  }
+
+  auto run_fn = [this](const RunOptions& run_options,
+                       gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                       gsl::span<const std::string> output_names, std::vector<OrtValue>& fetches) {
+    // The outputs are sliced per request on the CPU.
+    const std::vector<OrtDevice> fetches_device_info(output_names.size());
+    return RunImpl(run_options, feed_names, feeds, output_names, &fetches, &fetches_device_info);
+  };
+
+  LOGS(*session_logger_, INFO) << "Dynamic batching enabled with a maximum batch size of " << max_batch_size
+                               << " and a timeout of " << timeout_us << "us.";
+  batching_scheduler_ = std::make_unique<BatchingScheduler>(
+      max_batch_size, std::chrono::microseconds(timeout_us), std::move(batched_inputs), std::move(batched_outputs),
+      session_state_->GetAllocator(OrtDevice()), std::move(run_fn));
+}
+
 Status InferenceSession::Run(const RunOptions& run_options,
                              gsl::span<const char* const> feed_names,
                              gsl::span<const OrtValue* const> feeds,
@@ -3279,6 +3513,50 @@ common::Status InferenceSession::RunAsync(const RunOptions* run_options,
   return Status::OK();
 }
 
+common::Status InferenceSession::RunAsync(const RunOptions* run_options,
+                                          gsl::span<const char* const> feed_names,
+                                          gsl::span<const OrtValue* const> feeds,
+                                          gsl::span<const char* const> fetch_names,
+                                          gsl::span<OrtValue*> fetches,
+                                          RunCompletionQueue& queue,
+                                          void* tag) {
+  auto* tp = GetIntraOpThreadPoolToUse();
+  if (!tp || concurrency::ThreadPool::DegreeOfParallelism(tp) < 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "intra op thread pool must have at least one thread for RunAsync");
+  }
+
+  // The request may wait in the queue after this call returns, so keep copies of everything but the fetches.
+  std::vector<std::string> feed_name_vec(feed_names.begin(), feed_names.end());
+  std::vector<OrtValue> feed_vec;
+  feed_vec.reserve(feeds.size());
+  for (const OrtValue* feed : feeds) {
+    if (feed == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "NULL input supplied for RunAsync");
+    }
+    feed_vec.push_back(*feed);
+  }
+  std::vector<std::string> fetch_name_vec(fetch_names.begin(), fetch_names.end());
+
+  std::function<Status()> run_fn = [this, run_options_copy = run_options ? *run_options : RunOptions(),
+                                    feed_name_vec = std::move(feed_name_vec), feed_vec = std::move(feed_vec),
+                                    fetch_name_vec = std::move(fetch_name_vec), fetches]() {
+    InlinedVector<const char*> feed_name_ptrs;
+    InlinedVector<const OrtValue*> feed_ptrs;
+    for (size_t i = 0; i < feed_vec.size(); ++i) {
+      feed_name_ptrs.push_back(feed_name_vec[i].c_str());
+      feed_ptrs.push_back(&feed_vec[i]);
+    }
+    InlinedVector<const char*> fetch_name_ptrs;
+    for (const auto& fetch_name : fetch_name_vec) {
+      fetch_name_ptrs.push_back(fetch_name.c_str());
+    }
+    return Run(run_options_copy, feed_name_ptrs, feed_ptrs, fetch_name_ptrs, fetches);
+  };  // run_fn
+
+  queue.Submit(tp, std::move(run_fn), tag);
+  return Status::OK();
+}
+
 common::Status InferenceSession::Run(const NameMLValMap& feeds, gsl::span<const std::string> output_names,
                                      std::vector<OrtValue>* p_fetches) {
   return Run(RunOptions(), feeds, output_names, p_fetches);
@@ -3500,6 +3778,29 @@ const profiling::Profiler& InferenceSession::GetProfiling() const {
   return session_profiler_;
 }
 
+std::map<std::string, std::string> InferenceSession::GetThreadPoolMetrics() const {
+  std::map<std::string, std::string> result;
+  auto add_metrics = [&result](const std::string& prefix, const concurrency::ThreadPool* tp) {
+    if (tp == nullptr) {
+      return;
+    }
+    const auto metrics = concurrency::ThreadPool::GetMetrics(tp);
+    result[prefix + "num_threads"] = std::to_string(metrics.num_threads);
+    result[prefix + "parallel_sections"] = std::to_string(metrics.parallel_sections);
+    result[prefix + "parallel_loops"] = std::to_string(metrics.parallel_loops);
+    result[prefix + "tasks_executed"] = std::to_string(metrics.tasks_executed);
+    result[prefix + "tasks_stolen"] = std::to_string(metrics.tasks_stolen);
+    result[prefix + "spin_time_us"] = std::to_string(metrics.spin_time_us);
+    result[prefix + "blocked_time_us"] = std::to_string(metrics.blocked_time_us);
+    result[prefix + "max_queue_depth"] = std::to_string(metrics.max_queue_depth);
+    result[prefix + "loop_imbalance_us"] = std::to_string(metrics.loop_imbalance_us);
+    result[prefix + "max_loop_imbalance_us"] = std::to_string(metrics.max_loop_imbalance_us);
+  };
+  add_metrics("intra_op.", GetIntraOpThreadPoolToUse());
+  add_metrics("inter_op.", GetInterOpThreadPoolToUse());
+  return result;
+}
+
 #if !defined(ORT_MINIMAL_BUILD)
 std::vector<TuningResults> InferenceSession::GetTuningResults() const {
   std::vector<TuningResults> ret;
@@ -20,6 +20,7 @@
 #include "core/framework/iexecutor.h"
 #include "core/framework/external_data_loader_manager.h"
 #include "core/framework/kernel_registry_manager.h"
+#include "core/framework/node_thread_counts.h"
 #include "core/framework/prepacked_weights_container.h"
 #include "core/framework/resource_accountant.h"
 #include "core/framework/session_state.h"
@@ -30,6 +31,9 @@
 #include "core/optimizer/graph_transformer_level.h"
 #include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/insert_cast_transformer.h"
+#include "core/platform/env.h"
+#include "core/session/batching_scheduler.h"
+#include "core/session/run_completion_queue.h"
 #include <mutex>
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
 #include "core/language_interop_ops/language_interop_ops.h"
@@ -380,6 +384,19 @@ class InferenceSession {
                                         RunAsyncCallbackFn callback,
                                         void* user_data = nullptr);
 
+  /**
+   * Submits a Run to `queue`, which executes it on the intra op thread pool of the session once fewer than its
+   * maximum number of concurrent runs are in flight. The names, feeds and run options are copied. `fetches` must
+   * stay valid until the completion with `tag` has been dequeued.
+   */
+  [[nodiscard]] common::Status RunAsync(const RunOptions* run_options,
+                                        gsl::span<const char* const> feed_names,
+                                        gsl::span<const OrtValue* const> feeds,
+                                        gsl::span<const char* const> fetch_names,
+                                        gsl::span<OrtValue*> fetches,
+                                        RunCompletionQueue& queue,
+                                        void* tag);
+
   /**
    * Run a pre-loaded and pre-intialized model.
    * Multiple threads are allowed to run this function; hence its thread-safe.
@@ -547,6 +564,12 @@ class InferenceSession {
     */
   const profiling::Profiler& GetProfiling() const;
 
+  /**
+    * Get the always-on metrics of the thread pools used by this session, which may be shared with other sessions.
+    @return a map from "intra_op.<metric>" and "inter_op.<metric>" to the metric value, for each pool in use.
+    */
+  std::map<std::string, std::string> GetThreadPoolMetrics() const;
+
 #if !defined(ORT_MINIMAL_BUILD)
   /**
    * Get the TuningResults of TunableOp for every execution providers.
@@ -715,6 +738,10 @@ class InferenceSession {
   // EP instance.
   ExecutionProviders execution_providers_;
 
+  // Mapping of the file of an ORT format model loaded from a file path, see kOrtSessionOptionsConfigMapORTModelFile.
+  // This MUST be prior to model_ and session_state_ as their initializers may point into the mapping.
+  Env::MappedMemoryPtr ort_format_model_mapped_memory_;
+
   // The model served by this inference session instance.
   // Currently this has to be a shared ptr because the Model::Load method
   // returns a shared_ptr only. Ideally factory functions should always return
@@ -783,6 +810,15 @@ class InferenceSession {
   const logging::Logger& CreateLoggerForRun(const RunOptions& run_options,
                                             std::unique_ptr<logging::Logger>& new_run_logger);
 
+  // Executes a single Run() call. Run() forwards here directly or via the batching scheduler.
+  [[nodiscard]] common::Status RunImpl(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                                       gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
+                                       std::vector<OrtValue>* p_fetches,
+                                       const std::vector<OrtDevice>* p_fetches_device_info);
+
+  // Creates batching_scheduler_ if dynamic batching is enabled and the model has a symbolic batch dimension.
+  void CreateBatchingScheduler();
+
   void InitLogger(logging::LoggingManager* logging_manager);
 
   static void TraceSessionOptions(const SessionOptions& session_options, bool captureState, const logging::Logger& logger);
@@ -883,6 +919,13 @@ class InferenceSession {
   // Spinning is restarted on the next Run()
   bool force_spinning_stop_between_runs_ = false;
 
+  // Maximum number of threads a parallel loop of this session may use in the intra op thread pool. 0 means no limit.
+  // Set from kOrtSessionOptionsConfigIntraOpMaxDegreeOfParallelism.
+  int intra_op_max_degree_of_parallelism_ = 0;
+
+  // Joins concurrent Run() calls along the batch dimension. Set from kOrtSessionOptionsConfigDynamicBatchingMaxBatchSize.
+  std::unique_ptr<BatchingScheduler> batching_scheduler_;
+
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> thread_pool_;
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
 
@@ -974,9 +1017,12 @@ class InferenceSession {
   //   until the session is created.
   //   (Longer term) If we are going to use the memory offsets directly for initializers, the model data
   //   should be alive until the InferenceSession goes away.
+  // If the session is started with a model_uri
+  //   We map the file into ort_format_model_mapped_memory_ if "session.map_ort_model_file" is set to "1", and
+  //   the initializers use the mapped bytes until the InferenceSession goes away.
   // If the session is started with an input byte array contains model data, and the caller does not
   // specify ORT should use the model bytes directly
-  // Or the session is started with a model_uri
+  // Or the session is started with a model_uri that is not mapped
   //   We store them currently in the ort_format_model_bytes_data_holder_ to make the Load + Initialize
   //   behave the same way as for an ONNX model, as we need some of the bytes for the Load (create the Model)
   //   and some for the Initialize (create SessionState).
@@ -1044,6 +1090,14 @@ class InferenceSession {
 #if !defined(ORT_MINIMAL_BUILD)
   // Enable nodestats collection
   std::optional<NodeStatsRecorder> node_stats_recorder_;
+
+  // Intra-op thread counts of the nodes, see kOrtSessionOptionsConfigNodeThreadCountsFile.
+  std::optional<NodeThreadCounts> node_thread_counts_;
+  // File the learned thread counts are written to after a Run. Empty if they are not learned or not saved.
+  PathString node_thread_counts_output_file_;
+
+  // Allocation timeline of the arenas of the session, see kOrtSessionOptionsConfigAllocationTimelineFile.
+  std::shared_ptr<AllocationTimeline> allocation_timeline_;
 #endif
 };
 
@@ -48,6 +48,7 @@
 #include "core/session/onnxruntime_c_api.h"
 #include "core/session/ort_apis.h"
 #include "core/session/ort_env.h"
+#include "core/session/run_completion_queue.h"
 #include "core/session/utils.h"
 
 #if defined(USE_CUDA) || defined(USE_CUDA_PROVIDER_INTERFACE)
@@ -871,6 +872,63 @@ ORT_API_STATUS_IMPL(OrtApis::RunAsync, _Inout_ OrtSession* sess, _In_opt_ const
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CreateRunCompletionQueue, size_t max_concurrent_runs, size_t max_pending_runs,
+                    _Outptr_ OrtRunCompletionQueue** out) {
+  API_IMPL_BEGIN
+  if (max_concurrent_runs == 0) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "max_concurrent_runs must be greater than 0");
+  }
+  auto queue = std::make_unique<::onnxruntime::RunCompletionQueue>(max_concurrent_runs, max_pending_runs);
+  *out = reinterpret_cast<OrtRunCompletionQueue*>(queue.release());
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API(void, OrtApis::ReleaseRunCompletionQueue, _Frees_ptr_opt_ OrtRunCompletionQueue* queue) {
+  delete reinterpret_cast<::onnxruntime::RunCompletionQueue*>(queue);
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunWithCompletionQueue, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output,
+                    _Inout_ OrtRunCompletionQueue* queue, _In_opt_ void* tag) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+
+  if (run_options != nullptr && !run_options->active_adapters.empty()) {
+    LOGS(*session->GetLogger(), WARNING) << "RunWithCompletionQueue() active adapters specified, but won't have an effect";
+  }
+
+  return ToOrtStatus(session->RunAsync(run_options,
+                                       gsl::make_span(input_names, input_len),
+                                       gsl::make_span(input, input_len),
+                                       gsl::make_span(output_names, output_names_len),
+                                       gsl::make_span(output, output_names_len),
+                                       *reinterpret_cast<::onnxruntime::RunCompletionQueue*>(queue),
+                                       tag));
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunCompletionQueueDequeue, _Inout_ OrtRunCompletionQueue* queue, int64_t timeout_ms,
+                    size_t max_completions, _Out_writes_(max_completions) void** tags,
+                    _Out_writes_(max_completions) OrtStatusPtr* statuses,
+                    _Out_ size_t* num_completions) {
+  API_IMPL_BEGIN
+  auto* completion_queue = reinterpret_cast<::onnxruntime::RunCompletionQueue*>(queue);
+  std::vector<::onnxruntime::RunCompletionQueue::Completion> completions(max_completions);
+  const size_t count = completion_queue->Dequeue(std::chrono::milliseconds(timeout_ms), max_completions,
+                                                 completions.data());
+  for (size_t i = 0; i < count; ++i) {
+    tags[i] = completions[i].tag;
+    statuses[i] = ToOrtStatus(completions[i].status);
+  }
+  *num_completions = count;
+  return nullptr;
+  API_IMPL_END
+}
+
 struct OrtIoBinding {
   std::unique_ptr<::onnxruntime::IOBinding> binding_;
   explicit OrtIoBinding(std::unique_ptr<::onnxruntime::IOBinding>&& binding) : binding_(std::move(binding)) {}
@@ -2254,6 +2312,16 @@ ORT_API_STATUS_IMPL(OrtApis::SessionGetProfilingStartTimeNs, _In_ const OrtSessi
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionGetThreadPoolMetrics, _In_ const OrtSession* sess, _Outptr_ OrtKeyValuePairs** out) {
+  API_IMPL_BEGIN
+  const auto* session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  auto kvps = std::make_unique<OrtKeyValuePairs>();
+  kvps->CopyFromMap(session->GetThreadPoolMetrics());
+  *out = reinterpret_cast<OrtKeyValuePairs*>(kvps.release());
+  return nullptr;
+  API_IMPL_END
+}
+
 // End support for non-tensor types
 
 ORT_API_STATUS_IMPL(OrtApis::CreateArenaCfg, _In_ size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes,
@@ -2293,6 +2361,16 @@ ORT_API_STATUS_IMPL(OrtApis::CreateArenaCfgV2, _In_reads_(num_keys) const char*
       cfg->initial_growth_chunk_size_bytes = static_cast<int>(arena_config_values[i]);
     } else if (strcmp(arena_config_keys[i], "max_power_of_two_extend_bytes") == 0) {
       cfg->max_power_of_two_extend_bytes = static_cast<int64_t>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "thread_local_cache_max_bytes") == 0) {
+      cfg->thread_local_cache_max_bytes = static_cast<int64_t>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "huge_page_mode") == 0) {
+      cfg->huge_page_mode = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "trim_watermark_bytes") == 0) {
+      cfg->trim_watermark_bytes = static_cast<int64_t>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "trim_idle_interval_ms") == 0) {
+      cfg->trim_idle_interval_ms = static_cast<int64_t>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "trim_run_interval") == 0) {
+      cfg->trim_run_interval = static_cast<int64_t>(arena_config_values[i]);
     } else {
       std::ostringstream oss;
       oss << "Invalid key found: " << arena_config_keys[i];
@@ -2323,6 +2401,22 @@ ORT_API_STATUS_IMPL(OrtApis::CreatePrepackedWeightsContainer, _Outptr_ OrtPrepac
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CreatePrepackedWeightsContainerWithArenaCfg, _In_ const OrtArenaCfg* arena_cfg,
+                    _Outptr_ OrtPrepackedWeightsContainer** out) {
+  API_IMPL_BEGIN
+  if (arena_cfg == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "arena_cfg must not be null");
+  }
+  OrtArenaCfg cfg = *arena_cfg;
+  if (!cfg.IsValid()) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Invalid arena configuration.");
+  }
+  std::unique_ptr<PrepackedWeightsContainer> container = std::make_unique<PrepackedWeightsContainer>(cfg);
+  *out = reinterpret_cast<OrtPrepackedWeightsContainer*>(container.release());
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API(void, OrtApis::ReleasePrepackedWeightsContainer, _Frees_ptr_opt_ OrtPrepackedWeightsContainer* ptr) {
   delete reinterpret_cast<PrepackedWeightsContainer*>(ptr);
 }
@@ -4108,6 +4202,18 @@ static constexpr OrtApi ort_api_1_to_23 = {
     &OrtApis::CopyTensors,
 
     &OrtApis::Graph_GetModelMetadata,
+
+    &OrtApis::RunOptionsSetPriority,
+    &OrtApis::RunOptionsGetPriority,
+    &OrtApis::SessionGetThreadPoolMetrics,
+
+    &OrtApis::CreateRunCompletionQueue,
+    &OrtApis::ReleaseRunCompletionQueue,
+    &OrtApis::RunWithCompletionQueue,
+    &OrtApis::RunCompletionQueueDequeue,
+
+    &OrtApis::RunOptionsSetDeadline,
+    &OrtApis::CreatePrepackedWeightsContainerWithArenaCfg,
 };
 
 // OrtApiBase can never change as there is no way to know what version of OrtApiBase is returned by OrtGetApiBase.
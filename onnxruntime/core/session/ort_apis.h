@@ -741,4 +741,26 @@ ORT_API_STATUS_IMPL(CopyTensors, _In_ const OrtEnv* env,
                     _In_reads_(num_tensors) OrtValue* const* dst_tensors,
                     _In_opt_ OrtSyncStream* stream,
                     _In_ size_t num_tensors);
+
+ORT_API_STATUS_IMPL(RunOptionsSetPriority, _Inout_ OrtRunOptions* options, int priority);
+ORT_API_STATUS_IMPL(RunOptionsGetPriority, _In_ const OrtRunOptions* options, _Out_ int* priority);
+ORT_API_STATUS_IMPL(SessionGetThreadPoolMetrics, _In_ const OrtSession* sess, _Outptr_ OrtKeyValuePairs** out);
+
+ORT_API_STATUS_IMPL(CreateRunCompletionQueue, size_t max_concurrent_runs, size_t max_pending_runs,
+                    _Outptr_ OrtRunCompletionQueue** out);
+ORT_API(void, ReleaseRunCompletionQueue, _Frees_ptr_opt_ OrtRunCompletionQueue* queue);
+ORT_API_STATUS_IMPL(RunWithCompletionQueue, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output,
+                    _Inout_ OrtRunCompletionQueue* queue, _In_opt_ void* tag);
+ORT_API_STATUS_IMPL(RunCompletionQueueDequeue, _Inout_ OrtRunCompletionQueue* queue, int64_t timeout_ms,
+                    size_t max_completions, _Out_writes_(max_completions) void** tags,
+                    _Out_writes_(max_completions) OrtStatusPtr* statuses,
+                    _Out_ size_t* num_completions);
+
+ORT_API_STATUS_IMPL(RunOptionsSetDeadline, _Inout_ OrtRunOptions* options, int64_t timeout_us);
+ORT_API_STATUS_IMPL(CreatePrepackedWeightsContainerWithArenaCfg, _In_ const OrtArenaCfg* arena_cfg,
+                    _Outptr_ OrtPrepackedWeightsContainer** out);
 }  // namespace OrtApis
@@ -0,0 +1,106 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/run_completion_queue.h"
+
+#include <algorithm>
+#include <optional>
+
+namespace onnxruntime {
+
+RunCompletionQueue::RunCompletionQueue(size_t max_concurrent_runs, size_t max_pending_runs)
+    : max_concurrent_runs_(max_concurrent_runs), max_pending_runs_(max_pending_runs) {
+  ORT_ENFORCE(max_concurrent_runs_ > 0, "The maximum number of concurrent runs must be greater than 0.");
+}
+
+RunCompletionQueue::~RunCompletionQueue() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  pending_runs_.clear();
+  state_cv_.wait(lock, [this]() { return num_running_ == 0; });
+}
+
+void RunCompletionQueue::Submit(concurrency::ThreadPool* thread_pool, std::function<Status()> run, void* tag) {
+  ORT_ENFORCE(thread_pool != nullptr, "A thread pool is required to run asynchronously.");
+
+  PendingRun pending_run{thread_pool, std::move(run), tag};
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (num_running_ >= max_concurrent_runs_) {
+      state_cv_.wait(lock, [this]() {
+        return max_pending_runs_ == 0 || pending_runs_.size() < max_pending_runs_ ||
+               num_running_ < max_concurrent_runs_;
+      });
+    }
+
+    if (num_running_ >= max_concurrent_runs_) {
+      pending_runs_.push_back(std::move(pending_run));
+      return;
+    }
+    ++num_running_;
+  }
+
+  Start(std::move(pending_run));
+}
+
+void RunCompletionQueue::Start(PendingRun pending_run) {
+  concurrency::ThreadPool::Schedule(
+      pending_run.thread_pool, [this, run = std::move(pending_run.run), tag = pending_run.tag]() {
+        Status status;
+        ORT_TRY {
+          status = run();
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+          });
+        }
+        ORT_CATCH(...) {
+          status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, "unknown exception");
+        }
+        Finish(tag, std::move(status));
+      });
+}
+
+void RunCompletionQueue::Finish(void* tag, Status status) {
+  std::optional<PendingRun> next_run;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    completions_.push_back({tag, std::move(status)});
+    completion_cv_.notify_one();
+
+    // The slot of the finished run is handed to the oldest pending run.
+    if (!pending_runs_.empty()) {
+      next_run.emplace(std::move(pending_runs_.front()));
+      pending_runs_.pop_front();
+    } else {
+      --num_running_;
+    }
+
+    // Notify while holding the lock, the destructor may be waiting for the last run to finish.
+    state_cv_.notify_all();
+  }
+
+  if (next_run.has_value()) {
+    Start(std::move(*next_run));
+  }
+}
+
+size_t RunCompletionQueue::Dequeue(std::chrono::milliseconds timeout, size_t max_completions,
+                                   Completion* completions) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  const auto has_completions = [this]() { return !completions_.empty(); };
+  if (timeout.count() < 0) {
+    completion_cv_.wait(lock, has_completions);
+  } else {
+    completion_cv_.wait_for(lock, timeout, has_completions);
+  }
+
+  const size_t num_completions = std::min(max_completions, completions_.size());
+  for (size_t i = 0; i < num_completions; ++i) {
+    completions[i] = std::move(completions_.front());
+    completions_.pop_front();
+  }
+  return num_completions;
+}
+
+}  // namespace onnxruntime
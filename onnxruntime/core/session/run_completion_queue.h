@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#include "core/common/common.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+/**
+ * Runs submitted by a caller are executed on thread pools, at most max_concurrent_runs at a time, and their
+ * results are collected in a queue the caller drains at its own pace.
+ *
+ * A run that cannot start because max_concurrent_runs are in flight waits in a FIFO. Submit() blocks while
+ * max_pending_runs runs are waiting, which bounds the memory held by queued requests.
+ * When a run finishes, the next waiting run is scheduled on its own thread pool.
+ */
+class RunCompletionQueue {
+ public:
+  struct Completion {
+    void* tag;
+    Status status;
+  };
+
+  /**
+   * @param max_concurrent_runs Maximum number of runs executing at once. Must be greater than 0.
+   * @param max_pending_runs Maximum number of runs waiting to start before Submit() blocks. 0 means no limit.
+   */
+  RunCompletionQueue(size_t max_concurrent_runs, size_t max_pending_runs);
+
+  // Waits for the executing runs to finish. Runs that have not started are dropped without a completion.
+  ~RunCompletionQueue();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunCompletionQueue);
+
+  /**
+   * Submits a run identified by `tag`. The run is executed on `thread_pool`, which must not be null.
+   * A completion with its tag and status is queued when it finishes.
+   */
+  void Submit(concurrency::ThreadPool* thread_pool, std::function<Status()> run, void* tag);
+
+  /**
+   * Removes up to `max_completions` completions from the queue, oldest first.
+   * Waits up to `timeout` for the first one if the queue is empty. A negative timeout waits indefinitely.
+   * @return The number of completions written to `completions`.
+   */
+  size_t Dequeue(std::chrono::milliseconds timeout, size_t max_completions, Completion* completions);
+
+ private:
+  struct PendingRun {
+    concurrency::ThreadPool* thread_pool;
+    std::function<Status()> run;
+    void* tag;
+  };
+
+  void Start(PendingRun pending_run);
+  void Finish(void* tag, Status status);
+
+  const size_t max_concurrent_runs_;
+  const size_t max_pending_runs_;
+
+  std::mutex mutex_;
+  std::condition_variable completion_cv_;  // signaled when a completion is queued
+  std::condition_variable state_cv_;       // signaled when a pending run starts or a run finishes
+  std::deque<PendingRun> pending_runs_;    // GUARDED_BY(mutex_)
+  std::deque<Completion> completions_;     // GUARDED_BY(mutex_)
+  size_t num_running_ = 0;                 // GUARDED_BY(mutex_)
+};
+
+}  // namespace onnxruntime
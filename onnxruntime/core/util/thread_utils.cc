@@ -22,6 +22,8 @@ std::ostream& operator<<(std::ostream& os, const OrtThreadPoolParams& params) {
   os << " dynamic_block_base_: " << params.dynamic_block_base_;
   os << " stack_size: " << params.stack_size;
   os << " affinity_str: " << params.affinity_str;
+  os << " numa_aware: " << params.numa_aware;
+  os << " adaptive_spin_target_us: " << params.adaptive_spin_target_us;
   // os << " name: " << (params.name ? params.name : L"nullptr");
   os << " set_denormal_as_zero: " << params.set_denormal_as_zero;
   // os << " custom_create_thread_fn: " << (params.custom_create_thread_fn ? "set" : "nullptr");
@@ -151,6 +153,13 @@ CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   to.custom_thread_creation_options = options.custom_thread_creation_options;
   to.custom_join_thread_fn = options.custom_join_thread_fn;
   to.dynamic_block_base_ = options.dynamic_block_base_;
+  to.numa_aware = options.numa_aware;
+  if (to.numa_aware && to.affinities.empty()) {
+    LOGS_DEFAULT(WARNING) << "NUMA-aware thread pool requested without thread affinities, "
+                          << "falling back to the default work distribution";
+  }
+  ORT_ENFORCE(options.adaptive_spin_target_us >= 0, "adaptive_spin_target_us must be non-negative");
+  to.adaptive_spin_target_us = options.adaptive_spin_target_us;
   if (to.custom_create_thread_fn) {
     ORT_ENFORCE(to.custom_join_thread_fn, "custom join thread function not set");
   }
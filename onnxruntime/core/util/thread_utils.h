@@ -43,6 +43,14 @@ struct OrtThreadPoolParams {
   // meaning ith thread will be attached to first 8 logical processors
   std::string affinity_str;
 
+  // If it is true, group the threads by the NUMA node of their affinity and prefer
+  // distributing and stealing work within a node. Requires thread affinities to be set.
+  bool numa_aware = false;
+
+  // If it is positive and allow_spinning is true, workers adapt the time they spin after the queue
+  // became empty to the observed gaps between work, spinning at most this many microseconds.
+  int adaptive_spin_target_us = 0;
+
   const ORTCHAR_T* name = nullptr;
 
   // Set or unset denormal as zero
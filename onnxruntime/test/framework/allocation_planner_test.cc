@@ -390,6 +390,16 @@ class PlannerTest : public ::testing::Test {
   void SetNodePartitionConfigFilePath(const char* config_file_path) {
     ORT_THROW_IF_ERROR(sess_options_->config_options.AddConfigEntry(kNodePartitionConfigFile, config_file_path));
   }
+  SessionOptions& GetSessionOptions() { return *sess_options_; }
+  std::vector<NodeIndex> GetLaunchedNodes(size_t stream_idx) const {
+    std::vector<NodeIndex> nodes;
+    for (const auto& step : GetState().GetExecutionPlan()->execution_plan[stream_idx]->steps_) {
+      if (strstr(typeid(*step).name(), "LaunchKernelStep") != nullptr) {
+        nodes.push_back(step->GetNodeIndex());
+      }
+    }
+    return nodes;
+  }
   std::unique_ptr<::onnxruntime::KernelDef>& GetStdKernel() { return std_kernel_; }
 #ifdef USE_CUDA
   void MemcpyToHostInCuda_TransposeInCudaAndCpu(const char* partitionConfigFile = nullptr) {
@@ -718,6 +728,86 @@ TEST_F(PlannerTest, InPlaceSizeMismatchTest) {
   CheckFreed(3, {X2});
 }
 
+// InPlaceSecondInputTest: Check that a binary operator reuses its second input in place when the first one is
+// used by a later node.
+TEST_F(PlannerTest, InPlaceSecondInputTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5"), X6("X6"), add("add");
+  std::unique_ptr<KernelDef> binary_in_place_kernel = KernelDefBuilder()
+                                                          .SetName("Add")
+                                                          .Provider(kCpuExecutionProvider)
+                                                          .SinceVersion(7)
+                                                          .MayInplace(0, 0)
+                                                          .MayInplace(1, 0)
+                                                          .Build();
+
+  // graph structure:
+  AddNormalNode(X1, X2);  // X2: temporary, used after the Add node
+  AddNormalNode(X1, X3);  // X3: temporary
+  std::vector<onnxruntime::NodeArg*> add_inputs{Arg(X2), Arg(X3)}, add_outputs{Arg(X4)};
+  AddNode(*binary_in_place_kernel, add, add_inputs, add_outputs);  // X4: temporary
+  AddNormalNode(X2, X5);                                           // X5: output
+  AddNormalNode(X4, X6);                                           // X6: output
+
+  // simulate shape-inference results:
+  Shape shape1{"M", "N"};
+  auto shape = &shape1.value;
+  SetShape({{X1, shape}, {X2, shape}, {X3, shape}, {X4, shape}, {X5, shape}, {X6, shape}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kAllocate);
+  CheckAllocKind(X4, AllocKind::kReuse);
+
+  int x3_index, x4_index;
+  ASSERT_STATUS_OK(GetState().GetOrtValueNameIdxMap().GetIdx(X3, x3_index));
+  ASSERT_STATUS_OK(GetState().GetOrtValueNameIdxMap().GetIdx(X4, x4_index));
+  EXPECT_EQ(GetPlan().allocation_plan[x4_index].reused_buffer, x3_index);
+}
+
+// BoundOutputTest: Check that the value a graph output aliases through Identity nodes is planned to be written to
+// the buffer bound to the graph output, unless the value is used by other nodes.
+TEST_F(PlannerTest, BoundOutputTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5"), X6("X6"), X7("X7");
+  std::unique_ptr<KernelDef> alias_kernel =
+      KernelDefBuilder().SetName("Identity").Provider(kCpuExecutionProvider).SinceVersion(1, 12).Alias(0, 0).Build();
+
+  // graph structure:
+  AddNormalNode(X1, X2);           // X2: temporary, written to the buffer of X4
+  AddNode(*alias_kernel, X2, X3);  // X3: temporary, alias of X2
+  AddNode(*alias_kernel, X3, X4);  // X4: output
+  AddNormalNode(X1, X5);           // X5: temporary, used by two nodes
+  AddNode(*alias_kernel, X5, X6);  // X6: output
+  AddNormalNode(X5, X7);           // X7: output
+
+  // simulate shape-inference results:
+  Shape shape1{"M", "N"};
+  auto shape = &shape1.value;
+  SetShape({{X1, shape}, {X2, shape}, {X3, shape}, {X4, shape}, {X5, shape}, {X6, shape}, {X7, shape}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kReuse);
+  CheckAllocKind(X4, AllocKind::kAllocateOutput);
+  CheckAllocKind(X5, AllocKind::kAllocate);
+
+  int x2_index, x3_index, x4_index, x5_index;
+  ASSERT_STATUS_OK(GetState().GetOrtValueNameIdxMap().GetIdx(X2, x2_index));
+  ASSERT_STATUS_OK(GetState().GetOrtValueNameIdxMap().GetIdx(X3, x3_index));
+  ASSERT_STATUS_OK(GetState().GetOrtValueNameIdxMap().GetIdx(X4, x4_index));
+  ASSERT_STATUS_OK(GetState().GetOrtValueNameIdxMap().GetIdx(X5, x5_index));
+  EXPECT_EQ(GetPlan().allocation_plan[x2_index].bound_output, x4_index);
+  // X3 aliases X2, so it shares the bound buffer.
+  EXPECT_EQ(GetPlan().allocation_plan[x3_index].reused_buffer, x2_index);
+  EXPECT_EQ(GetPlan().allocation_plan[x3_index].bound_output, x4_index);
+  EXPECT_EQ(GetPlan().allocation_plan[x5_index].bound_output, -1);
+}
+
 // Test operator<< to output details of an allocation & execution plan.
 TEST_F(PlannerTest, PlanOutputTest) {
   // tensor variables:
@@ -1450,6 +1540,71 @@ TEST_F(PlannerTest, MultiStream2NodesSameStreamConsumedBy1NodeInDifferentStream)
 }
 #endif
 
+// Test ExecutionOrder::CRITICAL_PATH with parallel execution on the graph:
+// p1    p3
+// |     |
+// p2    p4
+//   \   /
+//    p5
+// The recorded profile makes p3 and p4 the long branch, so it is expected to be started first.
+TEST_F(PlannerTest, CriticalPathOrderParallel) {
+  std::unique_ptr<::onnxruntime::KernelDef> cpuKernelAdd = KernelDefBuilder().SetName("Add").Provider(kCpuExecutionProvider).SinceVersion(1, 10).Build();
+  std::string Graph_input("Graph_input"), Arg1("Arg1"), Arg2("Arg2"), Arg3("Arg3"), Arg4("Arg4"), Arg5("Arg5"),
+      p1("p1"), p2("p2"), p3("p3"), p4("p4"), p5("p5");
+  std::vector<onnxruntime::NodeArg*> input1{Arg(Graph_input)}, output1{Arg(Arg1)}, output2{Arg(Arg2)},
+      output3{Arg(Arg3)}, output4{Arg(Arg4)}, input5{Arg(Arg2), Arg(Arg4)}, output5{Arg(Arg5)};
+  auto* node1 = AddNode(*GetStdKernel(), p1, input1, output1);
+  auto* node2 = AddNode(*GetStdKernel(), p2, output1, output2);
+  auto* node3 = AddNode(*GetStdKernel(), p3, input1, output3);
+  auto* node4 = AddNode(*GetStdKernel(), p4, output3, output4);
+  auto* node5 = AddNode(*cpuKernelAdd, p5, input5, output5);
+
+  GetSessionOptions().execution_mode = ExecutionMode::ORT_PARALLEL;
+  GetSessionOptions().execution_order = ExecutionOrder::CRITICAL_PATH;
+  ASSERT_STATUS_OK(GetSessionOptions().config_options.AddConfigEntry(
+      kOrtSessionOptionsConfigNodeCostProfileFile, "./testdata/critical_path_order_profile.json"));
+  CreatePlan({}, false);
+
+  std::vector<NodeIndex> expected{node3->Index(), node4->Index(), node1->Index(), node2->Index(), node5->Index()};
+  ASSERT_EQ(GetState().GetExecutionPlan()->execution_plan.size(), 1U);
+  EXPECT_EQ(GetLaunchedNodes(0), expected);
+}
+
+// Test ExecutionOrder::CRITICAL_PATH with sequential execution on the graph:
+// m1    m3
+// |     |
+// m2    m4
+// m1 has a much larger output than m3 according to the recorded profile, so the m3 branch is expected to run
+// first to keep fewer bytes alive.
+TEST_F(PlannerTest, CriticalPathOrderSequential) {
+  std::string Graph_input("Graph_input"), Arg1("Arg1"), Arg2("Arg2"), Arg3("Arg3"), Arg4("Arg4"),
+      m1("m1"), m2("m2"), m3("m3"), m4("m4");
+  std::vector<onnxruntime::NodeArg*> input1{Arg(Graph_input)}, output1{Arg(Arg1)}, output2{Arg(Arg2)},
+      output3{Arg(Arg3)}, output4{Arg(Arg4)};
+  auto* node1 = AddNode(*GetStdKernel(), m1, input1, output1);
+  auto* node2 = AddNode(*GetStdKernel(), m2, output1, output2);
+  auto* node3 = AddNode(*GetStdKernel(), m3, input1, output3);
+  auto* node4 = AddNode(*GetStdKernel(), m4, output3, output4);
+
+  GetSessionOptions().execution_order = ExecutionOrder::CRITICAL_PATH;
+  ASSERT_STATUS_OK(GetSessionOptions().config_options.AddConfigEntry(
+      kOrtSessionOptionsConfigNodeCostProfileFile, "./testdata/critical_path_order_profile.json"));
+  CreatePlan({}, false);
+
+  std::vector<NodeIndex> expected{node3->Index(), node4->Index(), node1->Index(), node2->Index()};
+  ASSERT_EQ(GetState().GetExecutionPlan()->execution_plan.size(), 1U);
+  EXPECT_EQ(GetLaunchedNodes(0), expected);
+}
+
+TEST(NodeExecutionCostsTest, LoadFromProfile) {
+  NodeExecutionCosts costs;
+  ASSERT_STATUS_OK(LoadNodeExecutionCosts(ORT_TSTR("./testdata/critical_path_order_profile.json"), costs));
+  EXPECT_EQ(costs.size(), 9U);
+  EXPECT_DOUBLE_EQ(costs["p3"].duration_us, 100.0);
+  EXPECT_DOUBLE_EQ(costs["m1"].output_bytes, 4000.0);
+  EXPECT_FALSE(LoadNodeExecutionCosts(ORT_TSTR("./testdata/does_not_exist.json"), costs).IsOK());
+}
+
 #if !defined(__wasm__) && defined(ORT_ENABLE_STREAM)
 TEST_F(PlannerTest, ParaPlanCreation) {
   TypeProto graph_in_type;
@@ -2003,6 +2158,41 @@ TEST_F(PlannerTest, TestMultiStreamMismatchDevice) {
   status = sess.Initialize();
   ASSERT_TRUE(!status.IsOK());
 }
+
+// Test CostBasedPartitioner on the graph:
+// node1   node3
+//   |       |
+// node2   node4
+//    \     /
+//     node5
+// All nodes are CPU EP nodes. The two branches are expected to be placed on separate CPU streams.
+TEST_F(PlannerTest, CostBasedPartitionerTwoBranches) {
+  std::unique_ptr<::onnxruntime::KernelDef> cpuKernelAdd = KernelDefBuilder().SetName("Add").Provider(kCpuExecutionProvider).SinceVersion(1, 10).Build();
+  std::string Graph_input("Graph_input"), Arg1("Arg1"), Arg2("Arg2"), Arg3("Arg3"), Arg4("Arg4"), Arg5("Arg5"),
+      node1("node1"), node2("node2"), node3("node3"), node4("node4"), node5("node5");
+  std::vector<onnxruntime::NodeArg*> input1{Arg(Graph_input)}, output1{Arg(Arg1)}, output2{Arg(Arg2)},
+      output3{Arg(Arg3)}, output4{Arg(Arg4)}, input5{Arg(Arg2), Arg(Arg4)}, output5{Arg(Arg5)};
+  auto* p_node1 = AddNode(*GetStdKernel(), node1, input1, output1);
+  auto* p_node2 = AddNode(*GetStdKernel(), node2, output1, output2);
+  auto* p_node3 = AddNode(*GetStdKernel(), node3, input1, output3);
+  auto* p_node4 = AddNode(*GetStdKernel(), node4, output3, output4);
+  AddNode(*cpuKernelAdd, node5, input5, output5);
+
+  const char* type = "CostBasedPartitioner";
+  auto graph_partitioner = IGraphPartitioner::CreateGraphPartitioner(
+      DefaultLoggingManager().DefaultLogger(),
+      ORT_TSTR("./testdata/multi_stream_models/cost_based_partition.json"));
+  ASSERT_TRUE(graph_partitioner && strcmp(graph_partitioner->Type(), type) == 0);
+
+  SetNodePartitionConfigFilePath("./testdata/multi_stream_models/cost_based_partition.json");
+  CreatePlan({}, false);
+
+  const auto* plan = GetState().GetExecutionPlan();
+  ASSERT_EQ(plan->execution_plan.size(), 2U) << "one CPU stream per branch";
+  EXPECT_EQ(plan->node_stream_map_[p_node1->Index()], plan->node_stream_map_[p_node2->Index()]);
+  EXPECT_EQ(plan->node_stream_map_[p_node3->Index()], plan->node_stream_map_[p_node4->Index()]);
+  EXPECT_NE(plan->node_stream_map_[p_node1->Index()], plan->node_stream_map_[p_node3->Index()]);
+}
 #endif
 
 #if defined(USE_CUDA) && defined(ORT_ENABLE_STREAM)
@@ -6,7 +6,12 @@
 #include "core/framework/allocator_utils.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
+#include <chrono>
 #include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
 #include "core/framework/stream_handles.h"
 
 namespace onnxruntime {
@@ -307,6 +312,246 @@ TEST(BFCArenaTest, TestShrink) {
   EXPECT_EQ(stats.total_allocated_bytes, 10 * 1024 * 1024) << "Expect 10M bytes but actually " << stats.total_allocated_bytes << " bytes";
 }
 
+TEST(BFCArenaTest, TrimToWatermark) {
+  BFCArenaTrimPolicy trim_policy;
+  trim_policy.watermark_bytes = 6 * 1024 * 1024;
+  trim_policy.run_interval = 2;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             BFCArena::DEFAULT_THREAD_LOCAL_CACHE_MAX_BYTES, trim_policy);
+  void* p1k = a.Alloc(1024);
+  a.Free(a.Alloc(4 * 1024 * 1024));
+  a.Free(a.Alloc(8 * 1024 * 1024));
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_extensions, 3);
+
+  a.OnRunEnd();
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_extensions, 3) << "Trimmed before the run interval";
+
+  // The most recent free region is released, which brings the arena below the watermark.
+  a.OnRunEnd();
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_extensions, 2);
+  EXPECT_EQ(stats.total_allocated_bytes, 4 * 1024 * 1024 + 1024);
+  EXPECT_EQ(stats.total_released_bytes, 8 * 1024 * 1024);
+  EXPECT_EQ(a.Trim(), 0u);
+
+  a.Free(p1k);
+}
+
+TEST(BFCArenaTest, TrimWhenIdle) {
+  BFCArenaTrimPolicy trim_policy;
+  trim_policy.watermark_bytes = 0;
+  trim_policy.idle_interval_ms = 10;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             BFCArena::DEFAULT_THREAD_LOCAL_CACHE_MAX_BYTES, trim_policy);
+  a.Free(a.Alloc(4 * 1024 * 1024));
+
+  // The background thread releases the region after two idle checks.
+  AllocatorStats stats;
+  for (int i = 0; i < 500; ++i) {
+    a.GetStats(&stats);
+    if (stats.total_allocated_bytes == 0) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(stats.total_allocated_bytes, 0);
+  EXPECT_EQ(stats.total_released_bytes, 4 * 1024 * 1024);
+}
+
+TEST(BFCArenaTest, ThreadLocalCacheReusesChunks) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             1 << 20);
+
+  // Frees are queued and moved to the cache in batches, so free more pointers than a batch.
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 64; ++i) {
+    ptrs.push_back(a.Alloc(1000));
+  }
+  for (void* p : ptrs) {
+    a.Free(p);
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_cache_hits, 0);
+  EXPECT_EQ(stats.num_cache_misses, 64);
+  // The cached chunks are not in use.
+  EXPECT_EQ(stats.bytes_in_use, 0);
+
+  // A smaller request of the same size class is served by the cached chunks.
+  std::vector<void*> reused_ptrs;
+  for (int i = 0; i < 64; ++i) {
+    reused_ptrs.push_back(a.Alloc(900));
+  }
+  a.GetStats(&stats);
+  EXPECT_GE(stats.num_cache_hits, 32);
+  EXPECT_EQ(stats.num_cache_hits + stats.num_cache_misses, 128);
+  EXPECT_EQ(stats.num_allocs, 128);
+  EXPECT_THAT(reused_ptrs, ::testing::UnorderedElementsAreArray(ptrs));
+  // Cache hits do not update the chunks, whose requested size is their size while they are cached.
+  for (void* p : reused_ptrs) {
+    EXPECT_EQ(a.RequestedSize(p), a.AllocatedSize(p));
+  }
+
+  for (void* p : reused_ptrs) {
+    a.Free(p);
+  }
+
+  // Large allocations bypass the cache, and are returned to the arena when the queue is drained.
+  void* large = a.Alloc(1 << 20);
+  a.Free(large);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_cache_hits + stats.num_cache_misses, 128);
+}
+
+TEST(BFCArenaTest, ThreadLocalCacheIsBypassedForReservedChunks) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             1 << 20);
+
+  void* p1 = a.Alloc(1000);
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  const int64_t region_bytes = stats.total_allocated_bytes;
+
+  // A reserved chunk is queued by Free() like the other pointers, and returned to the device allocator instead of
+  // the cache when the queue is drained by the next cache miss.
+  void* reserved = a.Reserve(1024);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, region_bytes + 1024);
+  a.Free(reserved);
+  void* p2 = a.Alloc(1000);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, region_bytes);
+  EXPECT_EQ(stats.bytes_in_use, 2 * 1024);
+  EXPECT_EQ(stats.num_cache_hits, 0);
+  EXPECT_EQ(stats.num_cache_misses, 2);
+
+  a.Free(p1);
+  a.Free(p2);
+}
+
+TEST(BFCArenaTest, ThreadLocalCacheIsReclaimedOnShrink) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             1 << 20);
+  void* p1k = a.Alloc(1024);
+  void* p10M = a.Alloc(10 * 1024 * 1024);
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_extensions, 2);
+
+  // p1k is held by the cache of this thread until the arena shrinks.
+  a.Free(p1k);
+  EXPECT_EQ(a.Shrink(), Status::OK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_extensions, 1);
+  EXPECT_EQ(stats.total_allocated_bytes, 10 * 1024 * 1024);
+  a.Free(p10M);
+}
+
+TEST(BFCArenaTest, ThreadLocalCacheConcurrentAllocations) {
+  OrtArenaCfg config(0, static_cast<int>(ArenaExtendStrategy::kSameAsRequested), -1, -1, -1, -1);
+  config.thread_local_cache_max_bytes = 64 * 1024;
+  AllocatorCreationInfo device_info{
+      [](OrtDevice::DeviceId) { return std::make_unique<CPUAllocator>(); },
+      0, true, config};
+  auto allocator = CreateAllocator(device_info);
+  BFCArena& a = *static_cast<BFCArena*>(allocator.get());
+
+  constexpr int kNumThreads = 4;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&a, t]() {
+      std::vector<void*> ptrs;
+      for (int i = 0; i < 2000; ++i) {
+        const size_t size = 64 + ((i * 37 + t) % 16) * 1024;
+        void* p = a.Alloc(size);
+        ASSERT_NE(p, nullptr);
+        ptrs.push_back(p);
+        if (ptrs.size() == 48) {
+          for (void* q : ptrs) {
+            a.Free(q);
+          }
+          ptrs.clear();
+        }
+      }
+      for (void* q : ptrs) {
+        a.Free(q);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_cache_hits + stats.num_cache_misses, kNumThreads * 2000);
+  EXPECT_GT(stats.num_cache_hits, 0);
+
+  // The caches were returned to the arena when the threads exited.
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
+TEST(BFCArenaTest, AllocationTimeline) {
+  const std::filesystem::path file_path = "bfc_arena_allocation_timeline.json";
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30);
+  a.SetAllocationTimeline(std::make_shared<AllocationTimeline>(file_path));
+
+  void* p1;
+  void* p2;
+  {
+    AllocationTimeline::ScopedAttribution node("conv1");
+    AllocationTimeline::ScopedAttribution output(3);
+    p1 = a.Alloc(1024);
+  }
+  p2 = a.Alloc(2048);
+  std::ostringstream p2_id;
+  p2_id << p2;
+  a.Free(p1);
+
+  // The thread caches are bypassed while recording, so the freed chunk is back in a bin.
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_cache_hits + stats.num_cache_misses, 0);
+
+  // The file is completed when the arena releases the timeline.
+  a.SetAllocationTimeline(nullptr);
+  a.Free(p2);
+
+  std::ifstream file(file_path);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  const std::string trace = contents.str();
+  file.close();
+  std::filesystem::remove(file_path);
+
+  ASSERT_EQ(trace.front(), '[');
+  EXPECT_EQ(trace[trace.find_last_not_of('\n')], ']');
+  EXPECT_THAT(trace, testing::HasSubstr(R"("ph" : "b","id" : ")"));
+  EXPECT_THAT(trace, testing::HasSubstr(R"("name" :"conv1","args" : {"arena" : "Cpu","node" : "conv1",)"
+                                        R"("ort_value_index" : 3,"size" : 1024,"region" : 0,"offset" : 0,)"));
+  EXPECT_THAT(trace, testing::HasSubstr(R"("ph" : "e","id" : ")"));
+  EXPECT_THAT(trace, testing::HasSubstr(R"("name" :"Cpu fragmentation")"));
+  EXPECT_THAT(trace, testing::HasSubstr(R"("name" :"Cpu free chunks per bin")"));
+  // p2 was freed after the recording stopped.
+  EXPECT_THAT(trace, testing::Not(testing::HasSubstr(R"("ph" : "e","id" : ")" + p2_id.str())));
+}
+
 class BadAllocator : public IAllocator {
  public:
   BadAllocator() : IAllocator(OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator)) {}
@@ -8,6 +8,7 @@
 #include "core/graph/model.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test_utils.h"
 #include "test/test_environment.h"
 #include "test/framework/TestAllocatorManager.h"
@@ -119,6 +120,90 @@ TEST_F(ExecutionFrameTest, TensorAllocationTest) {
   ASSERT_EQ(tensor2->Data<float>(), p_tensor->Data<float>());
 }
 
+// T is planned to be written to the buffer of the graph output Y that aliases it, when the buffer bound for Y fits.
+TEST_F(ExecutionFrameTest, BoundOutputBufferTest) {
+  onnxruntime::Model model("test", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg input_def("X", &tensor_float), relu_out_def("T", &tensor_float),
+      output_def("Y", &tensor_float);
+
+  graph.AddNode("node1", "Relu", "Relu operator", ArgMap{&input_def}, ArgMap{&relu_out_def})
+      .SetExecutionProviderType(kCpuExecutionProvider);
+  graph.AddNode("node2", "Identity", "Identity operator", ArgMap{&relu_out_def}, ArgMap{&output_def})
+      .SetExecutionProviderType(kCpuExecutionProvider);
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_typ = cpu_xp->Type();
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(xp_typ, std::move(cpu_xp)));
+  KernelRegistryManager kernel_registry_manager;
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  DataTransferManager dtm;
+  ExternalDataLoaderManager edlm;
+  profiling::Profiler profiler;
+
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = false;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.use_deterministic_compute = false;
+  sess_options.enable_mem_reuse = true;
+
+  SessionState state(graph, execution_providers, &tp_, nullptr, dtm, edlm,
+                     DefaultLoggingManager().DefaultLogger(), profiler, sess_options);
+  ASSERT_STATUS_OK(state.FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager));
+
+  const OrtValueNameIdxMap& mlvalue_name_idx_map(state.GetOrtValueNameIdxMap());
+  int t_idx = -1, y_idx = -1;
+  ASSERT_STATUS_OK(mlvalue_name_idx_map.GetIdx("T", t_idx));
+  ASSERT_STATUS_OK(mlvalue_name_idx_map.GetIdx("Y", y_idx));
+  ASSERT_EQ(state.GetExecutionPlan()->allocation_plan[t_idx].bound_output, y_idx);
+
+  auto cpu_allocator = execution_providers.Get(xp_typ)->CreatePreferredAllocators()[0];
+  const TensorShape shape(std::vector<int64_t>{2, 3});
+
+  // Allocates T in a frame whose fetch Y is preallocated and returns whether T was written to the buffer of Y.
+  auto writes_to_bound_output = [&](OrtValue& y_value) {
+    vector<OrtValue> outputs{y_value};
+    ExecutionFrame frame(
+        {},
+        {},
+        AsSpan({y_idx}),
+        outputs,
+        {},
+#ifdef ORT_ENABLE_STREAM
+        {},
+#endif
+        state);
+
+    OrtValue& t_value = *frame.GetMutableNodeInputOrOutputMLValue(t_idx);
+    EXPECT_STATUS_OK(frame.AllocateMLValueTensorSelfOwnBuffer(t_value, t_idx, DataTypeImpl::GetType<float>(),
+                                                              cpu_allocator->Info().device, shape));
+    EXPECT_EQ(t_value.Get<Tensor>().Shape(), shape);
+    return t_value.Get<Tensor>().DataRaw() == y_value.Get<Tensor>().DataRaw();
+  };
+
+  OrtValue matching;
+  CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{2, 3}, std::vector<float>(6, 0.0f), &matching);
+  EXPECT_TRUE(writes_to_bound_output(matching));
+
+  // a buffer of another size falls back to a buffer of its own, which is then copied to the bound buffer.
+  OrtValue larger;
+  CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{3, 3}, std::vector<float>(9, 0.0f), &larger);
+  EXPECT_FALSE(writes_to_bound_output(larger));
+
+  // so does a buffer on another device. the frame never accesses the data, so host memory stands in for it.
+  std::vector<float> host_data(6, 0.0f);
+  OrtMemoryInfo gpu_info("Cuda", OrtAllocatorType::OrtDeviceAllocator,
+                         OrtDevice(OrtDevice::GPU, OrtDevice::MemType::DEFAULT, OrtDevice::VendorIds::NVIDIA, 0));
+  OrtValue other_device;
+  Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), shape, host_data.data(), gpu_info, other_device);
+  EXPECT_FALSE(writes_to_bound_output(other_device));
+}
+
 TEST_F(ExecutionFrameTest, OutputShapeValidationTest) {
   onnxruntime::Model model("test", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
                            {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
@@ -370,6 +455,127 @@ TEST_F(ExecutionFrameTest, MemPatternTest) {
   ASSERT_EQ(p->GetBlock(4)->offset_, kAllocAlignment);
 }
 
+TEST_F(ExecutionFrameTest, SymbolicMemPatternTest) {
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_type = cpu_xp->Type();
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 7;
+  onnxruntime::Model model("test", true, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           domain_to_version, {}, DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  // T1 and T2 have the symbolic batch dimension of X1.
+  TypeProto x1_type(tensor_float), x2_type(tensor_float), x3_type(tensor_float);
+  x1_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  x1_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  x2_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  x2_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  x3_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  x3_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  onnxruntime::NodeArg input_def1("X1", &x1_type),
+      input_def2("X2", &x2_type),
+      input_def3("X3", &x3_type),
+      gemm1_out_def("T1", &tensor_float),
+      gemm2_out_def("T2", &tensor_float),
+      clip_out_def("T3", &tensor_float);
+
+  graph.AddNode("node1", "MatMul", "gemm1", ArgMap{&input_def1, &input_def2}, ArgMap{&gemm1_out_def})
+      .SetExecutionProviderType(xp_type);
+  graph.AddNode("node2", "MatMul", "gemm2", ArgMap{&gemm1_out_def, &input_def3}, ArgMap{&gemm2_out_def})
+      .SetExecutionProviderType(xp_type);
+  graph.AddNode("node3", "Clip", "clip1", ArgMap{&gemm2_out_def}, ArgMap{&clip_out_def})
+      .SetExecutionProviderType(xp_type);
+
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  KernelRegistryManager kernel_registry_manager;
+
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(xp_type, std::move(cpu_xp)));
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  DataTransferManager dtm;
+  ExternalDataLoaderManager edlm;
+  profiling::Profiler profiler;
+
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.enable_mem_reuse = true;
+  ASSERT_STATUS_OK(sess_options.config_options.AddConfigEntry(kOrtSessionOptionsConfigMemoryPatternCacheSize, "1"));
+
+  SessionState state(graph, execution_providers, &tp_, nullptr, dtm, edlm,
+                     DefaultLoggingManager().DefaultLogger(), profiler, sess_options);
+
+  ASSERT_STATUS_OK(state.FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager));
+
+  const OrtValueNameIdxMap& mlvalue_name_idx_map(state.GetOrtValueNameIdxMap());
+
+  int x1_idx = -1, x2_idx = -1, x3_idx = -1;
+  int t1_idx = -1, t2_idx = -1, t3_idx = -1;
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("X1", x1_idx).IsOK());
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("X2", x2_idx).IsOK());
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("X3", x3_idx).IsOK());
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("T1", t1_idx).IsOK());
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("T2", t2_idx).IsOK());
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("T3", t3_idx).IsOK());
+
+  auto cpu_allocator = execution_providers.Get(xp_type)->CreatePreferredAllocators()[0];
+  const auto feed_idxs = AsSpan({x1_idx, x2_idx, x3_idx});
+  auto make_feeds = [&](int64_t batch) {
+    std::vector<OrtValue> feeds(3);
+    CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{batch, 2},
+                         std::vector<float>(static_cast<size_t>(batch) * 2, 1.0f), &feeds[0]);
+    CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{2, 2}, std::vector<float>(4, 1.0f), &feeds[1]);
+    CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{2, 3}, std::vector<float>(6, 1.0f), &feeds[2]);
+    return feeds;
+  };
+
+  // Trace a run with a batch of 1.
+  std::vector<OrtValue> feeds = make_feeds(1);
+  std::vector<OrtValue> outputs;
+  ExecutionFrame frame(feed_idxs, feeds, AsSpan({t3_idx}), outputs, {},
+#ifdef ORT_ENABLE_STREAM
+                       {},
+#endif
+                       state);
+  ASSERT_TRUE(frame.HasMemoryPatternPlanner());
+
+  OrtValue& t1_value = *frame.GetMutableNodeInputOrOutputMLValue(t1_idx);
+  OrtValue& t2_value = *frame.GetMutableNodeInputOrOutputMLValue(t2_idx);
+  ASSERT_STATUS_OK(frame.AllocateMLValueTensorSelfOwnBuffer(t1_value, t1_idx, DataTypeImpl::GetType<float>(),
+                                                            cpu_allocator->Info().device,
+                                                            TensorShape(std::vector<int64_t>{1, 2})));
+  ASSERT_STATUS_OK(frame.AllocateMLValueTensorSelfOwnBuffer(t2_value, t2_idx, DataTypeImpl::GetType<float>(),
+                                                            cpu_allocator->Info().device,
+                                                            TensorShape(std::vector<int64_t>{1, 3})));
+
+  MemoryPatternGroup pattern;
+  MemoryPatternTrace trace;
+  ASSERT_STATUS_OK(frame.GeneratePatterns(pattern, &trace));
+  ASSERT_STATUS_OK(state.UpdateMemoryPatternGroupCache(feeds, feed_idxs, std::move(pattern), &trace));
+
+  // The pattern of a batch of 16 is generated without tracing another run.
+  std::vector<OrtValue> feeds16 = make_feeds(16);
+  const InlinedHashMap<int, TensorShape>* inferred_shapes = nullptr;
+  auto pattern16 = state.GetMemoryPatternGroup(feeds16, feed_idxs, inferred_shapes);
+  ASSERT_NE(pattern16, nullptr);
+  auto p = pattern16->GetPatterns(cpu_allocator->Info().device);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(p->GetBlock(t1_idx)->size_, 16u * 2 * sizeof(float));
+  EXPECT_EQ(p->GetBlock(t1_idx)->offset_, 0u);
+  EXPECT_EQ(p->GetBlock(t2_idx)->size_, 16u * 3 * sizeof(float));
+  EXPECT_EQ(p->GetBlock(t2_idx)->offset_, 16u * 2 * sizeof(float));
+  EXPECT_EQ(state.GetMemoryPatternGroup(feeds16, feed_idxs, inferred_shapes), pattern16);
+
+  // The cache holds a single pattern, so the pattern of a batch of 1 was evicted and is generated again.
+  auto pattern1 = state.GetMemoryPatternGroup(feeds, feed_idxs, inferred_shapes);
+  ASSERT_NE(pattern1, nullptr);
+  EXPECT_EQ(pattern1->GetPatterns(cpu_allocator->Info().device)->GetBlock(t2_idx)->offset_, kAllocAlignment);
+  EXPECT_NE(state.GetMemoryPatternGroup(feeds16, feed_idxs, inferred_shapes), pattern16);
+}
+
 #ifdef ENABLE_TRAINING
 TEST_F(ExecutionFrameTest, MemPatternWithExternalOutputsTest) {
   auto cpu_xp = CreateCPUExecutionProvider();
@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/huge_page_allocator.h"
+
+#include <cstring>
+
+#include "core/framework/allocator_utils.h"
+#include "core/framework/bfc_arena.h"
+#include "core/framework/prepacked_weights_container.h"
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+// Whether huge pages are available depends on the machine, so the tests accept a fallback to normal pages.
+void CheckHugePageBuffer(IAllocator& allocator, void* p, size_t size) {
+  ASSERT_NE(p, nullptr);
+  std::memset(p, 1, size);
+
+  AllocatorStats stats;
+  allocator.GetStats(&stats);
+  if (stats.num_huge_page_fallbacks == 0) {
+    EXPECT_GE(stats.huge_page_bytes, static_cast<int64_t>(size));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % HugePageAllocator::kHugePageSize, 0u);
+  } else {
+    EXPECT_EQ(stats.huge_page_bytes, 0);
+  }
+}
+}  // namespace
+
+TEST(HugePageAllocatorTest, SmallBuffersUseNormalPages) {
+  HugePageAllocator allocator(std::make_unique<CPUAllocator>(), HugePageMode::kTransparent);
+  void* p = allocator.Alloc(4096);
+  ASSERT_NE(p, nullptr);
+
+  AllocatorStats stats;
+  allocator.GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, 1);
+  EXPECT_EQ(stats.huge_page_bytes, 0);
+  EXPECT_EQ(stats.num_huge_page_fallbacks, 0);
+  allocator.Free(p);
+}
+
+TEST(HugePageAllocatorTest, LargeBuffers) {
+  for (auto mode : {HugePageMode::kTransparent, HugePageMode::kExplicit}) {
+    HugePageAllocator allocator(std::make_unique<CPUAllocator>(), mode);
+    const size_t size = 3 * HugePageAllocator::kHugePageSize / 2;
+    void* p = allocator.Alloc(size);
+    CheckHugePageBuffer(allocator, p, size);
+    allocator.Free(p);
+
+    AllocatorStats stats;
+    allocator.GetStats(&stats);
+    EXPECT_EQ(stats.huge_page_bytes, 0);
+  }
+}
+
+TEST(HugePageAllocatorTest, ArenaRegions) {
+  OrtArenaCfg config(0, -1, -1, -1, -1, -1);
+  config.huge_page_mode = static_cast<int>(HugePageMode::kTransparent);
+  AllocatorCreationInfo device_info{
+      [](OrtDevice::DeviceId) { return std::make_unique<CPUAllocator>(); },
+      0, true, config};
+  auto allocator = CreateAllocator(device_info);
+  ASSERT_NE(dynamic_cast<BFCArena*>(allocator.get()), nullptr);
+
+  // The first region fills a huge page even though the request is small, and its padding does not take
+  // another huge page.
+  void* p = allocator->Alloc(1024);
+  ASSERT_NE(p, nullptr);
+  AllocatorStats stats;
+  allocator->GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes,
+            static_cast<int64_t>(HugePageAllocator::kHugePageSize - HugePageAllocator::kHugePagePadding));
+  if (stats.num_huge_page_fallbacks == 0) {
+    EXPECT_EQ(stats.huge_page_bytes, static_cast<int64_t>(HugePageAllocator::kHugePageSize));
+  }
+  allocator->Free(p);
+}
+
+TEST(HugePageAllocatorTest, RegionSizeForHugePages) {
+  constexpr size_t kRegionSize = HugePageAllocator::kHugePageSize - HugePageAllocator::kHugePagePadding;
+  EXPECT_EQ(HugePageAllocator::RegionSizeForHugePages(1024), kRegionSize);
+  EXPECT_EQ(HugePageAllocator::RegionSizeForHugePages(HugePageAllocator::kHugePageSize), kRegionSize);
+  EXPECT_EQ(HugePageAllocator::RegionSizeForHugePages(HugePageAllocator::kHugePageSize + 1),
+            2 * HugePageAllocator::kHugePageSize - HugePageAllocator::kHugePagePadding);
+}
+
+TEST(HugePageAllocatorTest, PrepackedWeightsContainer) {
+  OrtArenaCfg config(0, -1, -1, -1, -1, -1);
+  config.huge_page_mode = static_cast<int>(HugePageMode::kTransparent);
+  PrepackedWeightsContainer container(config);
+  auto allocator = container.GetOrCreateAllocator(CPU);
+  ASSERT_NE(dynamic_cast<HugePageAllocator*>(allocator.get()), nullptr);
+
+  const size_t size = 2 * HugePageAllocator::kHugePageSize;
+  void* p = allocator->Alloc(size);
+  CheckHugePageBuffer(*allocator, p, size);
+  allocator->Free(p);
+
+  PrepackedWeightsContainer default_container;
+  EXPECT_EQ(dynamic_cast<HugePageAllocator*>(default_container.GetOrCreateAllocator(CPU).get()), nullptr);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
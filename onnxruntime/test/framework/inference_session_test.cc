@@ -57,6 +57,7 @@
 #include "test/providers/provider_test_utils.h"
 #include "test/optimizer/dummy_graph_transformer.h"
 #include "test/util/include/default_providers.h"
+#include "test/util/include/file_util.h"
 #include "test/util/include/inference_session_wrapper.h"
 
 #include "gtest/gtest.h"
@@ -1229,6 +1230,120 @@ TEST(InferenceSessionTests, TestIOBindingReuse) {
   }
 }
 
+// Y = Reshape(MatMul(A, B), [4]) and Z = Neg(Neg(Reshape(Y, [2, 2]))). The first Neg reuses the buffer of the MatMul
+// output, which is written to the buffer bound to Y.
+static void CreateMatMulReshapeModel(std::unique_ptr<onnxruntime::Model>& p_model) {
+  p_model = std::make_unique<Model>("matmul_reshape", false, ModelMetaData(), PathString(),
+                                    IOnnxRuntimeOpSchemaRegistryList(), std::unordered_map<std::string, int>{{kOnnxDomain, 13}},
+                                    std::vector<ONNX_NAMESPACE::FunctionProto>{},
+                                    DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = p_model->MainGraph();
+
+  auto make_type = [](std::initializer_list<int64_t> dims) {
+    TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    for (int64_t dim : dims) {
+      type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+    }
+    return type;
+  };
+  const TypeProto type_2x3 = make_type({2, 3});
+  const TypeProto type_3x2 = make_type({3, 2});
+  const TypeProto type_2x2 = make_type({2, 2});
+  const TypeProto type_4 = make_type({4});
+
+  auto add_shape_initializer = [&graph](const std::string& name, std::initializer_list<int64_t> shape) {
+    ONNX_NAMESPACE::TensorProto tensor{};
+    tensor.set_name(name);
+    tensor.add_dims(static_cast<int64_t>(shape.size()));
+    tensor.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+    for (int64_t dim : shape) {
+      tensor.add_int64_data(dim);
+    }
+    graph.AddInitializedTensor(tensor);
+    return &graph.GetOrCreateNodeArg(name, nullptr);
+  };
+
+  auto& a = graph.GetOrCreateNodeArg("A", &type_2x3);
+  auto& b = graph.GetOrCreateNodeArg("B", &type_3x2);
+  auto& t = graph.GetOrCreateNodeArg("T", &type_2x2);
+  auto& y = graph.GetOrCreateNodeArg("Y", &type_4);
+  auto& t2 = graph.GetOrCreateNodeArg("T2", &type_2x2);
+  auto& u = graph.GetOrCreateNodeArg("U", &type_2x2);
+  auto& z = graph.GetOrCreateNodeArg("Z", &type_2x2);
+  auto* shape_4 = add_shape_initializer("shape_4", {4});
+  auto* shape_2x2 = add_shape_initializer("shape_2x2", {2, 2});
+
+  graph.AddNode("matmul", "MatMul", "", {&a, &b}, {&t});
+  graph.AddNode("reshape_y", "Reshape", "", {&t, shape_4}, {&y});
+  graph.AddNode("reshape_t2", "Reshape", "", {&y, shape_2x2}, {&t2});
+  graph.AddNode("neg_u", "Neg", "", {&t2}, {&u});
+  graph.AddNode("neg_z", "Neg", "", {&u}, {&z});
+  graph.SetOutputs({&y, &z});
+  ASSERT_STATUS_OK(graph.Resolve());
+}
+
+TEST(InferenceSessionTests, TestIOBindingWritesAliasedOutputInPlace) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestIOBindingWritesAliasedOutputInPlace";
+  so.graph_optimization_level = TransformerLevel::Default;
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  std::unique_ptr<Model> p_model;
+  CreateMatMulReshapeModel(p_model);
+
+  std::string s1;
+  p_model->ToProto().SerializeToString(&s1);
+  std::stringstream sstr(s1);
+  ASSERT_STATUS_OK(session_object.Load(sstr));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // the MatMul output is planned to be written to the buffer bound to Y, and its buffer is reused by U.
+  const auto& session_state = session_object.GetSessionState();
+  int t_index, u_index, y_index;
+  ASSERT_STATUS_OK(session_state.GetOrtValueNameIdxMap().GetIdx("T", t_index));
+  ASSERT_STATUS_OK(session_state.GetOrtValueNameIdxMap().GetIdx("U", u_index));
+  ASSERT_STATUS_OK(session_state.GetOrtValueNameIdxMap().GetIdx("Y", y_index));
+  const auto& plan = session_state.GetExecutionPlan()->allocation_plan;
+  EXPECT_EQ(plan[t_index].bound_output, y_index);
+  EXPECT_EQ(plan[u_index].alloc_kind, AllocKind::kReuse);
+  EXPECT_EQ(plan[u_index].reused_buffer, t_index);
+
+  auto cpu_alloc = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  OrtValue a, b;
+  CreateMLValue<float>(cpu_alloc, std::vector<int64_t>{2, 3}, std::vector<float>{1, 2, 3, 4, 5, 6}, &a);
+  CreateMLValue<float>(cpu_alloc, std::vector<int64_t>{3, 2}, std::vector<float>{1, 2, 3, 4, 5, 6}, &b);
+  const std::vector<float> expected_values{22, 28, 49, 64};
+
+  std::unique_ptr<IOBinding> io_binding;
+  ASSERT_STATUS_OK(session_object.NewIOBinding(&io_binding));
+  ASSERT_STATUS_OK(io_binding->BindInput("A", a));
+  ASSERT_STATUS_OK(io_binding->BindInput("B", b));
+
+  // run twice, to trace the memory patterns and then use them.
+  for (int run = 0; run < 2; ++run) {
+    OrtValue y;
+    AllocateMLValue<float>(cpu_alloc, std::vector<int64_t>{4}, &y);
+    const void* y_buffer = y.Get<Tensor>().DataRaw();
+    ASSERT_STATUS_OK(io_binding->BindOutput("Y", y));
+    ASSERT_STATUS_OK(io_binding->BindOutput("Z"));
+
+    ASSERT_STATUS_OK(session_object.Run(RunOptions(), *io_binding));
+
+    // U must not overwrite Y although the plan reuses the buffer of the MatMul output.
+    const auto& outputs = io_binding->GetOutputs();
+    ASSERT_EQ(outputs.size(), 2u);
+    EXPECT_EQ(outputs[0].Get<Tensor>().DataRaw(), y_buffer);
+    VerifyOutputs(outputs[0].Get<Tensor>(), {4}, expected_values);
+    VerifyOutputs(outputs[1].Get<Tensor>(), {2, 2}, expected_values);
+  }
+
+  // Y is allocated by the session when no buffer is bound.
+  ASSERT_STATUS_OK(io_binding->BindOutput("Y"));
+  ASSERT_STATUS_OK(session_object.Run(RunOptions(), *io_binding));
+  VerifyOutputs(io_binding->GetOutputs()[0].Get<Tensor>(), {4}, expected_values);
+  VerifyOutputs(io_binding->GetOutputs()[1].Get<Tensor>(), {2, 2}, expected_values);
+}
+
 TEST(InferenceSessionTests, InvalidInputTypeOfTensorElement) {
   SessionOptions so;
 
@@ -1955,6 +2070,193 @@ TEST(InferenceSessionTests, Test2LayerNestedSubgraph) {
   VerifyOutputs(fetches, expected_dims, expected_values);
 }
 
+// Y = X * X with X and Y of shape [batch, 2]
+static void CreateDynamicBatchModel(const PathString& model_file_name) {
+  onnxruntime::Model model("dynamic_batch", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("node_1", "Mul", "node 1.", {&x, &x}, {&y});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  ASSERT_STATUS_OK(onnxruntime::Model::Save(model, model_file_name));
+}
+
+TEST(InferenceSessionTests, DynamicBatchingJoinsConcurrentRuns) {
+  PathString model_file_name = ORT_TSTR("dynamic_batching_test_graph.onnx");
+  CreateDynamicBatchModel(model_file_name);
+
+  constexpr int kNumRequests = 4;
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.DynamicBatchingJoinsConcurrentRuns";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigDynamicBatchingMaxBatchSize,
+                                                    std::to_string(kNumRequests).c_str()));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigDynamicBatchingBatchSeparable, "1"));
+  // long enough for all requests to join, a batch is run as soon as it is full or no other request is running
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigDynamicBatchingTimeoutUs, "10000000"));
+  InferenceSession session{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session.Load(model_file_name));
+  ASSERT_STATUS_OK(session.Initialize());
+
+  const std::vector<std::string> output_names{"Y"};
+  std::vector<std::vector<OrtValue>> fetches(kNumRequests);
+  std::vector<Status> statuses(kNumRequests);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumRequests; ++i) {
+    threads.emplace_back([&, i]() {
+      OrtValue x;
+      CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], std::vector<int64_t>{1, 2},
+                           std::vector<float>{static_cast<float>(i), static_cast<float>(i + 1)}, &x);
+      NameMLValMap feeds{{"X", x}};
+      RunOptions run_options;
+      statuses[i] = session.Run(run_options, feeds, output_names, &fetches[i]);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (int i = 0; i < kNumRequests; ++i) {
+    ASSERT_STATUS_OK(statuses[i]);
+    ASSERT_EQ(fetches[i].size(), 1u);
+    VerifyOutputs(fetches[i], {1, 2}, {static_cast<float>(i * i), static_cast<float>((i + 1) * (i + 1))});
+  }
+
+  // a request that arrives while no other request is running does not wait for the timeout
+  OrtValue single_x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], std::vector<int64_t>{1, 2},
+                       std::vector<float>{3.0f, 4.0f}, &single_x);
+  NameMLValMap single_feeds{{"X", single_x}};
+  std::vector<OrtValue> single_fetches;
+  const auto start = std::chrono::steady_clock::now();
+  ASSERT_STATUS_OK(session.Run(RunOptions(), single_feeds, output_names, &single_fetches));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+  VerifyOutputs(single_fetches, {1, 2}, {9.0f, 16.0f});
+
+  // a request with the maximum batch size is not batched
+  OrtValue x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0],
+                       std::vector<int64_t>{kNumRequests, 2}, std::vector<float>(kNumRequests * 2, 2.0f), &x);
+  NameMLValMap feeds{{"X", x}};
+  std::vector<OrtValue> batch_fetches;
+  ASSERT_STATUS_OK(session.Run(RunOptions(), feeds, output_names, &batch_fetches));
+  VerifyOutputs(batch_fetches, {kNumRequests, 2}, std::vector<float>(kNumRequests * 2, 4.0f));
+}
+
+TEST(InferenceSessionTests, RunFailsAfterDeadline) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.RunFailsAfterDeadline";
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  std::vector<int64_t> dims_mul_x = {3, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  OrtValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims_mul_x, values_mul_x,
+                       &ml_value);
+  NameMLValMap feeds{{"X", ml_value}};
+  std::vector<std::string> output_names{"Y"};
+  std::vector<OrtValue> fetches;
+
+  RunOptions run_options;
+  run_options.deadline = std::chrono::steady_clock::now();
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(session_object.Run(run_options, feeds, output_names, &fetches),
+                                      "deadline of the Run has passed");
+
+  // a deadline in the future does not affect the Run
+  run_options.deadline = std::chrono::steady_clock::now() + std::chrono::hours(1);
+  fetches.clear();
+  ASSERT_STATUS_OK(session_object.Run(run_options, feeds, output_names, &fetches));
+  VerifyOutputs(fetches, dims_mul_x, {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f});
+}
+
+TEST(InferenceSessionTests, MemoryBudget) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.MemoryBudget";
+
+  // the output of the single node of the model needs more than 16 bytes
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigMemoryBudgetBytes, "16"));
+  {
+    InferenceSession session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+    auto status = session_object.Initialize();
+    ASSERT_FALSE(status.IsOK());
+    EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("No execution plan fits the memory budget"));
+  }
+
+  so.config_options.configurations[kOrtSessionOptionsConfigMemoryBudgetBytes] = "4096";
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  std::vector<int64_t> dims_mul_x = {3, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  OrtValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims_mul_x, values_mul_x,
+                       &ml_value);
+  NameMLValMap feeds{{"X", ml_value}};
+  std::vector<std::string> output_names{"Y"};
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, output_names, &fetches));
+  VerifyOutputs(fetches, dims_mul_x, {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f});
+}
+
+TEST(InferenceSessionTests, LearnsNodeThreadCounts) {
+  const PathString thread_counts_file = ORT_TSTR("inference_session_node_thread_counts.json");
+  ScopedFileDeleter file_deleter(thread_counts_file);
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.LearnsNodeThreadCounts";
+  so.intra_op_param.thread_pool_size = 4;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigNodeThreadCountsFile,
+                                                    ToUTF8String(thread_counts_file).c_str()));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigNodeThreadCountsTuningRuns, "1"));
+
+  std::vector<int64_t> dims_mul_x = {3, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  OrtValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims_mul_x, values_mul_x,
+                       &ml_value);
+  NameMLValMap feeds{{"X", ml_value}};
+  std::vector<std::string> output_names{"Y"};
+
+  {
+    InferenceSession session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+    ASSERT_STATUS_OK(session_object.Initialize());
+
+    // thread counts of 1, 2 and 4 are measured once for each node
+    for (int i = 0; i < 3; ++i) {
+      std::vector<OrtValue> fetches;
+      ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, output_names, &fetches));
+      VerifyOutputs(fetches, dims_mul_x, {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f});
+    }
+  }
+
+  std::ifstream learned(thread_counts_file);
+  ASSERT_TRUE(learned.is_open());
+  const std::string content((std::istreambuf_iterator<char>(learned)), std::istreambuf_iterator<char>());
+  EXPECT_NE(content.find("node_thread_counts"), std::string::npos);
+  EXPECT_NE(content.find("mul_1_"), std::string::npos);
+
+  // a session without learning uses the saved thread counts
+  so.config_options.configurations.erase(kOrtSessionOptionsConfigNodeThreadCountsTuningRuns);
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, output_names, &fetches));
+  VerifyOutputs(fetches, dims_mul_x, {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f});
+}
+
 TEST(InferenceSessionTests, TestTruncatedSequence) {
   // model/data generated by <repo>/onnxruntime/test/testdata/CNTK/gen.py GenScan()
   // Manually updated to have IR version of 4.
@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/node_thread_counts.h"
+
+#include <fstream>
+
+#include "gtest/gtest.h"
+#include "test/util/include/asserts.h"
+#include "test/util/include/file_util.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+// Runs the learning executions of a node, timing each candidate thread count with `duration_us`.
+template <typename DurationFn>
+void LearnThreadCount(NodeThreadCounts& thread_counts, NodeThreadCounts::Entry& entry, size_t num_executions,
+                      DurationFn duration_us) {
+  for (size_t i = 0; i < num_executions; ++i) {
+    bool tuning = false;
+    const int thread_count = thread_counts.GetThreadCount(entry, tuning);
+    ASSERT_TRUE(tuning);
+    thread_counts.ReportDuration(entry, thread_count, std::chrono::microseconds(duration_us(thread_count)));
+  }
+}
+}  // namespace
+
+TEST(NodeThreadCountsTest, LearnsSmallestThreadCountCloseToFastest) {
+  // candidates are 1, 2, 4 and 8 threads
+  NodeThreadCounts thread_counts(8, 2);
+  auto& entry = thread_counts.GetOrAddEntry("node");
+
+  LearnThreadCount(thread_counts, entry, 8, [](int thread_count) {
+    switch (thread_count) {
+      case 1:
+        return 100;
+      case 2:
+        return 60;
+      case 4:
+        return 39;
+      default:
+        return 38;
+    }
+  });
+
+  bool tuning = true;
+  EXPECT_EQ(thread_counts.GetThreadCount(entry, tuning), 4);
+  EXPECT_FALSE(tuning);
+}
+
+TEST(NodeThreadCountsTest, FullPoolIsStoredAsNoLimit) {
+  NodeThreadCounts thread_counts(4, 1);
+  auto& entry = thread_counts.GetOrAddEntry("node");
+
+  LearnThreadCount(thread_counts, entry, 3, [](int thread_count) { return 100 / thread_count; });
+
+  bool tuning = true;
+  EXPECT_EQ(thread_counts.GetThreadCount(entry, tuning), 0);
+  EXPECT_FALSE(tuning);
+}
+
+TEST(NodeThreadCountsTest, NoLearningWithoutTuningRuns) {
+  NodeThreadCounts thread_counts(8, 0);
+  auto& entry = thread_counts.GetOrAddEntry("node");
+
+  bool tuning = true;
+  EXPECT_EQ(thread_counts.GetThreadCount(entry, tuning), 0);
+  EXPECT_FALSE(tuning);
+}
+
+TEST(NodeThreadCountsTest, SaveAndLoad) {
+  const PathString file_path = ORT_TSTR("node_thread_counts_test.json");
+  ScopedFileDeleter file_deleter(file_path);
+
+  {
+    NodeThreadCounts thread_counts(2, 1);
+    auto& learned = thread_counts.GetOrAddEntry("learned");
+    thread_counts.GetOrAddEntry("not_learned");
+    LearnThreadCount(thread_counts, learned, 2, [](int thread_count) { return thread_count == 1 ? 10 : 20; });
+    ASSERT_STATUS_OK(thread_counts.SaveIfUpdated(file_path));
+  }
+
+  NodeThreadCounts thread_counts(2, 1);
+  ASSERT_STATUS_OK(thread_counts.Load(file_path));
+
+  bool tuning = true;
+  EXPECT_EQ(thread_counts.GetThreadCount(thread_counts.GetOrAddEntry("learned"), tuning), 1);
+  EXPECT_FALSE(tuning);
+
+  // nodes that had not finished learning are learned again
+  thread_counts.GetThreadCount(thread_counts.GetOrAddEntry("not_learned"), tuning);
+  EXPECT_TRUE(tuning);
+}
+
+TEST(NodeThreadCountsTest, LoadRejectsInvalidThreadCount) {
+  const PathString file_path = ORT_TSTR("node_thread_counts_invalid_test.json");
+  ScopedFileDeleter file_deleter(file_path);
+  {
+    std::ofstream of_stream(file_path);
+    of_stream << R"({"node_thread_counts":{"node":-1}})";
+  }
+
+  NodeThreadCounts thread_counts(8, 0);
+  ASSERT_STATUS_NOT_OK(thread_counts.Load(file_path));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
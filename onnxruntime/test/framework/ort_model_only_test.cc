@@ -533,6 +533,13 @@ TEST(OrtModelOnlyTests, LoadOrtFormatModel) {
   RunOrtModel(test_info);
 }
 
+// Memory map the model file instead of reading it into memory
+TEST(OrtModelOnlyTests, LoadOrtFormatModelWithMapping) {
+  OrtModelTestInfo test_info = GetTestInfoForLoadOrtFormatModel();
+  test_info.configs.push_back(std::make_pair(kOrtSessionOptionsConfigMapORTModelFile, "1"));
+  RunOrtModel(test_info);
+}
+
 // Load the model from a buffer instead of a file path
 TEST(OrtModelOnlyTests, LoadOrtFormatModelFromBuffer) {
   OrtModelTestInfo test_info = GetTestInfoForLoadOrtFormatModel();
@@ -0,0 +1,122 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shared_initializer_store.h"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/framework/tensor.h"
+#include "gtest/gtest.h"
+#include "test/framework/test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+constexpr int64_t kNumElements = SharedInitializerStore::kMinSharedBytes / sizeof(float);
+
+OrtValue CreateInitializer(float value, int64_t num_elements = kNumElements) {
+  OrtValue ort_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {num_elements},
+                       std::vector<float>(static_cast<size_t>(num_elements), value), &ort_value);
+  return ort_value;
+}
+}  // namespace
+
+TEST(SharedInitializerStoreTest, IdenticalInitializersShareBuffer) {
+  SharedInitializerStore store;
+
+  OrtValue a = CreateInitializer(1.f);
+  OrtValue b = CreateInitializer(1.f);
+  OrtValue c = CreateInitializer(2.f);
+
+  auto shared_a = store.GetOrAdd(a);
+  auto shared_b = store.GetOrAdd(b);
+  auto shared_c = store.GetOrAdd(c);
+
+  EXPECT_EQ(shared_a, shared_b);
+  EXPECT_EQ(shared_a->Get<Tensor>().DataRaw(), a.Get<Tensor>().DataRaw());
+  EXPECT_NE(shared_a, shared_c);
+
+  auto stats = store.GetStats();
+  EXPECT_EQ(stats.num_initializers, 2u);
+  EXPECT_EQ(stats.unique_bytes, 2 * SharedInitializerStore::kMinSharedBytes);
+  EXPECT_EQ(stats.saved_bytes, SharedInitializerStore::kMinSharedBytes);
+
+  // Entries without users are dropped.
+  shared_a.reset();
+  shared_b.reset();
+  stats = store.GetStats();
+  EXPECT_EQ(stats.num_initializers, 1u);
+  EXPECT_EQ(stats.saved_bytes, 0u);
+}
+
+TEST(SharedInitializerStoreTest, ConcurrentIdenticalInitializersShareBuffer) {
+  SharedInitializerStore store;
+
+  constexpr int kNumThreads = 8;
+  std::vector<OrtValue> values;
+  for (int i = 0; i < kNumThreads; ++i) {
+    values.push_back(CreateInitializer(1.f));
+  }
+
+  // The contents are compared outside of the lock, so identical values added concurrently must still end up in
+  // a single entry.
+  std::vector<std::shared_ptr<const OrtValue>> shared(kNumThreads);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&store, &values, &shared, i]() { shared[i] = store.GetOrAdd(values[i]); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (int i = 1; i < kNumThreads; ++i) {
+    EXPECT_EQ(shared[i], shared[0]);
+  }
+  const auto stats = store.GetStats();
+  EXPECT_EQ(stats.num_initializers, 1u);
+  EXPECT_EQ(stats.saved_bytes, (kNumThreads - 1) * SharedInitializerStore::kMinSharedBytes);
+}
+
+TEST(SharedInitializerStoreTest, SameBytesWithDifferentShapeAreNotShared) {
+  SharedInitializerStore store;
+
+  OrtValue a = CreateInitializer(1.f);
+  OrtValue b;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {2, kNumElements / 2},
+                       std::vector<float>(static_cast<size_t>(kNumElements), 1.f), &b);
+
+  EXPECT_NE(store.GetOrAdd(a), store.GetOrAdd(b));
+}
+
+TEST(SharedInitializerStoreTest, SmallInitializersCannotBeShared) {
+  EXPECT_TRUE(SharedInitializerStore::CanShare(CreateInitializer(1.f)));
+  EXPECT_FALSE(SharedInitializerStore::CanShare(CreateInitializer(1.f, 16)));
+}
+
+TEST(SharedInitializerStoreTest, PrepackedWeightsAreRemovedWithLastUser) {
+  SharedInitializerStore store;
+  auto& container = store.GetPrepackedWeightsContainer();
+  const std::string key = "MatMul+1";
+
+  {
+    std::lock_guard<std::mutex> lock(container.mutex_);
+    ASSERT_TRUE(container.WriteWeight(key, PrePackedWeights{}));
+    store.AddPrepackedWeightsUser(key);
+    store.AddPrepackedWeightsUser(key);
+  }
+
+  const std::vector<std::string> keys{key};
+  store.ReleasePrepackedWeights(keys);
+  EXPECT_TRUE(container.HasWeight(key));
+
+  store.ReleasePrepackedWeights(keys);
+  EXPECT_FALSE(container.HasWeight(key));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "core/util/thread_utils.h"
+#include "test/mlas/bench/bench_util.h"
+
+#include <stdexcept>
+#include <vector>
+
+using onnxruntime::narrow;
+
+void REDUCE(benchmark::State& state) {
+  const auto kind = static_cast<MLAS_REDUCE_KIND>(state.range(0));
+  const auto outer = narrow<size_t>(state.range(1));
+  const auto reduce = narrow<size_t>(state.range(2));
+  const auto inner = narrow<size_t>(state.range(3));
+  const auto threads = narrow<int>(state.range(4));
+
+  if (outer == 0 || reduce == 0 || inner == 0 || threads <= 0) {
+    throw std::invalid_argument("Outer, Reduce, Inner and Threads must be greater than 0!");
+  }
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = threads;
+  tpo.auto_set_affinity = true;
+
+  std::unique_ptr<onnxruntime::concurrency::ThreadPool> tp(
+      onnxruntime::concurrency::CreateThreadPool(
+          &onnxruntime::Env::Default(), tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+
+  auto input = RandomVectorUniform<float>(outer * reduce * inner, -1.0f, 1.0f);
+  std::vector<float> output(outer * inner);
+
+  // warming up run
+  MlasReduce(kind, input.data(), output.data(), outer, reduce, inner, tp.get());
+
+  for (auto _ : state) {
+    MlasReduce(kind, input.data(), output.data(), outer, reduce, inner, tp.get());
+  }
+
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(input.size() * sizeof(float)));
+}
+
+static void ReduceArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"Kind", "Outer", "Reduce", "Inner", "Threads"});
+  for (int kind : {MlasReduceSum, MlasReduceMean, MlasReduceMaximum, MlasReduceLogSumExp}) {
+    for (int threads : {1, 8}) {
+      // Reduction over the innermost (contiguous) axis.
+      b->Args({kind, 4096, 768, 1, threads});
+      b->Args({kind, 64, 50257, 1, threads});
+      // Reduction over an outer axis with a contiguous tail.
+      b->Args({kind, 1, 4096, 768, threads});
+      b->Args({kind, 32, 196, 768, threads});
+      b->Args({kind, 256, 49, 64, threads});
+    }
+  }
+}
+
+BENCHMARK(REDUCE)->Apply(ReduceArgs)->UseRealTime();
@@ -91,6 +91,24 @@ void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
   std::vector<int64_t> y_shape = {batch_size, GF};
   y_shape.insert(y_shape.end(), output_shape.begin(), output_shape.end());
 
+  auto X = RandomVectorUniform(x_shape, -2.0, 2.0);
+  auto F = RandomVectorUniform(f_shape, -1.0, 1.0);
+
+  // transform a 3x3 filter ahead of time as the Conv kernel does when prepacking.
+  std::vector<float> packed_filter;
+  if (rank == 2 && kernel_shape[0] == 3 && kernel_shape[1] == 3) {
+    packed_filter.resize(MlasConvWinogradPackedFilterSize(static_cast<size_t>(groups),
+                                                          static_cast<size_t>(input_channels_per_group),
+                                                          static_cast<size_t>(output_channels_per_group)));
+    if (!packed_filter.empty()) {
+      MlasConvWinogradPackFilter(static_cast<size_t>(groups),
+                                 static_cast<size_t>(input_channels_per_group),
+                                 static_cast<size_t>(output_channels_per_group),
+                                 F.data(),
+                                 packed_filter.data());
+    }
+  }
+
   MLAS_ACTIVATION activation;
   activation.ActivationKind = MlasIdentityActivation;
   MLAS_CONV_PARAMETERS Parameters;
@@ -110,10 +128,9 @@ void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
                   &activation,
                   &WorkingBufferSize,
                   0.0f,
-                  nullptr);
+                  nullptr,
+                  packed_filter.empty() ? nullptr : packed_filter.data());
 
-  auto X = RandomVectorUniform(x_shape, -2.0, 2.0);
-  auto F = RandomVectorUniform(f_shape, -1.0, 1.0);
   int64_t y_size = std::accumulate(y_shape.begin(), y_shape.end(), 1LL, std::multiplies<int64_t>());
   std::vector<float> Y(static_cast<size_t>(y_size));
   std::vector<float> working_buffer(WorkingBufferSize);
@@ -245,3 +262,19 @@ static void General_Conv2d(benchmark::internal::Benchmark* b) {
 }
 
 BENCHMARK_CAPTURE(SCONV_NCHW, 2d, "")->Apply(General_Conv2d)->UseRealTime();
+
+static void Winograd_Conv2d(benchmark::internal::Benchmark* b) {
+  b->ArgNames(ArgNamesForConv(2));
+  // 3x3 stride 1 convolutions that select the Winograd F(2x2,3x3) (Cpg or Fpg < 32) or F(4x4,3x3) algorithm.
+  //    Rank, N, G,Cpg,Fpg,  I,   , K, , P, , , , S, , D, ,
+  b->Args({2, 1, 1, 16, 16, 112, 112, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+  b->Args({2, 1, 1, 24, 48, 56, 56, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+  b->Args({2, 1, 1, 64, 64, 112, 112, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+  b->Args({2, 1, 1, 128, 128, 56, 56, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+  b->Args({2, 1, 1, 256, 256, 28, 28, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+  b->Args({2, 1, 1, 512, 512, 14, 14, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+  b->Args({2, 4, 1, 64, 64, 56, 56, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+  b->Args({2, 1, 4, 32, 32, 56, 56, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+}
+
+BENCHMARK_CAPTURE(SCONV_NCHW, Winograd, "")->Apply(Winograd_Conv2d)->UseRealTime();
@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "core/common/narrow.h"
+#include "test/mlas/bench/bench_util.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using onnxruntime::narrow;
+
+template <typename Routine>
+static void RunUnary(benchmark::State& state, float min_value, float max_value, Routine routine) {
+  const auto n = narrow<size_t>(state.range(0));
+
+  if (n == 0) {
+    throw std::invalid_argument("N must be greater than 0!");
+  }
+
+  auto input = RandomVectorUniform<float>(n, min_value, max_value);
+  std::vector<float> output(n);
+
+  // warming up run
+  routine(input.data(), output.data(), n);
+
+  for (auto _ : state) {
+    routine(input.data(), output.data(), n);
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+void LOG(benchmark::State& state) {
+  RunUnary(state, 1e-3f, 1e3f, [](const float* x, float* y, size_t n) { MlasComputeLog(x, y, n); });
+}
+
+void LOG_REFERENCE(benchmark::State& state) {
+  RunUnary(state, 1e-3f, 1e3f, [](const float* x, float* y, size_t n) {
+    for (size_t i = 0; i < n; i++) y[i] = std::log(x[i]);
+  });
+}
+
+void SIN(benchmark::State& state) {
+  RunUnary(state, -10.0f, 10.0f, [](const float* x, float* y, size_t n) { MlasComputeSin(x, y, n); });
+}
+
+void SIN_REFERENCE(benchmark::State& state) {
+  RunUnary(state, -10.0f, 10.0f, [](const float* x, float* y, size_t n) {
+    for (size_t i = 0; i < n; i++) y[i] = std::sin(x[i]);
+  });
+}
+
+void COS(benchmark::State& state) {
+  RunUnary(state, -10.0f, 10.0f, [](const float* x, float* y, size_t n) { MlasComputeCos(x, y, n); });
+}
+
+void COS_REFERENCE(benchmark::State& state) {
+  RunUnary(state, -10.0f, 10.0f, [](const float* x, float* y, size_t n) {
+    for (size_t i = 0; i < n; i++) y[i] = std::cos(x[i]);
+  });
+}
+
+void POW(benchmark::State& state) {
+  RunUnary(state, 0.0f, 10.0f, [](const float* x, float* y, size_t n) { MlasComputePow(x, 2.5f, y, n); });
+}
+
+void POW_REFERENCE(benchmark::State& state) {
+  RunUnary(state, 0.0f, 10.0f, [](const float* x, float* y, size_t n) {
+    for (size_t i = 0; i < n; i++) y[i] = std::pow(x[i], 2.5f);
+  });
+}
+
+static void TranscendentalArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"N"});
+  for (int n : {64, 1024, 16384, 262144}) {
+    b->Args({n});
+  }
+}
+
+BENCHMARK(LOG)->Apply(TranscendentalArgs)->UseRealTime();
+BENCHMARK(LOG_REFERENCE)->Apply(TranscendentalArgs)->UseRealTime();
+BENCHMARK(SIN)->Apply(TranscendentalArgs)->UseRealTime();
+BENCHMARK(SIN_REFERENCE)->Apply(TranscendentalArgs)->UseRealTime();
+BENCHMARK(COS)->Apply(TranscendentalArgs)->UseRealTime();
+BENCHMARK(COS_REFERENCE)->Apply(TranscendentalArgs)->UseRealTime();
+BENCHMARK(POW)->Apply(TranscendentalArgs)->UseRealTime();
+BENCHMARK(POW_REFERENCE)->Apply(TranscendentalArgs)->UseRealTime();
@@ -40,6 +40,19 @@ class MlasConv2DTest : public MlasTestBase {
     MLAS_ACTIVATION Activation;
     Activation.ActivationKind = MlasIdentityActivation;
 
+    //
+    // Transform a 3x3 filter ahead of time as the Conv kernel does when
+    // prepacking, so that MlasConvPrepare may select the Winograd algorithm.
+    //
+
+    float* PackedFilter = nullptr;
+    size_t PackedFilterSize = MlasConvWinogradPackedFilterSize(GroupCount, InputChannels, FilterCount);
+
+    if (KernelHeight == 3 && KernelWidth == 3 && PackedFilterSize > 0) {
+      PackedFilter = BufferPackedFilter.GetBuffer(PackedFilterSize);
+      MlasConvWinogradPackFilter(GroupCount, InputChannels, FilterCount, Filter, PackedFilter);
+    }
+
     MLAS_CONV_PARAMETERS Parameters;
     size_t WorkingBufferSize;
 
@@ -58,7 +71,10 @@ class MlasConv2DTest : public MlasTestBase {
                     &Activation,
                     &WorkingBufferSize,
                     0.0f,
-                    threadpool_);
+                    threadpool_,
+                    PackedFilter);
+
+    ApproximateResult = (Parameters.Algorithm == MlasConvAlgorithmWinograd);
 
     MlasConv(&Parameters,
              Input,
@@ -67,6 +83,34 @@ class MlasConv2DTest : public MlasTestBase {
              BufferWorking.GetBuffer(WorkingBufferSize),
              Output,
              threadpool_);
+
+    if (Parameters.Algorithm == MlasConvAlgorithmWinograd) {
+      //
+      // Verify that the filter transformed by MlasConv produces the same
+      // output as the filter packed ahead of time.
+      //
+
+      size_t OutputElements = BatchCount * GroupCount * FilterCount * OutputHeight * OutputWidth;
+      float* OutputUnpacked = BufferOutputUnpacked.GetBuffer(OutputElements);
+
+      Parameters.u.Winograd.PackedFilter = nullptr;
+
+      MlasConv(&Parameters,
+               Input,
+               Filter,
+               Bias,
+               BufferWorking.GetBuffer(WorkingBufferSize),
+               OutputUnpacked,
+               threadpool_);
+
+      ASSERT_EQ(memcmp(Output, OutputUnpacked, OutputElements * sizeof(float)), 0)
+          << "B" << BatchCount << "/"
+          << "G" << GroupCount << "/"
+          << "Cpg" << InputChannels << "/"
+          << "Fpg" << FilterCount << "/"
+          << "H" << InputHeight << "/"
+          << "W" << InputWidth;
+    }
   }
 
   void ReferenceConv2D(
@@ -154,9 +198,18 @@ class MlasConv2DTest : public MlasTestBase {
   MatrixGuardBuffer<float> BufferOutputReference;
   MatrixGuardBuffer<float> BufferWorking;
   MatrixGuardBuffer<float> BufferIm2Col;
+  MatrixGuardBuffer<float> BufferPackedFilter;
+  MatrixGuardBuffer<float> BufferOutputUnpacked;
 
   MLAS_THREADPOOL* threadpool_;
 
+  //
+  // The Winograd algorithm reorders the accumulation, so its results are not
+  // bitwise identical to the reference implementation.
+  //
+
+  bool ApproximateResult = false;
+
  public:
   static const char* GetTestSuiteName() {
     static const std::string suite_name(Threaded ? "Conv2d_Threaded" : "Conv2d_SingleThread");
@@ -246,6 +299,27 @@ class MlasConv2DTest : public MlasTestBase {
                     Bias,
                     OutputReference);
 
+    if (ApproximateResult) {
+      //
+      // The error of the transformed accumulation scales with the magnitude
+      // of the summed products, which is bounded by the filter footprint.
+      //
+
+      const float Tolerance = 2e-6f * float(InputChannels * KernelSize) * 64.0f * 64.0f;
+
+      for (size_t i = 0; i < OutputElements; i++) {
+        ASSERT_NEAR(Output[i], OutputReference[i], Tolerance) << "@" << i << " of " << OutputElements << ", "
+            << "B" << BatchCount << "/"
+            << "G" << GroupCount << "/"
+            << "Cpg" << InputChannels << "/"
+            << "Fpg" << FilterCount << "/"
+            << "H" << InputHeight << "/"
+            << "W" << InputWidth << "/"
+            << "Pad" << PaddingLeftHeight << "," << PaddingLeftWidth << "," << PaddingRightHeight << "," << PaddingRightWidth;
+      }
+      return;
+    }
+
     ASSERT_EQ(memcmp(Output, OutputReference, OutputElements * sizeof(float)), 0)
         << "B" << BatchCount << "/"
         << "G" << GroupCount << "/"
@@ -140,6 +140,15 @@ class Conv2dShortExecuteTest : public MlasTestFixture<Conv2dTester> {
       test_registered += RegisterSingleTest(1, 16, 1, i, i, 1, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
       test_registered += RegisterSingleTest(1, 16, 1, i, i, 1, 3, 3, 1, 1, 1, 1, 1, 1, 2, 2);
     }
+    // 3x3 stride 1 convolutions that select the Winograd F(2x2,3x3) and F(4x4,3x3) algorithms.
+    static const unsigned ws[] = {4, 13, 33};
+    for (unsigned i : ws) {
+      test_registered += RegisterSingleTest(1, 1, 16, i, i + 3, 8, 3, 3, 0, 0, 0, 0, 1, 1, 1, 1);
+      test_registered += RegisterSingleTest(2, 1, 24, i, i, 40, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+      test_registered += RegisterSingleTest(1, 2, 32, i + 1, i, 32, 3, 3, 1, 0, 0, 1, 1, 1, 1, 1);
+      test_registered += RegisterSingleTest(3, 1, 64, i + 2, i + 5, 48, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+      test_registered += RegisterSingleTest(1, 1, 128, i, i, 96, 3, 3, 2, 2, 2, 2, 1, 1, 1, 1);
+    }
     return test_registered;
   }
 
@@ -0,0 +1,190 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <limits>
+#include <vector>
+
+template <bool Threaded>
+class MlasEltwiseProgramTest : public MlasTestBase {
+ private:
+  MLAS_THREADPOOL* threadpool_;
+
+  static float Evaluate(MLAS_ELTWISE_OPCODE Opcode, float A, float B) {
+    switch (Opcode) {
+      case MlasEltwiseOpAdd:
+        return A + B;
+      case MlasEltwiseOpSub:
+        return A - B;
+      case MlasEltwiseOpMul:
+        return A * B;
+      case MlasEltwiseOpDiv:
+        return A / B;
+      case MlasEltwiseOpMax:
+        return std::max(A, B);
+      case MlasEltwiseOpMin:
+        return std::min(A, B);
+      case MlasEltwiseOpRelu:
+        return std::max(A, 0.0f);
+      case MlasEltwiseOpSigmoid:
+        return 1.0f / (1.0f + std::exp(-A));
+      case MlasEltwiseOpTanh:
+        return std::tanh(A);
+      case MlasEltwiseOpExp:
+        return std::exp(A);
+      case MlasEltwiseOpLog:
+        return std::log(A);
+      case MlasEltwiseOpErf:
+        return std::erf(A);
+      case MlasEltwiseOpNeg:
+        return -A;
+      case MlasEltwiseOpAbs:
+        return std::fabs(A);
+      case MlasEltwiseOpSqrt:
+        return std::sqrt(A);
+      case MlasEltwiseOpReciprocal:
+        return 1.0f / A;
+    }
+    return 0.0f;
+  }
+
+  void Test(const std::vector<MLAS_ELTWISE_INSTRUCTION>& Program,
+            size_t RegisterCount,
+            const std::vector<size_t>& InputCounts,
+            size_t N) {
+    std::default_random_engine generator(static_cast<unsigned>(N + InputCounts.size()));
+    std::uniform_real_distribution<float> distribution(0.25f, 4.0f);
+
+    std::vector<std::vector<float>> Inputs(InputCounts.size());
+    std::vector<const float*> InputPointers;
+
+    for (size_t i = 0; i < InputCounts.size(); i++) {
+      Inputs[i].resize(InputCounts[i]);
+      for (auto& v : Inputs[i]) {
+        v = distribution(generator);
+      }
+      InputPointers.push_back(Inputs[i].data());
+    }
+
+    std::vector<float> Output(N);
+
+    MlasEltwiseProgramExecute(Program.data(), Program.size(), RegisterCount, InputPointers.data(),
+                              InputCounts.data(), InputCounts.size(), Output.data(), N, threadpool_);
+
+    std::vector<float> Registers(RegisterCount);
+
+    for (size_t n = 0; n < N; n++) {
+      for (size_t i = 0; i < InputCounts.size(); i++) {
+        Registers[i] = Inputs[i][n % InputCounts[i]];
+      }
+      for (const auto& Instruction : Program) {
+        Registers[Instruction.Destination] =
+            Evaluate(Instruction.Opcode, Registers[Instruction.Source0], Registers[Instruction.Source1]);
+      }
+      float ref = Registers[Program.back().Destination];
+      ASSERT_TRUE(CloseEnough(Output[n], ref))
+          << "@" << n << " of " << N << ", got: " << Output[n] << ", expecting: " << ref;
+    }
+  }
+
+  void TestNaN() {
+    constexpr float NaN = std::numeric_limits<float>::quiet_NaN();
+    constexpr float Infinity = std::numeric_limits<float>::infinity();
+    const std::vector<float> A = {NaN, 1.0f, NaN, -Infinity, 2.0f, Infinity, NaN, -1.0f, 3.0f};
+    const std::vector<float> B = {1.0f, NaN, NaN, Infinity, -2.0f, -Infinity, -Infinity, NaN, 4.0f};
+    const float* Inputs[] = {A.data(), B.data()};
+    const size_t InputCounts[] = {A.size(), B.size()};
+
+    for (MLAS_ELTWISE_OPCODE Opcode : {MlasEltwiseOpMax, MlasEltwiseOpMin}) {
+      const MLAS_ELTWISE_INSTRUCTION Program[] = {{Opcode, 2, 0, 1}};
+      std::vector<float> Output(A.size());
+
+      MlasEltwiseProgramExecute(Program, 1, 3, Inputs, InputCounts, 2, Output.data(), Output.size(), threadpool_);
+
+      for (size_t n = 0; n < A.size(); n++) {
+        if (std::isnan(A[n]) || std::isnan(B[n])) {
+          ASSERT_TRUE(std::isnan(Output[n])) << "@" << n << ", got: " << Output[n] << ", expecting NaN";
+        } else {
+          ASSERT_EQ(Output[n], Evaluate(Opcode, A[n], B[n])) << "@" << n;
+        }
+      }
+    }
+  }
+
+ public:
+  MlasEltwiseProgramTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "EltwiseProgram_Threaded" : "EltwiseProgram_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    //
+    // x * sigmoid(x * a + b), with the temporary register reused in place.
+    //
+
+    const std::vector<MLAS_ELTWISE_INSTRUCTION> Swish = {
+        {MlasEltwiseOpMul, 3, 0, 1},
+        {MlasEltwiseOpAdd, 3, 3, 2},
+        {MlasEltwiseOpSigmoid, 3, 3, 0},
+        {MlasEltwiseOpMul, 3, 0, 3},
+    };
+
+    //
+    // Every supported operation, with a result that is read after it is
+    // overwritten by the last instruction.
+    //
+
+    const std::vector<MLAS_ELTWISE_INSTRUCTION> All = {
+        {MlasEltwiseOpSub, 2, 0, 1},
+        {MlasEltwiseOpAbs, 2, 2, 0},
+        {MlasEltwiseOpSqrt, 2, 2, 0},
+        {MlasEltwiseOpLog, 3, 0, 0},
+        {MlasEltwiseOpTanh, 3, 3, 0},
+        {MlasEltwiseOpMax, 2, 2, 3},
+        {MlasEltwiseOpNeg, 3, 1, 0},
+        {MlasEltwiseOpErf, 3, 3, 0},
+        {MlasEltwiseOpMin, 3, 3, 2},
+        {MlasEltwiseOpExp, 3, 3, 0},
+        {MlasEltwiseOpRelu, 2, 2, 0},
+        {MlasEltwiseOpReciprocal, 2, 2, 0},
+        {MlasEltwiseOpDiv, 2, 3, 2},
+        {MlasEltwiseOpAdd, 2, 2, 3},
+    };
+
+    for (size_t n : {1, 3, 4, 7, 17, 255, 256, 257, 1000, 4096, 65536 + 3}) {
+      Test(Swish, 4, {n, n, n}, n);
+      Test(Swish, 4, {n, 1, 1}, n);
+      Test(All, 4, {n, n}, n);
+      Test(All, 4, {n, 1}, n);
+    }
+
+    //
+    // Inputs that repeat with a short and a long period.
+    //
+
+    for (size_t period : {3, 64, 255, 256, 768, 1000}) {
+      for (size_t rows : {1, 2, 5, 37}) {
+        const size_t n = period * rows;
+        Test(Swish, 4, {n, period, 1}, n);
+        Test(Swish, 4, {n, period, period}, n);
+        Test(All, 4, {period, n}, n);
+      }
+    }
+
+    TestNaN();
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasEltwiseProgramTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasEltwiseProgramTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,223 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+#include "core/mlas/lib/mlasi.h"
+
+template <bool Threaded>
+class MlasReduceTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MatrixGuardBuffer<MLAS_FP16> BufferInputFp16;
+  MatrixGuardBuffer<MLAS_FP16> BufferOutputFp16;
+  MLAS_THREADPOOL* threadpool_;
+
+  static const char* KindName(MLAS_REDUCE_KIND ReduceKind) {
+    switch (ReduceKind) {
+      case MlasReduceSum:
+        return "Sum";
+      case MlasReduceMean:
+        return "Mean";
+      case MlasReduceMaximum:
+        return "Maximum";
+      case MlasReduceLogSumExp:
+        return "LogSumExp";
+    }
+    return "?";
+  }
+
+  void ReferenceReduce(MLAS_REDUCE_KIND ReduceKind,
+                       const float* Input,
+                       float* Output,
+                       size_t OuterCount,
+                       size_t ReduceCount,
+                       size_t InnerCount) {
+    for (size_t o = 0; o < OuterCount; o++) {
+      for (size_t i = 0; i < InnerCount; i++) {
+        const float* p = Input + o * ReduceCount * InnerCount + i;
+
+        double MaximumValue = -std::numeric_limits<double>::infinity();
+        double Sum = 0.0;
+
+        for (size_t r = 0; r < ReduceCount; r++) {
+          MaximumValue = (std::max)(MaximumValue, double(p[r * InnerCount]));
+          Sum += double(p[r * InnerCount]);
+        }
+
+        double Result;
+
+        switch (ReduceKind) {
+          case MlasReduceSum:
+            Result = Sum;
+            break;
+          case MlasReduceMean:
+            Result = Sum / double(ReduceCount);
+            break;
+          case MlasReduceMaximum:
+            Result = MaximumValue;
+            break;
+          case MlasReduceLogSumExp: {
+            double SumExp = 0.0;
+            for (size_t r = 0; r < ReduceCount; r++) {
+              SumExp += std::exp(double(p[r * InnerCount]) - MaximumValue);
+            }
+            Result = MaximumValue + std::log(SumExp);
+            break;
+          }
+          default:
+            Result = 0.0;
+            break;
+        }
+
+        Output[o * InnerCount + i] = float(Result);
+      }
+    }
+  }
+
+  void Test(size_t OuterCount, size_t ReduceCount, size_t InnerCount, float MinimumValue, float MaximumValue) {
+    const size_t InputSize = OuterCount * ReduceCount * InnerCount;
+    const size_t OutputSize = OuterCount * InnerCount;
+
+    float* Input = BufferInput.GetBuffer(InputSize);
+    float* Output = BufferOutput.GetBuffer(OutputSize);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputSize);
+    MLAS_FP16* InputFp16 = BufferInputFp16.GetBuffer(InputSize);
+    MLAS_FP16* OutputFp16 = BufferOutputFp16.GetBuffer(OutputSize);
+
+    std::default_random_engine generator(static_cast<unsigned>(InputSize));
+    std::uniform_real_distribution<float> distribution(MinimumValue, MaximumValue);
+
+    //
+    // Round the inputs through fp16 so that the same reference serves both
+    // element types.
+    //
+
+    for (size_t n = 0; n < InputSize; n++) {
+      InputFp16[n] = MLAS_FP16(distribution(generator));
+      Input[n] = InputFp16[n].ToFloat();
+    }
+
+    for (MLAS_REDUCE_KIND ReduceKind : {MlasReduceSum, MlasReduceMean, MlasReduceMaximum, MlasReduceLogSumExp}) {
+      ReferenceReduce(ReduceKind, Input, OutputReference, OuterCount, ReduceCount, InnerCount);
+
+      MlasReduce(ReduceKind, Input, Output, OuterCount, ReduceCount, InnerCount, threadpool_);
+
+      for (size_t n = 0; n < OutputSize; n++) {
+        float diff = std::fabs(Output[n] - OutputReference[n]);
+        ASSERT_TRUE(diff <= 1e-4f || diff <= std::fabs(OutputReference[n]) * 1e-5f)
+            << KindName(ReduceKind) << " " << OuterCount << "x" << ReduceCount << "x" << InnerCount
+            << " @" << n << ", got: " << Output[n] << ", expecting: " << OutputReference[n];
+      }
+
+      MlasReduce(ReduceKind, InputFp16, OutputFp16, OuterCount, ReduceCount, InnerCount, threadpool_);
+
+      for (size_t n = 0; n < OutputSize; n++) {
+        float out = OutputFp16[n].ToFloat();
+        float diff = std::fabs(out - OutputReference[n]);
+        ASSERT_TRUE(diff <= 5e-3f || diff <= std::fabs(OutputReference[n]) * 2e-3f)
+            << KindName(ReduceKind) << " fp16 " << OuterCount << "x" << ReduceCount << "x" << InnerCount
+            << " @" << n << ", got: " << out << ", expecting: " << OutputReference[n];
+      }
+    }
+  }
+
+  void TestInfinity() {
+    constexpr float Infinity = std::numeric_limits<float>::infinity();
+    const float Input[] = {-Infinity, -Infinity, 1.0f, -Infinity, -Infinity, Infinity};
+    float Output[2];
+
+    MlasReduce(MlasReduceMaximum, Input, Output, 3, 2, 1, threadpool_);
+    ASSERT_EQ(Output[0], -Infinity);
+
+    MlasReduce(MlasReduceLogSumExp, Input, Output, 1, 3, 2, threadpool_);
+    ASSERT_EQ(Output[0], 1.0f);
+    ASSERT_EQ(Output[1], Infinity);
+  }
+
+  void TestNaN() {
+    const float NaN = std::numeric_limits<float>::quiet_NaN();
+
+    for (MLAS_REDUCE_KIND ReduceKind : {MlasReduceMaximum, MlasReduceLogSumExp}) {
+      //
+      // Contiguous rows, with the NaN before and after the other elements.
+      //
+
+      const float Rows[] = {1.0f, 2.0f, 3.0f, NaN, NaN, 1.0f, 2.0f, 3.0f};
+      float Output[5];
+
+      MlasReduce(ReduceKind, Rows, Output, 2, 4, 1, threadpool_);
+      ASSERT_TRUE(std::isnan(Output[0])) << KindName(ReduceKind) << " got: " << Output[0];
+      ASSERT_TRUE(std::isnan(Output[1])) << KindName(ReduceKind) << " got: " << Output[1];
+
+      //
+      // Strided rows, with the NaN in the first and last rows.
+      //
+
+      const float Columns[] = {1.0f, NaN, 3.0f, 4.0f, 5.0f,
+                               6.0f, 7.0f, 8.0f, 9.0f, 0.0f,
+                               0.0f, 0.0f, 0.0f, 0.0f, NaN};
+
+      MlasReduce(ReduceKind, Columns, Output, 1, 3, 5, threadpool_);
+      for (size_t n = 0; n < 5; n++) {
+        ASSERT_EQ(std::isnan(Output[n]), n == 1 || n == 4) << KindName(ReduceKind) << " @" << n << ", got: " << Output[n];
+      }
+
+      //
+      // A long reduced axis, which is split across threads.
+      //
+
+      std::vector<float> Input(100000 * 2, 1.0f);
+      Input[77777 * 2] = NaN;
+
+      MlasReduce(ReduceKind, Input.data(), Output, 1, 100000, 2, threadpool_);
+      ASSERT_TRUE(std::isnan(Output[0])) << KindName(ReduceKind) << " got: " << Output[0];
+      ASSERT_FALSE(std::isnan(Output[1])) << KindName(ReduceKind) << " got: " << Output[1];
+
+      MlasReduce(ReduceKind, Input.data(), Output, 1, 200000, 1, threadpool_);
+      ASSERT_TRUE(std::isnan(Output[0])) << KindName(ReduceKind) << " got: " << Output[0];
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "Reduce_Threaded" : "Reduce_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasReduceTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    for (size_t r = 1; r < 80; r++) {
+      Test(1, r, 1, -10.f, 10.f);
+      Test(3, r, 1, -10.f, 10.f);
+      Test(2, r, 7, -10.f, 10.f);
+    }
+
+    Test(1, 1, 33, -10.f, 10.f);
+    Test(1, 17, 300, -10.f, 10.f);
+    Test(5, 3, 257, -10.f, 10.f);
+    Test(64, 257, 1, -5.f, 5.f);
+    Test(4, 96, 1000, -5.f, 5.f);
+    Test(1, 3000, 3, -5.f, 5.f);
+    Test(2, 2048, 1, 20.f, 30.f);
+    // Narrow outputs with a long reduced axis, which is split across threads.
+    Test(1, 8192, 128, 0.f, 1.f);
+    Test(1, 100000, 1, -5.f, 5.f);
+    Test(1, 30000, 3, -1.f, 0.f);
+    TestInfinity();
+    TestNaN();
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasReduceTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasReduceTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -142,20 +142,25 @@ class MlasSQNBitGemmTest : public MlasTestBase {
 
           const float b_scale = QuantBScale[n * BlockCountK + k_blk];
 
-          static_assert(BlkBitWidth == 4, "only implemented for 4-bit quantized B");
+          static_assert(BlkBitWidth == 2 || BlkBitWidth == 4, "only implemented for 2-bit and 4-bit quantized B");
 
-          uint8_t b_zp = 8;
+          // values and zero points are packed from the low bits of a byte
+          constexpr size_t ValuesPerByte = 8 / BlkBitWidth;
+          constexpr uint8_t ValueMask = (1 << BlkBitWidth) - 1;
+
+          uint8_t b_zp = 1 << (BlkBitWidth - 1);
           if (QuantBZeroPoint != nullptr) {
-            const uint8_t b_zp_byte = QuantBZeroPoint[n * ((BlockCountK + 1) / 2) + k_blk / 2];
-            b_zp = (k_blk & 1) ? (b_zp_byte >> 4) : (b_zp_byte & 0x0F);
+            const uint8_t b_zp_byte =
+                QuantBZeroPoint[n * ((BlockCountK + ValuesPerByte - 1) / ValuesPerByte) + k_blk / ValuesPerByte];
+            b_zp = (b_zp_byte >> (BlkBitWidth * (k_blk % ValuesPerByte))) & ValueMask;
           }
 
           int32_t qsum = 0;
 
           for (size_t kk = 0; kk < k_blk_len; ++kk) {
             const int8_t qa = QuantAData[m * BlockCountK * BlkLen + k + kk];
-            const uint8_t qb_byte = QuantBData[(n * BlockCountK * BlkLen + k + kk) / 2];
-            const int8_t qb = ((kk & 1) == 1 ? (qb_byte >> 4) : (qb_byte & 0x0F)) - b_zp;
+            const uint8_t qb_byte = QuantBData[(n * BlockCountK * BlkLen + k + kk) / ValuesPerByte];
+            const int8_t qb = ((qb_byte >> (BlkBitWidth * (kk % ValuesPerByte))) & ValueMask) - b_zp;
             qsum += qa * qb;
           }
 
@@ -428,6 +433,11 @@ static size_t SQNBitGemmRegisterAllShortExecuteTests() {
   count += SQNBitGemmShortExecuteTest<4, 64>::RegisterShortExecuteTests();
   count += SQNBitGemmShortExecuteTest<4, 128>::RegisterShortExecuteTests();
   count += SQNBitGemmShortExecuteTest<4, 256>::RegisterShortExecuteTests();
+  count += SQNBitGemmShortExecuteTest<2, 16>::RegisterShortExecuteTests();
+  count += SQNBitGemmShortExecuteTest<2, 32>::RegisterShortExecuteTests();
+  count += SQNBitGemmShortExecuteTest<2, 64>::RegisterShortExecuteTests();
+  count += SQNBitGemmShortExecuteTest<2, 128>::RegisterShortExecuteTests();
+  count += SQNBitGemmShortExecuteTest<2, 256>::RegisterShortExecuteTests();
 
   return count;
 }
@@ -0,0 +1,188 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+#include "core/mlas/lib/mlasi.h"
+
+#include <functional>
+
+class MlasTranscendentalTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<MLAS_FP16> BufferInputFp16;
+  MatrixGuardBuffer<MLAS_FP16> BufferOutputFp16;
+
+  using FloatRoutine = std::function<void(const float*, float*, size_t)>;
+  using HalfRoutine = std::function<void(const MLAS_FP16*, MLAS_FP16*, size_t)>;
+  using ReferenceRoutine = std::function<double(double)>;
+
+  static bool IsClose(float Output, double Reference, float AbsoluteTolerance, float RelativeTolerance) {
+    if (std::isnan(Reference)) {
+      return std::isnan(Output);
+    }
+    if (std::isinf(Reference)) {
+      return Output == Reference;
+    }
+    double diff = std::fabs(double(Output) - Reference);
+    return diff <= AbsoluteTolerance || diff <= std::fabs(Reference) * RelativeTolerance;
+  }
+
+  void Test(const char* Name,
+            const FloatRoutine& Routine,
+            const HalfRoutine& RoutineFp16,
+            const ReferenceRoutine& Reference,
+            size_t N,
+            float MinimumValue,
+            float MaximumValue,
+            float AbsoluteTolerance,
+            float RelativeTolerance) {
+    float* Input = BufferInput.GetBuffer(N);
+    float* Output = BufferOutput.GetBuffer(N);
+    MLAS_FP16* InputFp16 = BufferInputFp16.GetBuffer(N);
+    MLAS_FP16* OutputFp16 = BufferOutputFp16.GetBuffer(N);
+
+    std::default_random_engine generator(static_cast<unsigned>(N));
+    std::uniform_real_distribution<float> distribution(MinimumValue, MaximumValue);
+
+    for (size_t n = 0; n < N; n++) {
+      Input[n] = distribution(generator);
+    }
+
+    Routine(Input, Output, N);
+
+    for (size_t n = 0; n < N; n++) {
+      double ref = Reference(double(Input[n]));
+      ASSERT_TRUE(IsClose(Output[n], ref, AbsoluteTolerance, RelativeTolerance))
+          << Name << " @" << n << " of " << N << ", input: " << Input[n]
+          << ", got: " << Output[n] << ", expecting: " << ref;
+    }
+
+    //
+    // In place updates are supported.
+    //
+
+    Routine(Input, Input, N);
+
+    for (size_t n = 0; n < N; n++) {
+      ASSERT_TRUE(Input[n] == Output[n] || (std::isnan(Input[n]) && std::isnan(Output[n])))
+          << Name << " in place @" << n << " of " << N;
+    }
+
+    for (size_t n = 0; n < N; n++) {
+      InputFp16[n] = MLAS_FP16(distribution(generator));
+    }
+
+    RoutineFp16(InputFp16, OutputFp16, N);
+
+    for (size_t n = 0; n < N; n++) {
+      float in = InputFp16[n].ToFloat();
+      double ref = double(MLAS_FP16(float(Reference(double(in)))).ToFloat());
+      ASSERT_TRUE(IsClose(OutputFp16[n].ToFloat(), ref, 1e-3f, 2e-3f))
+          << Name << " fp16 @" << n << " of " << N << ", input: " << in
+          << ", got: " << OutputFp16[n].ToFloat() << ", expecting: " << ref;
+    }
+  }
+
+  void TestSpecialValues(const char* Name,
+                         const FloatRoutine& Routine,
+                         const ReferenceRoutine& Reference,
+                         float RelativeTolerance) {
+    const float Values[] = {
+        0.0f,
+        -0.0f,
+        1.0f,
+        -1.0f,
+        std::numeric_limits<float>::min(),
+        std::numeric_limits<float>::denorm_min(),
+        -std::numeric_limits<float>::denorm_min(),
+        std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::infinity(),
+        -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN(),
+    };
+    constexpr size_t N = sizeof(Values) / sizeof(Values[0]);
+
+    float Output[N];
+    Routine(Values, Output, N);
+
+    for (size_t n = 0; n < N; n++) {
+      double ref = Reference(double(Values[n]));
+      ASSERT_TRUE(IsClose(Output[n], ref, 0.0f, RelativeTolerance))
+          << Name << " input: " << Values[n] << ", got: " << Output[n] << ", expecting: " << ref;
+    }
+  }
+
+  void TestPow(float Exponent, size_t N, float MinimumValue, float MaximumValue) {
+    std::ostringstream name;
+    name << "Pow(" << Exponent << ")";
+
+    auto Routine = [Exponent](const float* Input, float* Output, size_t Count) {
+      MlasComputePow(Input, Exponent, Output, Count);
+    };
+    auto RoutineFp16 = [Exponent](const MLAS_FP16* Input, MLAS_FP16* Output, size_t Count) {
+      MlasComputePow(Input, MLAS_FP16(Exponent), Output, Count);
+    };
+    auto Reference = [Exponent](double x) {
+      return std::pow(x, double(Exponent));
+    };
+
+    Test(name.str().c_str(), Routine, RoutineFp16, Reference, N, MinimumValue, MaximumValue, 1e-6f, 1e-5f);
+    TestSpecialValues(name.str().c_str(), Routine, [Exponent](double x) {
+      return double(std::pow(float(x), Exponent));
+    }, 1e-5f);
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Transcendental");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    auto Log = [](const float* Input, float* Output, size_t N) { MlasComputeLog(Input, Output, N); };
+    auto LogFp16 = [](const MLAS_FP16* Input, MLAS_FP16* Output, size_t N) { MlasComputeLog(Input, Output, N); };
+    auto LogReference = [](double x) { return std::log(x); };
+
+    auto Sin = [](const float* Input, float* Output, size_t N) { MlasComputeSin(Input, Output, N); };
+    auto SinFp16 = [](const MLAS_FP16* Input, MLAS_FP16* Output, size_t N) { MlasComputeSin(Input, Output, N); };
+    auto SinReference = [](double x) { return std::sin(x); };
+
+    auto Cos = [](const float* Input, float* Output, size_t N) { MlasComputeCos(Input, Output, N); };
+    auto CosFp16 = [](const MLAS_FP16* Input, MLAS_FP16* Output, size_t N) { MlasComputeCos(Input, Output, N); };
+    auto CosReference = [](double x) { return std::cos(x); };
+
+    for (size_t n = 1; n < 64; n++) {
+      Test("Log", Log, LogFp16, LogReference, n, 1e-3f, 100.f, 1e-6f, 1e-6f);
+      Test("Sin", Sin, SinFp16, SinReference, n, -10.f, 10.f, 1e-6f, 1e-6f);
+      Test("Cos", Cos, CosFp16, CosReference, n, -10.f, 10.f, 1e-6f, 1e-6f);
+    }
+
+    Test("Log", Log, LogFp16, LogReference, 4099, -1.f, 60000.f, 1e-6f, 1e-6f);
+    Test("Sin", Sin, SinFp16, SinReference, 4099, -60000.f, 60000.f, 1e-5f, 1e-5f);
+    Test("Cos", Cos, CosFp16, CosReference, 4099, -60000.f, 60000.f, 1e-5f, 1e-5f);
+
+    TestSpecialValues("Log", Log, LogReference, 1e-6f);
+    TestSpecialValues("Sin", Sin, [](double x) { return double(std::sin(float(x))); }, 1e-6f);
+    TestSpecialValues("Cos", Cos, [](double x) { return double(std::cos(float(x))); }, 1e-6f);
+
+    //
+    // The exponents are exactly representable in half precision so that the
+    // same reference applies to both data types.
+    //
+
+    for (float Exponent : {0.5f, -0.5f, 1.5f, 3.0f, -2.0f, 2.375f, 0.0f}) {
+      TestPow(Exponent, 1, 0.f, 10.f);
+      TestPow(Exponent, 15, -10.f, 10.f);
+      TestPow(Exponent, 1023, -10.f, 10.f);
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasTranscendentalTest>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+static void EnableElementwiseChainFusion(SessionOptions& session_options) {
+  ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsEnableElementwiseChainFusion, "1"));
+}
+
+TEST(ElementwiseChainFusionTests, FuseChainWithBias) {
+  // relu(tanh(x + bias) * y) with a bias that repeats over the last dimension.
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 8}, -4.f, 4.f);
+    auto* scale_arg = builder.MakeInput<float>({2, 3, 8}, -2.f, 2.f);
+    auto* bias_arg = builder.MakeInitializer<float>({8}, -1.f, 1.f);
+    auto* add_out_arg = builder.MakeIntermediate();
+    auto* tanh_out_arg = builder.MakeIntermediate();
+    auto* mul_out_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Add", {input_arg, bias_arg}, {add_out_arg});
+    builder.AddNode("Tanh", {add_out_arg}, {tanh_out_arg});
+    builder.AddNode("Mul", {tanh_out_arg, scale_arg}, {mul_out_arg});
+    builder.AddNode("Relu", {mul_out_arg}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 0);
+    EXPECT_EQ(op_to_count["Tanh"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["Relu"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level3, 13,
+                    0.0001, 0.000001, nullptr, EnableElementwiseChainFusion);
+}
+
+TEST(ElementwiseChainFusionTests, StopAtSharedAndBroadcastValues) {
+  // The output of the Add is also a graph output and the Sub broadcasts a column, so only Exp, Div and Neg are fused.
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({4, 8}, -2.f, 2.f);
+    auto* column_arg = builder.MakeInput<float>({4, 1}, -2.f, 2.f);
+    auto* denominator_arg = builder.MakeScalarInitializer<float>(3.f);
+    auto* sub_out_arg = builder.MakeIntermediate();
+    auto* add_out_arg = builder.MakeOutput();
+    auto* exp_out_arg = builder.MakeIntermediate();
+    auto* div_out_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Sub", {input_arg, column_arg}, {sub_out_arg});
+    builder.AddNode("Add", {sub_out_arg, input_arg}, {add_out_arg});
+    builder.AddNode("Exp", {add_out_arg}, {exp_out_arg});
+    builder.AddNode("Div", {exp_out_arg, denominator_arg}, {div_out_arg});
+    builder.AddNode("Neg", {div_out_arg}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Sub"], 1);
+    EXPECT_EQ(op_to_count["Add"], 1);
+    EXPECT_EQ(op_to_count["Exp"], 0);
+    EXPECT_EQ(op_to_count["Div"], 0);
+    EXPECT_EQ(op_to_count["Neg"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level3, 13,
+                    0.0001, 0.000001, nullptr, EnableElementwiseChainFusion);
+}
+
+TEST(ElementwiseChainFusionTests, DisabledByDefault) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 8}, -2.f, 2.f);
+    auto* sigmoid_out_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Sigmoid", {input_arg}, {sigmoid_out_arg});
+    builder.AddNode("Abs", {sigmoid_out_arg}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 0);
+    EXPECT_EQ(op_to_count["Sigmoid"], 1);
+    EXPECT_EQ(op_to_count["Abs"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level3, 13);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -150,6 +150,10 @@ ABSL_FLAG(bool, s, DefaultPerformanceTestConfig().run_config.f_dump_statistics,
 ABSL_FLAG(bool, v, DefaultPerformanceTestConfig().run_config.f_verbose, "Shows verbose information.");
 ABSL_FLAG(bool, I, DefaultPerformanceTestConfig().run_config.generate_model_input_binding, "Generates tensor input binding. Free dimensions are treated as 1 unless overridden using -f.");
 ABSL_FLAG(bool, P, false, "Uses parallel executor instead of sequential executor.");
+ABSL_FLAG(std::string, execution_order, "",
+          "Specifies the node execution order: 'DEFAULT', 'PRIORITY_BASED' or 'CRITICAL_PATH'.\n"
+          "CRITICAL_PATH uses the node costs of the profile given with -C \"session.node_cost_profile_file|<profile_file>\" "
+          "(e.g. written by an earlier run with -p) or estimates them from the shapes.");
 ABSL_FLAG(bool, q, DefaultPerformanceTestConfig().run_config.do_cuda_copy_in_separate_stream, "[CUDA only] Uses separate stream for copy.");
 ABSL_FLAG(bool, z, DefaultPerformanceTestConfig().run_config.set_denormal_as_zero, "Sets denormal as zero. When turning on this option reduces latency dramatically, a model may have denormals.");
 ABSL_FLAG(bool, D, DefaultPerformanceTestConfig().run_config.disable_spinning, "Disables spinning entirely for thread owned by onnxruntime intra-op thread pool.");
@@ -352,6 +356,17 @@ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int a
   // -P
   if (absl::GetFlag(FLAGS_P)) test_config.run_config.execution_mode = ExecutionMode::ORT_PARALLEL;
 
+  // --execution_order
+  {
+    const auto& execution_order = absl::GetFlag(FLAGS_execution_order);
+    if (!execution_order.empty()) {
+      if (execution_order != "DEFAULT" && execution_order != "PRIORITY_BASED" && execution_order != "CRITICAL_PATH") {
+        return false;
+      }
+      test_config.run_config.execution_order = execution_order;
+    }
+  }
+
   // -c
   if (absl::GetFlag(FLAGS_c) <= static_cast<size_t>(0)) return false;
   test_config.run_config.concurrent_session_runs = absl::GetFlag(FLAGS_c);
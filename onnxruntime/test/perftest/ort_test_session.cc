@@ -663,6 +663,13 @@ select from 'TF8', 'TF16', 'UINT8', 'FLOAT', 'ITENSOR'. \n)");
     session_options.AddConfigEntry(kOrtSessionOptionsConfigForceSpinningStop, "1");
   }
 
+  if (!performance_test_config.run_config.execution_order.empty()) {
+    warn_dup_config_entry(kOrtSessionOptionsConfigExecutionOrder);
+    fprintf(stdout, "Setting execution order to %s\n", performance_test_config.run_config.execution_order.c_str());
+    session_options.AddConfigEntry(kOrtSessionOptionsConfigExecutionOrder,
+                                   performance_test_config.run_config.execution_order.c_str());
+  }
+
   if (!performance_test_config.run_config.register_custom_op_path.empty()) {
     session_options.RegisterCustomOpsLibrary(performance_test_config.run_config.register_custom_op_path.c_str());
   }
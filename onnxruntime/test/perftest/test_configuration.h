@@ -51,6 +51,7 @@ struct RunConfig {
   bool enable_cpu_mem_arena{true};
   bool generate_model_input_binding{false};
   ExecutionMode execution_mode{ExecutionMode::ORT_SEQUENTIAL};
+  std::string execution_order;
   int intra_op_num_threads{0};
   int inter_op_num_threads{0};
   GraphOptimizationLevel optimization_level{ORT_ENABLE_ALL};
@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <memory>
 #include <functional>
+#include <thread>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -229,6 +230,36 @@ void TestStagedMultiLoopSections(const std::string& name, int num_threads, int n
   }
 }
 
+// Test a NUMA-aware thread pool.  The workers are spread over two mock
+// NUMA nodes, so the test exercises node-local dispatching and stealing
+// on any machine, including ones with a single node.
+void TestNumaAwareSections(int num_threads, int num_loops) {
+  onnxruntime::ThreadOptions thread_options;
+  thread_options.numa_aware = true;
+  for (int i = 0; i < num_threads - 1; i++) {
+    thread_options.numa_nodes.push_back(i % 2);
+  }
+  for (int rep = 0; rep < 5; rep++) {
+    constexpr int num_tasks = 1024;
+    auto test_data = CreateTestData(num_tasks);
+    auto test_data_section = CreateTestData(num_threads);
+    auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), thread_options, nullptr, num_threads, true);
+    ThreadPool::TrySimpleParallelFor(tp.get(), num_tasks, [&](std::ptrdiff_t i) {
+      IncrementElement(*test_data, i);
+    });
+    {
+      ThreadPool::ParallelSection ps(tp.get());
+      for (int l = 0; l < num_loops; l++) {
+        ThreadPool::TrySimpleParallelFor(tp.get(), num_threads, [&](std::ptrdiff_t i) {
+          IncrementElement(*test_data_section, i);
+        });
+      }
+    }
+    ValidateTestData(*test_data);
+    ValidateTestData(*test_data_section, num_loops);
+  }
+}
+
 }  // namespace
 
 namespace onnxruntime {
@@ -510,6 +541,217 @@ TEST(ThreadPoolTest, TestStagedMultiLoopSections_4Thread_100Loop) {
   TestStagedMultiLoopSections("TestStagedMultiLoopSections_4Thread_100Loop", 4, 100);
 }
 
+TEST(ThreadPoolTest, TestNumaAwareSections_5Thread_10Loop) {
+  TestNumaAwareSections(5, 10);
+}
+
+TEST(ThreadPoolTest, TestNumaAwareSections_8Thread_100Loop) {
+  TestNumaAwareSections(8, 100);
+}
+
+TEST(ThreadPoolTest, TestAdaptiveSpinPolicy) {
+  AdaptiveSpinPolicy policy;
+  policy.SetTarget(100);
+  ASSERT_EQ(policy.SpinBudgetMicroseconds(), 100u);
+
+  // Short gaps: the budget follows twice the average gap.
+  for (int i = 0; i < 100; i++) {
+    policy.RecordIdleGap(10);
+  }
+  ASSERT_EQ(policy.SpinBudgetMicroseconds(), 21u);
+
+  // Long gaps, e.g. idle between requests: stop spinning.
+  for (int i = 0; i < 10; i++) {
+    policy.RecordIdleGap(100000);
+  }
+  ASSERT_EQ(policy.SpinBudgetMicroseconds(), 0u);
+
+  // Work arriving in short gaps again: resume spinning, capped at the target.
+  for (int i = 0; i < 20; i++) {
+    policy.RecordIdleGap(80);
+  }
+  ASSERT_GT(policy.SpinBudgetMicroseconds(), 0u);
+  ASSERT_LE(policy.SpinBudgetMicroseconds(), 100u);
+}
+
+TEST(ThreadPoolTest, TestAdaptiveSpinning) {
+  onnxruntime::ThreadOptions thread_options;
+  thread_options.adaptive_spin_target_us = 50;
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), thread_options, nullptr, 4, true);
+  ThreadPool::StartProfiling(tp.get());
+  // Tasks scheduled one at a time leave the workers idle in between.
+  for (int rep = 0; rep < 20; rep++) {
+    onnxruntime::Barrier b(1);
+    ThreadPool::Schedule(tp.get(), [&]() { b.Notify(); });
+    b.Wait();
+  }
+#if !defined(ORT_MINIMAL_BUILD)
+  ASSERT_NE(ThreadPool::StopProfiling(tp.get()).find("spin_budget_us"), std::string::npos);
+#else
+  ThreadPool::StopProfiling(tp.get());
+#endif
+}
+
+TEST(ThreadPoolTest, TestMetrics) {
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions(), nullptr, 4, true);
+  auto metrics = ThreadPool::GetMetrics(tp.get());
+  ASSERT_EQ(metrics.num_threads, 3u);
+  ASSERT_EQ(metrics.parallel_loops, 0u);
+
+  constexpr int num_loops = 10;
+  for (int i = 0; i < num_loops; i++) {
+    ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [](std::ptrdiff_t) {});
+  }
+  {
+    ThreadPool::ParallelSection ps(tp.get());
+    ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [](std::ptrdiff_t) {});
+  }
+  onnxruntime::Barrier b(1);
+  ThreadPool::Schedule(tp.get(), [&]() { b.Notify(); });
+  b.Wait();
+
+  metrics = ThreadPool::GetMetrics(tp.get());
+  ASSERT_EQ(metrics.parallel_sections, 1u);
+  ASSERT_EQ(metrics.parallel_loops, static_cast<uint64_t>(num_loops + 1));
+  ASSERT_GE(metrics.tasks_executed, 1u);
+  ASSERT_GE(metrics.max_queue_depth, 1u);
+  ASSERT_LE(metrics.max_loop_imbalance_us, metrics.loop_imbalance_us);
+
+  metrics = ThreadPool::GetMetrics(nullptr);
+  ASSERT_EQ(metrics.num_threads, 0u);
+  ASSERT_EQ(metrics.tasks_executed, 0u);
+}
+
+TEST(ThreadPoolTest, TestSchedulingOptionsMaxDegreeOfParallelism) {
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions(), nullptr, 5, true);
+  const int full_dop = ThreadPool::DegreeOfParallelism(tp.get());
+  {
+    ThreadPool::ScopedSchedulingOptions scope(nullptr, {0, 2});
+    ASSERT_EQ(ThreadPool::DegreeOfParallelism(tp.get()), full_dop / 5 * 2);
+
+    // The loop must complete using at most 2 distinct threads.
+    auto test_data = CreateTestData(1000);
+    std::mutex mutex;
+    std::vector<std::thread::id> thread_ids;
+    ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t i) {
+      IncrementElement(*test_data, i);
+      std::lock_guard<std::mutex> lock(mutex);
+      if (std::find(thread_ids.begin(), thread_ids.end(), std::this_thread::get_id()) == thread_ids.end()) {
+        thread_ids.push_back(std::this_thread::get_id());
+      }
+    });
+    ValidateTestData(*test_data);
+    ASSERT_LE(thread_ids.size(), 2u);
+
+    // Tasks inherit the scheduling options of the thread scheduling them.
+    onnxruntime::Barrier b(1);
+    int scheduled_max_dop = -1;
+    ThreadPool::Schedule(tp.get(), [&]() {
+      scheduled_max_dop = ThreadPool::GetSchedulingOptions().max_degree_of_parallelism;
+      b.Notify();
+    });
+    b.Wait();
+    ASSERT_EQ(scheduled_max_dop, 2);
+  }
+  ASSERT_EQ(ThreadPool::DegreeOfParallelism(tp.get()), full_dop);
+}
+
+TEST(ThreadPoolTest, TestSchedulingOptionsPriority) {
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions(), nullptr, 4, true);
+  const int full_dop = ThreadPool::DegreeOfParallelism(tp.get());
+  auto dop_at_priority = [&](int priority) {
+    int dop = 0;
+    std::thread t([&]() {
+      ThreadPool::ScopedSchedulingOptions scope(tp.get(), {priority, 0});
+      dop = ThreadPool::DegreeOfParallelism(tp.get());
+    });
+    t.join();
+    return dop;
+  };
+
+  {
+    ThreadPool::ScopedSchedulingOptions high_priority_scope(tp.get(), {1, 0});
+    // The high priority caller keeps the whole pool, lower priority callers run sequentially.
+    ASSERT_EQ(ThreadPool::DegreeOfParallelism(tp.get()), full_dop);
+    ASSERT_EQ(dop_at_priority(1), full_dop);
+    ASSERT_EQ(dop_at_priority(0), 1);
+    ASSERT_EQ(dop_at_priority(-1), 1);
+  }
+  {
+    ThreadPool::ScopedSchedulingOptions normal_priority_scope(tp.get(), {0, 0});
+    ASSERT_EQ(dop_at_priority(0), full_dop);
+    ASSERT_EQ(dop_at_priority(-1), 1);
+  }
+  ASSERT_EQ(dop_at_priority(-1), full_dop);
+}
+
+TEST(ThreadPoolTest, TestSchedulingOptionsCancellation) {
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions(), nullptr, 4, true);
+  ASSERT_FALSE(ThreadPool::IsCancelled());
+
+  // Once the terminate flag is set, the remaining blocks of the loop are skipped.  Like RunOptions::terminate the
+  // flag is a plain bool, so the loop is limited to the calling thread, which is then the only one accessing it.
+  bool terminate = false;
+  {
+    ThreadPool::ScopedSchedulingOptions scope(nullptr, {0, 1, &terminate});
+    ASSERT_FALSE(ThreadPool::IsCancelled());
+    std::ptrdiff_t num_executed = 0;
+    ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t) {
+      if (++num_executed == 10) {
+        terminate = true;
+      }
+    });
+    ASSERT_TRUE(ThreadPool::IsCancelled());
+    ASSERT_EQ(num_executed, 10);
+
+    // Loops run directly in the calling thread are not interrupted, as the caller may read their results.
+    num_executed = 0;
+    ThreadPool::TryParallelFor(nullptr, 1000, 1.0, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      num_executed += last - first;
+    });
+    ThreadPool::TrySimpleParallelFor(nullptr, 1000, [&](std::ptrdiff_t) { ++num_executed; });
+    ThreadPool::TryParallelFor(tp.get(), 1, 1.0, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      num_executed += last - first;
+    });
+    ASSERT_EQ(num_executed, 2001);
+  }
+  ASSERT_FALSE(ThreadPool::IsCancelled());
+
+  // A deadline that passes in the middle of a loop spread across the pool stops the workers from starting new
+  // blocks, and the loop returns once the blocks already started have completed.
+  {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(50);
+    ThreadPool::ScopedSchedulingOptions scope(nullptr, {0, 0, nullptr, deadline});
+    std::atomic<std::ptrdiff_t> num_executed{0};
+    ThreadPool::TrySimpleParallelFor(tp.get(), 10000, [&](std::ptrdiff_t) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      num_executed++;
+    });
+    ASSERT_TRUE(ThreadPool::IsCancelled());
+    ASSERT_GT(num_executed.load(), 0);
+    ASSERT_LT(num_executed.load(), 10000);
+  }
+  ASSERT_FALSE(ThreadPool::IsCancelled());
+
+  // An expired deadline cancels the loop before any block runs, including for scheduled tasks.
+  {
+    ThreadPool::ScopedSchedulingOptions scope(nullptr, {0, 0, nullptr, std::chrono::steady_clock::now()});
+    ASSERT_TRUE(ThreadPool::IsCancelled());
+    std::atomic<std::ptrdiff_t> num_executed{0};
+    ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t) { num_executed++; });
+    ASSERT_EQ(num_executed.load(), 0);
+
+    onnxruntime::Barrier b(1);
+    bool scheduled_cancelled = false;
+    ThreadPool::Schedule(tp.get(), [&]() {
+      scheduled_cancelled = ThreadPool::IsCancelled();
+      b.Notify();
+    });
+    b.Wait();
+    ASSERT_TRUE(scheduled_cancelled);
+  }
+}
+
 #ifdef _WIN32
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
 #pragma warning(push)
@@ -3,6 +3,7 @@
 #include "core/graph/constants.h"
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
 
 using namespace std;
 namespace onnxruntime {
@@ -673,6 +674,78 @@ TEST(ConvTest, Conv2D_group) {
   TestConvOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape, true);
 }
 
+// Runs a 3x3 stride 1 convolution with enough channels and tiles to use the MLAS Winograd algorithm on the CPU EP.
+// Returns the number of weights pre-packed by Conv<float>::PrePack.
+size_t RunConv2DWinograd(int64_t H, int64_t W_, bool weight_is_initializer, bool input_shape_is_known) {
+  constexpr int64_t N = 1, C = 16, M = 16;
+
+  vector<float> X(static_cast<size_t>(N * C * H * W_));
+  vector<float> W(static_cast<size_t>(M * C * 3 * 3));
+  vector<float> B(static_cast<size_t>(M));
+  for (size_t i = 0; i < X.size(); i++) X[i] = static_cast<float>(i % 13) * 0.25f - 1.5f;
+  for (size_t i = 0; i < W.size(); i++) W[i] = static_cast<float>(i % 7) * 0.125f - 0.375f;
+  for (size_t i = 0; i < B.size(); i++) B[i] = static_cast<float>(i) * 0.5f;
+
+  vector<float> Y(static_cast<size_t>(N * M * H * W_));
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t oh = 0; oh < H; oh++) {
+      for (int64_t ow = 0; ow < W_; ow++) {
+        float sum = B[m];
+        for (int64_t c = 0; c < C; c++) {
+          for (int64_t kh = 0; kh < 3; kh++) {
+            for (int64_t kw = 0; kw < 3; kw++) {
+              const int64_t ih = oh + kh - 1;
+              const int64_t iw = ow + kw - 1;
+              if (ih >= 0 && ih < H && iw >= 0 && iw < W_) {
+                sum += X[(c * H + ih) * W_ + iw] * W[((m * C + c) * 3 + kh) * 3 + kw];
+              }
+            }
+          }
+        }
+        Y[(m * H + oh) * W_ + ow] = sum;
+      }
+    }
+  }
+
+  OpTester test("Conv", 11);
+  test.AddAttribute("group", int64_t{1});
+  test.AddAttribute("kernel_shape", vector<int64_t>{3, 3});
+  test.AddAttribute("pads", vector<int64_t>{1, 1, 1, 1});
+  test.AddAttribute("strides", vector<int64_t>{1, 1});
+  test.AddShapeToTensorData(input_shape_is_known);
+  test.AddInput<float>("X", {N, C, H, W_}, X);
+  test.AddInput<float>("W", {M, C, 3, 3}, W, weight_is_initializer);
+  test.AddInput<float>("B", {M}, B);
+  test.AddOutput<float>("Y", {N, M, H, W_}, Y);
+  test.SetOutputTolerance(1e-4f);
+
+  // A single thread makes the selection of the algorithm without a packed filter deterministic.
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 1;
+
+  size_t number_of_pre_packed_weights = 0;
+  test.Config(so)
+      .ConfigEp(DefaultCpuExecutionProvider())
+      .RunWithConfig(&number_of_pre_packed_weights);
+  return number_of_pre_packed_weights;
+}
+
+TEST(ConvTest, Conv2D_Winograd) {
+  // Without an initializer, the convolution is too small to amortize transforming the filter on each run and uses
+  // the GEMM path.
+  EXPECT_EQ(RunConv2DWinograd(8, 9, false, true), 0u);
+
+  // The input shape shows that the Winograd algorithm is selected, so PrePack replaces the filter with the
+  // transformed filter.
+  EXPECT_EQ(RunConv2DWinograd(8, 9, true, true), 1u);
+
+  // Otherwise the filter is kept for the GEMM path...
+  EXPECT_EQ(RunConv2DWinograd(8, 9, true, false), 0u);
+
+  // ...and transformed the first time the input is large enough for the Winograd algorithm.
+  EXPECT_EQ(RunConv2DWinograd(32, 33, true, false), 0u);
+}
+
 TEST(ConvTest, Depthwise2D_Bias_Group1_Issue18992) {
   ConvOpAndTestAttributes attrs = {
       "",                           // auto_pad
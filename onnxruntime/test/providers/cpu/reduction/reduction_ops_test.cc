@@ -5027,6 +5027,113 @@ TEST(ReductionOpTest, ReduceMax_KRK_keepdims) {
   test.Run();
 }
 
+// A NaN in the reduced elements makes the maximum NaN, as for the reductions that do not use MLAS.
+TEST(ReductionOpTest, ReduceMax_KR_NaN) {
+  constexpr float FLOAT_NAN = std::numeric_limits<float>::quiet_NaN();
+  OpTester test("ReduceMax");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<float>("data", {3, 4},
+                       {1.0f, 2.0f, 3.0f, FLOAT_NAN,
+                        FLOAT_NAN, 1.0f, 2.0f, 3.0f,
+                        1.0f, 2.0f, 3.0f, 4.0f});
+  test.AddOutput<float>("reduced", {3}, {FLOAT_NAN, FLOAT_NAN, 4.0f});
+  test.ConfigEp(DefaultCpuExecutionProvider()).RunWithConfig();
+}
+
+TEST(ReductionOpTest, ReduceMax_RK_NaN) {
+  constexpr float FLOAT_NAN = std::numeric_limits<float>::quiet_NaN();
+  OpTester test("ReduceMax");
+  test.AddAttribute("axes", std::vector<int64_t>{0});
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<float>("data", {3, 5},
+                       {1.0f, FLOAT_NAN, 3.0f, 4.0f, 5.0f,
+                        6.0f, 7.0f, 8.0f, 9.0f, 0.0f,
+                        0.0f, 0.0f, 0.0f, 0.0f, FLOAT_NAN});
+  test.AddOutput<float>("reduced", {5}, {6.0f, FLOAT_NAN, 8.0f, 9.0f, FLOAT_NAN});
+  test.ConfigEp(DefaultCpuExecutionProvider()).RunWithConfig();
+}
+
+TEST(ReductionOpTest, ReduceMax_KRK_NaN) {
+  constexpr float FLOAT_NAN = std::numeric_limits<float>::quiet_NaN();
+  OpTester test("ReduceMax");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<float>("data", {2, 3, 2},
+                       {FLOAT_NAN, 2.0f,
+                        3.0f, 4.0f,
+                        5.0f, 6.0f,
+
+                        7.0f, 8.0f,
+                        9.0f, 10.0f,
+                        11.0f, FLOAT_NAN});
+  test.AddOutput<float>("reduced", {2, 2}, {FLOAT_NAN, 6.0f, 11.0f, FLOAT_NAN});
+  test.ConfigEp(DefaultCpuExecutionProvider()).RunWithConfig();
+}
+
+// Reduces a long axis into a narrow output, which MLAS splits across the threads of the intra-op pool.
+void TestReduceLongAxisNarrowOutput(const std::string& op_type) {
+  constexpr int64_t rows = 100000, columns = 4;
+
+  // Small integers keep the sums exact in any order.
+  std::vector<float> data(static_cast<size_t>(rows * columns));
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i % 7);
+  }
+  data[static_cast<size_t>(77777 * columns + 2)] = 9.0f;
+
+  std::vector<float> expected(static_cast<size_t>(columns));
+  for (size_t c = 0; c < expected.size(); ++c) {
+    double sum = 0.0, maximum = -std::numeric_limits<double>::infinity();
+    for (size_t r = 0; r < static_cast<size_t>(rows); ++r) {
+      const double value = data[r * columns + c];
+      sum += value;
+      maximum = std::max(maximum, value);
+    }
+
+    if (op_type == "ReduceSum") {
+      expected[c] = static_cast<float>(sum);
+    } else if (op_type == "ReduceMax") {
+      expected[c] = static_cast<float>(maximum);
+    } else {
+      double sum_exp = 0.0;
+      for (size_t r = 0; r < static_cast<size_t>(rows); ++r) {
+        sum_exp += std::exp(data[r * columns + c] - maximum);
+      }
+      expected[c] = static_cast<float>(maximum + std::log(sum_exp));
+    }
+  }
+
+  OpTester test(op_type.c_str(), 13);
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<float>("data", {rows, columns}, data);
+  if (op_type == "ReduceSum") {
+    test.AddInput<int64_t>("axes", {1}, {0}, true);
+  } else {
+    test.AddAttribute("axes", std::vector<int64_t>{0});
+  }
+  test.AddOutput<float>("reduced", {columns}, expected);
+  test.SetOutputTolerance(1e-5f);
+
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 4;
+  test.Config(so)
+      .ConfigEp(DefaultCpuExecutionProvider())
+      .RunWithConfig();
+}
+
+TEST(ReductionOpTest, ReduceSum_RK_long_axis_parallel) {
+  TestReduceLongAxisNarrowOutput("ReduceSum");
+}
+
+TEST(ReductionOpTest, ReduceMax_RK_long_axis_parallel) {
+  TestReduceLongAxisNarrowOutput("ReduceMax");
+}
+
+TEST(ReductionOpTest, ReduceLogSumExp_RK_long_axis_parallel) {
+  TestReduceLongAxisNarrowOutput("ReduceLogSumExp");
+}
+
 TEST(ReductionOpTest, ReduceMax_RKR) {
   OpTester test("ReduceMax");
   test.AddAttribute("axes", std::vector<int64_t>{0, 2});
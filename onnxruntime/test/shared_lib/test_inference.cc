@@ -8,6 +8,7 @@
 #include <iostream>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <sstream>
 #include <thread>
 #include <vector>
@@ -4524,6 +4525,48 @@ TEST(CApiTest, RunAsyncFail) {
   EXPECT_THROW(session.RunAsync(run_options, input_names, input_tensors, 1, output_names, output_values, 1, CallbackFail, nullptr), std::exception);
 }
 
+TEST(CApiTest, RunAsyncWithCompletionQueue) {
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(2);
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  const char* input_names[] = {"X"};
+  float x_value[] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  int64_t x_dim[] = {3, 2};
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  Ort::Value input_tensors[1] = {
+      Ort::Value::CreateTensor<float>(memory_info, x_value, 6, x_dim, 2),
+  };
+  const char* output_names[] = {"Y"};
+  Ort::RunOptions run_options;
+
+  constexpr size_t kNumRuns = 8;
+  Ort::RunCompletionQueue queue(/*max_concurrent_runs*/ 2, /*max_pending_runs*/ 4);
+  std::vector<Ort::Value> output_values;
+  for (size_t i = 0; i < kNumRuns; ++i) {
+    output_values.emplace_back(nullptr);
+  }
+  for (size_t i = 0; i < kNumRuns; ++i) {
+    session.RunAsync(run_options, input_names, input_tensors, 1, output_names, &output_values[i], 1, queue,
+                     &output_values[i]);
+  }
+
+  std::set<void*> tags;
+  for (int attempt = 0; attempt < 100 && tags.size() < kNumRuns; ++attempt) {
+    // drain in batches, each call waits up to 100ms for the first completion
+    for (auto& completion : queue.Dequeue(100, 3)) {
+      ASSERT_TRUE(completion.status.IsOK()) << completion.status.GetErrorMessage();
+      EXPECT_TRUE(tags.insert(completion.tag).second);
+      auto* output_value = static_cast<Ort::Value*>(completion.tag);
+      EXPECT_EQ(output_value->At<float>({1, 0}), 9.f);
+    }
+  }
+  EXPECT_EQ(tags.size(), kNumRuns);
+
+  // nothing left to dequeue
+  EXPECT_TRUE(queue.Dequeue(0, 1).empty());
+}
+
 static void TestRunWithLoraAdapter(const Ort::LoraAdapter& adapter) {
   constexpr const ORTCHAR_T* model_path = TSTR("testdata/lora/two_params_lora_model.onnx");
 
@@ -19,3 +19,12 @@ TEST(CApiTest, run_options_config) {
   EXPECT_STREQ(options.GetConfigEntry("foo"), "bar");
   EXPECT_EQ(options.GetConfigEntry("not foo"), nullptr);
 }
+
+TEST(CApiTest, run_options_priority) {
+  Ort::RunOptions options;
+  EXPECT_EQ(options.GetPriority(), 0);
+  options.SetPriority(1);
+  EXPECT_EQ(options.GetPriority(), 1);
+  options.SetPriority(-1);
+  EXPECT_EQ(options.GetPriority(), -1);
+}